@@ -1,4 +1,4 @@
-QT += core gui network xml widgets multimedia
+QT += core gui network xml widgets multimedia concurrent
 
 CONFIG += c++17
 
@@ -30,11 +30,30 @@ SOURCES += \
     src/core/ParameterInLimits.cpp \
     src/core/ParameterOutOfLimits.cpp \
     src/core/ParameterChanged.cpp \
+    src/core/ParameterExpression.cpp \
+    src/core/ParameterRateOfChange.cpp \
+    src/core/ParameterTrend.cpp \
+    src/core/ParameterStatistic.cpp \
     src/core/ParameterModel.cpp \
+    src/core/ConditionProgram.cpp \
+    src/core/Expression.cpp \
+    src/core/LimitKernel.cpp \
+    src/core/WindowStore.cpp \
+    src/core/HistoryStore.cpp \
+    src/core/TelemetryArchive.cpp \
+    src/core/TelemetryArchiveReader.cpp \
+    src/core/TelemetryQuery.cpp \
+    src/core/RuleReplay.cpp \
     src/core/SotmClient.cpp \
     src/core/XmlParser.cpp \
     src/core/MonitoringService.cpp \
     src/core/AlertManager.cpp \
+    src/core/LogBuffer.cpp \
+    src/core/LogIndex.cpp \
+    src/core/LogSearch.cpp \
+    src/core/LogStringTable.cpp \
+    src/core/LogJournalCursor.cpp \
+    src/core/LogJournalReader.cpp \
     src/core/LogManager.cpp \
     src/core/TmiAnalyzer.cpp \
     src/core/UpdateManager.cpp \
@@ -56,11 +75,36 @@ HEADERS += \
     src/core/ParameterInLimits.h \
     src/core/ParameterOutOfLimits.h \
     src/core/ParameterChanged.h \
+    src/core/ParameterExpression.h \
+    src/core/ParameterRateOfChange.h \
+    src/core/ParameterTrend.h \
+    src/core/ParameterStatistic.h \
     src/core/ParameterModel.h \
+    src/core/ParameterSnapshot.h \
+    src/core/TickResult.h \
+    src/core/ConditionProgram.h \
+    src/core/Expression.h \
+    src/core/LimitKernel.h \
+    src/core/WindowStore.h \
+    src/core/HistoryStore.h \
+    src/core/TelemetryArchive.h \
+    src/core/BinaryFormat.h \
+    src/core/TelemetryArchiveFormat.h \
+    src/core/TelemetryArchiveReader.h \
+    src/core/TelemetryQuery.h \
+    src/core/RuleReplay.h \
     src/core/SotmClient.h \
     src/core/XmlParser.h \
     src/core/MonitoringService.h \
     src/core/AlertManager.h \
+    src/core/LogEntry.h \
+    src/core/LogBuffer.h \
+    src/core/LogIndex.h \
+    src/core/LogSearch.h \
+    src/core/LogStringTable.h \
+    src/core/LogJournalFormat.h \
+    src/core/LogJournalCursor.h \
+    src/core/LogJournalReader.h \
     src/core/LogManager.h \
     src/core/TmiAnalyzer.h \
     src/core/UpdateManager.h \
@@ -0,0 +1,47 @@
+# Микробенчмарк проверки пределов: виртуальный путь Parameter::updateValue()
+# против скомпилированной программы и векторного ядра LimitKernel.
+#
+# Сборка (из корня репозитория):
+#   qmake benchmarks/LimitKernelBenchmark && make
+# Запуск:
+#   ./LimitKernelBenchmark [количество_параметров] [количество_тактов]
+
+QT += core xml concurrent
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = LimitKernelBenchmark
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    main.cpp \
+    $$ROOT/src/core/Parameter.cpp \
+    $$ROOT/src/core/ParameterEquals.cpp \
+    $$ROOT/src/core/ParameterNotEquals.cpp \
+    $$ROOT/src/core/ParameterInLimits.cpp \
+    $$ROOT/src/core/ParameterOutOfLimits.cpp \
+    $$ROOT/src/core/ParameterChanged.cpp \
+    $$ROOT/src/core/ParameterExpression.cpp \
+    $$ROOT/src/core/ParameterRateOfChange.cpp \
+    $$ROOT/src/core/ParameterTrend.cpp \
+    $$ROOT/src/core/ParameterStatistic.cpp \
+    $$ROOT/src/core/ConditionProgram.cpp \
+    $$ROOT/src/core/Expression.cpp \
+    $$ROOT/src/core/LimitKernel.cpp \
+    $$ROOT/src/core/WindowStore.cpp \
+    $$ROOT/src/core/HistoryStore.cpp
+
+HEADERS += \
+    $$ROOT/src/core/Parameter.h \
+    $$ROOT/src/core/ConditionProgram.h \
+    $$ROOT/src/core/LimitKernel.h \
+    $$ROOT/src/core/WindowStore.h \
+    $$ROOT/src/core/HistoryStore.h
+
+INCLUDEPATH += $$ROOT/src/core
@@ -0,0 +1,180 @@
+// benchmarks/LimitKernelBenchmark/main.cpp
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QTextStream>
+#include <QVariantList>
+#include <QtAlgorithms>
+#include <QVector>
+#include <memory>
+#include <random>
+
+#include "Parameter.h"
+#include "ConditionProgram.h"
+#include "LimitKernel.h"
+
+using namespace ParamControl;
+
+namespace {
+
+/**
+ * @brief Набор тактов для прогона: одинаковые данные для всех вариантов.
+ */
+struct Workload {
+    QVector<std::shared_ptr<Parameter>> parameters;
+    QVector<QVector<ParameterValue>> ticks;
+};
+
+Workload makeWorkload(int parameterCount, int tickCount) {
+    Workload workload;
+    std::mt19937 rng(20240601);
+    std::uniform_real_distribution<double> limit(-100.0, 100.0);
+    std::uniform_real_distribution<double> width(5.0, 50.0);
+
+    for (int i = 0; i < parameterCount; ++i) {
+        const double lower = limit(rng);
+        QVariantList limits;
+        limits << lower << lower + width(rng);
+        const ParameterType type = (i % 4 == 0) ? ParameterType::OutOfLimits : ParameterType::InLimits;
+        workload.parameters.append(Parameter::create(QString("T%1").arg(i), type, limits));
+    }
+
+    std::uniform_real_distribution<double> value(-150.0, 150.0);
+    workload.ticks.resize(tickCount);
+    for (auto& tick : workload.ticks) {
+        tick.reserve(parameterCount);
+        for (int i = 0; i < parameterCount; ++i) {
+            tick.append(ParameterValue{QString("T%1").arg(i), QVariant(value(rng))});
+        }
+    }
+
+    return workload;
+}
+
+/**
+ * @brief Прежний путь: поиск значения по имени и виртуальный checkCondition() на объект.
+ */
+qint64 runVirtual(const Workload& workload, int& transitions) {
+    QElapsedTimer timer;
+    timer.start();
+
+    for (const auto& tick : workload.ticks) {
+        QMap<QString, QVariant> valueMap;
+        for (const auto& value : tick) {
+            valueMap[value.name] = value.value;
+        }
+        for (const auto& parameter : workload.parameters) {
+            if (parameter->updateValue(valueMap.value(parameter->getName()))) {
+                ++transitions;
+            }
+        }
+    }
+
+    return timer.nsecsElapsed();
+}
+
+/**
+ * @brief Полный путь ConditionProgram: разбор входов такта и выполнение правил.
+ */
+qint64 runProgram(const Workload& workload, int& transitions) {
+    auto program = ConditionProgram::compile(workload.parameters);
+    ConditionProgram::RunResult result;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (const auto& tick : workload.ticks) {
+        program->loadInputs(tick);
+        program->run(result);
+        transitions += result.transitions.size();
+    }
+
+    return timer.nsecsElapsed();
+}
+
+/**
+ * @brief Только ядро LimitTable на заранее заполненных значениях.
+ */
+qint64 runKernel(const Workload& workload, LimitKernelPath path, int& transitions) {
+    LimitTable table;
+    QVector<QVector<double>> values(workload.ticks.size());
+
+    for (const auto& parameter : workload.parameters) {
+        const QVariantList limits = parameter->getTargetValue().toList();
+        table.addRow(limits[0].toDouble(), limits[1].toDouble(),
+                     parameter->getType() == ParameterType::OutOfLimits, ParameterStatus::Unknown);
+    }
+    for (int t = 0; t < workload.ticks.size(); ++t) {
+        for (const auto& value : workload.ticks[t]) {
+            values[t].append(value.value.toDouble());
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (const auto& tick : values) {
+        table.beginTick();
+        for (int lane = 0; lane < tick.size(); ++lane) {
+            table.setValue(lane, tick[lane]);
+        }
+        table.evaluate(path);
+        for (quint64 word : table.changedBits()) {
+            transitions += qPopulationCount(word);
+        }
+    }
+
+    return timer.nsecsElapsed();
+}
+
+void report(QTextStream& out, const QString& name, qint64 nsecs, int ticks, int rules,
+            int transitions, qint64 baseline) {
+    const double perTick = double(nsecs) / ticks / 1000.0;
+    const double perRule = double(nsecs) / (double(ticks) * rules);
+    out << QString("%1 %2 us/tick %3 ns/rule  x%4  (transitions: %5)")
+               .arg(name, -22)
+               .arg(perTick, 10, 'f', 1)
+               .arg(perRule, 7, 'f', 2)
+               .arg(double(baseline) / qMax<qint64>(nsecs, 1), 6, 'f', 1)
+               .arg(transitions)
+        << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    const int parameterCount = args.size() > 1 ? args[1].toInt() : 5000;
+    const int tickCount = args.size() > 2 ? args[2].toInt() : 200;
+
+    QTextStream out(stdout);
+    out << "Parameters: " << parameterCount << ", ticks: " << tickCount
+        << ", detected kernel: " << LimitKernel::pathName(LimitKernel::detectedPath()) << "\n";
+
+    const Workload workload = makeWorkload(parameterCount, tickCount);
+
+    int transitions = 0;
+    const qint64 virtualNs = runVirtual(workload, transitions);
+    report(out, "virtual updateValue", virtualNs, tickCount, parameterCount, transitions, virtualNs);
+
+    transitions = 0;
+    report(out, "ConditionProgram", runProgram(workload, transitions),
+           tickCount, parameterCount, transitions, virtualNs);
+
+    QVector<LimitKernelPath> paths = {LimitKernelPath::Scalar};
+    if (LimitKernel::detectedPath() != LimitKernelPath::Scalar) {
+        paths << LimitKernelPath::Sse2;
+    }
+    if (LimitKernel::detectedPath() == LimitKernelPath::Avx2) {
+        paths << LimitKernelPath::Avx2;
+    }
+    for (LimitKernelPath path : paths) {
+        transitions = 0;
+        report(out, "LimitTable " + LimitKernel::pathName(path), runKernel(workload, path, transitions),
+               tickCount, parameterCount, transitions, virtualNs);
+    }
+
+    return 0;
+}
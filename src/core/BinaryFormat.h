@@ -0,0 +1,45 @@
+// src/core/BinaryFormat.h
+#pragma once
+
+#include <QByteArray>
+#include <QtEndian>
+
+#include <cstring>
+
+/**
+ * @file BinaryFormat.h
+ * @brief Чтение и запись чисел little-endian без требований к выравниванию.
+ *
+ * Общие для форматов на диске: архива ТМИ (TelemetryArchiveFormat.h)
+ * и журнала событий (LogJournalFormat.h).
+ */
+
+namespace ParamControl {
+
+template <typename T>
+inline void archivePut(QByteArray& out, T value) {
+    T stored = qToLittleEndian(value);
+    out.append(reinterpret_cast<const char*>(&stored), int(sizeof(T)));
+}
+
+inline void archivePutDouble(QByteArray& out, double value) {
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    archivePut<quint64>(out, bits);
+}
+
+template <typename T>
+inline T archiveGet(const uchar* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return qFromLittleEndian(value);
+}
+
+inline double archiveGetDouble(const uchar* data) {
+    const quint64 bits = archiveGet<quint64>(data);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace ParamControl
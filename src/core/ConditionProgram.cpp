@@ -0,0 +1,984 @@
+// src/core/ConditionProgram.cpp
+#include "ConditionProgram.h"
+#include "ParameterChanged.h"
+#include "ParameterRateOfChange.h"
+#include "ParameterTrend.h"
+#include "ParameterStatistic.h"
+
+#include <QSet>
+#include <QVariantList>
+#include <QDateTime>
+#include <QDebug>
+#include <QtAlgorithms> // Для qCountTrailingZeroBits
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iterator>
+
+namespace ParamControl {
+
+namespace {
+
+/**
+ * @brief Разбирает порог условия в double и, если возможно, в int64.
+ * @return true, если значение является числом.
+ */
+bool parseThreshold(const QVariant& value, double& number, qint64& integer, bool& isInteger) {
+    const QString text = value.toString().trimmed();
+    bool ok = false;
+
+    integer = text.toLongLong(&ok);
+    if (ok) {
+        number = static_cast<double>(integer);
+        isInteger = true;
+        return true;
+    }
+
+    isInteger = false;
+    number = text.toDouble(&ok);
+    return ok;
+}
+
+/**
+ * @brief Проверяет, что целое значение точно представимо в double.
+ */
+bool exactInDouble(qint64 value) {
+    const double converted = static_cast<double>(value);
+    return converted >= -9007199254740992.0 && converted <= 9007199254740992.0 &&
+           static_cast<qint64>(converted) == value;
+}
+
+} // namespace
+
+std::shared_ptr<ConditionProgram> ConditionProgram::compile(
+    const QVector<std::shared_ptr<Parameter>>& parameters,
+    const ConditionProgram* previous,
+    const HistoryStore* history,
+    int sampleIntervalMs)
+{
+    auto program = std::make_shared<ConditionProgram>();
+    program->m_sampleIntervalMs = qMax(1, sampleIntervalMs);
+
+    const int count = parameters.size();
+    program->m_keys.reserve(count);
+    program->m_opcodes.reserve(count);
+    program->m_inputSlots.reserve(count);
+    program->m_lower.reserve(count);
+    program->m_upper.reserve(count);
+    program->m_lowerInt.reserve(count);
+    program->m_upperInt.reserve(count);
+    program->m_integerLimits.reserve(count);
+    program->m_textTargets.reserve(count);
+    program->m_status.reserve(count);
+    program->m_lastValue.reserve(count);
+    program->m_hasLast.reserve(count);
+    program->m_hysteresis.reserve(count);
+    program->m_filtered.reserve(count);
+    program->m_entrySamples.reserve(count);
+    program->m_exitSamples.reserve(count);
+    program->m_entryHoldMs.reserve(count);
+    program->m_exitHoldMs.reserve(count);
+    program->m_pendingCount.reserve(count);
+    program->m_pendingSince.reserve(count);
+    program->m_windows.reserve(count);
+    program->m_statistics.reserve(count);
+    program->m_lanes.reserve(count);
+
+    // Индекс правил предыдущей программы для переноса состояния
+    QHash<RuleKey, int> previousRules;
+    if (previous) {
+        previousRules.reserve(previous->m_keys.size());
+        for (int i = 0; i < previous->m_keys.size(); ++i) {
+            previousRules.insert(previous->m_keys[i], i);
+        }
+    }
+
+    for (const auto& parameter : parameters) {
+        program->appendRule(*parameter);
+
+        const int rule = program->m_keys.size() - 1;
+        const int oldRule = previousRules.value(program->m_keys[rule], -1);
+        if (oldRule >= 0) {
+            program->m_lastValue[rule] = previous->m_lastValue[oldRule];
+            program->m_hasLast[rule] = previous->m_hasLast[oldRule];
+            if (program->m_filtered[rule] && previous->m_pendingCount[oldRule] > 0) {
+                program->m_pendingCount[rule] = previous->m_pendingCount[oldRule];
+                program->m_pendingSince[rule] = previous->m_pendingSince[oldRule];
+                if (program->m_lanes[rule] >= 0) {
+                    program->m_limits.setPending(program->m_lanes[rule], true);
+                }
+            }
+            if (program->m_windows[rule] >= 0 && previous->m_windows[oldRule] >= 0) {
+                program->m_windowStore.copyWindow(program->m_windows[rule],
+                                                  previous->m_windowStore, previous->m_windows[oldRule]);
+            }
+        }
+        if (history && program->m_windows[rule] >= 0 &&
+            program->m_windowStore.sampleCount(program->m_windows[rule]) == 0) {
+            program->seedWindow(rule, *history);
+        }
+    }
+
+    if (previous) {
+        program->m_tickTimeMs = previous->m_tickTimeMs;
+    }
+
+    program->buildExpressionGraph();
+    program->m_inputs.resize(program->m_inputIndex.size());
+
+    // Последние известные значения входов нужны выражениям и после перекомпиляции
+    if (previous) {
+        for (auto it = program->m_inputIndex.constBegin(); it != program->m_inputIndex.constEnd(); ++it) {
+            const int oldSlot = previous->m_inputIndex.value(it.key(), -1);
+            if (oldSlot >= 0) {
+                program->m_inputs[it.value()] = previous->m_inputs[oldSlot];
+                program->m_inputs[it.value()].present = false;
+            }
+        }
+    }
+
+    return program;
+}
+
+int ConditionProgram::ruleCount() const {
+    return m_opcodes.size();
+}
+
+int ConditionProgram::inputCount() const {
+    return m_inputs.size();
+}
+
+QStringList ConditionProgram::inputNames() const {
+    return m_inputIndex.keys();
+}
+
+void ConditionProgram::appendRule(const Parameter& parameter) {
+    const QString name = parameter.getName();
+    const ParameterType type = parameter.getType();
+    const QVariant target = parameter.getTargetValue();
+
+    // Вход правила: один слот на уникальное имя параметра ТМИ.
+    // У выражения собственного входа нет - его входы определяются в buildExpressionGraph().
+    int slot = -1;
+    if (type != ParameterType::Expression) {
+        slot = inputSlotFor(name);
+    }
+
+    ConditionOpcode opcode = ConditionOpcode::Invalid;
+    double lower = 0.0;
+    double upper = 0.0;
+    qint64 lowerInt = 0;
+    qint64 upperInt = 0;
+    bool integerLimits = false;
+    QString textTarget;
+    int windowCapacity = 0;
+    qint64 windowSpanMs = 0;
+    WindowStatistic statistic = WindowStatistic::Deviation;
+
+    switch (type) {
+        case ParameterType::Equals:
+        case ParameterType::NotEquals: {
+            const bool equals = (type == ParameterType::Equals);
+            textTarget = target.toString();
+            if (parseThreshold(target, lower, lowerInt, integerLimits)) {
+                opcode = equals ? ConditionOpcode::EqualsNumber : ConditionOpcode::NotEqualsNumber;
+            } else {
+                opcode = equals ? ConditionOpcode::EqualsText : ConditionOpcode::NotEqualsText;
+            }
+            break;
+        }
+        case ParameterType::InLimits:
+        case ParameterType::OutOfLimits: {
+            const QVariantList limits = target.toList();
+            bool lowerInteger = false;
+            bool upperInteger = false;
+            if (limits.size() >= 2 &&
+                parseThreshold(limits[0], lower, lowerInt, lowerInteger) &&
+                parseThreshold(limits[1], upper, upperInt, upperInteger)) {
+                integerLimits = lowerInteger && upperInteger;
+                opcode = (type == ParameterType::InLimits) ? ConditionOpcode::InLimits
+                                                           : ConditionOpcode::OutOfLimits;
+            } else {
+                qWarning() << "ConditionProgram: Invalid limits for parameter" << name;
+            }
+            break;
+        }
+        case ParameterType::Changed:
+            opcode = ConditionOpcode::Changed;
+            break;
+        case ParameterType::Expression: {
+            QString error;
+            auto expression = Expression::compile(target.toString(), &error);
+            if (expression) {
+                opcode = ConditionOpcode::Expression;
+                m_exprRules.append(m_opcodes.size());
+                m_exprCode.append(expression);
+            } else {
+                qWarning() << "ConditionProgram: Invalid expression for parameter" << name << "-" << error;
+            }
+            break;
+        }
+        case ParameterType::RateOfChange:
+        case ParameterType::Trend: {
+            // Порог хранится в m_lower: наклон в секунду (RateOfChange) или изменение за окно (Trend)
+            const QVariantList settings = target.toList();
+            bool firstOk = false;
+            bool secondOk = false;
+            const double first = settings.value(0).toDouble(&firstOk);
+            const double second = settings.value(1).toDouble(&secondOk);
+            if (!firstOk || !secondOk) {
+                qWarning() << "ConditionProgram: Invalid window settings for parameter" << name;
+            } else if (type == ParameterType::RateOfChange && second > 0.0) {
+                opcode = ConditionOpcode::RateOfChange;
+                lower = first / 60.0;
+                windowSpanMs = qRound64(second * 1000.0);
+                windowCapacity = WindowStore::capacityForSpan(windowSpanMs, m_sampleIntervalMs);
+            } else if (type == ParameterType::Trend && first >= 2.0 && first <= ParameterTrend::kMaxSamples) {
+                opcode = ConditionOpcode::Trend;
+                lower = second;
+                windowCapacity = int(first);
+            } else {
+                qWarning() << "ConditionProgram: Invalid window settings for parameter" << name;
+            }
+            break;
+        }
+        case ParameterType::Statistic: {
+            // Порог хранится в m_lower, вид статистики - в m_statistics
+            const QVariantList settings = target.toList();
+            bool thresholdOk = false;
+            bool windowOk = false;
+            const double threshold = settings.value(1).toDouble(&thresholdOk);
+            const double seconds = settings.value(2).toDouble(&windowOk);
+            if (thresholdOk && windowOk && seconds > 0.0 &&
+                ParameterStatistic::parseStatistic(settings.value(0).toString(), statistic)) {
+                opcode = ConditionOpcode::Statistic;
+                lower = threshold;
+                windowSpanMs = qRound64(seconds * 1000.0);
+                windowCapacity = WindowStore::capacityForSpan(windowSpanMs, m_sampleIntervalMs);
+            } else {
+                qWarning() << "ConditionProgram: Invalid window settings for parameter" << name;
+            }
+            break;
+        }
+        default:
+            qWarning() << "ConditionProgram: Unknown parameter type for" << name;
+            break;
+    }
+
+    // Окно сверх наибольшей емкости охватывает только последние отсчеты
+    if (windowSpanMs > 0 && windowSpanMs / m_sampleIntervalMs + 2 > WindowStore::kMaxSpanCapacity) {
+        qWarning() << "ConditionProgram: Window of parameter" << name << "is limited to"
+                   << WindowStore::kMaxSpanCapacity << "samples";
+    }
+
+    m_keys.append(qMakePair(name, static_cast<int>(type)));
+    m_opcodes.append(opcode);
+    m_inputSlots.append(slot);
+    m_lower.append(lower);
+    m_upper.append(upper);
+    m_lowerInt.append(lowerInt);
+    m_upperInt.append(upperInt);
+    m_integerLimits.append(integerLimits ? 1 : 0);
+    m_textTargets.append(textTarget);
+    m_status.append(parameter.getStatus());
+    m_lastValue.append(QVariant());
+    m_hasLast.append(0);
+
+    // Гистерезис имеет смысл только для условий с границами
+    const ConditionFilter filter = parameter.getFilter();
+    const bool limitRule = (opcode == ConditionOpcode::InLimits || opcode == ConditionOpcode::OutOfLimits);
+    const double hysteresis = limitRule ? filter.hysteresis : 0.0;
+    m_hysteresis.append(hysteresis);
+    m_filtered.append(filter.isImmediate() ? 0 : 1);
+    m_entrySamples.append(filter.entrySamples);
+    m_exitSamples.append(filter.exitSamples);
+    m_entryHoldMs.append(qRound64(filter.entrySeconds * 1000.0));
+    m_exitHoldMs.append(qRound64(filter.exitSeconds * 1000.0));
+    m_pendingCount.append(0);
+    m_pendingSince.append(0);
+    m_windows.append(windowCapacity > 0 ? m_windowStore.addWindow(windowCapacity, windowSpanMs) : -1);
+    m_statistics.append(static_cast<quint8>(statistic));
+
+    // Пределы с большими целыми границами остаются в скалярном цикле (точное сравнение int64)
+    const int rule = m_opcodes.size() - 1;
+    if (limitRule && (!integerLimits || (exactInDouble(lowerInt) && exactInDouble(upperInt)))) {
+        const int lane = m_limits.addRow(lower, upper, opcode == ConditionOpcode::OutOfLimits,
+                                         parameter.getStatus(), hysteresis, !filter.isImmediate());
+        m_lanes.append(lane);
+        m_laneRules.append(rule);
+    } else if (opcode == ConditionOpcode::Expression || slot < 0) {
+        // Выражения вычисляются по графу зависимостей, а не скалярным циклом
+        m_lanes.append(-1);
+    } else {
+        m_lanes.append(-1);
+        m_scalarRules.append(rule);
+    }
+}
+
+void ConditionProgram::seedWindow(int rule, const HistoryStore& history) {
+    const int window = m_windows[rule];
+    const QString& name = m_keys[rule].first;
+
+    // Окно по времени берет отсчеты за свою длительность, окно по числу отсчетов - последние
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    const qint64 spanMs = m_windowStore.span(window);
+    const QVector<HistorySample> samples = (spanMs > 0)
+        ? history.samples(name, nowMs - spanMs, nowMs)
+        : history.latest(name, m_windowStore.capacity(window));
+
+    const qint64 monotonicNowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    for (const HistorySample& sample : samples) {
+        bool ok = false;
+        const double value = sample.value.toDouble(&ok);
+        if (ok) {
+            m_windowStore.push(window, monotonicNowMs - (nowMs - sample.timestampMs), value);
+        }
+    }
+}
+
+int ConditionProgram::inputSlotFor(const QString& name) {
+    int slot = m_inputIndex.value(name, -1);
+    if (slot < 0) {
+        slot = m_inputIndex.size();
+        m_inputIndex.insert(name, slot);
+    }
+    return slot;
+}
+
+void ConditionProgram::buildExpressionGraph() {
+    const int nodeCount = m_exprRules.size();
+    m_ruleNodes.fill(-1, m_opcodes.size());
+    m_exprSources.resize(nodeCount);
+    m_exprDependents.resize(nodeCount);
+    m_exprValue.fill(std::nan(""), nodeCount);
+    m_exprHasValue.fill(0, nodeCount);
+    m_exprQueued.fill(0, nodeCount);
+
+    // Имя правила-выражения → узел: по нему другие выражения читают его результат
+    QHash<QString, int> nodeByName;
+    for (int node = 0; node < nodeCount; ++node) {
+        m_ruleNodes[m_exprRules[node]] = node;
+        nodeByName.insert(m_keys[m_exprRules[node]].first, node);
+    }
+
+    // Имена правил-выражений, которые не компилируются: ссылка на такое имя
+    // не должна молча стать входом ТМИ, которого нет
+    QSet<QString> invalidNames;
+    for (int rule = 0; rule < m_keys.size(); ++rule) {
+        if (m_keys[rule].second == static_cast<int>(ParameterType::Expression) &&
+            m_opcodes[rule] == ConditionOpcode::Invalid) {
+            invalidNames.insert(m_keys[rule].first);
+        }
+    }
+
+    // Ребра графа: вход ТМИ → выражение и выражение → выражение.
+    // Имя, которое одновременно читают правила других типов (параметр ТМИ)
+    // и носит правило-выражение, неоднозначно: выражение с ним отключается,
+    // иначе имя правила молча меняло бы смысл чужих выражений
+    QVector<int> inDegree(nodeCount, 0);
+    QVector<QString> ambiguous(nodeCount);
+    QVector<QString> invalid(nodeCount);
+    for (int node = 0; node < nodeCount; ++node) {
+        for (const QString& identifier : m_exprCode[node]->identifiers()) {
+            const int source = nodeByName.value(identifier, -1);
+            if (source >= 0 && m_inputIndex.contains(identifier)) {
+                ambiguous[node] = identifier;
+                m_exprSources[node].append(inputSlotFor(identifier));
+                ++inDegree[node]; // Узел не получит позиции и не будет вычисляться
+            } else if (source >= 0) {
+                m_exprSources[node].append(-(source + 1));
+                m_exprDependents[source].append(node);
+                ++inDegree[node];
+            } else if (invalidNames.contains(identifier) && !m_inputIndex.contains(identifier)) {
+                invalid[node] = identifier;
+                ++inDegree[node]; // Как и неоднозначный узел, не вычисляется
+            } else {
+                const int slot = inputSlotFor(identifier);
+                m_exprSources[node].append(slot);
+                if (m_inputDependents.size() <= slot) {
+                    m_inputDependents.resize(slot + 1);
+                }
+                m_inputDependents[slot].append(node);
+            }
+        }
+    }
+    m_inputDependents.resize(m_inputIndex.size());
+
+    // Топологическая сортировка (алгоритм Кана); узлы в циклах не получают позиции
+    m_exprOrder.clear();
+    m_exprPosition.fill(-1, nodeCount);
+    for (int node = 0; node < nodeCount; ++node) {
+        if (inDegree[node] == 0) {
+            m_exprOrder.append(node);
+        }
+    }
+    for (int i = 0; i < m_exprOrder.size(); ++i) {
+        const int node = m_exprOrder[i];
+        m_exprPosition[node] = i;
+        for (int dependent : m_exprDependents[node]) {
+            if (--inDegree[dependent] == 0) {
+                m_exprOrder.append(dependent);
+            }
+        }
+    }
+
+    // Выражения, зависящие от отключенного: источник отключения передается по ребрам,
+    // чтобы сообщить о нем, а не о цикле, которого нет
+    QVector<int> disabledBy(nodeCount, -1);
+    QVector<int> queue;
+    for (int node = 0; node < nodeCount; ++node) {
+        if (!ambiguous[node].isEmpty() || !invalid[node].isEmpty()) {
+            disabledBy[node] = node;
+            queue.append(node);
+        }
+    }
+    for (int i = 0; i < queue.size(); ++i) {
+        for (int dependent : m_exprDependents[queue[i]]) {
+            if (disabledBy[dependent] < 0) {
+                disabledBy[dependent] = queue[i];
+                queue.append(dependent);
+            }
+        }
+    }
+
+    for (int node = 0; node < nodeCount; ++node) {
+        const QString& name = m_keys[m_exprRules[node]].first;
+        if (!ambiguous[node].isEmpty()) {
+            qWarning() << "ConditionProgram: Identifier" << ambiguous[node] << "in expression" << name
+                       << "names both a telemetry parameter and an expression rule - rule disabled";
+        } else if (!invalid[node].isEmpty()) {
+            qWarning() << "ConditionProgram: Expression" << name << "depends on invalid expression"
+                       << invalid[node] << "- rule disabled";
+        } else if (disabledBy[node] >= 0) {
+            qWarning() << "ConditionProgram: Expression" << name << "depends on disabled expression"
+                       << m_keys[m_exprRules[disabledBy[node]]].first << "- rule disabled";
+        } else if (m_exprPosition[node] < 0) {
+            qWarning() << "ConditionProgram: Cyclic dependency in expression" << name << "- rule disabled";
+        }
+    }
+
+    // После компиляции каждое выражение вычисляется на первом такте
+    m_exprHeap.clear();
+    for (int node = 0; node < nodeCount; ++node) {
+        scheduleExpression(node);
+    }
+}
+
+void ConditionProgram::scheduleExpression(int node) {
+    if (m_exprQueued[node] || m_exprPosition[node] < 0) {
+        return;
+    }
+    m_exprQueued[node] = 1;
+    m_exprHeap.push_back(m_exprPosition[node]);
+    std::push_heap(m_exprHeap.begin(), m_exprHeap.end(), std::greater<int>());
+}
+
+void ConditionProgram::runExpressions(RunResult& result) {
+    result.evaluated.clear();
+    result.transitions.clear();
+
+    // Узлы, статус которых ждет подтверждения по времени, пересчитываются каждый такт
+    for (int node : m_exprRetry) {
+        scheduleExpression(node);
+    }
+    m_exprRetry.clear();
+
+    // Узлы, входы которых изменились на этом такте
+    for (int slot : m_changedSlots) {
+        for (int node : m_inputDependents[slot]) {
+            scheduleExpression(node);
+        }
+    }
+
+    // Обход в топологическом порядке: из кучи извлекается узел с наименьшей позицией,
+    // поэтому выражение вычисляется только после всех выражений, от которых зависит
+    QVector<double> values;
+    while (!m_exprHeap.empty()) {
+        std::pop_heap(m_exprHeap.begin(), m_exprHeap.end(), std::greater<int>());
+        const int node = m_exprOrder[m_exprHeap.back()];
+        m_exprHeap.pop_back();
+        m_exprQueued[node] = 0;
+
+        // Собираем значения входов; без значения хотя бы одного входа выражение не вычисляется
+        const QVector<int>& sources = m_exprSources[node];
+        values.resize(sources.size());
+        bool ready = true;
+        for (int i = 0; i < sources.size() && ready; ++i) {
+            const int source = sources[i];
+            if (source >= 0) {
+                const TickInput& input = m_inputs[source];
+                ready = input.seen;
+                values[i] = input.isNumber ? input.number : std::nan("");
+            } else {
+                const int sourceNode = -source - 1;
+                ready = m_exprHasValue[sourceNode];
+                values[i] = m_exprValue[sourceNode];
+            }
+        }
+        if (!ready) {
+            continue;
+        }
+
+        const double value = m_exprCode[node]->execute(values.constData());
+        const double previous = m_exprValue[node];
+        const bool valueChanged = !m_exprHasValue[node] ||
+            !(value == previous || (std::isnan(value) && std::isnan(previous)));
+        m_exprValue[node] = value;
+        m_exprHasValue[node] = 1;
+
+        const int rule = m_exprRules[node];
+        result.evaluated.append(rule);
+
+        const ParameterStatus status = confirmStatus(rule, Expression::isTrue(value));
+        if (status != m_status[rule]) {
+            m_status[rule] = status;
+            result.transitions.append(rule);
+        }
+        if (m_pendingCount[rule] > 0) {
+            m_exprRetry.append(node);
+        }
+
+        // Зависимые выражения пересчитываются, только если результат изменился
+        if (valueChanged) {
+            for (int dependent : m_exprDependents[node]) {
+                scheduleExpression(dependent);
+            }
+        }
+    }
+
+    std::sort(result.evaluated.begin(), result.evaluated.end());
+    std::sort(result.transitions.begin(), result.transitions.end());
+}
+
+void ConditionProgram::parseInput(const QVariant& value, TickInput& input) {
+    input.raw = value;
+    input.present = true;
+    input.seen = true;
+    input.isNumber = false;
+    input.isInteger = false;
+
+    switch (static_cast<QMetaType::Type>(value.type())) {
+        case QMetaType::Int:
+        case QMetaType::LongLong:
+        case QMetaType::UInt:
+        case QMetaType::ULongLong:
+            input.integer = value.toLongLong();
+            input.number = static_cast<double>(input.integer);
+            input.isNumber = true;
+            input.isInteger = true;
+            input.text = value.toString();
+            return;
+        case QMetaType::Double:
+        case QMetaType::Float:
+            input.number = value.toDouble();
+            input.isNumber = true;
+            input.text = value.toString();
+            return;
+        default:
+            break;
+    }
+
+    input.text = value.toString();
+    const QString trimmed = input.text.trimmed();
+
+    bool ok = false;
+    input.integer = trimmed.toLongLong(&ok);
+    if (ok) {
+        input.number = static_cast<double>(input.integer);
+        input.isNumber = true;
+        input.isInteger = true;
+        return;
+    }
+
+    input.number = trimmed.toDouble(&ok);
+    input.isNumber = ok;
+}
+
+void ConditionProgram::loadInputs(const QVector<ParameterValue>& values, qint64 timestampMs) {
+    if (timestampMs < 0) {
+        timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    m_tickTimeMs = timestampMs;
+
+    for (TickInput& input : m_inputs) {
+        input.present = false;
+    }
+    m_changedSlots.clear();
+
+    for (const auto& value : values) {
+        const int slot = m_inputIndex.value(value.name, -1);
+        if (slot < 0) {
+            continue;
+        }
+
+        TickInput& input = m_inputs[slot];
+        if (m_inputDependents[slot].isEmpty()) {
+            parseInput(value.value, input);
+            continue;
+        }
+
+        // Вход читают выражения: запоминаем, изменилось ли значение
+        const bool hadValue = input.seen;
+        const QString previousText = input.text;
+        parseInput(value.value, input);
+        if (!hadValue || input.text != previousText) {
+            m_changedSlots.append(slot);
+        }
+    }
+
+    // Заполняем столбец значений таблицы пределов
+    m_limits.beginTick();
+    for (int lane = 0; lane < m_laneRules.size(); ++lane) {
+        const TickInput& input = m_inputs[m_inputSlots[m_laneRules[lane]]];
+        if (!input.present) {
+            continue;
+        }
+        if (input.isNumber) {
+            m_limits.setValue(lane, input.number);
+        } else {
+            m_limits.setInvalid(lane);
+        }
+    }
+}
+
+bool ConditionProgram::evaluate(int rule, const TickInput& input) {
+    switch (m_opcodes[rule]) {
+        case ConditionOpcode::EqualsNumber:
+        case ConditionOpcode::NotEqualsNumber: {
+            bool equal;
+            if (!input.isNumber) {
+                equal = (input.text == m_textTargets[rule]);
+            } else if (input.isInteger && m_integerLimits[rule]) {
+                equal = (input.integer == m_lowerInt[rule]);
+            } else {
+                equal = (input.number == m_lower[rule]);
+            }
+            return (m_opcodes[rule] == ConditionOpcode::EqualsNumber) ? equal : !equal;
+        }
+
+        case ConditionOpcode::EqualsText:
+            return input.text == m_textTargets[rule];
+
+        case ConditionOpcode::NotEqualsText:
+            return input.text != m_textTargets[rule];
+
+        case ConditionOpcode::InLimits:
+            if (!input.isNumber) {
+                return false;
+            }
+            // После перехода в Error норма восстанавливается только внутри зоны возврата
+            if (m_hysteresis[rule] > 0.0 && m_status[rule] == ParameterStatus::Error) {
+                return input.number >= m_lower[rule] + m_hysteresis[rule] &&
+                       input.number <= m_upper[rule] - m_hysteresis[rule];
+            }
+            if (input.isInteger && m_integerLimits[rule]) {
+                return input.integer >= m_lowerInt[rule] && input.integer <= m_upperInt[rule];
+            }
+            return input.number >= m_lower[rule] && input.number <= m_upper[rule];
+
+        case ConditionOpcode::OutOfLimits:
+            // Некорректные данные считаются нарушением условия
+            if (!input.isNumber) {
+                return false;
+            }
+            if (m_hysteresis[rule] > 0.0 && m_status[rule] == ParameterStatus::Error) {
+                return input.number < m_lower[rule] - m_hysteresis[rule] ||
+                       input.number > m_upper[rule] + m_hysteresis[rule];
+            }
+            if (input.isInteger && m_integerLimits[rule]) {
+                return input.integer < m_lowerInt[rule] || input.integer > m_upperInt[rule];
+            }
+            return input.number < m_lower[rule] || input.number > m_upper[rule];
+
+        case ConditionOpcode::Changed: {
+            // Первое значение только запоминается; норма - когда значение не меняется
+            const bool changed = m_hasLast[rule] && ParameterChanged::valueChanged(m_lastValue[rule], input.raw);
+            m_lastValue[rule] = input.raw;
+            m_hasLast[rule] = 1;
+            return !changed;
+        }
+
+        case ConditionOpcode::RateOfChange: {
+            if (!input.isNumber) {
+                return false;
+            }
+            const int window = m_windows[rule];
+            m_windowStore.push(window, m_tickTimeMs, input.number);
+            const double slope = m_windowStore.slopePerSecond(window);
+            if (std::isnan(slope)) {
+                return true;
+            }
+            return (m_lower[rule] >= 0.0) ? slope <= m_lower[rule] : slope >= m_lower[rule];
+        }
+
+        case ConditionOpcode::Trend: {
+            if (!input.isNumber) {
+                return false;
+            }
+            // Тренд оценивается только по заполненному окну
+            const int window = m_windows[rule];
+            m_windowStore.push(window, m_tickTimeMs, input.number);
+            if (m_windowStore.sampleCount(window) < m_windowStore.capacity(window)) {
+                return true;
+            }
+            const double change = m_windowStore.fittedChange(window);
+            if (std::isnan(change)) {
+                return true;
+            }
+            return (m_lower[rule] >= 0.0) ? change <= m_lower[rule] : change >= m_lower[rule];
+        }
+
+        case ConditionOpcode::Statistic:
+            if (!input.isNumber) {
+                return false;
+            }
+            return ParameterStatistic::evaluate(static_cast<WindowStatistic>(m_statistics[rule]), m_lower[rule],
+                                                m_windowStore, m_windows[rule], m_tickTimeMs, input.number);
+
+        case ConditionOpcode::Invalid:
+        default:
+            return false;
+    }
+}
+
+void ConditionProgram::run(RunResult& result) {
+    result.evaluated.clear();
+    result.transitions.clear();
+
+    prepareChunks();
+
+    // Малые конфигурации - в вызывающем потоке, без накладных расходов пула
+    if (m_chunks.size() == 1) {
+        runChunk(m_chunks[0]);
+    } else {
+        QtConcurrent::blockingMap(m_chunks, [this](RunChunk& chunk) { runChunk(chunk); });
+    }
+
+    // Части идут по возрастанию номеров правил: конкатенация сохраняет порядок,
+    // затем скалярные правила и правила пределов сливаются в порядке конфигурации
+    RunResult scalar;
+    RunResult lanes;
+    for (const RunChunk& chunk : m_chunks) {
+        scalar.evaluated += chunk.scalar.evaluated;
+        scalar.transitions += chunk.scalar.transitions;
+        lanes.evaluated += chunk.lanes.evaluated;
+        lanes.transitions += chunk.lanes.transitions;
+    }
+
+    RunResult merged;
+    merged.evaluated.reserve(scalar.evaluated.size() + lanes.evaluated.size());
+    std::merge(scalar.evaluated.cbegin(), scalar.evaluated.cend(),
+               lanes.evaluated.cbegin(), lanes.evaluated.cend(),
+               std::back_inserter(merged.evaluated));
+    std::merge(scalar.transitions.cbegin(), scalar.transitions.cend(),
+               lanes.transitions.cbegin(), lanes.transitions.cend(),
+               std::back_inserter(merged.transitions));
+
+    // Выражения - после остальных правил, только с изменившимися входами
+    RunResult expressions;
+    runExpressions(expressions);
+
+    result.evaluated.reserve(merged.evaluated.size() + expressions.evaluated.size());
+    std::merge(merged.evaluated.cbegin(), merged.evaluated.cend(),
+               expressions.evaluated.cbegin(), expressions.evaluated.cend(),
+               std::back_inserter(result.evaluated));
+    std::merge(merged.transitions.cbegin(), merged.transitions.cend(),
+               expressions.transitions.cbegin(), expressions.transitions.cend(),
+               std::back_inserter(result.transitions));
+}
+
+void ConditionProgram::prepareChunks() {
+    const int rules = m_opcodes.size();
+    const int words = m_limits.wordCount();
+
+    int chunkCount = 1;
+    if (rules >= kParallelThreshold) {
+        chunkCount = qBound(1, rules / kMinChunkRules, QThreadPool::globalInstance()->maxThreadCount() * 2);
+    }
+
+    // Каждая часть получает непрерывный диапазон скалярных правил и слов таблицы пределов
+    m_chunks.resize(chunkCount);
+    for (int i = 0; i < chunkCount; ++i) {
+        RunChunk& chunk = m_chunks[i];
+        chunk.scalarBegin = int(qint64(m_scalarRules.size()) * i / chunkCount);
+        chunk.scalarEnd = int(qint64(m_scalarRules.size()) * (i + 1) / chunkCount);
+        chunk.wordBegin = int(qint64(words) * i / chunkCount);
+        chunk.wordEnd = int(qint64(words) * (i + 1) / chunkCount);
+    }
+}
+
+void ConditionProgram::runChunk(RunChunk& chunk) {
+    chunk.scalar.evaluated.clear();
+    chunk.scalar.transitions.clear();
+
+    // Скалярные правила (Equals, NotEquals, Changed, окна отсчетов, пределы с большими целыми границами).
+    // Каждое правило меняет только собственное состояние, поэтому части независимы.
+    for (int i = chunk.scalarBegin; i < chunk.scalarEnd; ++i) {
+        const int rule = m_scalarRules[i];
+        const TickInput& input = m_inputs[m_inputSlots[rule]];
+        if (!input.present) {
+            continue;
+        }
+
+        const ParameterStatus status = confirmStatus(rule, evaluate(rule, input));
+        chunk.scalar.evaluated.append(rule);
+
+        if (status != m_status[rule]) {
+            m_status[rule] = status;
+            chunk.scalar.transitions.append(rule);
+        }
+    }
+
+    // Правила пределов - векторным ядром по своему диапазону слов
+    m_limits.evaluate(LimitKernel::detectedPath(), chunk.wordBegin, chunk.wordEnd);
+    collectLimitResults(chunk.wordBegin, chunk.wordEnd, chunk.lanes);
+}
+
+void ConditionProgram::collectLimitResults(int firstWord, int lastWord, RunResult& result) {
+    result.evaluated.clear();
+    result.transitions.clear();
+
+    const QVector<quint64>& present = m_limits.presentBits();
+    const QVector<quint64>& changed = m_limits.changedBits();
+    const QVector<quint64>& review = m_limits.reviewBits();
+
+    // Строки таблицы добавлялись в порядке правил, поэтому обход битов по возрастанию
+    // дает возрастающие номера правил
+    for (int word = firstWord; word < lastWord; ++word) {
+        for (quint64 bits = present[word]; bits != 0; bits &= bits - 1) {
+            const int lane = word * 64 + qCountTrailingZeroBits(bits);
+            result.evaluated.append(m_laneRules[lane]);
+        }
+
+        // Изменения без фильтра и строки с фильтром не пересекаются; общий обход
+        // сохраняет возрастающий порядок переходов
+        const quint64 reviewWord = review[word];
+        for (quint64 bits = changed[word] | reviewWord; bits != 0; bits &= bits - 1) {
+            const int bit = qCountTrailingZeroBits(bits);
+            const int lane = word * 64 + bit;
+            const int rule = m_laneRules[lane];
+
+            if (!((reviewWord >> bit) & 1)) {
+                m_status[rule] = m_limits.status(lane);
+                result.transitions.append(rule);
+                continue;
+            }
+
+            const ParameterStatus status = confirmStatus(rule, m_limits.conditionMet(lane));
+            m_limits.setPending(lane, m_pendingCount[rule] > 0);
+            if (status != m_status[rule]) {
+                m_status[rule] = status;
+                m_limits.setStatus(lane, status);
+                result.transitions.append(rule);
+            }
+        }
+    }
+}
+
+ParameterStatus ConditionProgram::confirmStatus(int rule, bool conditionMet) {
+    const ParameterStatus current = m_status[rule];
+    const ParameterStatus candidate = conditionMet ? ParameterStatus::Ok : ParameterStatus::Error;
+
+    // Без фильтра, при совпадении со статусом и при первой норме - сразу
+    if (!m_filtered[rule] || candidate == current ||
+        (current == ParameterStatus::Unknown && candidate == ParameterStatus::Ok)) {
+        m_pendingCount[rule] = 0;
+        return candidate;
+    }
+
+    if (m_pendingCount[rule] == 0) {
+        m_pendingSince[rule] = m_tickTimeMs;
+    }
+    ++m_pendingCount[rule];
+
+    const bool entering = (candidate == ParameterStatus::Error);
+    const int samples = entering ? m_entrySamples[rule] : m_exitSamples[rule];
+    const qint64 holdMs = entering ? m_entryHoldMs[rule] : m_exitHoldMs[rule];
+    if (m_pendingCount[rule] >= samples && m_tickTimeMs - m_pendingSince[rule] >= holdMs) {
+        m_pendingCount[rule] = 0;
+        return candidate;
+    }
+    return current;
+}
+
+ParameterStatus ConditionProgram::status(int rule) const {
+    return m_status.value(rule, ParameterStatus::Unknown);
+}
+
+QVariant ConditionProgram::inputValue(int rule) const {
+    if (rule < 0 || rule >= m_inputSlots.size()) {
+        return QVariant();
+    }
+
+    // Для выражения значение правила - результат выражения
+    const int node = m_ruleNodes[rule];
+    if (node >= 0) {
+        return m_exprHasValue[node] ? QVariant(m_exprValue[node]) : QVariant();
+    }
+    if (m_inputSlots[rule] < 0) {
+        return QVariant();
+    }
+    return m_inputs[m_inputSlots[rule]].raw;
+}
+
+WindowStats ConditionProgram::windowStats(int rule) const {
+    if (rule < 0 || rule >= m_windows.size() || m_windows[rule] < 0) {
+        return WindowStats();
+    }
+    return m_windowStore.stats(m_windows[rule]);
+}
+
+bool ConditionProgram::hasWindow(int rule) const {
+    return rule >= 0 && rule < m_windows.size() && m_windows[rule] >= 0;
+}
+
+int ConditionProgram::sampleIntervalMs() const {
+    return m_sampleIntervalMs;
+}
+
+void ConditionProgram::resetRule(int rule) {
+    if (rule < 0 || rule >= m_keys.size()) {
+        return;
+    }
+
+    m_lastValue[rule].clear();
+    m_hasLast[rule] = 0;
+    m_pendingCount[rule] = 0;
+    m_pendingSince[rule] = 0;
+    if (m_lanes[rule] >= 0) {
+        m_limits.setPending(m_lanes[rule], false);
+    }
+}
+
+QVector<int> ConditionProgram::resetChangeTracking() {
+    QVector<int> transitions;
+
+    for (int rule = 0; rule < m_opcodes.size(); ++rule) {
+        if (m_opcodes[rule] != ConditionOpcode::Changed) {
+            continue;
+        }
+
+        // Текущее значение становится опорным
+        const TickInput& input = m_inputs[m_inputSlots[rule]];
+        if (input.present) {
+            m_lastValue[rule] = input.raw;
+            m_hasLast[rule] = 1;
+        }
+
+        m_pendingCount[rule] = 0;
+        if (m_status[rule] != ParameterStatus::Ok) {
+            m_status[rule] = ParameterStatus::Ok;
+            transitions.append(rule);
+        }
+    }
+
+    return transitions;
+}
+
+} // namespace ParamControl
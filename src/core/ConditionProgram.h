@@ -0,0 +1,361 @@
+// src/core/ConditionProgram.h
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+#include <QHash>
+#include <QPair>
+#include <memory>
+#include <vector>
+
+#include "Parameter.h"
+#include "Expression.h"
+#include "LimitKernel.h"
+#include "WindowStore.h"
+#include "HistoryStore.h"
+#include "XmlParser.h" // Для ParameterValue
+
+namespace ParamControl {
+
+/**
+ * @brief Код операции скомпилированного правила
+ */
+enum class ConditionOpcode : quint8 {
+    EqualsNumber,       ///< Равенство числовому значению
+    EqualsText,         ///< Равенство строковому значению
+    NotEqualsNumber,    ///< Неравенство числовому значению
+    NotEqualsText,      ///< Неравенство строковому значению
+    InLimits,           ///< Нахождение в пределах [min, max]
+    OutOfLimits,        ///< Выход за пределы [min, max]
+    Changed,            ///< Изменение значения по сравнению с предыдущим (ParameterChanged::valueChanged())
+    Expression,         ///< Выражение над несколькими входами (граф зависимостей)
+    RateOfChange,       ///< Наклон по окну времени не превышает порог
+    Trend,              ///< Изменение по окну из N отсчетов не превышает порог
+    Statistic,          ///< Статистика скользящего окна в норме (см. ParameterStatistic)
+    Invalid             ///< Условие не удалось скомпилировать (всегда нарушено)
+};
+
+/**
+ * @brief Скомпилированная программа проверки условий контроля.
+ *
+ * Программа строится из списка объектов Parameter при добавлении, удалении
+ * и редактировании параметров. Каждое правило хранит код операции и заранее
+ * разобранные пороги (double и int64), поэтому в цикле проверки нет
+ * преобразований QVariant и виртуальных вызовов. Данные правил хранятся
+ * в виде структуры массивов; номер правила совпадает с номером строки
+ * параметра в ParameterModel.
+ *
+ * Правила InLimits/OutOfLimits с границами, точно представимыми в double,
+ * выносятся в таблицу LimitTable и проверяются векторным ядром за один
+ * проход; остальные правила выполняются скалярным циклом.
+ *
+ * Правила-выражения образуют граф зависимостей (входы ТМИ и результаты
+ * других выражений). На такте пересчитываются только выражения, входы
+ * которых изменились, в топологическом порядке графа; стоимость такта
+ * определяется числом изменений, а не числом выражений.
+ *
+ * Начиная с kParallelThreshold правил такт делится на непрерывные части,
+ * которые проверяются параллельно в глобальном пуле потоков. Результаты
+ * частей собираются в порядке номеров правил, поэтому порядок переходов
+ * (и, следовательно, журнала и оповещений) не зависит от числа потоков.
+ *
+ * Переход статуса может требовать подтверждения (ConditionFilter): счетчик
+ * тактов и время начала подтверждения хранятся в состоянии правила, поэтому
+ * фильтр стоит O(1) на правило за такт. Правила без фильтра переключаются сразу.
+ *
+ * Правила скорости изменения, тренда и статистики окна хранят отсчеты
+ * в окнах WindowStore, память под которые выделяется при компиляции;
+ * такт добавляет отсчет и обновляет наклон, среднее, СКО, минимум
+ * и максимум окна за O(1).
+ *
+ * Объекты Parameter остаются интерфейсом редактирования и сериализации.
+ */
+class ConditionProgram {
+public:
+    /**
+     * @brief Результат выполнения программы на одном такте
+     */
+    struct RunResult {
+        QVector<int> evaluated;     ///< Номера правил, для которых пришло значение
+        QVector<int> transitions;   ///< Номера правил, у которых изменился статус
+    };
+
+    /// Число правил, начиная с которого такт проверяется в нескольких потоках.
+    static constexpr int kParallelThreshold = 4096;
+
+    /// Минимальное число правил в одной части при параллельной проверке.
+    static constexpr int kMinChunkRules = 1024;
+
+    ConditionProgram() = default;
+
+    /**
+     * @brief Компилирует список параметров в программу.
+     *
+     * Состояние правил (статус, последнее значение для Changed, окна отсчетов) переносится
+     * из предыдущей программы для параметров с тем же именем и типом. Окна новых
+     * правил заполняются из истории значений, поэтому правило сразу получает
+     * накопленные отсчеты, а не ждет заполнения окна.
+     * @param parameters Параметры в порядке конфигурации.
+     * @param previous Предыдущая программа (может быть nullptr).
+     * @param history История значений для заполнения окон новых правил (может быть nullptr).
+     * @param sampleIntervalMs Интервал опроса, по которому рассчитывается емкость окон,
+     *        заданных длительностью (WindowStore::capacityForSpan()), мс.
+     * @return Скомпилированная программа.
+     */
+    static std::shared_ptr<ConditionProgram> compile(
+        const QVector<std::shared_ptr<Parameter>>& parameters,
+        const ConditionProgram* previous = nullptr,
+        const HistoryStore* history = nullptr,
+        int sampleIntervalMs = WindowStore::kDefaultSampleIntervalMs);
+
+    /**
+     * @brief Количество правил в программе.
+     */
+    int ruleCount() const;
+
+    /**
+     * @brief Количество уникальных входных значений (имен параметров ТМИ).
+     */
+    int inputCount() const;
+
+    /**
+     * @brief Имена параметров ТМИ, значения которых читают правила программы.
+     */
+    QStringList inputNames() const;
+
+    /**
+     * @brief Загружает значения очередного такта в таблицу входов.
+     *
+     * Каждое значение разбирается в число один раз, независимо от того,
+     * сколько правил его используют. Входы, отсутствующие в ответе,
+     * помечаются как неполученные, и их правила на этом такте не проверяются.
+     * @param values Значения параметров, полученные от СОТМ.
+     * @param timestampMs Время такта в мс для подтверждения статусов по времени;
+     *        -1 - текущее время монотонных часов.
+     */
+    void loadInputs(const QVector<ParameterValue>& values, qint64 timestampMs = -1);
+
+    /**
+     * @brief Выполняет все правила одним циклом по загруженному такту.
+     * @param result Заполняется номерами проверенных правил и правил со сменой статуса.
+     */
+    void run(RunResult& result);
+
+    /**
+     * @brief Возвращает текущий статус правила.
+     */
+    ParameterStatus status(int rule) const;
+
+    /**
+     * @brief Возвращает исходное значение входа правила на последнем такте.
+     */
+    QVariant inputValue(int rule) const;
+
+    /**
+     * @brief Возвращает статистику окна отсчетов правила.
+     *
+     * Значения уже поддерживаются окном, вызов стоит O(1).
+     * @return Статистика или пустая (samples == 0) для правил без окна.
+     */
+    WindowStats windowStats(int rule) const;
+
+    /**
+     * @brief Проверяет, что правило ведет окно отсчетов (статистика меняется каждый такт).
+     */
+    bool hasWindow(int rule) const;
+
+    /**
+     * @brief Интервал опроса, с которым скомпилированы окна правил, мс.
+     */
+    int sampleIntervalMs() const;
+
+    /**
+     * @brief Сбрасывает отслеживание изменений для правил типа Changed.
+     *
+     * Текущее значение становится опорным, статус возвращается в Ok.
+     * @return Номера правил, у которых изменился статус.
+     */
+    QVector<int> resetChangeTracking();
+
+    /**
+     * @brief Сбрасывает состояние правила после изменения его условия.
+     *
+     * Состояние переносится из предыдущей программы по имени и типу
+     * параметра, поэтому после правки условия правило иначе продолжило бы
+     * с опорным значением Changed и неподтвержденным статусом, накопленными
+     * по старому условию. Окно отсчетов сохраняется: в нем исходные значения.
+     */
+    void resetRule(int rule);
+
+private:
+    /**
+     * @brief Разобранное значение входа на текущем такте
+     */
+    struct TickInput {
+        QVariant raw;           ///< Исходное значение
+        QString text;           ///< Строковое представление
+        double number = 0.0;    ///< Числовое значение (если isNumber)
+        qint64 integer = 0;     ///< Целое значение (если isInteger)
+        bool isNumber = false;  ///< Значение удалось разобрать как число
+        bool isInteger = false; ///< Значение является целым числом
+        bool present = false;   ///< Значение получено на текущем такте
+        bool seen = false;      ///< Значение хотя бы раз получено (для выражений)
+    };
+
+    /**
+     * @brief Часть такта для проверки в одном потоке
+     */
+    struct RunChunk {
+        int scalarBegin = 0;    ///< Первая позиция в m_scalarRules
+        int scalarEnd = 0;      ///< Позиция за последней в m_scalarRules
+        int wordBegin = 0;      ///< Первое слово таблицы пределов
+        int wordEnd = 0;        ///< Слово за последним в таблице пределов
+        RunResult scalar;       ///< Результаты скалярных правил части
+        RunResult lanes;        ///< Результаты правил пределов части
+    };
+
+    /// Ключ правила для переноса состояния между компиляциями.
+    using RuleKey = QPair<QString, int>;
+
+    // --- Таблица входов ---
+    QHash<QString, int> m_inputIndex;   ///< Имя параметра ТМИ → номер входа
+    QVector<TickInput> m_inputs;        ///< Значения входов текущего такта
+
+    // --- Правила (структура массивов) ---
+    QVector<RuleKey> m_keys;            ///< Имя и тип параметра правила
+    QVector<ConditionOpcode> m_opcodes; ///< Код операции
+    QVector<int> m_inputSlots;          ///< Номер входа
+    QVector<double> m_lower;            ///< Нижняя граница или числовая цель
+    QVector<double> m_upper;            ///< Верхняя граница
+    QVector<qint64> m_lowerInt;         ///< Нижняя граница или цель как int64
+    QVector<qint64> m_upperInt;         ///< Верхняя граница как int64
+    QVector<quint8> m_integerLimits;    ///< Пороги правила целочисленные
+    QVector<QString> m_textTargets;     ///< Строковая цель (Equals/NotEquals)
+    QVector<ParameterStatus> m_status;  ///< Текущий статус правила
+    QVector<QVariant> m_lastValue;      ///< Последнее значение (Changed)
+    QVector<quint8> m_hasLast;          ///< Последнее значение зафиксировано (Changed)
+    QVector<double> m_hysteresis;       ///< Ширина зоны возврата (InLimits/OutOfLimits)
+    QVector<quint8> m_filtered;         ///< Статус правила требует подтверждения
+    QVector<int> m_entrySamples;        ///< Тактов подряд для перехода в Error
+    QVector<int> m_exitSamples;         ///< Тактов подряд для возврата в норму
+    QVector<qint64> m_entryHoldMs;      ///< Время удержания для перехода в Error, мс
+    QVector<qint64> m_exitHoldMs;       ///< Время удержания для возврата в норму, мс
+    QVector<int> m_pendingCount;        ///< Тактов подряд с неподтвержденным новым статусом
+    QVector<qint64> m_pendingSince;     ///< Время первого такта подтверждения, мс
+    QVector<int> m_windows;             ///< Номер правила → окно WindowStore (-1, если нет)
+    QVector<quint8> m_statistics;       ///< Контролируемая статистика окна (WindowStatistic)
+    WindowStore m_windowStore;          ///< Окна отсчетов (RateOfChange, Trend, Statistic)
+    qint64 m_tickTimeMs = 0;            ///< Время текущего такта, мс
+    int m_sampleIntervalMs = WindowStore::kDefaultSampleIntervalMs; ///< Интервал опроса для емкости окон, мс
+
+    // --- Разбиение правил между скалярным циклом и таблицей пределов ---
+    LimitTable m_limits;                ///< Правила пределов для векторного ядра
+    QVector<int> m_lanes;               ///< Номер правила → строка LimitTable (-1 для скалярных)
+    QVector<int> m_laneRules;           ///< Строка LimitTable → номер правила
+    QVector<int> m_scalarRules;         ///< Номера правил скалярного цикла (по возрастанию)
+    QVector<RunChunk> m_chunks;         ///< Части такта (одна - однопоточный режим)
+
+    // --- Граф выражений (узел = правило-выражение) ---
+    QVector<int> m_ruleNodes;                                   ///< Номер правила → узел (-1, если не выражение)
+    QVector<int> m_exprRules;                                   ///< Узел → номер правила
+    QVector<std::shared_ptr<const Expression>> m_exprCode;     ///< Байт-код выражения
+    QVector<QVector<int>> m_exprSources;    ///< Источники идентификаторов: вход >= 0, узел n как -(n + 1)
+    QVector<QVector<int>> m_exprDependents; ///< Узел → зависящие от него узлы
+    QVector<QVector<int>> m_inputDependents;///< Вход → читающие его узлы
+    QVector<int> m_exprOrder;               ///< Топологический порядок узлов
+    QVector<int> m_exprPosition;            ///< Узел → позиция в m_exprOrder (-1 для узлов в цикле)
+    QVector<double> m_exprValue;            ///< Последний результат узла
+    QVector<quint8> m_exprHasValue;         ///< Узел уже вычислялся
+    QVector<quint8> m_exprQueued;           ///< Узел стоит в очереди пересчета
+    std::vector<int> m_exprHeap;            ///< Очередь пересчета: куча позиций m_exprOrder
+    QVector<int> m_exprRetry;               ///< Узлы с неподтвержденным статусом (пересчет на следующем такте)
+    QVector<int> m_changedSlots;            ///< Входы выражений, изменившиеся на текущем такте
+
+    /**
+     * @brief Разбирает значение в число.
+     * @param value Исходное значение.
+     * @param input Заполняемая запись входа.
+     */
+    static void parseInput(const QVariant& value, TickInput& input);
+
+    /**
+     * @brief Добавляет правило для параметра.
+     * @param parameter Параметр.
+     */
+    void appendRule(const Parameter& parameter);
+
+    /**
+     * @brief Заполняет окно правила последними отсчетами из истории.
+     *
+     * Время истории (мс от эпохи) переводится в шкалу монотонных часов такта.
+     * @param rule Номер правила с окном.
+     * @param history История значений.
+     */
+    void seedWindow(int rule, const HistoryStore& history);
+
+    /**
+     * @brief Возвращает номер входа для имени параметра ТМИ, создавая его при необходимости.
+     */
+    int inputSlotFor(const QString& name);
+
+    /**
+     * @brief Строит граф зависимостей выражений и их топологический порядок.
+     *
+     * Выражения, участвующие в цикле, отключаются с предупреждением.
+     */
+    void buildExpressionGraph();
+
+    /**
+     * @brief Ставит узел в очередь пересчета (повторная постановка игнорируется).
+     */
+    void scheduleExpression(int node);
+
+    /**
+     * @brief Пересчитывает выражения, входы которых изменились.
+     * @param result Заполняется в порядке возрастания номеров правил.
+     */
+    void runExpressions(RunResult& result);
+
+    /**
+     * @brief Делит правила на части в зависимости от их количества.
+     */
+    void prepareChunks();
+
+    /**
+     * @brief Проверяет правила одной части такта.
+     * @param chunk Часть такта; результаты записываются в нее же.
+     */
+    void runChunk(RunChunk& chunk);
+
+    /**
+     * @brief Переносит результаты LimitTable в номера правил и статусы.
+     * @param firstWord Первое слово таблицы пределов.
+     * @param lastWord Слово за последним.
+     * @param result Заполняется в порядке возрастания номеров правил.
+     */
+    void collectLimitResults(int firstWord, int lastWord, RunResult& result);
+
+    /**
+     * @brief Применяет фильтр подтверждения к результату условия.
+     *
+     * Для правил без фильтра возвращает статус, соответствующий результату.
+     * Иначе считает такты и время, в течение которых результат отличается
+     * от текущего статуса, и возвращает новый статус только после подтверждения.
+     * @param rule Номер правила.
+     * @param conditionMet Результат условия на текущем такте.
+     * @return Статус правила после такта.
+     */
+    ParameterStatus confirmStatus(int rule, bool conditionMet);
+
+    /**
+     * @brief Проверяет одно правило на текущем такте.
+     * @param rule Номер правила.
+     * @param input Значение входа правила.
+     * @return true, если условие выполнено (параметр в норме).
+     */
+    bool evaluate(int rule, const TickInput& input);
+};
+
+} // namespace ParamControl
@@ -0,0 +1,516 @@
+// src/core/Expression.cpp
+#include "Expression.h"
+
+#include <QVarLengthArray>
+#include <cmath>
+
+namespace ParamControl {
+
+namespace {
+
+/**
+ * @brief Лексема выражения
+ */
+struct Token {
+    enum Kind { Number, Identifier, Operator, LeftParen, RightParen, Comma, End };
+
+    Kind kind = End;
+    QString text;       ///< Текст лексемы (для операторов - нормализованный: "&&", "||", "!")
+    double number = 0.0;
+    int position = 0;   ///< Позиция в исходном тексте (для сообщений об ошибках)
+};
+
+bool isIdentifierStart(QChar c) {
+    return c.isLetter() || c == QChar('_');
+}
+
+bool isIdentifierPart(QChar c) {
+    return c.isLetterOrNumber() || c == QChar('_') || c == QChar('.');
+}
+
+/**
+ * @brief Приводит словесные логические операторы к символьным.
+ * @return Символьный оператор или пустая строка, если слово не является оператором.
+ */
+QString keywordOperator(const QString& word) {
+    const QString lower = word.toLower();
+    if (lower == "and" || lower == "while" || lower == "и") {
+        return "&&";
+    }
+    if (lower == "or" || lower == "или") {
+        return "||";
+    }
+    if (lower == "not" || lower == "не") {
+        return "!";
+    }
+    return QString();
+}
+
+} // namespace
+
+/**
+ * @brief Рекурсивный спуск с генерацией постфиксного байт-кода.
+ *
+ * Приоритеты (от низшего): ||, &&, !, сравнения, + -, * /, унарный минус.
+ */
+class Expression::Parser {
+public:
+    Parser(const QString& text, Expression& expression)
+        : m_text(text), m_expression(expression) {}
+
+    bool parse(QString& error) {
+        if (!tokenize(error)) {
+            return false;
+        }
+        if (!parseOr(error)) {
+            return false;
+        }
+        if (current().kind != Token::End) {
+            error = QString("Неожиданная лексема \"%1\" в позиции %2")
+                        .arg(current().text).arg(current().position + 1);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    const QString& m_text;
+    Expression& m_expression;
+    QVector<Token> m_tokens;
+    int m_pos = 0;
+    int m_depth = 0;    ///< Текущая глубина стека при генерации
+
+    const Token& current() const { return m_tokens[m_pos]; }
+
+    bool isOperator(const char* op) const {
+        return current().kind == Token::Operator && current().text == op;
+    }
+
+    bool tokenize(QString& error) {
+        int i = 0;
+        const int length = m_text.length();
+
+        while (i < length) {
+            const QChar c = m_text[i];
+            if (c.isSpace()) {
+                ++i;
+                continue;
+            }
+
+            Token token;
+            token.position = i;
+
+            if (c.isDigit() || (c == QChar('.') && i + 1 < length && m_text[i + 1].isDigit())) {
+                int end = i;
+                while (end < length && (m_text[end].isDigit() || m_text[end] == QChar('.'))) {
+                    ++end;
+                }
+                // Показатель степени: 1e5, 2.5E-3
+                if (end < length && (m_text[end] == QChar('e') || m_text[end] == QChar('E'))) {
+                    int exponent = end + 1;
+                    if (exponent < length && (m_text[exponent] == QChar('+') || m_text[exponent] == QChar('-'))) {
+                        ++exponent;
+                    }
+                    if (exponent < length && m_text[exponent].isDigit()) {
+                        end = exponent;
+                        while (end < length && m_text[end].isDigit()) {
+                            ++end;
+                        }
+                    }
+                }
+                token.kind = Token::Number;
+                token.text = m_text.mid(i, end - i);
+                bool ok = false;
+                token.number = token.text.toDouble(&ok);
+                if (!ok) {
+                    error = QString("Неверное число \"%1\" в позиции %2").arg(token.text).arg(i + 1);
+                    return false;
+                }
+                i = end;
+            } else if (isIdentifierStart(c)) {
+                int end = i + 1;
+                while (end < length && isIdentifierPart(m_text[end])) {
+                    ++end;
+                }
+                token.text = m_text.mid(i, end - i);
+                const QString op = keywordOperator(token.text);
+                if (op.isEmpty()) {
+                    token.kind = Token::Identifier;
+                } else {
+                    token.kind = Token::Operator;
+                    token.text = op;
+                }
+                i = end;
+            } else if (c == QChar('[')) {
+                const int end = m_text.indexOf(QChar(']'), i + 1);
+                if (end < 0) {
+                    error = QString("Не закрыта скобка [ в позиции %1").arg(i + 1);
+                    return false;
+                }
+                token.kind = Token::Identifier;
+                token.text = m_text.mid(i + 1, end - i - 1).trimmed();
+                if (token.text.isEmpty()) {
+                    error = QString("Пустое имя параметра в позиции %1").arg(i + 1);
+                    return false;
+                }
+                i = end + 1;
+            } else if (c == QChar('(')) {
+                token.kind = Token::LeftParen;
+                token.text = "(";
+                ++i;
+            } else if (c == QChar(')')) {
+                token.kind = Token::RightParen;
+                token.text = ")";
+                ++i;
+            } else if (c == QChar(',')) {
+                token.kind = Token::Comma;
+                token.text = ",";
+                ++i;
+            } else {
+                // Двухсимвольные операторы проверяются первыми
+                static const char* const twoChar[] = {"<=", ">=", "==", "!=", "&&", "||"};
+                static const char* const oneChar[] = {"<", ">", "+", "-", "*", "/", "!", "="};
+                token.kind = Token::Operator;
+                const QString pair = m_text.mid(i, 2);
+                for (const char* op : twoChar) {
+                    if (pair == op) {
+                        token.text = op;
+                        break;
+                    }
+                }
+                if (token.text.isEmpty()) {
+                    for (const char* op : oneChar) {
+                        if (QString(c) == op) {
+                            token.text = op;
+                            break;
+                        }
+                    }
+                }
+                if (token.text.isEmpty()) {
+                    error = QString("Недопустимый символ \"%1\" в позиции %2").arg(c).arg(i + 1);
+                    return false;
+                }
+                i += token.text.length();
+                // Одиночный "=" трактуется как сравнение
+                if (token.text == "=") {
+                    token.text = "==";
+                }
+            }
+
+            m_tokens.append(token);
+        }
+
+        Token end;
+        end.kind = Token::End;
+        end.text = "конец выражения";
+        end.position = length;
+        m_tokens.append(end);
+        return true;
+    }
+
+    void generate(ExpressionOp op, int operand = 0) {
+        m_expression.m_code.append(ExpressionInstruction{op, operand});
+
+        switch (op) {
+            case ExpressionOp::PushConst:
+            case ExpressionOp::LoadVar:
+                ++m_depth;
+                break;
+            case ExpressionOp::Neg:
+            case ExpressionOp::Not:
+            case ExpressionOp::Abs:
+                break;
+            default:
+                --m_depth; // Бинарные операции: два операнда -> один результат
+                break;
+        }
+        m_expression.m_maxStack = qMax(m_expression.m_maxStack, m_depth);
+    }
+
+    bool parseOr(QString& error) {
+        if (!parseAnd(error)) {
+            return false;
+        }
+        while (isOperator("||")) {
+            ++m_pos;
+            if (!parseAnd(error)) {
+                return false;
+            }
+            generate(ExpressionOp::Or);
+        }
+        return true;
+    }
+
+    bool parseAnd(QString& error) {
+        if (!parseNot(error)) {
+            return false;
+        }
+        while (isOperator("&&")) {
+            ++m_pos;
+            if (!parseNot(error)) {
+                return false;
+            }
+            generate(ExpressionOp::And);
+        }
+        return true;
+    }
+
+    bool parseNot(QString& error) {
+        if (isOperator("!")) {
+            ++m_pos;
+            if (!parseNot(error)) {
+                return false;
+            }
+            generate(ExpressionOp::Not);
+            return true;
+        }
+        return parseComparison(error);
+    }
+
+    bool parseComparison(QString& error) {
+        if (!parseAdditive(error)) {
+            return false;
+        }
+        while (current().kind == Token::Operator) {
+            ExpressionOp op;
+            const QString& text = current().text;
+            if (text == "<") op = ExpressionOp::Less;
+            else if (text == "<=") op = ExpressionOp::LessEqual;
+            else if (text == ">") op = ExpressionOp::Greater;
+            else if (text == ">=") op = ExpressionOp::GreaterEqual;
+            else if (text == "==") op = ExpressionOp::Equal;
+            else if (text == "!=") op = ExpressionOp::NotEqual;
+            else break;
+
+            ++m_pos;
+            if (!parseAdditive(error)) {
+                return false;
+            }
+            generate(op);
+        }
+        return true;
+    }
+
+    bool parseAdditive(QString& error) {
+        if (!parseMultiplicative(error)) {
+            return false;
+        }
+        while (isOperator("+") || isOperator("-")) {
+            const ExpressionOp op = isOperator("+") ? ExpressionOp::Add : ExpressionOp::Sub;
+            ++m_pos;
+            if (!parseMultiplicative(error)) {
+                return false;
+            }
+            generate(op);
+        }
+        return true;
+    }
+
+    bool parseMultiplicative(QString& error) {
+        if (!parseUnary(error)) {
+            return false;
+        }
+        while (isOperator("*") || isOperator("/")) {
+            const ExpressionOp op = isOperator("*") ? ExpressionOp::Mul : ExpressionOp::Div;
+            ++m_pos;
+            if (!parseUnary(error)) {
+                return false;
+            }
+            generate(op);
+        }
+        return true;
+    }
+
+    bool parseUnary(QString& error) {
+        if (isOperator("-")) {
+            ++m_pos;
+            if (!parseUnary(error)) {
+                return false;
+            }
+            generate(ExpressionOp::Neg);
+            return true;
+        }
+        if (isOperator("+")) {
+            ++m_pos;
+            return parseUnary(error);
+        }
+        return parsePrimary(error);
+    }
+
+    bool parsePrimary(QString& error) {
+        const Token token = current();
+
+        switch (token.kind) {
+            case Token::Number:
+                ++m_pos;
+                m_expression.m_constants.append(token.number);
+                generate(ExpressionOp::PushConst, m_expression.m_constants.size() - 1);
+                return true;
+
+            case Token::Identifier: {
+                ++m_pos;
+                if (current().kind == Token::LeftParen) {
+                    return parseCall(token, error);
+                }
+                int index = m_expression.m_identifiers.indexOf(token.text);
+                if (index < 0) {
+                    m_expression.m_identifiers.append(token.text);
+                    index = m_expression.m_identifiers.size() - 1;
+                }
+                generate(ExpressionOp::LoadVar, index);
+                return true;
+            }
+
+            case Token::LeftParen:
+                ++m_pos;
+                if (!parseOr(error)) {
+                    return false;
+                }
+                if (current().kind != Token::RightParen) {
+                    error = QString("Ожидается \")\" в позиции %1").arg(current().position + 1);
+                    return false;
+                }
+                ++m_pos;
+                return true;
+
+            default:
+                error = QString("Ожидается число, имя параметра или \"(\" в позиции %1")
+                            .arg(token.position + 1);
+                return false;
+        }
+    }
+
+    bool parseCall(const Token& name, QString& error) {
+        const QString function = name.text.toLower();
+        ExpressionOp op;
+        int arity;
+        if (function == "abs") {
+            op = ExpressionOp::Abs;
+            arity = 1;
+        } else if (function == "min") {
+            op = ExpressionOp::Min;
+            arity = 2;
+        } else if (function == "max") {
+            op = ExpressionOp::Max;
+            arity = 2;
+        } else {
+            error = QString("Неизвестная функция \"%1\" в позиции %2").arg(name.text).arg(name.position + 1);
+            return false;
+        }
+
+        ++m_pos; // "("
+        for (int argument = 0; argument < arity; ++argument) {
+            if (argument > 0) {
+                if (current().kind != Token::Comma) {
+                    error = QString("Функция %1 принимает %2 аргумента (позиция %3)")
+                                .arg(function).arg(arity).arg(current().position + 1);
+                    return false;
+                }
+                ++m_pos;
+            }
+            if (!parseOr(error)) {
+                return false;
+            }
+        }
+        if (current().kind != Token::RightParen) {
+            error = QString("Ожидается \")\" после аргументов %1 (позиция %2)")
+                        .arg(function).arg(current().position + 1);
+            return false;
+        }
+        ++m_pos;
+
+        generate(op);
+        return true;
+    }
+};
+
+std::shared_ptr<const Expression> Expression::compile(const QString& text, QString* errorMessage) {
+    auto expression = std::make_shared<Expression>();
+    expression->m_text = text.trimmed();
+
+    QString error;
+    if (expression->m_text.isEmpty()) {
+        error = "Пустое выражение";
+    } else {
+        Parser parser(expression->m_text, *expression);
+        parser.parse(error);
+    }
+
+    if (!error.isEmpty()) {
+        if (errorMessage) {
+            *errorMessage = error;
+        }
+        return nullptr;
+    }
+
+    expression->m_code.squeeze();
+    expression->m_constants.squeeze();
+    return expression;
+}
+
+QString Expression::text() const {
+    return m_text;
+}
+
+const QStringList& Expression::identifiers() const {
+    return m_identifiers;
+}
+
+bool Expression::isTrue(double value) {
+    return value != 0.0 && !std::isnan(value);
+}
+
+double Expression::execute(const double* values) const {
+    QVarLengthArray<double, 32> stack(m_maxStack);
+    int top = -1;
+
+    for (const ExpressionInstruction& instruction : m_code) {
+        switch (instruction.op) {
+            case ExpressionOp::PushConst:
+                stack[++top] = m_constants[instruction.operand];
+                break;
+            case ExpressionOp::LoadVar:
+                stack[++top] = values[instruction.operand];
+                break;
+            case ExpressionOp::Neg:
+                stack[top] = -stack[top];
+                break;
+            case ExpressionOp::Not:
+                stack[top] = isTrue(stack[top]) ? 0.0 : 1.0;
+                break;
+            case ExpressionOp::Abs:
+                stack[top] = std::fabs(stack[top]);
+                break;
+            default: {
+                const double right = stack[top--];
+                double& left = stack[top];
+                switch (instruction.op) {
+                    case ExpressionOp::Add:          left = left + right; break;
+                    case ExpressionOp::Sub:          left = left - right; break;
+                    case ExpressionOp::Mul:          left = left * right; break;
+                    case ExpressionOp::Div:          left = left / right; break;
+                    case ExpressionOp::Less:         left = (left < right) ? 1.0 : 0.0; break;
+                    case ExpressionOp::LessEqual:    left = (left <= right) ? 1.0 : 0.0; break;
+                    case ExpressionOp::Greater:      left = (left > right) ? 1.0 : 0.0; break;
+                    case ExpressionOp::GreaterEqual: left = (left >= right) ? 1.0 : 0.0; break;
+                    case ExpressionOp::Equal:        left = (left == right) ? 1.0 : 0.0; break;
+                    case ExpressionOp::NotEqual:     left = (left != right) ? 1.0 : 0.0; break;
+                    case ExpressionOp::And:          left = (isTrue(left) && isTrue(right)) ? 1.0 : 0.0; break;
+                    case ExpressionOp::Or:           left = (isTrue(left) || isTrue(right)) ? 1.0 : 0.0; break;
+                    case ExpressionOp::Min:
+                        left = (std::isnan(left) || std::isnan(right)) ? std::nan("") : qMin(left, right);
+                        break;
+                    case ExpressionOp::Max:
+                        left = (std::isnan(left) || std::isnan(right)) ? std::nan("") : qMax(left, right);
+                        break;
+                    default: break;
+                }
+                break;
+            }
+        }
+    }
+
+    return top >= 0 ? stack[top] : std::nan("");
+}
+
+} // namespace ParamControl
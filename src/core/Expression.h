@@ -0,0 +1,107 @@
+// src/core/Expression.h
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+
+namespace ParamControl {
+
+/**
+ * @brief Код операции байт-кода выражения (стековая машина)
+ */
+enum class ExpressionOp : quint8 {
+    PushConst,      ///< Положить константу m_constants[operand]
+    LoadVar,        ///< Положить значение идентификатора operand
+    Neg,            ///< Унарный минус
+    Not,            ///< Логическое НЕ
+    Add,            ///< Сложение
+    Sub,            ///< Вычитание
+    Mul,            ///< Умножение
+    Div,            ///< Деление
+    Less,           ///< <
+    LessEqual,      ///< <=
+    Greater,        ///< >
+    GreaterEqual,   ///< >=
+    Equal,          ///< ==
+    NotEqual,       ///< !=
+    And,            ///< Логическое И
+    Or,             ///< Логическое ИЛИ
+    Abs,            ///< abs(x)
+    Min,            ///< min(a, b)
+    Max             ///< max(a, b)
+};
+
+/**
+ * @brief Инструкция байт-кода
+ */
+struct ExpressionInstruction {
+    ExpressionOp op;    ///< Код операции
+    int operand;        ///< Номер константы или идентификатора
+};
+
+/**
+ * @brief Скомпилированное выражение над несколькими параметрами ТМИ.
+ *
+ * Язык выражений:
+ * - числа (123, 1.5, 2e-3) и имена параметров (ТОК_АКБ, ТЕМП1);
+ *   имя с пробелами или символами операций записывается в квадратных скобках: [Темп. бака];
+ * - арифметика: + - * / и унарный минус;
+ * - сравнения: < <= > >= == !=;
+ * - логика: && (and, while, и), || (or, или), ! (not, не);
+ * - функции: abs(x), min(a, b), max(a, b);
+ * - скобки.
+ *
+ * Логические значения представляются как 1.0 и 0.0; истинно любое ненулевое
+ * значение, кроме NaN. Пример: "ТОК_АКБ > 2 while РЕЖИМ == 3".
+ *
+ * Выражение компилируется в постфиксный байт-код один раз; список
+ * идентификаторов (входов) доступен для построения графа зависимостей.
+ */
+class Expression {
+public:
+    /**
+     * @brief Компилирует текст выражения.
+     * @param text Текст выражения.
+     * @param errorMessage Сюда записывается описание ошибки (может быть nullptr).
+     * @return Скомпилированное выражение или nullptr при синтаксической ошибке.
+     */
+    static std::shared_ptr<const Expression> compile(const QString& text,
+                                                     QString* errorMessage = nullptr);
+
+    /**
+     * @brief Исходный текст выражения.
+     */
+    QString text() const;
+
+    /**
+     * @brief Имена, которые читает выражение, в порядке первого появления.
+     *
+     * Номер имени в этом списке - операнд инструкции LoadVar.
+     */
+    const QStringList& identifiers() const;
+
+    /**
+     * @brief Выполняет байт-код.
+     * @param values Значения идентификаторов в порядке identifiers().
+     * @return Результат выражения.
+     */
+    double execute(const double* values) const;
+
+    /**
+     * @brief Проверяет логическую истинность результата.
+     */
+    static bool isTrue(double value);
+
+private:
+    class Parser;
+
+    QString m_text;                             ///< Исходный текст
+    QStringList m_identifiers;                  ///< Читаемые имена
+    QVector<double> m_constants;                ///< Таблица констант
+    QVector<ExpressionInstruction> m_code;      ///< Байт-код
+    int m_maxStack = 0;                         ///< Максимальная глубина стека
+};
+
+} // namespace ParamControl
@@ -0,0 +1,425 @@
+// src/core/HistoryStore.cpp
+#include "HistoryStore.h"
+
+#include <QtAlgorithms> // Для qCountLeadingZeroBits, qCountTrailingZeroBits
+
+#include <cstring>
+#include <limits>
+
+namespace ParamControl {
+
+namespace {
+
+/// Начальный размер битового потока нового блока, байт.
+constexpr int kInitialBlockBytes = 256;
+
+quint64 doubleBits(double value) {
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(quint64 bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Дописывает n младших бит value в поток (старшие биты первыми).
+ */
+void writeBits(QByteArray& stream, qint64& bitCount, quint64 value, int n) {
+    while (n > 0) {
+        const int used = int(bitCount & 7);
+        if (used == 0) {
+            stream.append('\0');
+        }
+        const int free = 8 - used;
+        const int take = qMin(free, n);
+        const quint64 chunk = (value >> (n - take)) & ((quint64(1) << take) - 1);
+        stream.data()[stream.size() - 1] |= char(chunk << (free - take));
+        n -= take;
+        bitCount += take;
+    }
+}
+
+/**
+ * @brief Последовательное чтение битового потока
+ */
+class BitReader {
+public:
+    explicit BitReader(const QByteArray& stream)
+        : m_data(reinterpret_cast<const quint8*>(stream.constData()))
+    {
+    }
+
+    quint64 read(int n) {
+        quint64 value = 0;
+        while (n > 0) {
+            const int used = int(m_position & 7);
+            const int available = 8 - used;
+            const int take = qMin(available, n);
+            const quint8 byte = m_data[m_position >> 3];
+            const quint64 chunk = (byte >> (available - take)) & ((1u << take) - 1);
+            value = (value << take) | chunk;
+            n -= take;
+            m_position += take;
+        }
+        return value;
+    }
+
+    bool readBit() {
+        return read(1) != 0;
+    }
+
+private:
+    const quint8* m_data;
+    qint64 m_position = 0;
+};
+
+void writeVarint(QByteArray& stream, quint32 value) {
+    while (value >= 0x80) {
+        stream.append(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    stream.append(char(value));
+}
+
+quint32 readVarint(const QByteArray& stream, int& offset) {
+    quint32 value = 0;
+    int shift = 0;
+    while (offset < stream.size()) {
+        const quint8 byte = quint8(stream[offset++]);
+        value |= quint32(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+        shift += 7;
+    }
+    return value;
+}
+
+} // namespace
+
+HistoryStore::HistoryStore(qint64 memoryBudget)
+    : m_memoryBudget(memoryBudget)
+{
+}
+
+void HistoryStore::setMemoryBudget(qint64 bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_memoryBudget = qMax<qint64>(0, bytes);
+    enforceBudget();
+}
+
+qint64 HistoryStore::memoryBudget() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memoryBudget;
+}
+
+qint64 HistoryStore::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_sealedBytes + m_openBytes;
+}
+
+void HistoryStore::append(const QString& name, qint64 timestampMs, const QVariant& value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    appendLocked(name, timestampMs, value);
+    enforceBudget();
+}
+
+void HistoryStore::appendTick(const QVector<ParameterValue>& values, qint64 timestampMs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& value : values) {
+        appendLocked(value.name, timestampMs, value.value);
+    }
+    enforceBudget();
+}
+
+void HistoryStore::appendLocked(const QString& name, qint64 timestampMs, const QVariant& value) {
+    int index = m_seriesIndex.value(name, -1);
+    if (index < 0) {
+        index = int(m_series.size());
+        m_series.emplace_back();
+        m_seriesIndex.insert(name, index);
+    }
+    Series& series = m_series[index];
+
+    // Числовые QVariant берутся как есть, строки разбираются так же, как входы ConditionProgram
+    bool isNumber = false;
+    double number = 0.0;
+    QString text;
+    switch (static_cast<QMetaType::Type>(value.type())) {
+        case QMetaType::Int:
+        case QMetaType::LongLong:
+        case QMetaType::UInt:
+        case QMetaType::ULongLong:
+        case QMetaType::Double:
+        case QMetaType::Float:
+            number = value.toDouble(&isNumber);
+            break;
+        default:
+            text = value.toString();
+            number = text.trimmed().toDouble(&isNumber);
+            break;
+    }
+    if (isNumber) {
+        text.clear();
+    }
+
+    // Время истории не убывает (переводы системных часов назад не ломают кодирование)
+    const Block& last = (series.open.count > 0 || series.sealed.empty()) ? series.open : series.sealed.back();
+    if (last.count > 0 && timestampMs < last.lastMs) {
+        timestampMs = last.lastMs;
+    }
+
+    // Блок полон или сменился вид значения - закрываем его
+    if (series.open.count > 0 &&
+        (series.open.count >= kBlockSamples || series.open.numeric != isNumber)) {
+        seal(index);
+    }
+
+    Block& block = series.open;
+    const qint64 before = block.bytes();
+    if (block.count == 0) {
+        block.numeric = isNumber;
+        block.bits.reserve(kInitialBlockBytes);
+    }
+    encode(block, timestampMs, number, text);
+    m_openBytes += block.bytes() - before;
+}
+
+void HistoryStore::encode(Block& block, qint64 timestampMs, double number, const QString& text) {
+    if (block.count == 0) {
+        // Первый отсчет блока хранится полностью
+        writeBits(block.bits, block.bitCount, quint64(timestampMs), 64);
+        block.firstMs = timestampMs;
+        block.lastDelta = 0;
+        if (block.numeric) {
+            block.lastBits = doubleBits(number);
+            block.lastLeading = -1;
+            writeBits(block.bits, block.bitCount, block.lastBits, 64);
+        }
+    } else {
+        // Время: разность разностей с кодами переменной длины
+        const qint64 delta = timestampMs - block.lastMs;
+        const qint64 dod = delta - block.lastDelta;
+        block.lastDelta = delta;
+        if (dod == 0) {
+            writeBits(block.bits, block.bitCount, 0x0, 1);
+        } else if (dod >= -63 && dod <= 64) {
+            writeBits(block.bits, block.bitCount, 0x2, 2);
+            writeBits(block.bits, block.bitCount, quint64(dod + 63), 7);
+        } else if (dod >= -255 && dod <= 256) {
+            writeBits(block.bits, block.bitCount, 0x6, 3);
+            writeBits(block.bits, block.bitCount, quint64(dod + 255), 9);
+        } else if (dod >= -2047 && dod <= 2048) {
+            writeBits(block.bits, block.bitCount, 0xE, 4);
+            writeBits(block.bits, block.bitCount, quint64(dod + 2047), 12);
+        } else {
+            writeBits(block.bits, block.bitCount, 0xF, 4);
+            writeBits(block.bits, block.bitCount, quint64(dod), 64);
+        }
+
+        // Значение: XOR с предыдущим, значащие биты в окне ведущих/хвостовых нулей
+        if (block.numeric) {
+            const quint64 bits = doubleBits(number);
+            const quint64 xored = bits ^ block.lastBits;
+            block.lastBits = bits;
+            if (xored == 0) {
+                writeBits(block.bits, block.bitCount, 0x0, 1);
+            } else {
+                const int leading = qMin(31, int(qCountLeadingZeroBits(xored)));
+                const int trailing = int(qCountTrailingZeroBits(xored));
+                if (block.lastLeading >= 0 && leading >= block.lastLeading && trailing >= block.lastTrailing) {
+                    const int length = 64 - block.lastLeading - block.lastTrailing;
+                    writeBits(block.bits, block.bitCount, 0x2, 2);
+                    writeBits(block.bits, block.bitCount, xored >> block.lastTrailing, length);
+                } else {
+                    const int length = 64 - leading - trailing;
+                    writeBits(block.bits, block.bitCount, 0x3, 2);
+                    writeBits(block.bits, block.bitCount, quint64(leading), 5);
+                    writeBits(block.bits, block.bitCount, quint64(length - 1), 6);
+                    writeBits(block.bits, block.bitCount, xored >> trailing, length);
+                    block.lastLeading = leading;
+                    block.lastTrailing = trailing;
+                }
+            }
+        }
+    }
+
+    // Строки не сжимаются: длина и байты UTF-8
+    if (!block.numeric) {
+        const QByteArray utf8 = text.toUtf8();
+        writeVarint(block.text, quint32(utf8.size()));
+        block.text.append(utf8);
+    }
+
+    block.lastMs = timestampMs;
+    ++block.count;
+}
+
+void HistoryStore::decode(const Block& block, qint64 fromMs, qint64 toMs, QVector<HistorySample>& out) {
+    if (block.count == 0 || block.lastMs < fromMs || block.firstMs > toMs) {
+        return;
+    }
+
+    BitReader reader(block.bits);
+    int textOffset = 0;
+    qint64 timestamp = 0;
+    qint64 delta = 0;
+    quint64 bits = 0;
+    int leading = 0;
+    int trailing = 0;
+
+    for (int i = 0; i < block.count; ++i) {
+        if (i == 0) {
+            timestamp = qint64(reader.read(64));
+            if (block.numeric) {
+                bits = reader.read(64);
+            }
+        } else {
+            qint64 dod = 0;
+            if (reader.readBit()) {
+                if (!reader.readBit()) {
+                    dod = qint64(reader.read(7)) - 63;
+                } else if (!reader.readBit()) {
+                    dod = qint64(reader.read(9)) - 255;
+                } else if (!reader.readBit()) {
+                    dod = qint64(reader.read(12)) - 2047;
+                } else {
+                    dod = qint64(reader.read(64));
+                }
+            }
+            delta += dod;
+            timestamp += delta;
+
+            if (block.numeric && reader.readBit()) {
+                if (reader.readBit()) {
+                    leading = int(reader.read(5));
+                    const int length = int(reader.read(6)) + 1;
+                    trailing = 64 - leading - length;
+                }
+                const int length = 64 - leading - trailing;
+                bits ^= reader.read(length) << trailing;
+            }
+        }
+
+        QVariant value;
+        if (block.numeric) {
+            value = bitsDouble(bits);
+        } else {
+            const int length = int(readVarint(block.text, textOffset));
+            value = QString::fromUtf8(block.text.constData() + textOffset, length);
+            textOffset += length;
+        }
+
+        if (timestamp > toMs) {
+            break;
+        }
+        if (timestamp >= fromMs) {
+            out.append({timestamp, value});
+        }
+    }
+}
+
+void HistoryStore::seal(int index) {
+    Series& series = m_series[index];
+    Block& block = series.open;
+
+    m_openBytes -= block.bytes();
+    block.bits.squeeze();
+    block.text.squeeze();
+    m_sealedBytes += block.bytes() + qint64(sizeof(Block));
+
+    series.sealed.push_back(std::move(block));
+    series.open = Block();
+    m_sealOrder.push_back(index);
+}
+
+void HistoryStore::enforceBudget() {
+    // Блоки закрываются по времени, поэтому начало очереди - самые старые данные
+    while (m_sealedBytes + m_openBytes > m_memoryBudget && !m_sealOrder.empty()) {
+        Series& series = m_series[m_sealOrder.front()];
+        m_sealOrder.pop_front();
+        m_sealedBytes -= series.sealed.front().bytes() + qint64(sizeof(Block));
+        series.sealed.pop_front();
+    }
+}
+
+std::vector<HistoryStore::Block> HistoryStore::collectBlocks(const QString& name, qint64 fromMs, qint64 toMs) const {
+    std::vector<Block> blocks;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const int index = m_seriesIndex.value(name, -1);
+    if (index < 0) {
+        return blocks;
+    }
+
+    // Копии блоков разделяют данные с оригиналами (QByteArray неявно разделяем)
+    const Series& series = m_series[index];
+    for (const Block& block : series.sealed) {
+        if (block.lastMs >= fromMs && block.firstMs <= toMs) {
+            blocks.push_back(block);
+        }
+    }
+    if (series.open.count > 0 && series.open.lastMs >= fromMs && series.open.firstMs <= toMs) {
+        blocks.push_back(series.open);
+    }
+    return blocks;
+}
+
+QVector<HistorySample> HistoryStore::samples(const QString& name, qint64 fromMs, qint64 toMs) const {
+    QVector<HistorySample> result;
+    for (const Block& block : collectBlocks(name, fromMs, toMs)) {
+        decode(block, fromMs, toMs, result);
+    }
+    return result;
+}
+
+QVector<HistorySample> HistoryStore::latest(const QString& name, int count) const {
+    QVector<HistorySample> result;
+    if (count <= 0) {
+        return result;
+    }
+
+    // Берем с конца столько блоков, сколько нужно для count отсчетов
+    std::vector<Block> blocks;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const int index = m_seriesIndex.value(name, -1);
+        if (index < 0) {
+            return result;
+        }
+
+        const Series& series = m_series[index];
+        int collected = 0;
+        if (series.open.count > 0) {
+            blocks.push_back(series.open);
+            collected += series.open.count;
+        }
+        for (auto it = series.sealed.crbegin(); it != series.sealed.crend() && collected < count; ++it) {
+            blocks.push_back(*it);
+            collected += it->count;
+        }
+    }
+
+    for (auto it = blocks.crbegin(); it != blocks.crend(); ++it) {
+        decode(*it, std::numeric_limits<qint64>::min(), std::numeric_limits<qint64>::max(), result);
+    }
+    if (result.size() > count) {
+        result.remove(0, result.size() - count);
+    }
+    return result;
+}
+
+void HistoryStore::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_seriesIndex.clear();
+    m_series.clear();
+    m_sealOrder.clear();
+    m_sealedBytes = 0;
+    m_openBytes = 0;
+}
+
+} // namespace ParamControl
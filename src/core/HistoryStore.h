@@ -0,0 +1,179 @@
+// src/core/HistoryStore.h
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "XmlParser.h" // Для ParameterValue
+
+namespace ParamControl {
+
+/**
+ * @brief Отсчет истории значения параметра
+ */
+struct HistorySample {
+    qint64 timestampMs = 0;     ///< Время отсчета (мс от эпохи UTC)
+    QVariant value;             ///< Значение (double для числовых отсчетов, QString для строковых)
+};
+
+/**
+ * @brief Хранилище истории значений параметров ТМИ в памяти.
+ *
+ * Для каждого имени параметра отсчеты пишутся в блоки по kBlockSamples
+ * отсчетов со сжатием в стиле Gorilla: время кодируется разностью разностей
+ * (на регулярном опросе - 1 бит на отсчет), числовые значения - XOR
+ * с предыдущим значением (повторяющееся значение - 1 бит). Строковые
+ * значения хранятся без сжатия значения (UTF-8 с длиной); при смене вида
+ * значения блок закрывается и начинается новый.
+ *
+ * Добавление отсчета стоит O(1). Закрытые блоки неизменяемы; когда общий
+ * объем превышает бюджет памяти, удаляются самые старые закрытые блоки
+ * (по всем параметрам в порядке закрытия).
+ *
+ * Класс потокобезопасен. Чтение копирует под блокировкой только ссылки
+ * на неявно разделяемые данные блоков и распаковывает их без блокировки.
+ */
+class HistoryStore {
+public:
+    /// Число отсчетов в блоке.
+    static constexpr int kBlockSamples = 512;
+
+    /// Бюджет памяти по умолчанию, байт.
+    static constexpr qint64 kDefaultMemoryBudget = 64LL * 1024 * 1024;
+
+    /**
+     * @brief Конструктор.
+     * @param memoryBudget Бюджет памяти, байт.
+     */
+    explicit HistoryStore(qint64 memoryBudget = kDefaultMemoryBudget);
+
+    /**
+     * @brief Устанавливает бюджет памяти; лишние старые блоки удаляются сразу.
+     * @param bytes Бюджет памяти, байт.
+     */
+    void setMemoryBudget(qint64 bytes);
+
+    /**
+     * @brief Возвращает бюджет памяти, байт.
+     */
+    qint64 memoryBudget() const;
+
+    /**
+     * @brief Возвращает объем, занятый блоками истории, байт.
+     */
+    qint64 memoryUsage() const;
+
+    /**
+     * @brief Добавляет отсчет параметра.
+     * @param name Имя параметра ТМИ.
+     * @param timestampMs Время отсчета (мс от эпохи UTC).
+     * @param value Значение.
+     */
+    void append(const QString& name, qint64 timestampMs, const QVariant& value);
+
+    /**
+     * @brief Добавляет все значения такта под одной блокировкой.
+     * @param values Значения параметров, полученные от СОТМ.
+     * @param timestampMs Время такта (мс от эпохи UTC).
+     */
+    void appendTick(const QVector<ParameterValue>& values, qint64 timestampMs);
+
+    /**
+     * @brief Возвращает отсчеты параметра за интервал времени [fromMs, toMs].
+     * @param name Имя параметра ТМИ.
+     * @param fromMs Начало интервала.
+     * @param toMs Конец интервала.
+     * @return Отсчеты в порядке времени.
+     */
+    QVector<HistorySample> samples(const QString& name, qint64 fromMs, qint64 toMs) const;
+
+    /**
+     * @brief Возвращает последние отсчеты параметра.
+     * @param name Имя параметра ТМИ.
+     * @param count Наибольшее число отсчетов.
+     * @return Отсчеты в порядке времени.
+     */
+    QVector<HistorySample> latest(const QString& name, int count) const;
+
+    /**
+     * @brief Удаляет всю историю.
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Блок сжатых отсчетов одного параметра
+     */
+    struct Block {
+        QByteArray bits;            ///< Битовый поток: время и числовые значения
+        QByteArray text;            ///< Строковые значения (UTF-8 с длиной)
+        qint64 bitCount = 0;        ///< Число записанных бит
+        qint64 firstMs = 0;         ///< Время первого отсчета
+        qint64 lastMs = 0;          ///< Время последнего отсчета
+        int count = 0;              ///< Число отсчетов
+        bool numeric = true;        ///< Блок числовых значений
+
+        // --- Состояние кодера (нужно только открытому блоку) ---
+        qint64 lastDelta = 0;       ///< Предыдущий интервал между отсчетами
+        quint64 lastBits = 0;       ///< Биты предыдущего значения
+        int lastLeading = -1;       ///< Ведущие нули предыдущего XOR (-1 - окна нет)
+        int lastTrailing = 0;       ///< Хвостовые нули предыдущего XOR
+
+        qint64 bytes() const { return bits.capacity() + text.capacity(); }
+    };
+
+    /**
+     * @brief История одного параметра
+     */
+    struct Series {
+        std::deque<Block> sealed;   ///< Закрытые блоки по возрастанию времени
+        Block open;                 ///< Открытый блок (count == 0 - пуст)
+    };
+
+    mutable std::mutex m_mutex;                 ///< Защита всех полей
+    QHash<QString, int> m_seriesIndex;          ///< Имя параметра → номер истории
+    std::vector<Series> m_series;               ///< Истории параметров
+    std::deque<int> m_sealOrder;                ///< Номера историй в порядке закрытия блоков
+    qint64 m_memoryBudget;                      ///< Бюджет памяти, байт
+    qint64 m_sealedBytes = 0;                   ///< Объем закрытых блоков
+    qint64 m_openBytes = 0;                     ///< Объем открытых блоков
+
+    /**
+     * @brief Добавляет отсчет; мьютекс должен быть захвачен.
+     */
+    void appendLocked(const QString& name, qint64 timestampMs, const QVariant& value);
+
+    /**
+     * @brief Закрывает открытый блок истории; мьютекс должен быть захвачен.
+     */
+    void seal(int series);
+
+    /**
+     * @brief Удаляет старые закрытые блоки сверх бюджета; мьютекс должен быть захвачен.
+     */
+    void enforceBudget();
+
+    /**
+     * @brief Копирует блоки истории, пересекающиеся с интервалом.
+     */
+    std::vector<Block> collectBlocks(const QString& name, qint64 fromMs, qint64 toMs) const;
+
+    /**
+     * @brief Кодирует отсчет в блок.
+     */
+    static void encode(Block& block, qint64 timestampMs, double number, const QString& text);
+
+    /**
+     * @brief Распаковывает отсчеты блока из интервала [fromMs, toMs].
+     */
+    static void decode(const Block& block, qint64 fromMs, qint64 toMs, QVector<HistorySample>& out);
+};
+
+} // namespace ParamControl
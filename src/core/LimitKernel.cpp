@@ -0,0 +1,360 @@
+// src/core/LimitKernel.cpp
+#include "LimitKernel.h"
+
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PARAMCONTROL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define PARAMCONTROL_X86 0
+#endif
+
+// На GCC/Clang AVX2-функции компилируются с атрибутом target, чтобы остальной
+// код оставался совместимым с базовым x86-64 без флагов -mavx2.
+#if PARAMCONTROL_X86 && (defined(__GNUC__) || defined(__clang__))
+#define PARAMCONTROL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PARAMCONTROL_TARGET_AVX2
+#endif
+
+namespace ParamControl {
+
+namespace {
+
+constexpr int kWordBits = 64;
+
+int wordsFor(int count) {
+    return (count + kWordBits - 1) / kWordBits;
+}
+
+/**
+ * @brief Скалярная проверка n <= 64 значений, начиная с заданной позиции.
+ */
+quint64 scalarWord(const double* value, const double* lower, const double* upper, int n) {
+    quint64 bits = 0;
+    for (int i = 0; i < n; ++i) {
+        if (value[i] >= lower[i] && value[i] <= upper[i]) {
+            bits |= quint64(1) << i;
+        }
+    }
+    return bits;
+}
+
+void evaluateScalar(const double* value, const double* lower, const double* upper,
+                    int count, quint64* insideBits) {
+    for (int base = 0, word = 0; base < count; base += kWordBits, ++word) {
+        insideBits[word] = scalarWord(value + base, lower + base, upper + base,
+                                      qMin(kWordBits, count - base));
+    }
+}
+
+#if PARAMCONTROL_X86
+
+void evaluateSse2(const double* value, const double* lower, const double* upper,
+                  int count, quint64* insideBits) {
+    const int fullWords = count / kWordBits;
+
+    for (int word = 0; word < fullWords; ++word) {
+        const int base = word * kWordBits;
+        quint64 bits = 0;
+        for (int i = 0; i < kWordBits; i += 2) {
+            const __m128d v = _mm_loadu_pd(value + base + i);
+            const __m128d inside = _mm_and_pd(_mm_cmpge_pd(v, _mm_loadu_pd(lower + base + i)),
+                                              _mm_cmple_pd(v, _mm_loadu_pd(upper + base + i)));
+            bits |= quint64(_mm_movemask_pd(inside)) << i;
+        }
+        insideBits[word] = bits;
+    }
+
+    const int tail = fullWords * kWordBits;
+    if (tail < count) {
+        insideBits[fullWords] = scalarWord(value + tail, lower + tail, upper + tail, count - tail);
+    }
+}
+
+PARAMCONTROL_TARGET_AVX2
+void evaluateAvx2(const double* value, const double* lower, const double* upper,
+                  int count, quint64* insideBits) {
+    const int fullWords = count / kWordBits;
+
+    for (int word = 0; word < fullWords; ++word) {
+        const int base = word * kWordBits;
+        quint64 bits = 0;
+        for (int i = 0; i < kWordBits; i += 4) {
+            const __m256d v = _mm256_loadu_pd(value + base + i);
+            // _CMP_*_OQ: сравнение с NaN дает false, как и в скалярной версии
+            const __m256d inside = _mm256_and_pd(
+                _mm256_cmp_pd(v, _mm256_loadu_pd(lower + base + i), _CMP_GE_OQ),
+                _mm256_cmp_pd(v, _mm256_loadu_pd(upper + base + i), _CMP_LE_OQ));
+            bits |= quint64(_mm256_movemask_pd(inside)) << i;
+        }
+        insideBits[word] = bits;
+    }
+
+    const int tail = fullWords * kWordBits;
+    if (tail < count) {
+        insideBits[fullWords] = scalarWord(value + tail, lower + tail, upper + tail, count - tail);
+    }
+}
+
+bool cpuHasAvx2() {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4] = {0, 0, 0, 0};
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // AVX требует поддержки сохранения YMM-регистров операционной системой
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif // PARAMCONTROL_X86
+
+} // namespace
+
+// --- LimitKernel ---
+
+LimitKernelPath LimitKernel::detectedPath() {
+#if PARAMCONTROL_X86
+    static const LimitKernelPath path = cpuHasAvx2() ? LimitKernelPath::Avx2 : LimitKernelPath::Sse2;
+    return path;
+#else
+    return LimitKernelPath::Scalar;
+#endif
+}
+
+QString LimitKernel::pathName(LimitKernelPath path) {
+    switch (path) {
+        case LimitKernelPath::Scalar: return "scalar";
+        case LimitKernelPath::Sse2:   return "SSE2";
+        case LimitKernelPath::Avx2:   return "AVX2";
+    }
+    return "unknown";
+}
+
+void LimitKernel::evaluate(LimitKernelPath path,
+                           const double* value, const double* lower, const double* upper,
+                           int count, quint64* insideBits) {
+    if (count <= 0) {
+        return;
+    }
+
+#if PARAMCONTROL_X86
+    if (path == LimitKernelPath::Avx2 && detectedPath() == LimitKernelPath::Avx2) {
+        evaluateAvx2(value, lower, upper, count, insideBits);
+        return;
+    }
+    if (path != LimitKernelPath::Scalar) {
+        evaluateSse2(value, lower, upper, count, insideBits);
+        return;
+    }
+#else
+    Q_UNUSED(path);
+#endif
+
+    evaluateScalar(value, lower, upper, count, insideBits);
+}
+
+// --- LimitTable ---
+
+int LimitTable::addRow(double lower, double upper, bool outOfLimits, ParameterStatus status,
+                       double hysteresis, bool filtered) {
+    const int lane = m_lower.size();
+    m_lower.append(lower);
+    m_upper.append(upper);
+    m_value.append(std::numeric_limits<double>::quiet_NaN());
+
+    // Зона возврата: для InLimits - сужение диапазона, для OutOfLimits - расширение
+    const double band = outOfLimits ? -hysteresis : hysteresis;
+    m_recoverLower.append(lower + band);
+    m_recoverUpper.append(upper - band);
+    m_hasHysteresis = m_hasHysteresis || hysteresis > 0.0;
+
+    const int words = wordsFor(lane + 1);
+    if (words > m_valid.size()) {
+        m_valid.append(0);
+        m_present.append(0);
+        m_invert.append(0);
+        m_inside.append(0);
+        m_ok.append(0);
+        m_known.append(0);
+        m_changed.append(0);
+        m_insideRecover.append(0);
+        m_met.append(0);
+        m_filtered.append(0);
+        m_pending.append(0);
+        m_review.append(0);
+    }
+
+    const int word = lane / kWordBits;
+    const quint64 bit = quint64(1) << (lane % kWordBits);
+    if (outOfLimits) {
+        m_invert[word] |= bit;
+    }
+    if (filtered) {
+        m_filtered[word] |= bit;
+    }
+    if (status != ParameterStatus::Unknown) {
+        m_known[word] |= bit;
+        if (status == ParameterStatus::Ok) {
+            m_ok[word] |= bit;
+        }
+    }
+
+    return lane;
+}
+
+int LimitTable::size() const {
+    return m_lower.size();
+}
+
+int LimitTable::wordCount() const {
+    return m_present.size();
+}
+
+void LimitTable::beginTick() {
+    m_present.fill(0);
+    m_valid.fill(0);
+}
+
+void LimitTable::setValue(int lane, double value) {
+    const int word = lane / kWordBits;
+    const quint64 bit = quint64(1) << (lane % kWordBits);
+
+    m_value[lane] = value;
+    m_present[word] |= bit;
+    if (std::isnan(value)) {
+        m_valid[word] &= ~bit;
+    } else {
+        m_valid[word] |= bit;
+    }
+}
+
+void LimitTable::setInvalid(int lane) {
+    const int word = lane / kWordBits;
+    const quint64 bit = quint64(1) << (lane % kWordBits);
+
+    m_value[lane] = std::numeric_limits<double>::quiet_NaN();
+    m_present[word] |= bit;
+    m_valid[word] &= ~bit;
+}
+
+void LimitTable::evaluate(LimitKernelPath path) {
+    evaluate(path, 0, m_present.size());
+}
+
+void LimitTable::evaluate(LimitKernelPath path, int firstWord, int lastWord) {
+    const int firstLane = firstWord * kWordBits;
+    const int laneCount = qMin(lastWord * kWordBits, m_value.size()) - firstLane;
+    if (laneCount <= 0) {
+        return;
+    }
+
+    LimitKernel::evaluate(path, m_value.constData() + firstLane, m_lower.constData() + firstLane,
+                          m_upper.constData() + firstLane, laneCount, m_inside.data() + firstWord);
+    if (m_hasHysteresis) {
+        LimitKernel::evaluate(path, m_value.constData() + firstLane, m_recoverLower.constData() + firstLane,
+                              m_recoverUpper.constData() + firstLane, laneCount,
+                              m_insideRecover.data() + firstWord);
+    }
+
+    for (int word = firstWord; word < lastWord; ++word) {
+        const quint64 present = m_present[word];
+
+        // Норма: значение - число, и попадание в диапазон совпадает с типом правила
+        quint64 met = (m_inside[word] ^ m_invert[word]) & m_valid[word];
+
+        // Строки в Error возвращаются в норму только по зоне возврата
+        if (m_hasHysteresis) {
+            const quint64 inError = m_known[word] & ~m_ok[word];
+            const quint64 recovered = (m_insideRecover[word] ^ m_invert[word]) & m_valid[word];
+            met = (met & ~inError) | (recovered & inError);
+        }
+        m_met[word] = met;
+
+        // Фильтруемые строки переключает вызывающая сторона после подтверждения
+        const quint64 direct = present & ~m_filtered[word];
+        const quint64 differs = ~m_known[word] | (met ^ m_ok[word]);
+        m_review[word] = present & m_filtered[word] & (differs | m_pending[word]);
+
+        // Изменение: статус был неизвестен или бит нормы отличается от прошлого такта
+        m_changed[word] = direct & differs;
+
+        m_ok[word] = (m_ok[word] & ~direct) | (met & direct);
+        m_known[word] |= direct;
+    }
+}
+
+const QVector<quint64>& LimitTable::presentBits() const {
+    return m_present;
+}
+
+const QVector<quint64>& LimitTable::changedBits() const {
+    return m_changed;
+}
+
+const QVector<quint64>& LimitTable::reviewBits() const {
+    return m_review;
+}
+
+bool LimitTable::conditionMet(int lane) const {
+    return (m_met[lane / kWordBits] >> (lane % kWordBits)) & 1;
+}
+
+ParameterStatus LimitTable::status(int lane) const {
+    const int word = lane / kWordBits;
+    const quint64 bit = quint64(1) << (lane % kWordBits);
+
+    if (!(m_known[word] & bit)) {
+        return ParameterStatus::Unknown;
+    }
+    return (m_ok[word] & bit) ? ParameterStatus::Ok : ParameterStatus::Error;
+}
+
+void LimitTable::setStatus(int lane, ParameterStatus status) {
+    const int word = lane / kWordBits;
+    const quint64 bit = quint64(1) << (lane % kWordBits);
+
+    if (status == ParameterStatus::Unknown) {
+        m_known[word] &= ~bit;
+        m_ok[word] &= ~bit;
+        return;
+    }
+    m_known[word] |= bit;
+    if (status == ParameterStatus::Ok) {
+        m_ok[word] |= bit;
+    } else {
+        m_ok[word] &= ~bit;
+    }
+}
+
+void LimitTable::setPending(int lane, bool pending) {
+    const int word = lane / kWordBits;
+    const quint64 bit = quint64(1) << (lane % kWordBits);
+
+    if (pending) {
+        m_pending[word] |= bit;
+    } else {
+        m_pending[word] &= ~bit;
+    }
+}
+
+} // namespace ParamControl
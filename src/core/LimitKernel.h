@@ -0,0 +1,184 @@
+// src/core/LimitKernel.h
+#pragma once
+
+#include <QVector>
+#include <QString>
+
+#include "Parameter.h" // Для ParameterStatus
+
+namespace ParamControl {
+
+/**
+ * @brief Реализация ядра проверки пределов
+ */
+enum class LimitKernelPath {
+    Scalar,     ///< Скалярный цикл (любая платформа)
+    Sse2,       ///< SSE2, 2 значения за инструкцию (базовый уровень x86-64)
+    Avx2        ///< AVX2, 4 значения за инструкцию (выбирается при поддержке процессором)
+};
+
+/**
+ * @brief Векторное ядро проверки попадания значений в диапазон [lower, upper].
+ *
+ * Результат записывается в битовую карту: бит i установлен, если
+ * lower[i] <= value[i] <= upper[i]. NaN в любой позиции дает 0.
+ */
+class LimitKernel {
+public:
+    /**
+     * @brief Возвращает лучшую реализацию, доступную на текущем процессоре.
+     *
+     * Проверка процессора выполняется один раз при первом вызове.
+     */
+    static LimitKernelPath detectedPath();
+
+    /**
+     * @brief Возвращает название реализации (для журналов и бенчмарка).
+     */
+    static QString pathName(LimitKernelPath path);
+
+    /**
+     * @brief Проверяет count значений и заполняет битовую карту.
+     * @param path Реализация ядра (если недоступна, используется Scalar).
+     * @param value Значения.
+     * @param lower Нижние границы.
+     * @param upper Верхние границы.
+     * @param count Количество значений.
+     * @param insideBits Выходная карта, не менее (count + 63) / 64 слов.
+     */
+    static void evaluate(LimitKernelPath path,
+                         const double* value, const double* lower, const double* upper,
+                         int count, quint64* insideBits);
+};
+
+/**
+ * @brief Таблица правил InLimits/OutOfLimits в виде структуры массивов.
+ *
+ * Хранит границы, значения текущего такта и битовые карты статусов.
+ * За такт ядро LimitKernel проверяет всю таблицу, после чего изменения
+ * статусов вычисляются сравнением карты с картой предыдущего такта
+ * по 64 правила за операцию.
+ *
+ * Строки с гистерезисом после перехода в Error проверяются по границам
+ * зоны возврата (второй проход ядра, только если такие строки есть).
+ * Строки с подтверждением статуса (фильтруемые) таблица не переключает
+ * сама: они попадают в карту reviewBits(), и вызывающая сторона
+ * устанавливает подтвержденный статус через setStatus().
+ */
+class LimitTable {
+public:
+    /**
+     * @brief Добавляет строку таблицы.
+     * @param lower Нижняя граница.
+     * @param upper Верхняя граница.
+     * @param outOfLimits true для OutOfLimits (норма - вне диапазона).
+     * @param status Начальный статус (перенесенный из предыдущей программы).
+     * @param hysteresis Ширина зоны возврата в норму (0 - без гистерезиса).
+     * @param filtered Статус строки подтверждается вызывающей стороной.
+     * @return Номер строки (дорожки) в таблице.
+     */
+    int addRow(double lower, double upper, bool outOfLimits, ParameterStatus status,
+               double hysteresis = 0.0, bool filtered = false);
+
+    /**
+     * @brief Количество строк таблицы.
+     */
+    int size() const;
+
+    /**
+     * @brief Количество 64-битных слов в битовых картах.
+     */
+    int wordCount() const;
+
+    /**
+     * @brief Сбрасывает признаки получения значений перед загрузкой нового такта.
+     */
+    void beginTick();
+
+    /**
+     * @brief Записывает числовое значение строки на текущем такте.
+     */
+    void setValue(int lane, double value);
+
+    /**
+     * @brief Отмечает, что значение строки получено, но не является числом.
+     *
+     * Такое значение считается нарушением условия для обоих типов правил.
+     */
+    void setInvalid(int lane);
+
+    /**
+     * @brief Проверяет всю таблицу и вычисляет изменения статусов.
+     * @param path Реализация ядра.
+     */
+    void evaluate(LimitKernelPath path = LimitKernel::detectedPath());
+
+    /**
+     * @brief Проверяет часть таблицы: слова битовых карт [firstWord, lastWord).
+     *
+     * Разные диапазоны слов не пересекаются по данным, поэтому их можно
+     * проверять одновременно из разных потоков.
+     * @param path Реализация ядра.
+     * @param firstWord Первое слово (строки с firstWord * 64).
+     * @param lastWord Слово, следующее за последним.
+     */
+    void evaluate(LimitKernelPath path, int firstWord, int lastWord);
+
+    /**
+     * @brief Карта строк, для которых на текущем такте получено значение.
+     */
+    const QVector<quint64>& presentBits() const;
+
+    /**
+     * @brief Карта строк, статус которых изменился на последнем evaluate().
+     */
+    const QVector<quint64>& changedBits() const;
+
+    /**
+     * @brief Карта фильтруемых строк, которым на последнем evaluate() нужно
+     * подтверждение: результат отличается от статуса или подтверждение уже идет.
+     */
+    const QVector<quint64>& reviewBits() const;
+
+    /**
+     * @brief Результат условия строки на последнем evaluate() (с учетом гистерезиса).
+     */
+    bool conditionMet(int lane) const;
+
+    /**
+     * @brief Текущий статус строки.
+     */
+    ParameterStatus status(int lane) const;
+
+    /**
+     * @brief Устанавливает подтвержденный статус фильтруемой строки.
+     */
+    void setStatus(int lane, ParameterStatus status);
+
+    /**
+     * @brief Отмечает, что у фильтруемой строки идет подтверждение нового статуса.
+     */
+    void setPending(int lane, bool pending);
+
+private:
+    QVector<double> m_lower;            ///< Нижние границы
+    QVector<double> m_upper;            ///< Верхние границы
+    QVector<double> m_value;            ///< Значения текущего такта
+    QVector<double> m_recoverLower;     ///< Нижние границы зоны возврата (гистерезис)
+    QVector<double> m_recoverUpper;     ///< Верхние границы зоны возврата (гистерезис)
+    bool m_hasHysteresis = false;       ///< Хотя бы у одной строки есть гистерезис
+    QVector<quint64> m_valid;           ///< Значение является числом (не NaN)
+    QVector<quint64> m_present;         ///< Значение получено на текущем такте
+    QVector<quint64> m_invert;          ///< Правило OutOfLimits
+    QVector<quint64> m_inside;          ///< Результат ядра: значение в диапазоне
+    QVector<quint64> m_ok;              ///< Статус Ok (действителен при m_known)
+    QVector<quint64> m_known;           ///< Статус определен (не Unknown)
+    QVector<quint64> m_changed;         ///< Статус изменился на последнем такте
+    QVector<quint64> m_insideRecover;   ///< Результат ядра по зоне возврата
+    QVector<quint64> m_met;             ///< Результат условия на последнем такте
+    QVector<quint64> m_filtered;        ///< Статус подтверждается вызывающей стороной
+    QVector<quint64> m_pending;         ///< Идет подтверждение нового статуса
+    QVector<quint64> m_review;          ///< Фильтруемые строки для подтверждения
+};
+
+} // namespace ParamControl
@@ -0,0 +1,142 @@
+// src/core/LogBuffer.cpp
+#include "LogBuffer.h"
+
+namespace ParamControl {
+
+// --- LogSnapshot ---
+
+int LogSnapshot::size() const {
+    return m_size;
+}
+
+bool LogSnapshot::isEmpty() const {
+    return m_size == 0;
+}
+
+quint64 LogSnapshot::firstSequence() const {
+    return m_firstSequence;
+}
+
+quint64 LogSnapshot::endSequence() const {
+    return m_firstSequence + quint64(m_size);
+}
+
+const LogEntry& LogSnapshot::at(int index) const {
+    const int position = m_first + index;
+    return (*m_chunks[size_t(position / LogBuffer::kChunkSize)])[size_t(position % LogBuffer::kChunkSize)];
+}
+
+int LogSnapshot::indexOf(quint64 sequence) const {
+    if (sequence < m_firstSequence || sequence >= endSequence()) {
+        return -1;
+    }
+    return int(sequence - m_firstSequence);
+}
+
+// --- LogBuffer ---
+
+LogBuffer::LogBuffer(int capacity)
+    : m_capacity(qMax(1, capacity))
+{
+}
+
+int LogBuffer::capacity() const {
+    return m_capacity;
+}
+
+void LogBuffer::setCapacity(int capacity) {
+    m_capacity = qMax(1, capacity);
+    while (m_size > m_capacity) {
+        popFront();
+    }
+}
+
+int LogBuffer::size() const {
+    return m_size;
+}
+
+bool LogBuffer::isEmpty() const {
+    return m_size == 0;
+}
+
+quint64 LogBuffer::firstSequence() const {
+    return m_firstSequence;
+}
+
+quint64 LogBuffer::endSequence() const {
+    return m_firstSequence + quint64(m_size);
+}
+
+const LogEntry& LogBuffer::at(int index) const {
+    const int position = m_first + index;
+    return (*m_chunks[size_t(position / kChunkSize)])[size_t(position % kChunkSize)];
+}
+
+quint64 LogBuffer::append(const LogEntry& entry) {
+    const int position = m_first + m_size;
+    if (position == int(m_chunks.size()) * kChunkSize) {
+        if (m_spare) {
+            m_chunks.push_back(std::move(m_spare));
+            m_spare.reset();
+        } else {
+            m_chunks.push_back(std::make_shared<LogChunk>(size_t(kChunkSize)));
+        }
+    }
+
+    // Ячейка за концом не видна ни одному снимку, поэтому пишется на месте
+    (*m_chunks.back())[size_t(position % kChunkSize)] = entry;
+    ++m_size;
+
+    if (m_size > m_capacity) {
+        popFront();
+    }
+    return endSequence() - 1;
+}
+
+void LogBuffer::replaceLast(const LogEntry& entry) {
+    const int position = m_first + m_size - 1;
+    std::shared_ptr<LogChunk>& chunk = m_chunks[size_t(position / kChunkSize)];
+    if (chunk.use_count() > 1) {
+        chunk = std::make_shared<LogChunk>(*chunk);
+    }
+    (*chunk)[size_t(position % kChunkSize)] = entry;
+}
+
+void LogBuffer::clear() {
+    m_firstSequence += quint64(m_size);
+    m_size = 0;
+    m_first = 0;
+    for (std::shared_ptr<LogChunk>& chunk : m_chunks) {
+        if (chunk.use_count() == 1) {
+            m_spare = std::move(chunk);
+        }
+    }
+    m_chunks.clear();
+}
+
+LogSnapshot LogBuffer::snapshot() const {
+    LogSnapshot snapshot;
+    snapshot.m_chunks.assign(m_chunks.begin(), m_chunks.end());
+    snapshot.m_first = m_first;
+    snapshot.m_size = m_size;
+    snapshot.m_firstSequence = m_firstSequence;
+    return snapshot;
+}
+
+void LogBuffer::popFront() {
+    ++m_first;
+    --m_size;
+    ++m_firstSequence;
+
+    if (m_first == kChunkSize || m_size == 0) {
+        // Участок без записей переиспользуется, только если его не держит снимок
+        std::shared_ptr<LogChunk> chunk = std::move(m_chunks.front());
+        m_chunks.pop_front();
+        if (chunk.use_count() == 1) {
+            m_spare = std::move(chunk);
+        }
+        m_first = 0;
+    }
+}
+
+} // namespace ParamControl
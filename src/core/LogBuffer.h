@@ -0,0 +1,168 @@
+// src/core/LogBuffer.h
+#pragma once
+
+#include <QtGlobal>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "LogEntry.h"
+
+namespace ParamControl {
+
+/// Участок кольцевого буфера журнала (всегда kChunkSize ячеек).
+using LogChunk = std::vector<LogEntry>;
+
+/**
+ * @brief Неизменяемый вид на записи журнала на момент снимка.
+ *
+ * Снимок хранит только ссылки на участки буфера, поэтому снимается за
+ * O(число участков) без копирования записей. Участок, на который ссылается
+ * снимок, буфер не переиспользует, а ячейки после конца снимка снимку не
+ * видны, поэтому читать снимок можно без блокировок сколько угодно долго.
+ *
+ * Каждая запись имеет порядковый номер (sequence), который растет с каждой
+ * записью и не сбрасывается при очистке; по нему строки представлений
+ * сопоставляются между снимками.
+ */
+class LogSnapshot {
+public:
+    /**
+     * @brief Число записей.
+     */
+    int size() const;
+
+    /**
+     * @brief Снимок пуст.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Порядковый номер первой записи.
+     */
+    quint64 firstSequence() const;
+
+    /**
+     * @brief Порядковый номер, следующий за последней записью.
+     */
+    quint64 endSequence() const;
+
+    /**
+     * @brief Запись по номеру в снимке (0 - самая старая).
+     */
+    const LogEntry& at(int index) const;
+
+    /**
+     * @brief Номер записи в снимке по порядковому номеру.
+     * @return Номер или -1, если запись вытеснена или еще не добавлена.
+     */
+    int indexOf(quint64 sequence) const;
+
+private:
+    friend class LogBuffer;
+
+    std::vector<std::shared_ptr<const LogChunk>> m_chunks; ///< Участки с записями снимка
+    int m_first = 0;                ///< Ячейка первой записи в первом участке
+    int m_size = 0;                 ///< Число записей
+    quint64 m_firstSequence = 0;    ///< Порядковый номер первой записи
+};
+
+/**
+ * @brief Кольцевой буфер записей журнала фиксированной емкости.
+ *
+ * Записи лежат в участках по kChunkSize ячеек. Добавление пишет запись
+ * в следующую ячейку последнего участка и при переполнении сдвигает начало
+ * на одну ячейку: O(1) без сдвига остальных записей. Участок, из которого
+ * вытеснены все записи, переиспользуется для новых записей, если на него
+ * не ссылается ни один снимок.
+ *
+ * Класс не потокобезопасен: LogManager вызывает его под своим мьютексом.
+ * Снимки (snapshot()) можно читать из любого потока.
+ */
+class LogBuffer {
+public:
+    /// Число ячеек в участке.
+    static constexpr int kChunkSize = 256;
+
+    /**
+     * @brief Конструктор.
+     * @param capacity Емкость, записей.
+     */
+    explicit LogBuffer(int capacity = 1000);
+
+    /**
+     * @brief Емкость, записей.
+     */
+    int capacity() const;
+
+    /**
+     * @brief Устанавливает емкость; лишние старые записи вытесняются сразу.
+     * @param capacity Емкость, записей (не меньше 1).
+     */
+    void setCapacity(int capacity);
+
+    /**
+     * @brief Число записей.
+     */
+    int size() const;
+
+    /**
+     * @brief Буфер пуст.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Порядковый номер первой записи.
+     */
+    quint64 firstSequence() const;
+
+    /**
+     * @brief Порядковый номер, который получит следующая запись.
+     */
+    quint64 endSequence() const;
+
+    /**
+     * @brief Запись по номеру (0 - самая старая).
+     */
+    const LogEntry& at(int index) const;
+
+    /**
+     * @brief Добавляет запись, вытесняя самую старую при заполнении.
+     * @return Порядковый номер записи.
+     */
+    quint64 append(const LogEntry& entry);
+
+    /**
+     * @brief Заменяет самую новую запись (буфер не пуст).
+     *
+     * Снимки, сделанные раньше, видят прежнюю запись: участок, который
+     * держит снимок, перед заменой копируется.
+     */
+    void replaceLast(const LogEntry& entry);
+
+    /**
+     * @brief Удаляет все записи (порядковые номера продолжают расти).
+     */
+    void clear();
+
+    /**
+     * @brief Снимок текущих записей.
+     */
+    LogSnapshot snapshot() const;
+
+private:
+    std::deque<std::shared_ptr<LogChunk>> m_chunks; ///< Участки от старых к новым
+    std::shared_ptr<LogChunk> m_spare;  ///< Освободившийся участок для повторного использования
+    int m_capacity;                     ///< Емкость, записей
+    int m_first = 0;                    ///< Ячейка первой записи в первом участке
+    int m_size = 0;                     ///< Число записей
+    quint64 m_firstSequence = 0;        ///< Порядковый номер первой записи
+
+    /**
+     * @brief Вытесняет самую старую запись.
+     */
+    void popFront();
+};
+
+} // namespace ParamControl
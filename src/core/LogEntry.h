@@ -0,0 +1,116 @@
+// src/core/LogEntry.h
+#pragma once
+
+#include <QDateTime>
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+
+#include "LogStringTable.h"
+
+namespace ParamControl {
+
+/**
+ * @brief Уровни логирования
+ */
+enum class LogLevel {
+    Info,       ///< Информационное сообщение
+    Error       ///< Ошибка
+};
+
+/**
+ * @brief Статус логируемого события
+ */
+enum class LogStatus {
+    Normal,     ///< Нормальное состояние
+    Error       ///< Ошибка
+};
+
+/**
+ * @brief Структура для хранения записи журнала
+ *
+ * Категория и шаблон сообщения хранятся номерами в LogStringTable,
+ * а сообщение - шаблоном и аргументами: текст строится только при показе
+ * или выгрузке (message()). Записи одного события отличаются лишь
+ * аргументами, а строки категорий и шаблонов хранятся один раз на процесс.
+ * Шаблон 0 - готовый текст сообщения в args[0] (записи текстового
+ * журнала и записи журнала на диске без известного шаблона). Записи
+ * двоичного журнала читаются шаблоном и аргументами (см. LogJournalFormat.h).
+ *
+ * Одинаковые события, идущие подряд, LogManager сворачивает в одну запись:
+ * timestamp - время первого, lastTimestamp - время последнего,
+ * repeatCount - их число.
+ */
+struct LogEntry {
+    QDateTime timestamp;                    ///< Время события
+    QDateTime lastTimestamp;                ///< Время последнего повтора (для серии одинаковых событий)
+    QStringList args;                       ///< Аргументы шаблона сообщения (%1, %2, ...)
+    QString value;                          ///< Значение (для параметров)
+    quint32 categoryId = 0;                 ///< Номер категории в LogStringTable::categories()
+    quint32 templateId = 0;                 ///< Номер шаблона в LogStringTable::templates()
+    LogLevel level = LogLevel::Info;        ///< Уровень логирования
+    LogStatus status = LogStatus::Normal;   ///< Статус события
+    int repeatCount = 1;                    ///< Число одинаковых событий подряд
+
+    /**
+     * @brief Категория события
+     */
+    QString category() const {
+        return LogStringTable::categories().at(categoryId);
+    }
+
+    /**
+     * @brief Текст сообщения (шаблон с подставленными аргументами)
+     */
+    QString message() const {
+        if (templateId == 0) {
+            return args.value(0);
+        }
+        return LogStringTable::format(LogStringTable::templates().at(templateId), args);
+    }
+
+    /**
+     * @brief Задает категорию (строка добавляется в таблицу категорий)
+     */
+    void setCategory(const QString& category) {
+        categoryId = LogStringTable::categories().intern(category);
+    }
+
+    /**
+     * @brief Задает сообщение шаблоном и аргументами
+     * @param messageTemplate Постоянный текст с местами %1, %2, ... (добавляется в таблицу шаблонов)
+     * @param arguments Аргументы по номерам мест
+     */
+    void setMessage(const QString& messageTemplate, const QStringList& arguments = QStringList()) {
+        templateId = LogStringTable::templates().intern(messageTemplate);
+        args = templateId == 0 ? QStringList() : arguments;
+    }
+
+    /**
+     * @brief Задает готовый текст сообщения
+     *
+     * Текст, совпадающий с известным шаблоном без аргументов, хранится
+     * номером шаблона; остальной текст в таблицу не попадает.
+     */
+    void setText(const QString& text) {
+        const quint32 id = LogStringTable::templates().find(text);
+        templateId = id == LogStringTable::kNotFound ? 0 : id;
+        args = id == LogStringTable::kNotFound ? QStringList{text} : QStringList();
+    }
+
+    /**
+     * @brief Запись о том же событии (для сворачивания повторов)
+     *
+     * Время и число повторов не сравниваются.
+     */
+    bool sameEvent(const LogEntry& other) const {
+        return level == other.level && status == other.status &&
+               categoryId == other.categoryId && templateId == other.templateId &&
+               args == other.args && value == other.value;
+    }
+};
+
+} // namespace ParamControl
+
+/// Запись передается в сигналах между потоками (LogSearch).
+Q_DECLARE_METATYPE(ParamControl::LogEntry)
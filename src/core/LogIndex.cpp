@@ -0,0 +1,204 @@
+// src/core/LogIndex.cpp
+#include "LogIndex.h"
+
+#include <algorithm>
+
+namespace ParamControl {
+
+// --- LogQuery ---
+
+bool LogQuery::matches(const LogEntry& entry) const {
+    const qint64 timestampMs = entry.timestamp.toMSecsSinceEpoch();
+    if (timestampMs < fromMs || timestampMs > toMs) {
+        return false;
+    }
+    if (level >= 0 && static_cast<int>(entry.level) != level) {
+        return false;
+    }
+    if (status >= 0 && static_cast<int>(entry.status) != status) {
+        return false;
+    }
+    return categories.isEmpty() || categories.contains(entry.categoryId);
+}
+
+// --- LogIndex ---
+
+void LogIndex::append(quint64 sequence, const LogEntry& entry) {
+    if (m_rows.empty()) {
+        m_firstSequence = sequence;
+    }
+
+    if (entry.categoryId >= m_byCategory.size()) {
+        m_byCategory.resize(size_t(entry.categoryId) + 1);
+    }
+
+    Row row;
+    row.timestampMs = entry.timestamp.toMSecsSinceEpoch();
+    row.timeKeyMs = m_rows.empty() ? row.timestampMs : qMax(m_rows.back().timeKeyMs, row.timestampMs);
+    row.floorMs = row.timestampMs;
+    row.category = entry.categoryId;
+    row.level = quint8(entry.level);
+    row.status = quint8(entry.status);
+
+    // Запись после перевода часов назад опускает наименьшее время предыдущих записей;
+    // при неубывающем времени цикл не выполняется ни разу
+    for (auto it = m_rows.rbegin(); it != m_rows.rend() && it->floorMs > row.timestampMs; ++it) {
+        it->floorMs = row.timestampMs;
+    }
+    m_rows.push_back(row);
+
+    m_byCategory[row.category].push_back(sequence);
+    m_byLevel[row.level].push_back(sequence);
+    m_byStatus[row.status].push_back(sequence);
+}
+
+void LogIndex::evictBefore(quint64 firstSequence) {
+    // Вытесняется начало каждого списка: номера в списках возрастают
+    while (!m_rows.empty() && m_firstSequence < firstSequence) {
+        const Row& row = m_rows.front();
+        m_byCategory[row.category].pop_front();
+        m_byLevel[row.level].pop_front();
+        m_byStatus[row.status].pop_front();
+        m_rows.pop_front();
+        ++m_firstSequence;
+    }
+}
+
+void LogIndex::clear() {
+    m_rows.clear();
+    for (Postings& postings : m_byCategory) {
+        postings.clear();
+    }
+    for (int i = 0; i < 2; ++i) {
+        m_byLevel[i].clear();
+        m_byStatus[i].clear();
+    }
+}
+
+QVector<quint64> LogIndex::query(const LogQuery& query, quint64 fromSequence) const {
+    QVector<quint64> result;
+    if (m_rows.empty() || query.fromMs > query.toMs) {
+        return result;
+    }
+
+    // Интервал времени -> интервал номеров [first, end): до first все записи раньше fromMs
+    // (наибольшее время меньше), начиная с end - позже toMs (наименьшее время больше)
+    const auto rowsBegin = m_rows.begin() + qint64(qMin<quint64>(m_rows.size(),
+        fromSequence > m_firstSequence ? fromSequence - m_firstSequence : 0));
+    const auto lower = std::lower_bound(rowsBegin, m_rows.end(), query.fromMs,
+        [](const Row& row, qint64 ms) { return row.timeKeyMs < ms; });
+    const auto upper = std::upper_bound(lower, m_rows.end(), query.toMs,
+        [](qint64 ms, const Row& row) { return ms < row.floorMs; });
+    const quint64 first = m_firstSequence + quint64(lower - m_rows.begin());
+    const quint64 end = m_firstSequence + quint64(upper - m_rows.begin());
+    if (first >= end) {
+        return result;
+    }
+
+    // Категории запроса, известные индексу
+    std::vector<quint32> categories;
+    for (quint32 category : query.categories) {
+        if (category < m_byCategory.size()) {
+            categories.push_back(category);
+        }
+    }
+    if (!query.categories.isEmpty() && categories.empty()) {
+        return result;
+    }
+    std::sort(categories.begin(), categories.end());
+    categories.erase(std::unique(categories.begin(), categories.end()), categories.end());
+
+    // Выбираем самый короткий список кандидатов
+    size_t best = size_t(end - first);
+    int driver = 0;     // 0 - все записи, 1 - категории, 2 - уровень, 3 - статус
+    if (!categories.empty()) {
+        size_t count = 0;
+        for (quint32 category : categories) {
+            count += countInRange(m_byCategory[category], first, end);
+        }
+        if (count < best) {
+            best = count;
+            driver = 1;
+        }
+    }
+    if (query.level >= 0 && query.level < 2) {
+        const size_t count = countInRange(m_byLevel[query.level], first, end);
+        if (count < best) {
+            best = count;
+            driver = 2;
+        }
+    }
+    if (query.status >= 0 && query.status < 2) {
+        const size_t count = countInRange(m_byStatus[query.status], first, end);
+        if (count < best) {
+            best = count;
+            driver = 3;
+        }
+    }
+
+    std::vector<quint64> candidates;
+    candidates.reserve(best);
+    switch (driver) {
+        case 1:
+            for (quint32 category : categories) {
+                collect(m_byCategory[category], first, end, candidates);
+            }
+            if (categories.size() > 1) {
+                std::sort(candidates.begin(), candidates.end());
+            }
+            break;
+        case 2:
+            collect(m_byLevel[query.level], first, end, candidates);
+            break;
+        case 3:
+            collect(m_byStatus[query.status], first, end, candidates);
+            break;
+        default:
+            for (quint64 sequence = first; sequence < end; ++sequence) {
+                candidates.push_back(sequence);
+            }
+            break;
+    }
+
+    // Остальные условия проверяются по признакам записи
+    result.reserve(int(candidates.size()));
+    for (quint64 sequence : candidates) {
+        const Row& row = m_rows[size_t(sequence - m_firstSequence)];
+        if (row.timestampMs < query.fromMs || row.timestampMs > query.toMs) {
+            continue;
+        }
+        if ((query.level >= 0 && row.level != query.level) ||
+            (query.status >= 0 && row.status != query.status)) {
+            continue;
+        }
+        if (!categories.empty() && driver != 1 &&
+            !std::binary_search(categories.begin(), categories.end(), row.category)) {
+            continue;
+        }
+        result.append(sequence);
+    }
+    return result;
+}
+
+QStringList LogIndex::categories() const {
+    QStringList result;
+    for (size_t i = 0; i < m_byCategory.size(); ++i) {
+        if (!m_byCategory[i].empty()) {
+            result.append(LogStringTable::categories().at(quint32(i)));
+        }
+    }
+    return result;
+}
+
+void LogIndex::collect(const Postings& postings, quint64 first, quint64 end, std::vector<quint64>& out) {
+    const auto begin = std::lower_bound(postings.begin(), postings.end(), first);
+    const auto stop = std::lower_bound(begin, postings.end(), end);
+    out.insert(out.end(), begin, stop);
+}
+
+size_t LogIndex::countInRange(const Postings& postings, quint64 first, quint64 end) {
+    const auto begin = std::lower_bound(postings.begin(), postings.end(), first);
+    return size_t(std::lower_bound(begin, postings.end(), end) - begin);
+}
+
+} // namespace ParamControl
@@ -0,0 +1,121 @@
+// src/core/LogIndex.h
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include "LogBuffer.h"
+#include "LogEntry.h"
+
+namespace ParamControl {
+
+/**
+ * @brief Условия запроса к журналу (все заданные условия должны выполняться).
+ */
+struct LogQuery {
+    qint64 fromMs = std::numeric_limits<qint64>::min(); ///< Начало интервала времени (мс от эпохи)
+    qint64 toMs = std::numeric_limits<qint64>::max();   ///< Конец интервала (включительно)
+    QVector<quint32> categories; ///< Номера категорий или имен параметров (любая из); пусто - все
+    int level = -1;             ///< Уровень (LogLevel); -1 - любой
+    int status = -1;            ///< Статус (LogStatus); -1 - любой
+
+    /**
+     * @brief Запись удовлетворяет условиям.
+     */
+    bool matches(const LogEntry& entry) const;
+};
+
+/**
+ * @brief Результат запроса: снимок журнала и строки в нем.
+ */
+struct LogQueryResult {
+    LogSnapshot snapshot;       ///< Снимок, в котором разрешаются строки
+    QVector<quint64> rows;      ///< Порядковые номера записей от старых к новым
+};
+
+/**
+ * @brief Индекс записей журнала в памяти для запросов с фильтрами.
+ *
+ * Для каждой категории, уровня и статуса индекс хранит список порядковых
+ * номеров записей (posting list), а для каждой записи - ее признаки
+ * (номер категории из LogStringTable, уровень, статус, время). Запрос выбирает самый короткий
+ * из списков по заданным условиям, сужает его двоичным поиском до интервала
+ * времени и проверяет остальные условия сравнением целых чисел, не трогая
+ * сами записи. Стоимость запроса определяется числом подходящих записей,
+ * а не размером журнала.
+ *
+ * Записи добавляются в порядке времени, но часы могут переводить назад.
+ * Поэтому начало интервала номеров ищется по наибольшему времени до записи,
+ * а конец - по наименьшему времени от записи до конца журнала. Обе величины
+ * не убывают, и в интервал попадают все записи с подходящим собственным временем.
+ *
+ * Класс не потокобезопасен: LogManager вызывает его под своим мьютексом
+ * вместе с LogBuffer, порядковые номера у них общие.
+ */
+class LogIndex {
+public:
+    /**
+     * @brief Добавляет запись.
+     * @param sequence Порядковый номер (следующий за последней записью индекса).
+     */
+    void append(quint64 sequence, const LogEntry& entry);
+
+    /**
+     * @brief Удаляет записи с номерами меньше firstSequence (вытесненные из буфера).
+     */
+    void evictBefore(quint64 firstSequence);
+
+    /**
+     * @brief Удаляет все записи.
+     */
+    void clear();
+
+    /**
+     * @brief Порядковые номера записей, удовлетворяющих запросу, от старых к новым.
+     * @param fromSequence Рассматривать записи начиная с этого номера.
+     */
+    QVector<quint64> query(const LogQuery& query, quint64 fromSequence = 0) const;
+
+    /**
+     * @brief Категории, по которым есть записи.
+     */
+    QStringList categories() const;
+
+private:
+    /**
+     * @brief Признаки записи, по которым проверяются условия
+     */
+    struct Row {
+        qint64 timestampMs;     ///< Время записи
+        qint64 timeKeyMs;       ///< Наибольшее время до записи включительно (не убывает)
+        qint64 floorMs;         ///< Наименьшее время от записи до последней включительно (не убывает)
+        quint32 category;       ///< Номер категории
+        quint8 level;           ///< Уровень
+        quint8 status;          ///< Статус
+    };
+
+    using Postings = std::deque<quint64>;
+
+    std::deque<Row> m_rows;                     ///< Признаки записей по порядку номеров
+    quint64 m_firstSequence = 0;                ///< Номер первой записи m_rows
+    std::vector<Postings> m_byCategory;         ///< Записи по номеру категории (LogStringTable)
+    Postings m_byLevel[2];                      ///< Записи по уровню
+    Postings m_byStatus[2];                     ///< Записи по статусу
+
+    /**
+     * @brief Номера записей списка в диапазоне [first, end)
+     */
+    static void collect(const Postings& postings, quint64 first, quint64 end, std::vector<quint64>& out);
+
+    /**
+     * @brief Число записей списка в диапазоне [first, end)
+     */
+    static size_t countInRange(const Postings& postings, quint64 first, quint64 end);
+};
+
+} // namespace ParamControl
@@ -0,0 +1,160 @@
+// src/core/LogJournalCursor.cpp
+#include "LogJournalCursor.h"
+
+#include <QDebug>
+
+#include <limits>
+
+namespace ParamControl {
+
+namespace {
+
+/// Число распакованных сегментов .qz, которые держит курсор.
+constexpr size_t kInflatedSegments = 2;
+
+} // namespace
+
+LogJournalCursor::LogJournalCursor(const QString& logFilePath, quint64 skip)
+    : m_reader(logFilePath)
+    , m_paths(logFilePath.isEmpty() ? QStringList() : m_reader.segmentFiles())
+{
+    m_segments.resize(size_t(m_paths.size()));
+    m_failed.resize(size_t(m_paths.size()), false);
+    for (const QString& path : m_paths) {
+        const QDateTime closedAt = LogJournalReader::segmentClosedAt(logFilePath, path);
+        m_closedAtMs.append(closedAt.isValid() ? closedAt.toMSecsSinceEpoch()
+                                               : std::numeric_limits<qint64>::max());
+    }
+
+    // Самые новые записи есть в памяти: начинаем перед ними
+    m_segment = m_paths.size() - 1;
+    quint64 skipped = 0;
+    while (skipped < skip && stepBack(std::numeric_limits<qint64>::min())) {
+        ++skipped;
+    }
+}
+
+bool LogJournalCursor::atStart() const {
+    return m_segment < 0;
+}
+
+QVector<LogJournalPosition> LogJournalCursor::previous(const LogQuery& query, int count) {
+    QVector<LogJournalPosition> rows;
+    if (query.fromMs > query.toMs) {
+        m_segment = -1;
+        return rows;
+    }
+
+    // Категории запроса -> номера справочника
+    std::vector<bool> allowed;
+    if (!query.categories.isEmpty()) {
+        const int categories = m_reader.categories().size();
+        allowed.resize(size_t(categories), false);
+        bool any = false;
+        for (int i = 0; i < categories; ++i) {
+            allowed[size_t(i)] = query.categories.contains(m_reader.categoryId(quint32(i)));
+            any = any || allowed[size_t(i)];
+        }
+        if (!any) {
+            m_segment = -1;
+            return rows;
+        }
+    }
+
+    while (rows.size() < count && stepBack(query.fromMs)) {
+        const uchar* payload = m_segments[size_t(m_segment)].data + m_position + 4;
+        const qint64 timestampMs = archiveGet<qint64>(payload);
+        const quint32 category = archiveGet<quint32>(payload + 8);
+        if (timestampMs < query.fromMs || timestampMs > query.toMs ||
+            (query.level >= 0 && payload[12] != query.level) ||
+            (query.status >= 0 && payload[13] != query.status) ||
+            (!allowed.empty() && (category >= allowed.size() || !allowed[category]))) {
+            continue;
+        }
+
+        LogJournalPosition position;
+        position.segment = m_segment;
+        position.offset = m_position;
+        rows.append(position);
+    }
+    return rows;
+}
+
+LogEntry LogJournalCursor::entryAt(const LogJournalPosition& position) {
+    if (position.segment < 0 || position.segment >= m_paths.size() || !loadSegment(position.segment)) {
+        return LogEntry();
+    }
+
+    const LogJournalReader::SegmentData& segment = m_segments[size_t(position.segment)];
+    const qint64 bytes = logJournalRecordAt(segment.data, segment.size, position.offset);
+    LogJournalEvent event;
+    if (bytes < 0 || !logJournalReadEvent(segment.data + position.offset + 4, quint32(bytes), event)) {
+        return LogEntry();
+    }
+    return m_reader.toEntry(event);
+}
+
+bool LogJournalCursor::stepBack(qint64 notBeforeMs) {
+    while (m_segment >= 0) {
+        // Все записи закрытого сегмента не позже времени его закрытия
+        if (m_closedAtMs[m_segment] < notBeforeMs || !loadSegment(m_segment)) {
+            --m_segment;
+            m_position = -1;
+            m_superseded = false;
+            continue;
+        }
+
+        const LogJournalReader::SegmentData& segment = m_segments[size_t(m_segment)];
+        if (m_position < 0) {
+            m_position = segment.size;
+        }
+        if (m_position > kLogJournalHeaderBytes) {
+            const quint32 bytes = archiveGet<quint32>(segment.data + m_position - 4);
+            const qint64 start = m_position - kLogJournalFrameBytes - qint64(bytes);
+            if (start >= kLogJournalHeaderBytes &&
+                logJournalRecordAt(segment.data, segment.size, start) == qint64(bytes)) {
+                m_position = start;
+
+                // Запись, замененная следующей за ней записью серии повторов, пропускается
+                const bool superseded = m_superseded;
+                m_superseded = logJournalSupersedes(segment.data + start + 4);
+                if (superseded) {
+                    continue;
+                }
+                return true;
+            }
+            qWarning() << "Поврежденная запись журнала:" << m_paths[m_segment] << m_position;
+        }
+
+        --m_segment;
+        m_position = -1;
+        m_superseded = false;
+    }
+    return false;
+}
+
+bool LogJournalCursor::loadSegment(int segment) {
+    LogJournalReader::SegmentData& data = m_segments[size_t(segment)];
+    if (data.data) {
+        return true;
+    }
+    if (m_failed[size_t(segment)]) {
+        return false;
+    }
+    if (!m_reader.loadSegment(m_paths[segment], data)) {
+        m_failed[size_t(segment)] = true;
+        return false;
+    }
+
+    // Несжатые сегменты только отображены; распакованные занимают память
+    if (!data.bytes.isEmpty()) {
+        m_inflated.push_back(segment);
+        while (m_inflated.size() > kInflatedSegments) {
+            m_segments[size_t(m_inflated.front())] = LogJournalReader::SegmentData();
+            m_inflated.pop_front();
+        }
+    }
+    return true;
+}
+
+} // namespace ParamControl
@@ -0,0 +1,96 @@
+// src/core/LogJournalCursor.h
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <deque>
+#include <vector>
+
+#include "LogEntry.h"
+#include "LogIndex.h"
+#include "LogJournalReader.h"
+
+namespace ParamControl {
+
+/**
+ * @brief Положение записи в журнале на диске.
+ */
+struct LogJournalPosition {
+    int segment = 0;        ///< Номер сегмента в списке курсора
+    qint64 offset = 0;      ///< Смещение записи в сегменте
+};
+
+/**
+ * @brief Постраничное чтение журнала на диске от новых записей к старым.
+ *
+ * Курсор запоминает список сегментов при создании и идет назад по длинам
+ * в конце записей (см. LogJournalFormat.h), проверяя условия запроса
+ * по постоянной части записи: время, категория, уровень и статус
+ * сравниваются без разбора строк. previous() возвращает только положения
+ * записей, а сами записи строятся entryAt() по требованию, поэтому страница
+ * истории стоит одинаково при любой длине журнала.
+ *
+ * Несжатые сегменты отображаются в память и остаются отображенными:
+ * положения в текущем сегменте действуют и после его закрытия
+ * переименованием. Из сжатых (.qz) распакованными держатся только
+ * последние использованные, остальные распаковываются снова при обращении.
+ *
+ * Курсор создается LogManager::journalBefore(), который согласует начало
+ * курсора с записями в памяти.
+ */
+class LogJournalCursor {
+public:
+    /**
+     * @brief Конструктор.
+     * @param logFilePath Путь к журналу, как он передается LogManager.
+     * @param skip Число самых новых записей журнала, которые пропускаются
+     *        (они есть в памяти).
+     */
+    LogJournalCursor(const QString& logFilePath, quint64 skip);
+
+    /**
+     * @brief Более старых записей нет.
+     */
+    bool atStart() const;
+
+    /**
+     * @brief Следующая порция более старых записей, подходящих под запрос.
+     * @param query Условия отбора (поиск останавливается на сегментах,
+     *        закрытых раньше начала интервала времени).
+     * @param count Наибольшее число записей.
+     * @return Положения записей от новых к старым.
+     */
+    QVector<LogJournalPosition> previous(const LogQuery& query, int count);
+
+    /**
+     * @brief Запись по положению (пустая запись, если сегмент уже не читается).
+     */
+    LogEntry entryAt(const LogJournalPosition& position);
+
+private:
+    LogJournalReader m_reader;                              ///< Справочник категорий и чтение сегментов
+    QStringList m_paths;                                    ///< Сегменты от старых к новым
+    QVector<qint64> m_closedAtMs;                           ///< Время закрытия сегментов (текущий - max)
+    std::vector<LogJournalReader::SegmentData> m_segments;  ///< Загруженные сегменты
+    std::vector<bool> m_failed;                             ///< Сегмент не удалось прочитать
+    std::deque<int> m_inflated;                             ///< Распакованные сегменты .qz, от старых к новым
+    int m_segment = -1;                                     ///< Сегмент курсора (-1 - начало журнала)
+    qint64 m_position = -1;                                 ///< Начало последней пройденной записи (-1 - конец сегмента)
+    bool m_superseded = false;                              ///< Предыдущая запись заменена пройденной (серия повторов)
+
+    /**
+     * @brief Переходит к предыдущей записи журнала.
+     * @param notBeforeMs Сегменты, закрытые раньше этого времени, не просматриваются.
+     * @return false, если более старых записей нет.
+     */
+    bool stepBack(qint64 notBeforeMs);
+
+    /**
+     * @brief Загружает сегмент (распакованные .qz сверх двух освобождаются).
+     */
+    bool loadSegment(int segment);
+};
+
+} // namespace ParamControl
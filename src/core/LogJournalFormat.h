@@ -0,0 +1,316 @@
+// src/core/LogJournalFormat.h
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include "LogEntry.h"
+#include "BinaryFormat.h"
+
+/**
+ * @file LogJournalFormat.h
+ * @brief Формат двоичного журнала событий на диске (общий для записи и чтения).
+ *
+ * Журнал с путем <каталог>/<имя>.<расширение> (например, LOG_main.txt)
+ * хранится в файлах:
+ *
+ * - <имя>.categories - справочник категорий, только дописывается.
+ *   Запись: u16 длина + UTF-8; номер категории - порядковый номер записи.
+ *   Справочник общий для всех сегментов журнала.
+ *
+ * - <имя>.templates - справочник шаблонов сообщений в том же формате.
+ *
+ * - <имя>.journal - текущий сегмент: заголовок и следующие за ним записи.
+ *   Закрытые сегменты называются <имя>_ГГГГММДД-ччммссззз.journal и после
+ *   сжатия - <то же>.qz (формат qCompress).
+ *
+ * Запись сегмента: u32 длина данных, данные, та же u32 длина. Длина в конце
+ * позволяет идти по записям от конца файла, не читая его начало. Запись,
+ * оборванная при аварии, распознается по несовпадению длин и отбрасывается.
+ *
+ * Данные записи события: timestampMs i64 (мс от эпохи UTC), categoryId u32,
+ * level u8, status u8, flags u16, u32 длина + UTF-8 сообщения,
+ * u32 длина + UTF-8 значения; у серии повторов за ними следуют
+ * lastTimestampMs i64 и repeatCount u32.
+ *
+ * Сообщение пишется готовым текстом (шаблон с подставленными аргументами,
+ * см. LogEntry), поэтому поиск по журналу (LogSearch) ищет подстроку прямо
+ * в байтах сегмента. У сообщения, заданного шаблоном, в конце данных
+ * (флаг kLogJournalTemplated) следуют номер шаблона в справочнике u32,
+ * число аргументов u8, для каждого аргумента начало u32 и длина u32
+ * в символах QString сообщения (0xFFFFFFFF - аргумента нет в тексте)
+ * и длина всего этого блока u16. По ним запись, прочитанная с диска,
+ * снова хранится шаблоном и аргументами.
+ *
+ * Серия одинаковых событий пишется, когда она заканчивается, а первое
+ * событие серии уже записано отдельной записью. Поэтому запись серии
+ * с флагом kLogJournalSupersedes заменяет предыдущую запись того же
+ * сегмента: читатели пропускают замененную запись.
+ *
+ * Текстовый формат "Дата Время | Уровень | Категория | Сообщение | Значение
+ * | Статус" строится по журналу по запросу (LogJournalReader::exportText()).
+ *
+ * Все числа - little-endian, структуры без выравнивания.
+ */
+
+namespace ParamControl {
+
+/// Сигнатура заголовка сегмента журнала.
+constexpr quint32 kLogJournalMagic = 0x4A4C4350;        // "PCLJ"
+/// Версия формата.
+constexpr quint16 kLogJournalVersion = 3;     // 2: флаги и серии повторов; 3: шаблоны сообщений
+/// Самая старая версия, которую читает текущий код (флаги версии 1 - нулевое резервное поле).
+constexpr quint16 kLogJournalMinVersion = 1;
+
+/// Размер заголовка сегмента: magic u32, version u16, headerBytes u16, startMs i64.
+constexpr int kLogJournalHeaderBytes = 16;
+/// Длина в начале и в конце записи.
+constexpr int kLogJournalFrameBytes = 8;
+/// Размер неизменной части данных события (до длины сообщения включительно).
+constexpr int kLogJournalEventFixedBytes = 20;
+/// Размер сведений о серии повторов в конце данных события.
+constexpr int kLogJournalRepeatBytes = 12;
+/// Флаг события: запись заменяет предыдущую запись сегмента.
+constexpr quint16 kLogJournalSupersedes = 0x0001;
+/// Флаг события: в конце данных - шаблон сообщения и положения аргументов.
+constexpr quint16 kLogJournalTemplated = 0x0002;
+/// Размер блока шаблона без аргументов: номер u32, число аргументов u8, длина блока u16.
+constexpr int kLogJournalTemplateBytes = 7;
+/// Наибольшее число аргументов шаблона в записи.
+constexpr int kLogJournalMaxArgs = 255;
+
+/// Расширение сегмента журнала.
+constexpr char kLogJournalSuffix[] = "journal";
+/// Расширение справочника категорий.
+constexpr char kLogCategoriesSuffix[] = "categories";
+/// Расширение справочника шаблонов сообщений.
+constexpr char kLogTemplatesSuffix[] = "templates";
+/// Расширение сжатого сегмента (добавляется к имени закрытого сегмента).
+constexpr char kLogCompressedSuffix[] = ".qz";
+/// Время закрытия сегмента в имени файла.
+constexpr char kLogSegmentTimeFormat[] = "yyyyMMdd-hhmmsszzz";
+
+/**
+ * @brief Заголовок сегмента журнала
+ */
+inline QByteArray logJournalHeader(qint64 startMs) {
+    QByteArray header;
+    archivePut<quint32>(header, kLogJournalMagic);
+    archivePut<quint16>(header, kLogJournalVersion);
+    archivePut<quint16>(header, kLogJournalHeaderBytes);
+    archivePut<qint64>(header, startMs);
+    return header;
+}
+
+/**
+ * @brief Проверяет заголовок сегмента и возвращает время его начала
+ *
+ * Версии с kLogJournalMinVersion по kLogJournalVersion читаются одинаково:
+ * более старые записи просто не имеют новых флагов. Более новая версия
+ * означает незнакомое расположение записей, и такой сегмент не читается.
+ * @return false, если это не сегмент журнала или его версия не поддерживается
+ */
+inline bool logJournalReadHeader(const uchar* data, qint64 size, qint64& startMs) {
+    if (size < kLogJournalHeaderBytes || archiveGet<quint32>(data) != kLogJournalMagic) {
+        return false;
+    }
+    const quint16 version = archiveGet<quint16>(data + 4);
+    if (version < kLogJournalMinVersion || version > kLogJournalVersion ||
+        archiveGet<quint16>(data + 6) != kLogJournalHeaderBytes) {
+        return false;
+    }
+    startMs = archiveGet<qint64>(data + 8);
+    return true;
+}
+
+/**
+ * @brief Дописывает запись события
+ * @param templateId Номер шаблона сообщения в справочнике (если entry.templateId != 0)
+ * @param supersedes Запись заменяет предыдущую запись сегмента (серия повторов)
+ */
+inline void logJournalPutEvent(QByteArray& out, const LogEntry& entry, quint32 categoryId,
+                               quint32 templateId, bool supersedes = false) {
+    const bool templated = entry.templateId != 0;
+    const int argCount = templated ? qMin(entry.args.size(), kLogJournalMaxArgs) : 0;
+    QVector<int> argSpans;
+    const QByteArray message = (templated
+        ? LogStringTable::format(LogStringTable::templates().at(entry.templateId), entry.args, &argSpans)
+        : entry.message()).toUtf8();
+    const QByteArray value = entry.value.toUtf8();
+    const bool repeated = entry.repeatCount > 1;
+    const int templateBytes = templated ? kLogJournalTemplateBytes + 8 * argCount : 0;
+    const quint32 bytes = quint32(kLogJournalEventFixedBytes + message.size() + 4 + value.size() +
+                                  (repeated ? kLogJournalRepeatBytes : 0) + templateBytes);
+
+    quint16 flags = supersedes ? kLogJournalSupersedes : 0;
+    if (templated) {
+        flags |= kLogJournalTemplated;
+    }
+    archivePut<quint32>(out, bytes);
+    archivePut<qint64>(out, entry.timestamp.toMSecsSinceEpoch());
+    archivePut<quint32>(out, categoryId);
+    out.append(char(entry.level));
+    out.append(char(entry.status));
+    archivePut<quint16>(out, flags);
+    archivePut<quint32>(out, quint32(message.size()));
+    out.append(message);
+    archivePut<quint32>(out, quint32(value.size()));
+    out.append(value);
+    if (repeated) {
+        archivePut<qint64>(out, entry.lastTimestamp.toMSecsSinceEpoch());
+        archivePut<quint32>(out, quint32(entry.repeatCount));
+    }
+    if (templated) {
+        archivePut<quint32>(out, templateId);
+        out.append(char(argCount));
+        for (int i = 0; i < argCount; ++i) {
+            archivePut<quint32>(out, quint32(argSpans[2 * i]));
+            archivePut<quint32>(out, quint32(argSpans[2 * i + 1]));
+        }
+        archivePut<quint16>(out, quint16(templateBytes));
+    }
+    archivePut<quint32>(out, bytes);
+}
+
+/**
+ * @brief Событие в записи журнала (строки указывают в данные записи)
+ */
+struct LogJournalEvent {
+    qint64 timestampMs = 0;                 ///< Время события (мс от эпохи UTC)
+    quint32 categoryId = 0;                 ///< Номер категории в справочнике
+    LogLevel level = LogLevel::Info;        ///< Уровень
+    LogStatus status = LogStatus::Normal;   ///< Статус
+    const char* message = nullptr;          ///< UTF-8 сообщения
+    int messageBytes = 0;                   ///< Длина сообщения
+    const char* value = nullptr;            ///< UTF-8 значения
+    int valueBytes = 0;                     ///< Длина значения
+    qint64 lastTimestampMs = 0;             ///< Время последнего повтора (у серии)
+    quint32 repeatCount = 1;                ///< Число событий в серии
+    bool supersedes = false;                ///< Запись заменяет предыдущую запись сегмента
+    bool templated = false;                 ///< Сообщение задано шаблоном
+    quint32 templateId = 0;                 ///< Номер шаблона в справочнике
+    int argCount = 0;                       ///< Число аргументов шаблона
+    const uchar* argSpans = nullptr;        ///< Пары (начало u32, длина u32) аргументов в сообщении
+};
+
+/**
+ * @brief Разбирает данные записи события
+ * @param payload Данные записи (после начальной длины)
+ * @param bytes Длина данных
+ * @return false, если данные повреждены
+ */
+inline bool logJournalReadEvent(const uchar* payload, quint32 bytes, LogJournalEvent& event) {
+    if (bytes < quint32(kLogJournalEventFixedBytes + 4)) {
+        return false;
+    }
+
+    // Блок шаблона в конце данных: дальше разбираются данные без него
+    event.templated = (archiveGet<quint16>(payload + 14) & kLogJournalTemplated) != 0;
+    if (event.templated) {
+        if (bytes < quint32(kLogJournalEventFixedBytes + 4 + kLogJournalTemplateBytes)) {
+            return false;
+        }
+        const quint32 templateBytes = archiveGet<quint16>(payload + bytes - 2);
+        if (templateBytes < quint32(kLogJournalTemplateBytes) ||
+            templateBytes > bytes - kLogJournalEventFixedBytes - 4) {
+            return false;
+        }
+        const uchar* block = payload + bytes - templateBytes;
+        if (templateBytes != quint32(kLogJournalTemplateBytes + 8 * block[4])) {
+            return false;
+        }
+        event.templateId = archiveGet<quint32>(block);
+        event.argCount = block[4];
+        event.argSpans = block + 5;
+        bytes -= templateBytes;
+    } else {
+        event.templateId = 0;
+        event.argCount = 0;
+        event.argSpans = nullptr;
+    }
+
+    const quint32 messageBytes = archiveGet<quint32>(payload + 16);
+    if (messageBytes > bytes - kLogJournalEventFixedBytes - 4) {
+        return false;
+    }
+    const quint32 valueOffset = kLogJournalEventFixedBytes + messageBytes;
+    const quint32 valueBytes = archiveGet<quint32>(payload + valueOffset);
+    const quint32 rest = bytes - valueOffset - 4;
+    const bool repeated = rest >= quint32(kLogJournalRepeatBytes) && valueBytes == rest - kLogJournalRepeatBytes;
+    if (valueBytes != rest && !repeated) {
+        return false;
+    }
+
+    event.timestampMs = archiveGet<qint64>(payload);
+    event.categoryId = archiveGet<quint32>(payload + 8);
+    event.level = payload[12] == quint8(LogLevel::Error) ? LogLevel::Error : LogLevel::Info;
+    event.status = payload[13] == quint8(LogStatus::Error) ? LogStatus::Error : LogStatus::Normal;
+    event.message = reinterpret_cast<const char*>(payload + kLogJournalEventFixedBytes);
+    event.messageBytes = int(messageBytes);
+    event.value = reinterpret_cast<const char*>(payload + valueOffset + 4);
+    event.valueBytes = int(valueBytes);
+    event.supersedes = (archiveGet<quint16>(payload + 14) & kLogJournalSupersedes) != 0;
+    if (repeated) {
+        event.lastTimestampMs = archiveGet<qint64>(payload + valueOffset + 4 + valueBytes);
+        event.repeatCount = archiveGet<quint32>(payload + valueOffset + 4 + valueBytes + 8);
+    } else {
+        event.lastTimestampMs = event.timestampMs;
+        event.repeatCount = 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Запись заменяет предыдущую запись сегмента (читается только флаг)
+ * @param payload Данные записи (после начальной длины)
+ */
+inline bool logJournalSupersedes(const uchar* payload) {
+    return (archiveGet<quint16>(payload + 14) & kLogJournalSupersedes) != 0;
+}
+
+/**
+ * @brief Проверяет, что в позиции position начинается целая запись
+ * @return Длина данных записи или -1
+ */
+inline qint64 logJournalRecordAt(const uchar* data, qint64 size, qint64 position) {
+    if (position + kLogJournalFrameBytes > size) {
+        return -1;
+    }
+    const quint32 bytes = archiveGet<quint32>(data + position);
+    if (position + kLogJournalFrameBytes + qint64(bytes) > size ||
+        archiveGet<quint32>(data + position + 4 + bytes) != bytes) {
+        return -1;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Конец последней целой записи сегмента (оборванная запись в конце отбрасывается)
+ */
+inline qint64 logJournalValidEnd(const uchar* data, qint64 size) {
+    if (size < kLogJournalHeaderBytes) {
+        return 0;
+    }
+
+    // Обычно последняя запись целая - проверяем ее по длине в конце файла
+    if (size == kLogJournalHeaderBytes) {
+        return size;
+    }
+    if (size >= kLogJournalHeaderBytes + kLogJournalFrameBytes) {
+        const quint32 bytes = archiveGet<quint32>(data + size - 4);
+        const qint64 start = size - kLogJournalFrameBytes - qint64(bytes);
+        if (start >= kLogJournalHeaderBytes && logJournalRecordAt(data, size, start) == bytes) {
+            return size;
+        }
+    }
+
+    // Иначе ищем конец целых записей с начала
+    qint64 position = kLogJournalHeaderBytes;
+    for (qint64 bytes; (bytes = logJournalRecordAt(data, size, position)) >= 0;) {
+        position += kLogJournalFrameBytes + bytes;
+    }
+    return position;
+}
+
+} // namespace ParamControl
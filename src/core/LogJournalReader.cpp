@@ -0,0 +1,307 @@
+// src/core/LogJournalReader.cpp
+#include "LogJournalReader.h"
+
+#include <QDir>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ParamControl {
+
+LogJournalReader::LogJournalReader(const QString& logFilePath)
+    : m_logFilePath(logFilePath)
+    , m_categories(readDictionary(categoriesPath(logFilePath)))
+{
+    m_categoryIds.reserve(m_categories.size());
+    for (const QString& category : m_categories) {
+        m_categoryIds.append(LogStringTable::categories().intern(category));
+    }
+
+    // Шаблоны известны до первой записи: прочитанные записи хранятся шаблонами
+    const QStringList templates = readDictionary(templatesPath(logFilePath));
+    m_templateIds.reserve(templates.size());
+    for (const QString& messageTemplate : templates) {
+        m_templateIds.append(LogStringTable::templates().intern(messageTemplate));
+    }
+}
+
+QString LogJournalReader::logFilePath() const {
+    return m_logFilePath;
+}
+
+QStringList LogJournalReader::segmentFiles() const {
+    const QFileInfo journal(journalPath(m_logFilePath));
+    const QString pattern = segmentPattern(m_logFilePath);
+
+    // Несжатый и сжатый сегмент с одним временем закрытия идут подряд: сжатие еще не закончено
+    QStringList files;
+    for (const QFileInfo& segment : journal.absoluteDir().entryInfoList(
+             {pattern, pattern + kLogCompressedSuffix}, QDir::Files, QDir::Name)) {
+        const QString path = segment.absoluteFilePath();
+        if (!files.isEmpty() && path == files.last() + kLogCompressedSuffix) {
+            continue;
+        }
+        files.append(path);
+    }
+    if (journal.exists()) {
+        files.append(journal.absoluteFilePath());
+    }
+    return files;
+}
+
+QString LogJournalReader::category(quint32 id) const {
+    return id < quint32(m_categories.size()) ? m_categories[int(id)] : QString("#%1").arg(id);
+}
+
+QStringList LogJournalReader::categories() const {
+    return m_categories;
+}
+
+quint32 LogJournalReader::categoryId(quint32 id) const {
+    return id < quint32(m_categoryIds.size()) ? m_categoryIds[int(id)]
+                                              : LogStringTable::categories().intern(category(id));
+}
+
+quint32 LogJournalReader::templateId(quint32 id) const {
+    return id < quint32(m_templateIds.size()) ? m_templateIds[int(id)] : 0;
+}
+
+QVector<LogEntry> LogJournalReader::tail(int count) const {
+    SegmentData segment;
+    if (count <= 0 || !loadSegment(journalPath(m_logFilePath), segment)) {
+        return {};
+    }
+
+    // Идем от конца по длинам в конце записей: читаются только последние count записей
+    QVector<LogEntry> entries;
+    qint64 position = segment.size;
+    bool superseded = false;
+    while (position > kLogJournalHeaderBytes && entries.size() < count) {
+        const quint32 bytes = archiveGet<quint32>(segment.data + position - 4);
+        const qint64 start = position - kLogJournalFrameBytes - qint64(bytes);
+        LogJournalEvent event;
+        if (start < kLogJournalHeaderBytes ||
+            !logJournalReadEvent(segment.data + start + 4, bytes, event)) {
+            break;
+        }
+        // Запись, замененная следующей за ней записью серии повторов, пропускается
+        if (!superseded) {
+            entries.append(toEntry(event));
+        }
+        superseded = event.supersedes;
+        position = start;
+    }
+
+    std::reverse(entries.begin(), entries.end());
+    return entries;
+}
+
+bool LogJournalReader::readSegment(const QString& segmentPath, const Visitor& visitor) const {
+    SegmentData segment;
+    if (!loadSegment(segmentPath, segment)) {
+        return false;
+    }
+
+    // Запись отдается, когда известно, что следующая запись ее не заменяет
+    LogJournalEvent pending;
+    bool hasPending = false;
+    qint64 position = kLogJournalHeaderBytes;
+    while (position < segment.size) {
+        const quint32 bytes = archiveGet<quint32>(segment.data + position);
+        LogJournalEvent event;
+        if (!logJournalReadEvent(segment.data + position + 4, bytes, event)) {
+            if (hasPending) {
+                visitor(toEntry(pending));
+            }
+            return false;
+        }
+        if (hasPending && !event.supersedes && !visitor(toEntry(pending))) {
+            return true;
+        }
+        pending = event;
+        hasPending = true;
+        position += kLogJournalFrameBytes + bytes;
+    }
+    if (hasPending) {
+        visitor(toEntry(pending));
+    }
+    return true;
+}
+
+qint64 LogJournalReader::exportText(QIODevice& device, qint64 fromMs, qint64 toMs) const {
+    qint64 exported = 0;
+    QByteArray buffer = textHeader().toUtf8();
+
+    for (const QString& segmentPath : segmentFiles()) {
+        // Все записи закрытого сегмента не позже времени его закрытия
+        const QDateTime closedAt = segmentClosedAt(m_logFilePath, segmentPath);
+        if (closedAt.isValid() && closedAt.toMSecsSinceEpoch() < fromMs) {
+            continue;
+        }
+
+        readSegment(segmentPath, [&](const LogEntry& entry) {
+            const qint64 timestampMs = entry.timestamp.toMSecsSinceEpoch();
+            if (timestampMs >= fromMs && timestampMs <= toMs) {
+                buffer += formatText(entry).toUtf8();
+                buffer += '\n';
+                ++exported;
+                if (buffer.size() >= 1024 * 1024) {
+                    device.write(buffer);
+                    buffer.clear();
+                }
+            }
+            return true;
+        });
+    }
+
+    device.write(buffer);
+    return exported;
+}
+
+QString LogJournalReader::journalPath(const QString& logFilePath) {
+    const QFileInfo logFile(logFilePath);
+    return logFile.absoluteDir().filePath(QString("%1.%2").arg(logFile.completeBaseName(), kLogJournalSuffix));
+}
+
+QString LogJournalReader::categoriesPath(const QString& logFilePath) {
+    const QFileInfo logFile(logFilePath);
+    return logFile.absoluteDir().filePath(QString("%1.%2").arg(logFile.completeBaseName(), kLogCategoriesSuffix));
+}
+
+QString LogJournalReader::templatesPath(const QString& logFilePath) {
+    const QFileInfo logFile(logFilePath);
+    return logFile.absoluteDir().filePath(QString("%1.%2").arg(logFile.completeBaseName(), kLogTemplatesSuffix));
+}
+
+QString LogJournalReader::segmentPattern(const QString& logFilePath) {
+    return QString("%1_*.%2").arg(QFileInfo(logFilePath).completeBaseName(), kLogJournalSuffix);
+}
+
+QString LogJournalReader::closedSegmentPath(const QString& logFilePath, const QDateTime& closedAt) {
+    const QFileInfo logFile(logFilePath);
+    return logFile.absoluteDir().filePath(QString("%1_%2.%3").arg(
+        logFile.completeBaseName(), closedAt.toString(kLogSegmentTimeFormat), kLogJournalSuffix));
+}
+
+QDateTime LogJournalReader::segmentClosedAt(const QString& logFilePath, const QString& segmentPath) {
+    const QString name = QFileInfo(segmentPath).fileName();
+    const QString prefix = QFileInfo(logFilePath).completeBaseName() + "_";
+    if (!name.startsWith(prefix)) {
+        return QDateTime();
+    }
+    return QDateTime::fromString(name.mid(prefix.size(), int(std::strlen(kLogSegmentTimeFormat))),
+                                 kLogSegmentTimeFormat);
+}
+
+QStringList LogJournalReader::readDictionary(const QString& dictionaryPath) {
+    QStringList strings;
+    QFile file(dictionaryPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return strings;
+    }
+
+    const QByteArray data = file.readAll();
+    const uchar* bytes = reinterpret_cast<const uchar*>(data.constData());
+    int position = 0;
+    while (position + 2 <= data.size()) {
+        const int length = archiveGet<quint16>(bytes + position);
+        if (position + 2 + length > data.size()) {
+            break;
+        }
+        strings.append(QString::fromUtf8(data.constData() + position + 2, length));
+        position += 2 + length;
+    }
+    return strings;
+}
+
+QString LogJournalReader::formatText(const LogEntry& entry) {
+    QString levelStr = entry.level == LogLevel::Info ? "INFO" : "ERROR";
+    QString statusStr = entry.status == LogStatus::Normal ? "Normal" : "Error";
+
+    // Серия повторов: число и время последнего события - в сообщении
+    QString message = entry.message();
+    if (entry.repeatCount > 1) {
+        message += QString(" (повторов: %1, последний %2)")
+                       .arg(entry.repeatCount)
+                       .arg(entry.lastTimestamp.toString("yyyy-MM-dd hh:mm:ss"));
+    }
+
+    return QString("%1 | %2 | %3 | %4 | %5 | %6")
+        .arg(entry.timestamp.toString("yyyy-MM-dd hh:mm:ss"))
+        .arg(levelStr)
+        .arg(entry.category())
+        .arg(message)
+        .arg(entry.value)
+        .arg(statusStr);
+}
+
+QString LogJournalReader::textHeader() {
+    return QString("# Журнал событий ParamControl\n"
+                   "# Формат: Дата Время | Уровень | Категория | Сообщение | Значение | Статус\n"
+                   "# Дата начала: %1\n\n").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd"));
+}
+
+bool LogJournalReader::loadSegment(const QString& segmentPath, SegmentData& segment) const {
+    segment.file = std::make_unique<QFile>(segmentPath);
+    if (!segment.file->open(QIODevice::ReadOnly)) {
+        // Закрытый сегмент мог быть сжат после получения списка сегментов
+        if (segmentPath.endsWith(kLogCompressedSuffix) || !QFile::exists(segmentPath + kLogCompressedSuffix)) {
+            return false;
+        }
+        return loadSegment(segmentPath + kLogCompressedSuffix, segment);
+    }
+
+    qint64 size = segment.file->size();
+    if (segmentPath.endsWith(kLogCompressedSuffix)) {
+        segment.bytes = qUncompress(segment.file->readAll());
+        segment.data = reinterpret_cast<const uchar*>(segment.bytes.constData());
+        size = segment.bytes.size();
+    } else if (size > 0) {
+        segment.data = segment.file->map(0, size);
+        if (!segment.data) {
+            segment.bytes = segment.file->readAll();
+            segment.data = reinterpret_cast<const uchar*>(segment.bytes.constData());
+            size = segment.bytes.size();
+        }
+    }
+
+    qint64 startMs = 0;
+    if (!segment.data || !logJournalReadHeader(segment.data, size, startMs)) {
+        return false;
+    }
+    segment.size = logJournalValidEnd(segment.data, size);
+    return true;
+}
+
+LogEntry LogJournalReader::toEntry(const LogJournalEvent& event) const {
+    LogEntry entry;
+    entry.timestamp = QDateTime::fromMSecsSinceEpoch(event.timestampMs);
+    entry.level = event.level;
+    entry.categoryId = categoryId(event.categoryId);
+    const QString message = QString::fromUtf8(event.message, event.messageBytes);
+    const quint32 messageTemplate = event.templated ? templateId(event.templateId) : 0;
+    if (messageTemplate != 0) {
+        // Аргументы - части текста сообщения по сохраненным положениям
+        QStringList args;
+        for (int i = 0; i < event.argCount; ++i) {
+            const quint32 start = archiveGet<quint32>(event.argSpans + 8 * i);
+            const quint32 length = archiveGet<quint32>(event.argSpans + 8 * i + 4);
+            args.append(start <= quint32(message.size()) && length <= quint32(message.size()) - start
+                            ? message.mid(int(start), int(length)) : QString());
+        }
+        entry.templateId = messageTemplate;
+        entry.args = args;
+    } else {
+        entry.setText(message);
+    }
+    entry.value = QString::fromUtf8(event.value, event.valueBytes);
+    entry.status = event.status;
+    entry.repeatCount = int(event.repeatCount);
+    if (event.repeatCount > 1) {
+        entry.lastTimestamp = QDateTime::fromMSecsSinceEpoch(event.lastTimestampMs);
+    }
+    return entry;
+}
+
+} // namespace ParamControl
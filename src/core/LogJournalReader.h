@@ -0,0 +1,172 @@
+// src/core/LogJournalReader.h
+#pragma once
+
+#include <QDateTime>
+#include <QFile>
+#include <QIODevice>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
+#include <memory>
+
+#include "LogEntry.h"
+#include "LogJournalFormat.h"
+
+namespace ParamControl {
+
+/**
+ * @brief Чтение двоичного журнала событий (см. LogJournalFormat.h).
+ *
+ * Журнал задается путем текстового журнала, который передается LogManager
+ * (например, ./data/LOG_main.txt): сегменты и справочник категорий лежат
+ * рядом с ним. Несжатые сегменты отображаются в память, сжатые (.qz)
+ * распаковываются целиком. Справочник категорий читается при создании,
+ * поэтому читатель видит записи, сделанные до его создания.
+ *
+ * Читатель не изменяет журнал и может работать одновременно с записью:
+ * оборванная запись в конце текущего сегмента не читается.
+ */
+class LogJournalReader {
+public:
+    /// Получатель записей; false - остановить чтение.
+    using Visitor = std::function<bool(const LogEntry&)>;
+
+    /**
+     * @brief Конструктор: читает справочник категорий.
+     * @param logFilePath Путь к журналу, как он передается LogManager.
+     */
+    explicit LogJournalReader(const QString& logFilePath);
+
+    /**
+     * @brief Путь к журналу, переданный в конструктор.
+     */
+    QString logFilePath() const;
+
+    /**
+     * @brief Файлы сегментов от старых к новым: закрытые сегменты и текущий.
+     */
+    QStringList segmentFiles() const;
+
+    /**
+     * @brief Название категории по номеру (для неизвестного номера - "#номер").
+     */
+    QString category(quint32 id) const;
+
+    /**
+     * @brief Справочник категорий (номер категории - номер в списке).
+     */
+    QStringList categories() const;
+
+    /**
+     * @brief Номер категории справочника в LogStringTable::categories().
+     */
+    quint32 categoryId(quint32 id) const;
+
+    /**
+     * @brief Номер шаблона справочника в LogStringTable::templates() (0 - шаблон неизвестен).
+     */
+    quint32 templateId(quint32 id) const;
+
+    /**
+     * @brief Последние записи текущего сегмента (читается с конца файла).
+     * @param count Наибольшее число записей.
+     * @return Записи от старых к новым.
+     */
+    QVector<LogEntry> tail(int count) const;
+
+    /**
+     * @brief Читает записи сегмента от старых к новым.
+     * @param segmentPath Путь к сегменту (из segmentFiles()).
+     * @param visitor Получатель записей.
+     * @return false, если сегмент не удалось прочитать.
+     */
+    bool readSegment(const QString& segmentPath, const Visitor& visitor) const;
+
+    /**
+     * @brief Выводит записи интервала [fromMs, toMs] в текстовом формате журнала.
+     * @param device Открытое на запись устройство.
+     * @return Число выведенных записей.
+     */
+    qint64 exportText(QIODevice& device, qint64 fromMs, qint64 toMs) const;
+
+    // --- Пути и текстовый формат ---
+
+    /**
+     * @brief Путь к текущему сегменту журнала.
+     */
+    static QString journalPath(const QString& logFilePath);
+
+    /**
+     * @brief Путь к справочнику категорий журнала.
+     */
+    static QString categoriesPath(const QString& logFilePath);
+
+    /**
+     * @brief Путь к справочнику шаблонов сообщений журнала.
+     */
+    static QString templatesPath(const QString& logFilePath);
+
+    /**
+     * @brief Маска имен закрытых сегментов (без ".qz").
+     */
+    static QString segmentPattern(const QString& logFilePath);
+
+    /**
+     * @brief Путь, под которым закрывается текущий сегмент.
+     * @param closedAt Время закрытия (входит в имя файла).
+     */
+    static QString closedSegmentPath(const QString& logFilePath, const QDateTime& closedAt);
+
+    /**
+     * @brief Время закрытия сегмента по имени его файла (недействительно для текущего).
+     */
+    static QDateTime segmentClosedAt(const QString& logFilePath, const QString& segmentPath);
+
+    /**
+     * @brief Читает справочник категорий или шаблонов (оборванная запись в конце отбрасывается).
+     */
+    static QStringList readDictionary(const QString& dictionaryPath);
+
+    /**
+     * @brief Строка записи в текстовом формате журнала.
+     */
+    static QString formatText(const LogEntry& entry);
+
+    /**
+     * @brief Заголовок текстового журнала.
+     */
+    static QString textHeader();
+
+    // --- Просмотр сегмента без разбора записей (для поиска) ---
+
+    /**
+     * @brief Данные сегмента: отображение несжатого файла или распакованный .qz
+     */
+    struct SegmentData {
+        std::unique_ptr<QFile> file;    ///< Файл (для отображения)
+        QByteArray bytes;               ///< Распакованные данные
+        const uchar* data = nullptr;    ///< Начало данных
+        qint64 size = 0;                ///< Длина целых записей (с заголовком)
+    };
+
+    /**
+     * @brief Открывает сегмент и проверяет заголовок
+     * @return false, если сегмент не удалось прочитать
+     */
+    bool loadSegment(const QString& segmentPath, SegmentData& segment) const;
+
+    /**
+     * @brief Запись журнала по событию
+     */
+    LogEntry toEntry(const LogJournalEvent& event) const;
+
+private:
+    QString m_logFilePath;              ///< Путь к журналу
+    QStringList m_categories;           ///< Справочник категорий
+    QVector<quint32> m_categoryIds;     ///< Номера категорий справочника в LogStringTable
+    QVector<quint32> m_templateIds;     ///< Номера шаблонов справочника в LogStringTable
+};
+
+} // namespace ParamControl
@@ -1,21 +1,200 @@
 #include "LogManager.h"
 #include <QDateTime>
 #include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QPair>
+#include <QtConcurrent>
+
+#include "LogJournalReader.h"
 
 namespace ParamControl {
 
+namespace {
+
+/// Строку не удалось записать в справочник журнала
+constexpr quint32 kNoDictionaryId = 0xFFFFFFFF;
+
+/**
+ * @brief Проверяет текущий сегмент журнала
+ * @param startMs Время начала сегмента из заголовка
+ * @return Конец целых записей; 0 - файла нет или он пуст; -1 - файл не является сегментом
+ */
+qint64 journalValidEnd(const QString& filePath, qint64& startMs) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+        return 0;
+    }
+
+    qint64 size = file.size();
+    QByteArray buffer;
+    const uchar* data = file.map(0, size);
+    if (!data) {
+        buffer = file.readAll();
+        data = reinterpret_cast<const uchar*>(buffer.constData());
+        size = buffer.size();
+    }
+    if (!logJournalReadHeader(data, size, startMs)) {
+        return -1;
+    }
+    return logJournalValidEnd(data, size);
+}
+
+/**
+ * @brief Открывает справочник строк журнала на дозапись и читает номера его строк
+ *
+ * Оборванная при аварии запись в конце справочника отбрасывается.
+ * @param ids Номер строки в table -> номер в справочнике
+ * @return true, если справочник открыт
+ */
+bool openDictionary(QFile& file, QHash<quint32, quint32>& ids, const QString& path, LogStringTable& table) {
+    if (file.isOpen()) {
+        return true;
+    }
+
+    const QStringList strings = LogJournalReader::readDictionary(path);
+    ids.clear();
+    qint64 validBytes = 0;
+    for (int i = 0; i < strings.size(); ++i) {
+        ids.insert(table.intern(strings[i]), quint32(i));
+        validBytes += 2 + strings[i].toUtf8().size();
+    }
+    if (QFileInfo(path).size() > validBytes) {
+        QFile::resize(path, validBytes);
+    }
+
+    file.setFileName(path);
+    if (!file.open(QIODevice::Append)) {
+        qWarning() << "Не удалось открыть справочник журнала:" << path;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Номер строки в справочнике; новая строка дописывается в справочник
+ *
+ * При ошибке записи справочник закрывается: openDictionary() откроет его
+ * заново, отбросит недописанную строку и перечитает номера.
+ * @param id Номер строки в table
+ * @return Номер в справочнике или kNoDictionaryId, если строку записать не удалось
+ */
+quint32 dictionaryId(QFile& file, QHash<quint32, quint32>& ids, const LogStringTable& table, quint32 id) {
+    const auto it = ids.constFind(id);
+    if (it != ids.constEnd()) {
+        return it.value();
+    }
+
+    // Строка попадает в справочник раньше записей, которые на нее ссылаются
+    const QByteArray text = table.at(id).toUtf8().left(0xFFFF);
+    QByteArray record;
+    archivePut<quint16>(record, quint16(text.size()));
+    record += text;
+    if (file.write(record) != record.size() || !file.flush()) {
+        // Недописанная строка сдвинула бы номера всех следующих строк
+        qWarning() << "Не удалось записать в справочник журнала:" << file.fileName() << file.errorString();
+        file.close();
+        return kNoDictionaryId;
+    }
+
+    const quint32 number = quint32(ids.size());
+    ids.insert(id, number);
+    return number;
+}
+
+/**
+ * @brief Сжимает закрытый сегмент: <сегмент>.qz пишется через временный файл, исходный удаляется
+ */
+bool compressSegment(const QString& filePath) {
+    QFile source(filePath);
+    if (!source.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray packed = qCompress(source.readAll());
+    source.close();
+
+    const QString targetPath = filePath + kLogCompressedSuffix;
+    QFile target(targetPath + ".part");
+    if (!target.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+        target.write(packed) != packed.size() || !target.flush()) {
+        qWarning() << "LogManager: не удалось сжать сегмент журнала" << filePath;
+        target.close();
+        target.remove();
+        return false;
+    }
+    target.close();
+
+    QFile::remove(targetPath);
+    if (!target.rename(targetPath)) {
+        target.remove();
+        return false;
+    }
+    return QFile::remove(filePath);
+}
+
+/**
+ * @brief Сжимает закрытые сегменты журнала и удаляет сегменты сверх срока хранения
+ */
+void maintainSegments(const QString& logFilePath, int retentionDays, int maxSegments) {
+    const QDir dir = QFileInfo(logFilePath).absoluteDir();
+    const QString pattern = LogJournalReader::segmentPattern(logFilePath);
+
+    for (const QFileInfo& segment : dir.entryInfoList({pattern}, QDir::Files, QDir::Name)) {
+        compressSegment(segment.absoluteFilePath());
+    }
+
+    // Имена начинаются со времени закрытия, поэтому порядок имен - порядок сегментов
+    const QFileInfoList segments = dir.entryInfoList({pattern, pattern + kLogCompressedSuffix}, QDir::Files, QDir::Name);
+    const QDateTime oldest = retentionDays > 0 ? QDateTime::currentDateTime().addDays(-retentionDays) : QDateTime();
+    for (int i = 0; i < segments.size(); ++i) {
+        const bool tooMany = maxSegments > 0 && segments.size() - i > maxSegments;
+        const QDateTime closed = LogJournalReader::segmentClosedAt(logFilePath, segments[i].absoluteFilePath());
+        const bool tooOld = oldest.isValid() && closed.isValid() && closed < oldest;
+        if (tooMany || tooOld) {
+            QFile::remove(segments[i].absoluteFilePath());
+        }
+    }
+}
+
+} // namespace
+
 LogManager::LogManager(QObject* parent)
     : QObject(parent)
-    , m_maxEntries(1000)
+    , m_entries(1000)
 {
+    m_writerThread = std::thread(&LogManager::writerLoop, this);
 }
 
 LogManager::~LogManager() {
+    {
+        QMutexLocker locker(&m_mutex);
+        endRepeatRun();
+    }
+    
+    // Поток записи дописывает очередь перед выходом
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_stopping = true;
+    }
+    m_writeWake.notify_one();
+    m_writerThread.join();
+    m_maintenance.waitForFinished();
 }
 
 bool LogManager::initialize(const QString& logFilePath, int maxEntries) {
-    m_logFilePath = logFilePath;
-    m_maxEntries = maxEntries;
+    // Записи, накопленные до смены файла, остаются в старом файле
+    flush();
+    switchLogFile(logFilePath);
+    {
+        QMutexLocker locker(&m_mutex);
+        m_entries.setCapacity(maxEntries);
+        m_index.evictBefore(m_entries.firstSequence());
+    }
+    {
+        // Досжимаем сегменты, оставшиеся несжатыми после аварийного завершения
+        std::lock_guard<std::mutex> fileLock(m_fileMutex);
+        scheduleMaintenance();
+    }
     
     // Загружаем существующие записи из файла при инициализации
     return readFromFile();
@@ -23,47 +202,87 @@ bool LogManager::initialize(const QString& logFilePath, int maxEntries) {
 
 void LogManager::log(LogLevel level, const QString& category, const QString& message, 
                     const QString& value, LogStatus status) {
-    QMutexLocker locker(&m_mutex);
-    
-    // Создаем запись лога
+    logTemplate(level, category, message, QStringList(), value, status);
+}
+
+void LogManager::logTemplate(LogLevel level, const QString& category, const QString& messageTemplate,
+                             const QStringList& args, const QString& value, LogStatus status) {
+    // Создаем запись лога: категория и шаблон - номерами, текст сообщения не строится
     LogEntry entry;
     entry.timestamp = QDateTime::currentDateTime();
     entry.level = level;
-    entry.category = category;
-    entry.message = message;
+    entry.setCategory(category);
+    entry.setMessage(messageTemplate, args);
     entry.value = value;
     entry.status = status;
     
-    // Добавляем запись в список
-    m_entries.append(entry);
-    
-    // Если превышено максимальное количество записей, удаляем самую старую
-    if (m_entries.size() > m_maxEntries) {
-        m_entries.removeFirst();
+    bool repeated = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        
+        const LogEntry* last = m_entries.isEmpty() ? nullptr : &m_entries.at(m_entries.size() - 1);
+        if (m_coalesceRepeats && m_repeatCandidate && last && last->sameEvent(entry)) {
+            // Повтор последнего события: запись в памяти обновляется на месте,
+            // а на диск серия попадет, когда закончится
+            LogEntry run = *last;
+            run.lastTimestamp = entry.timestamp;
+            ++run.repeatCount;
+            m_entries.replaceLast(run);
+            m_repeatPending = true;
+            entry = run;
+            repeated = true;
+        } else {
+            endRepeatRun();
+            
+            // Добавляем запись в кольцевой буфер (самая старая вытесняется при заполнении) и в индекс
+            appendEntry(entry);
+            
+            // Ставим в очередь на запись (под m_mutex, чтобы порядок в файле совпадал с порядком в памяти)
+            enqueueWrite(entry);
+            m_repeatCandidate = true;
+        }
     }
     
-    // Записываем в файл
-    writeToFile(entry);
-    
-    // Уведомляем о добавлении записи
-    emit logEntryAdded(entry);
+    // Уведомляем о записи вне блокировки: обработчики читают снимок журнала
+    if (repeated) {
+        emit logEntryUpdated(entry);
+    } else {
+        emit logEntryAdded(entry);
+    }
 }
 
 void LogManager::clearLog() {
-    QMutexLocker locker(&m_mutex);
-    
-    // Очищаем список записей
-    m_entries.clear();
-    
-    // Очищаем файл лога
-    QFile file(m_logFilePath);
-    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        // Записываем заголовок
-        QTextStream out(&file);
-        out << "# Журнал событий ParamControl\n";
-        out << "# Формат: Дата Время | Уровень | Категория | Сообщение | Значение | Статус\n";
-        out << "# Дата начала: " << QDateTime::currentDateTime().toString("yyyy-MM-dd") << "\n\n";
-        file.close();
+    {
+        QMutexLocker locker(&m_mutex);
+        
+        // Очищаем список записей (незаконченная серия повторов не записывается)
+        m_entries.clear();
+        m_index.clear();
+        m_repeatCandidate = false;
+        m_repeatPending = false;
+        
+        // Очищаем текущий сегмент: сначала дописываем очередь, чтобы поток записи не вернул старые записи
+        waitForWrites();
+        std::lock_guard<std::mutex> fileLock(m_fileMutex);
+        m_file.close();
+        QFile file(LogJournalReader::journalPath(m_logFilePath));
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            // Записываем заголовок (справочник категорий остается: номера не меняются)
+            file.write(logJournalHeader(QDateTime::currentMSecsSinceEpoch()));
+            file.close();
+        }
+        
+        // Закрытые сегменты тоже удаляются, иначе история и поиск вернули бы очищенные записи
+        // (фоновое сжатие заканчивается раньше, чтобы не создать .qz удаленного сегмента)
+        m_maintenance.waitForFinished();
+        const QDir dir = QFileInfo(m_logFilePath).absoluteDir();
+        const QString pattern = LogJournalReader::segmentPattern(m_logFilePath);
+        for (const QFileInfo& segment : dir.entryInfoList(
+                 {pattern, pattern + kLogCompressedSuffix, pattern + kLogCompressedSuffix + ".part"}, QDir::Files)) {
+            if (!QFile::remove(segment.absoluteFilePath())) {
+                qWarning() << "LogManager: не удалось удалить сегмент журнала" << segment.absoluteFilePath();
+            }
+        }
     }
     
     // Уведомляем об очистке лога
@@ -72,46 +291,61 @@ void LogManager::clearLog() {
 
 QVector<LogEntry> LogManager::getAllEntries() const {
     QMutexLocker locker(&m_mutex);
-    return m_entries;
-}
-
-QVector<LogEntry> LogManager::getEntriesByCategory(const QString& category) const {
-    QMutexLocker locker(&m_mutex);
     
     QVector<LogEntry> result;
-    for (const auto& entry : m_entries) {
-        if (entry.category == category) {
-            result.append(entry);
-        }
+    result.reserve(m_entries.size());
+    for (int i = 0; i < m_entries.size(); ++i) {
+        result.append(m_entries.at(i));
     }
     
     return result;
 }
 
-QVector<LogEntry> LogManager::getEntriesByLevel(LogLevel level) const {
+LogSnapshot LogManager::snapshot() const {
+    QMutexLocker locker(&m_mutex);
+    return m_entries.snapshot();
+}
+
+LogQueryResult LogManager::query(const LogQuery& query) const {
     QMutexLocker locker(&m_mutex);
     
-    QVector<LogEntry> result;
-    for (const auto& entry : m_entries) {
-        if (entry.level == level) {
-            result.append(entry);
-        }
-    }
-    
+    LogQueryResult result;
+    result.snapshot = m_entries.snapshot();
+    result.rows = m_index.query(query);
     return result;
 }
 
-QVector<LogEntry> LogManager::getEntriesByStatus(LogStatus status) const {
+QStringList LogManager::categories() const {
     QMutexLocker locker(&m_mutex);
+    return m_index.categories();
+}
+
+std::unique_ptr<LogJournalCursor> LogManager::journalBefore(quint64 sequence) {
+    // Пока держится m_mutex, новые записи не ставятся в очередь: после waitForWrites()
+    // последние записи файла - это записи буфера, и курсор отсчитывает их с конца
+    QMutexLocker locker(&m_mutex);
+    waitForWrites();
     
-    QVector<LogEntry> result;
-    for (const auto& entry : m_entries) {
-        if (entry.status == status) {
-            result.append(entry);
-        }
-    }
-    
-    return result;
+    const quint64 endSequence = m_entries.endSequence();
+    return std::make_unique<LogJournalCursor>(m_logFilePath, endSequence > sequence ? endSequence - sequence : 0);
+}
+
+QVector<LogEntry> LogManager::getEntriesByCategory(const QString& category) const {
+    LogQuery query;
+    query.categories.append(LogStringTable::categories().find(category));
+    return entriesMatching(query);
+}
+
+QVector<LogEntry> LogManager::getEntriesByLevel(LogLevel level) const {
+    LogQuery query;
+    query.level = static_cast<int>(level);
+    return entriesMatching(query);
+}
+
+QVector<LogEntry> LogManager::getEntriesByStatus(LogStatus status) const {
+    LogQuery query;
+    query.status = static_cast<int>(status);
+    return entriesMatching(query);
 }
 
 QString LogManager::getLogFilePath() const {
@@ -124,14 +358,15 @@ bool LogManager::setLogFilePath(const QString& logFilePath) {
     }
     
     // Сохраняем текущие записи в новый файл
-    QString oldFilePath = m_logFilePath;
-    m_logFilePath = logFilePath;
+    flush();
+    switchLogFile(logFilePath);
     
     return saveLog();
 }
 
 int LogManager::getMaxEntries() const {
-    return m_maxEntries;
+    QMutexLocker locker(&m_mutex);
+    return m_entries.capacity();
 }
 
 void LogManager::setMaxEntries(int maxEntries) {
@@ -139,134 +374,458 @@ void LogManager::setMaxEntries(int maxEntries) {
         return;
     }
     
-    m_maxEntries = maxEntries;
-    
     QMutexLocker locker(&m_mutex);
     
-    // Если текущее количество записей превышает новый максимум, удаляем лишние
-    while (m_entries.size() > m_maxEntries) {
-        m_entries.removeFirst();
-    }
+    // Если текущее количество записей превышает новый максимум, лишние вытесняются
+    m_entries.setCapacity(maxEntries);
+    m_index.evictBefore(m_entries.firstSequence());
 }
 
 bool LogManager::saveLog(const QString& filePath) {
     QMutexLocker locker(&m_mutex);
     
-    QString path = filePath.isEmpty() ? m_logFilePath : filePath;
+    if (filePath.isEmpty()) {
+        // Очередь уже в памяти (m_entries), но текущий сегмент перезаписывается целиком
+        // (вместе с незаконченной серией повторов: последняя запись пишется как есть)
+        waitForWrites();
+        m_repeatPending = false;
+        std::lock_guard<std::mutex> fileLock(m_fileMutex);
+        m_file.close();
+        if (!openDictionaries()) {
+            return false;
+        }
+        
+        QByteArray buffer = logJournalHeader(QDateTime::currentMSecsSinceEpoch());
+        for (int i = 0; i < m_entries.size(); ++i) {
+            const LogEntry& entry = m_entries.at(i);
+            logJournalPutEvent(buffer, entry, categoryId(entry.categoryId), templateId(entry.templateId));
+        }
+        
+        const QString path = LogJournalReader::journalPath(m_logFilePath);
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(buffer) != buffer.size()) {
+            qWarning() << "Не удалось открыть файл для записи:" << path;
+            return false;
+        }
+        return true;
+    }
     
-    QFile file(path);
+    QFile file(filePath);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qWarning() << "Не удалось открыть файл для записи:" << path;
+        qWarning() << "Не удалось открыть файл для записи:" << filePath;
         return false;
     }
     
     QTextStream out(&file);
     
     // Записываем заголовок
-    out << "# Журнал событий ParamControl\n";
-    out << "# Формат: Дата Время | Уровень | Категория | Сообщение | Значение | Статус\n";
-    out << "# Дата начала: " << QDateTime::currentDateTime().toString("yyyy-MM-dd") << "\n\n";
+    out << LogJournalReader::textHeader();
     
     // Записываем все записи
-    for (const auto& entry : m_entries) {
-        out << formatLogEntry(entry) << "\n";
+    for (int i = 0; i < m_entries.size(); ++i) {
+        out << formatLogEntry(m_entries.at(i)) << "\n";
     }
     
     file.close();
     return true;
 }
 
-bool LogManager::writeToFile(const LogEntry& entry) {
-    // Проверяем, существует ли файл
-    QFile file(m_logFilePath);
+void LogManager::setFlushInterval(int ms) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    m_flushIntervalMs = qMax(10, ms);
+}
+
+void LogManager::setFlushCount(int count) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    m_flushCount = qMax(1, count);
+}
+
+void LogManager::setFlushOnError(bool enabled) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    m_flushOnError = enabled;
+}
+
+void LogManager::flush() {
+    {
+        QMutexLocker locker(&m_mutex);
+        endRepeatRun();
+    }
+    waitForWrites();
+}
+
+void LogManager::setCoalesceRepeats(bool enabled) {
+    QMutexLocker locker(&m_mutex);
+    if (!enabled) {
+        endRepeatRun();
+        m_repeatCandidate = false;
+    }
+    m_coalesceRepeats = enabled;
+}
+
+void LogManager::endRepeatRun() {
+    if (m_repeatPending) {
+        m_repeatPending = false;
+        enqueueWrite(m_entries.at(m_entries.size() - 1));
+    }
+}
+
+void LogManager::waitForWrites() {
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+    const quint64 target = m_queuedCount;
+    if (m_writtenCount >= target) {
+        return;
+    }
+    m_flushRequested = true;
+    m_writeWake.notify_one();
+    m_writeDone.wait(lock, [this, target] { return m_writtenCount >= target; });
+}
+
+void LogManager::appendEntry(const LogEntry& entry) {
+    m_index.append(m_entries.append(entry), entry);
+    m_index.evictBefore(m_entries.firstSequence());
+}
+
+QVector<LogEntry> LogManager::entriesMatching(const LogQuery& query) const {
+    QMutexLocker locker(&m_mutex);
+    
+    const QVector<quint64> rows = m_index.query(query);
+    QVector<LogEntry> result;
+    result.reserve(rows.size());
+    for (quint64 sequence : rows) {
+        result.append(m_entries.at(int(sequence - m_entries.firstSequence())));
+    }
     
-    // Если файл не существует, создаем его с заголовком
-    if (!file.exists()) {
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qWarning() << "Не удалось создать файл лога:" << m_logFilePath;
+    return result;
+}
+
+void LogManager::enqueueWrite(const LogEntry& entry) {
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        if (m_pendingWrites.empty()) {
+            m_firstPendingTime = std::chrono::steady_clock::now();
+            wake = true;
+        }
+        m_pendingWrites.push_back(entry);
+        ++m_queuedCount;
+
+        if (entry.level == LogLevel::Error && m_flushOnError) {
+            m_urgentPending = true;
+            wake = true;
+        }
+        if (int(m_pendingWrites.size()) >= m_flushCount) {
+            wake = true;
+        }
+    }
+    if (wake) {
+        m_writeWake.notify_one();
+    }
+}
+
+void LogManager::writerLoop() {
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+    for (;;) {
+        m_writeWake.wait(lock, [this] { return !m_pendingWrites.empty() || m_stopping; });
+
+        // Пачка копится до интервала от первой записи, до порога числа записей или до ошибки
+        const auto deadline = m_firstPendingTime + std::chrono::milliseconds(m_flushIntervalMs);
+        m_writeWake.wait_until(lock, deadline, [this] {
+            return m_stopping || m_flushRequested || m_urgentPending ||
+                   int(m_pendingWrites.size()) >= m_flushCount;
+        });
+
+        std::deque<LogEntry> batch;
+        batch.swap(m_pendingWrites);
+        const bool stopping = m_stopping;
+        m_flushRequested = false;
+        m_urgentPending = false;
+        lock.unlock();
+
+        // Диск трогаем только без блокировки очереди: log() не ждет записи
+        if (!batch.empty()) {
+            writeBatch(batch);
+        }
+
+        lock.lock();
+        m_writtenCount += batch.size();
+        m_writeDone.notify_all();
+        if (stopping && m_pendingWrites.empty()) {
+            break;
+        }
+    }
+    lock.unlock();
+
+    std::lock_guard<std::mutex> fileLock(m_fileMutex);
+    m_file.close();
+    m_categoriesFile.close();
+    m_templatesFile.close();
+}
+
+bool LogManager::writeBatch(const std::deque<LogEntry>& batch) {
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    QByteArray buffer;
+    const auto writeBuffer = [this, &buffer] {
+        if (m_file.write(buffer) != buffer.size() || !m_file.flush()) {
+            qWarning() << "Не удалось записать в файл лога:" << m_file.fileName() << m_file.errorString();
+            m_file.close();
             return false;
         }
+        m_fileBytes += buffer.size();
+        buffer.clear();
+        return true;
+    };
+
+    QByteArray record;
+    for (const LogEntry& entry : batch) {
+        if (!m_file.isOpen() && !openSegment()) {
+            return false;
+        }
+
+        // Запись со ссылкой на незаписанную строку справочника не читается:
+        // пачка прерывается, справочник открывается заново при следующей записи
+        const quint32 category = categoryId(entry.categoryId);
+        const quint32 messageTemplate = category != kNoDictionaryId ? templateId(entry.templateId) : 0;
+        if (category == kNoDictionaryId || messageTemplate == kNoDictionaryId) {
+            if (!buffer.isEmpty()) {
+                writeBuffer();
+            }
+            return false;
+        }
+
+        // Серия повторов заменяет предыдущую запись - свое первое событие или прежнее состояние серии
+        const bool supersedes = entry.repeatCount > 1;
+        record.clear();
+        logJournalPutEvent(record, entry, category, messageTemplate, supersedes);
+
+        // Новый сегмент: при смене суток или когда запись превысит размер сегмента
+        const bool nextDay = m_rotateDaily && entry.timestamp.date() > m_segmentDate;
+        const bool full = m_segmentBytes > 0 &&
+                          m_fileBytes + buffer.size() + record.size() > m_segmentBytes;
+        if (nextDay || full) {
+            // Заменяемая запись остается в старом сегменте: состояние серии дописывается туда же,
+            // иначе в новом сегменте оно стало бы отдельным событием рядом с замененным
+            if (supersedes && m_fileBytes + buffer.size() > kLogJournalHeaderBytes) {
+                buffer += record;
+                record.clear();
+            }
+            if (!buffer.isEmpty() && !writeBuffer()) {
+                return false;
+            }
+            rotateSegment();
+            if (!openSegment()) {
+                return false;
+            }
+            if (record.isEmpty()) {
+                continue;
+            }
+        }
         
-        QTextStream out(&file);
-        out << "# Журнал событий ParamControl\n";
-        out << "# Формат: Дата Время | Уровень | Категория | Сообщение | Значение | Статус\n";
-        out << "# Дата начала: " << QDateTime::currentDateTime().toString("yyyy-MM-dd") << "\n\n";
-        
-        file.close();
+        // Заменять можно только запись того же сегмента (серия, начатая до перезапуска)
+        if (supersedes && m_fileBytes + buffer.size() <= kLogJournalHeaderBytes) {
+            record.clear();
+            logJournalPutEvent(record, entry, category, messageTemplate);
+        }
+        buffer += record;
     }
-    
-    // Открываем файл для добавления записи
-    if (!file.open(QIODevice::Append | QIODevice::Text)) {
-        qWarning() << "Не удалось открыть файл лога для записи:" << m_logFilePath;
+
+    return buffer.isEmpty() || writeBuffer();
+}
+
+bool LogManager::openSegment() {
+    if (!openDictionaries()) {
         return false;
     }
-    
-    QTextStream out(&file);
-    out << formatLogEntry(entry) << "\n";
-    
-    file.close();
+
+    const QString path = LogJournalReader::journalPath(m_logFilePath);
+    qint64 startMs = 0;
+    const qint64 validEnd = journalValidEnd(path, startMs);
+    if (validEnd < 0) {
+        // Файл не является сегментом журнала: откладываем его, чтобы не потерять и не дописать к нему
+        qWarning() << "LogManager: поврежден заголовок журнала" << path;
+        QFile::remove(path + ".bad");
+        QFile::rename(path, path + ".bad");
+    } else if (validEnd < QFileInfo(path).size()) {
+        // Запись, оборванная при аварии, отбрасывается, иначе следующие записи не прочитать
+        QFile::resize(path, validEnd);
+    }
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::Append)) {
+        qWarning() << "Не удалось открыть файл лога для записи:" << path;
+        return false;
+    }
+
+    // Если сегмента не было, начинаем его с заголовка
+    m_fileBytes = m_file.size();
+    if (m_fileBytes == 0) {
+        const QDateTime now = QDateTime::currentDateTime();
+        m_file.write(logJournalHeader(now.toMSecsSinceEpoch()));
+        m_fileBytes = kLogJournalHeaderBytes;
+        m_segmentDate = now.date();
+    } else {
+        m_segmentDate = QDateTime::fromMSecsSinceEpoch(startMs).date();
+    }
     return true;
 }
 
+bool LogManager::openDictionaries() {
+    return openDictionary(m_categoriesFile, m_categoryIds, LogJournalReader::categoriesPath(m_logFilePath),
+                          LogStringTable::categories()) &&
+           openDictionary(m_templatesFile, m_templateIds, LogJournalReader::templatesPath(m_logFilePath),
+                          LogStringTable::templates());
+}
+
+quint32 LogManager::categoryId(quint32 category) {
+    if (!openDictionaries()) {
+        return kNoDictionaryId;
+    }
+    return dictionaryId(m_categoriesFile, m_categoryIds, LogStringTable::categories(), category);
+}
+
+quint32 LogManager::templateId(quint32 messageTemplate) {
+    // Сообщение без шаблона (готовый текст) в справочник не попадает
+    if (messageTemplate == 0) {
+        return 0;
+    }
+    if (!openDictionaries()) {
+        return kNoDictionaryId;
+    }
+    return dictionaryId(m_templatesFile, m_templateIds, LogStringTable::templates(), messageTemplate);
+}
+
+void LogManager::rotateSegment() {
+    m_file.close();
+
+    const QString segmentPath = LogJournalReader::closedSegmentPath(m_logFilePath, QDateTime::currentDateTime());
+    if (!QFile::rename(m_file.fileName(), segmentPath)) {
+        // Продолжаем писать в тот же файл: потерять записи хуже, чем превысить размер
+        qWarning() << "LogManager: не удалось закрыть сегмент журнала" << segmentPath;
+        return;
+    }
+
+    scheduleMaintenance();
+}
+
+void LogManager::scheduleMaintenance() {
+    // Задания не пересекаются: новое ждет окончания предыдущего
+    m_maintenance.waitForFinished();
+    m_maintenance = QtConcurrent::run([path = m_logFilePath, days = m_retentionDays, count = m_maxSegments] {
+        maintainSegments(path, days, count);
+    });
+}
+
+void LogManager::setSegmentBytes(qint64 bytes) {
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    m_segmentBytes = bytes > 0 ? qMax<qint64>(1024 * 1024, bytes) : 0;
+}
+
+void LogManager::setRotateDaily(bool enabled) {
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    m_rotateDaily = enabled;
+}
+
+void LogManager::setRetention(int days, int maxSegments) {
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    m_retentionDays = qMax(0, days);
+    m_maxSegments = qMax(0, maxSegments);
+}
+
+QStringList LogManager::segmentFiles() const {
+    return LogJournalReader(getLogFilePath()).segmentFiles();
+}
+
+void LogManager::switchLogFile(const QString& logFilePath) {
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    m_file.close();
+    m_categoriesFile.close();
+    m_categoryIds.clear();
+    m_templatesFile.close();
+    m_templateIds.clear();
+    m_logFilePath = logFilePath;
+}
+
 bool LogManager::readFromFile() {
-    QFile file(m_logFilePath);
+    const int maxEntries = getMaxEntries();
+    std::unique_lock<std::mutex> fileLock(m_fileMutex);
     
-    // Если файл не существует, создаем его
-    if (!file.exists()) {
-        QFile newFile(m_logFilePath);
-        if (newFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            QTextStream out(&newFile);
-            out << "# Журнал событий ParamControl\n";
-            out << "# Формат: Дата Время | Уровень | Категория | Сообщение | Значение | Статус\n";
-            out << "# Дата начала: " << QDateTime::currentDateTime().toString("yyyy-MM-dd") << "\n\n";
-            newFile.close();
-        }
-        return true;  // Новый файл создан, но данных нет
+    // Последние записи читаются с конца сегмента, поэтому время запуска не зависит от его размера
+    QVector<LogEntry> loadedEntries;
+    if (QFile::exists(LogJournalReader::journalPath(m_logFilePath))) {
+        loadedEntries = LogJournalReader(m_logFilePath).tail(maxEntries);
+    } else if (QFile::exists(m_logFilePath)) {
+        // Журнала еще нет: показываем конец текстового журнала прежнего формата
+        loadedEntries = readTextTail(m_logFilePath, maxEntries);
     }
+    fileLock.unlock();
     
-    // Открываем файл для чтения
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Не удалось открыть файл лога для чтения:" << m_logFilePath;
-        return false;
+    // Обновляем список записей
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_repeatCandidate = false;
+    m_repeatPending = false;
+    for (const LogEntry& entry : loadedEntries) {
+        appendEntry(entry);
     }
     
-    QTextStream in(&file);
-    QVector<LogEntry> loadedEntries;
+    return true;
+}
+
+QVector<LogEntry> LogManager::readTextTail(const QString& filePath, int maxEntries) const {
+    // Открываем файл для чтения (без Text: строки разбираются прямо в отображенной памяти)
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Не удалось открыть файл лога для чтения:" << filePath;
+        return {};
+    }
     
-    // Пропускаем заголовок (строки, начинающиеся с #)
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        if (!line.startsWith('#') && !line.isEmpty()) {
-            LogEntry entry = parseLogLine(line);
-            loadedEntries.append(entry);
-            
-            // Ограничиваем количество загружаемых записей
-            if (loadedEntries.size() >= m_maxEntries) {
-                break;
-            }
+    // Файл отображается в память и просматривается с конца до maxEntries-й записи
+    const qint64 size = file.size();
+    QByteArray buffer;
+    const char* data = nullptr;
+    if (size > 0) {
+        data = reinterpret_cast<const char*>(file.map(0, size));
+        if (!data) {
+            buffer = file.readAll();
+            data = buffer.constData();
         }
     }
     
-    file.close();
-    
-    // Обновляем список записей
-    QMutexLocker locker(&m_mutex);
-    m_entries = loadedEntries;
+    // Начало и длина строк записей, от новых к старым
+    QVector<QPair<qint64, int>> lines;
+    qint64 position = size;
+    while (position > 0 && lines.size() < maxEntries) {
+        qint64 lineEnd = position;
+        if (data[lineEnd - 1] == '\n') {
+            --lineEnd;
+        }
+        qint64 lineStart = lineEnd;
+        while (lineStart > 0 && data[lineStart - 1] != '\n') {
+            --lineStart;
+        }
+        position = lineStart;
+        
+        qint64 length = lineEnd - lineStart;
+        if (length > 0 && data[lineEnd - 1] == '\r') {
+            --length;
+        }
+        
+        // Пропускаем заголовок (строки, начинающиеся с #) и пустые строки
+        if (length > 0 && data[lineStart] != '#') {
+            lines.append(qMakePair(lineStart, int(length)));
+        }
+    }
     
-    return true;
+    QVector<LogEntry> entries;
+    entries.reserve(lines.size());
+    for (int i = lines.size() - 1; i >= 0; --i) {
+        entries.append(parseLogLine(QString::fromUtf8(data + lines[i].first, lines[i].second)));
+    }
+    return entries;
 }
 
 QString LogManager::formatLogEntry(const LogEntry& entry) const {
-    QString levelStr = entry.level == LogLevel::Info ? "INFO" : "ERROR";
-    QString statusStr = entry.status == LogStatus::Normal ? "Normal" : "Error";
-    
-    return QString("%1 | %2 | %3 | %4 | %5 | %6")
-        .arg(entry.timestamp.toString("yyyy-MM-dd hh:mm:ss"))
-        .arg(levelStr)
-        .arg(entry.category)
-        .arg(entry.message)
-        .arg(entry.value)
-        .arg(statusStr);
+    return LogJournalReader::formatText(entry);
 }
 
 LogEntry LogManager::parseLogLine(const QString& line) const {
@@ -284,10 +843,10 @@ LogEntry LogManager::parseLogLine(const QString& line) const {
         entry.level = (levelStr == "INFO") ? LogLevel::Info : LogLevel::Error;
         
         // Категория
-        entry.category = parts[2].trimmed();
+        entry.setCategory(parts[2].trimmed());
         
-        // Сообщение
-        entry.message = parts[3].trimmed();
+        // Сообщение (готовый текст, в таблицу шаблонов не попадает)
+        entry.setText(parts[3].trimmed());
         
         // Значение
         entry.value = parts[4].trimmed();
@@ -299,8 +858,8 @@ LogEntry LogManager::parseLogLine(const QString& line) const {
         // Если формат не соответствует ожидаемому, устанавливаем текущее время и пустые поля
         entry.timestamp = QDateTime::currentDateTime();
         entry.level = LogLevel::Error;
-        entry.category = "Лог";
-        entry.message = "Ошибка формата: " + line;
+        entry.setCategory("Лог");
+        entry.setMessage("Ошибка формата: %1", {line});
         entry.value = "";
         entry.status = LogStatus::Error;
     }
@@ -7,43 +7,64 @@
 #include <QFile>
 #include <QTextStream>
 #include <QMutex>
+#include <QDate>
+#include <QFuture>
+#include <QHash>
+#include <QStringList>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
 
-namespace ParamControl {
-
-/**
- * @brief Уровни логирования
- */
-enum class LogLevel {
-    Info,       ///< Информационное сообщение
-    Error       ///< Ошибка
-};
-
-/**
- * @brief Статус логируемого события
- */
-enum class LogStatus {
-    Normal,     ///< Нормальное состояние
-    Error       ///< Ошибка
-};
+#include "LogBuffer.h"
+#include "LogEntry.h"
+#include "LogIndex.h"
+#include "LogJournalCursor.h"
 
-/**
- * @brief Структура для хранения записи журнала
- */
-struct LogEntry {
-    QDateTime timestamp;     ///< Время события
-    LogLevel level;          ///< Уровень логирования
-    QString category;        ///< Категория события
-    QString message;         ///< Сообщение
-    QString value;           ///< Значение (для параметров)
-    LogStatus status;        ///< Статус события
-};
+namespace ParamControl {
 
 /**
  * @brief Класс для управления журналом событий
  * 
  * Этот класс отвечает за журналирование событий и их сохранение в файл.
  * Он поддерживает фильтрацию по категориям и уровням логирования.
+ *
+ * Записи в памяти хранятся в кольцевом буфере LogBuffer емкостью maxEntries:
+ * добавление стоит O(1), а представления читают записи через снимок
+ * (snapshot()) без копирования. Индекс LogIndex по категориям, уровням,
+ * статусам и времени отвечает на запросы query() порядковыми номерами
+ * записей в снимке, не просматривая весь буфер. Категории и шаблоны
+ * сообщений записи хранят номерами в LogStringTable, а текст сообщения
+ * строится только при показе или записи в файл (logTemplate()).
+ *
+ * log() не обращается к диску: записи ставятся в очередь, а отдельный поток
+ * пишет накопленную пачку одним вызовом write() в постоянно открытый файл.
+ * Пачка пишется по истечении интервала, при наборе заданного числа записей
+ * или сразу, если среди них есть ошибка, чтобы при аварии не потерять ее.
+ *
+ * Одинаковые события подряд (например, "Ошибка при отправке запроса"
+ * на каждом такте, пока нет связи с СОТМ) сворачиваются в одну запись
+ * со временем первого и последнего события и числом повторов. Запись
+ * в памяти обновляется на месте (сигнал logEntryUpdated()), а на диск серия
+ * пишется, когда заканчивается: при другом событии, flush() или закрытии.
+ * Первое событие серии к этому времени уже записано, поэтому запись серии
+ * заменяет его (см. LogJournalFormat.h).
+ *
+ * На диске журнал двоичный (см. LogJournalFormat.h): рядом с путем журнала
+ * <имя>.<расширение> лежат текущий сегмент <имя>.journal и справочник
+ * категорий <имя>.categories. Запись не форматирует строк, а чтение не
+ * разбирает текст, поэтому символ '|' в сообщении ничего не ломает.
+ * Текстовый вид строится по запросу: saveLog() для записей в памяти,
+ * LogJournalReader::exportText() и утилита LogExport - для всего журнала.
+ *
+ * При смене суток или превышении размера поток записи переименовывает
+ * сегмент в <имя>_ГГГГММДД-ччммссззз.journal и начинает новый. Закрытые
+ * сегменты сжимаются qCompress в фоне (<сегмент>.qz), а сегменты старше
+ * срока хранения или сверх заданного числа удаляются. При запуске читаются
+ * только последние записи текущего сегмента; если журнала еще нет, но есть
+ * текстовый файл прежнего формата, читается его конец.
  */
 class LogManager : public QObject {
     Q_OBJECT
@@ -72,15 +93,36 @@ public:
      * @brief Добавление записи в журнал
      * @param level Уровень логирования
      * @param category Категория события
-     * @param message Сообщение
+     * @param message Сообщение (постоянный текст: он хранится в таблице шаблонов,
+     *        изменяемые части передаются в logTemplate())
      * @param value Значение (для параметров)
      * @param status Статус события
      */
     void log(LogLevel level, const QString& category, const QString& message, 
              const QString& value = QString(), LogStatus status = LogStatus::Normal);
     
+    /**
+     * @brief Добавление записи с сообщением по шаблону
+     *
+     * Текст сообщения не строится: запись хранит номер шаблона и аргументы,
+     * а текст получается при показе или записи в файл (LogEntry::message()).
+     *
+     * @param level Уровень логирования
+     * @param category Категория события
+     * @param messageTemplate Шаблон сообщения с местами %1, %2, ...
+     * @param args Аргументы шаблона
+     * @param value Значение (для параметров)
+     * @param status Статус события
+     */
+    void logTemplate(LogLevel level, const QString& category, const QString& messageTemplate,
+                     const QStringList& args, const QString& value = QString(),
+                     LogStatus status = LogStatus::Normal);
+    
     /**
      * @brief Очистка журнала
+     *
+     * Удаляются записи в памяти, текущий и закрытые сегменты на диске.
+     * Справочник категорий остается.
      */
     void clearLog();
     
@@ -89,6 +131,31 @@ public:
      * @return Список записей журнала
      */
     QVector<LogEntry> getAllEntries() const;
+
+    /**
+     * @brief Снимок записей журнала без копирования записей
+     * @return Неизменяемый вид на текущие записи
+     */
+    LogSnapshot snapshot() const;
+
+    /**
+     * @brief Запрос записей по интервалу времени, категориям (параметрам), уровню и статусу
+     * @param query Условия запроса
+     * @return Снимок журнала и порядковые номера подходящих записей в нем
+     */
+    LogQueryResult query(const LogQuery& query) const;
+
+    /**
+     * @brief Категории, по которым есть записи в памяти
+     */
+    QStringList categories() const;
+
+    /**
+     * @brief Курсор по журналу на диске для записей старше записи с номером sequence
+     * @param sequence Номер первой записи, которая читается из снимка в памяти
+     * @return Курсор, стоящий перед этой записью (очередь записи предварительно дописывается в файл)
+     */
+    std::unique_ptr<LogJournalCursor> journalBefore(quint64 sequence);
     
     /**
      * @brief Получение записей журнала, отфильтрованных по категории
@@ -137,18 +204,80 @@ public:
     void setMaxEntries(int maxEntries);
     
     /**
-     * @brief Сохранение журнала в файл
-     * @param filePath Путь к файлу (пусто - использовать текущий файл)
+     * @brief Сохранение записей из памяти
+     * @param filePath Путь к текстовому файлу (пусто - перезаписать ими текущий сегмент журнала)
      * @return true, если сохранение успешно
      */
     bool saveLog(const QString& filePath = QString());
 
+    /**
+     * @brief Устанавливает наибольшее время ожидания записи пачки.
+     * @param ms Интервал, мс.
+     */
+    void setFlushInterval(int ms);
+
+    /**
+     * @brief Устанавливает число записей, при котором пачка пишется, не дожидаясь интервала.
+     * @param count Число записей.
+     */
+    void setFlushCount(int count);
+
+    /**
+     * @brief Включает немедленную запись пачки при событии уровня Error.
+     * @param enabled true - писать сразу.
+     */
+    void setFlushOnError(bool enabled);
+
+    /**
+     * @brief Записывает накопленные записи и ждет окончания записи.
+     *
+     * Незаконченная серия повторов тоже записывается; следующий повтор продолжит ее.
+     */
+    void flush();
+
+    /**
+     * @brief Сворачивать ли одинаковые события подряд в одну запись (по умолчанию - да)
+     */
+    void setCoalesceRepeats(bool enabled);
+
+    /**
+     * @brief Устанавливает размер сегмента, после которого начинается новый.
+     * @param bytes Размер, байт (0 - без ограничения размера).
+     */
+    void setSegmentBytes(qint64 bytes);
+
+    /**
+     * @brief Включает начало нового сегмента при смене суток.
+     * @param enabled true - сегмент на каждые сутки.
+     */
+    void setRotateDaily(bool enabled);
+
+    /**
+     * @brief Устанавливает срок хранения закрытых сегментов.
+     * @param days Срок, сутки (0 - без ограничения срока).
+     * @param maxSegments Наибольшее число закрытых сегментов (0 - без ограничения).
+     */
+    void setRetention(int days, int maxSegments);
+
+    /**
+     * @brief Файлы сегментов журнала от старых к новым: закрытые сегменты и текущий.
+     *
+     * Сегменты читаются LogJournalReader.
+     */
+    QStringList segmentFiles() const;
+
 signals:
     /**
      * @brief Сигнал добавления записи в журнал
      * @param entry Запись журнала
      */
     void logEntryAdded(const LogEntry& entry);
+
+    /**
+     * @brief Сигнал обновления последней записи (повтор того же события)
+     * @param entry Запись с новым числом повторов и временем последнего повтора
+     */
+    void logEntryUpdated(const LogEntry& entry);
     
     /**
      * @brief Сигнал очистки журнала
@@ -157,23 +286,144 @@ signals:
 
 private:
     QString m_logFilePath;                    ///< Путь к файлу журнала
-    int m_maxEntries;                         ///< Максимальное количество записей в памяти
-    QVector<LogEntry> m_entries;              ///< Список записей журнала в памяти
+    LogBuffer m_entries;                      ///< Записи журнала в памяти (емкость - maxEntries)
+    LogIndex m_index;                         ///< Индекс записей m_entries для запросов
     
     mutable QMutex m_mutex;                   ///< Мьютекс для защиты доступа к данным
-    
+    bool m_coalesceRepeats = true;            ///< Сворачивать одинаковые события подряд
+    bool m_repeatCandidate = false;           ///< Последняя запись сделана log() и может повториться
+    bool m_repeatPending = false;             ///< Повторы последней записи еще не записаны на диск
+
+    // --- Очередь записи (под m_writeMutex) ---
+    std::mutex m_writeMutex;                  ///< Защита очереди и политики записи
+    std::condition_variable m_writeWake;      ///< Пробуждение потока записи
+    std::condition_variable m_writeDone;      ///< Окончание записи пачки (для flush())
+    std::deque<LogEntry> m_pendingWrites;     ///< Записи, ожидающие записи в файл
+    std::chrono::steady_clock::time_point m_firstPendingTime; ///< Время постановки первой записи пачки
+    quint64 m_queuedCount = 0;                ///< Поставлено в очередь за все время
+    quint64 m_writtenCount = 0;               ///< Обработано потоком записи за все время
+    int m_flushIntervalMs = 1000;             ///< Наибольшее ожидание пачки, мс
+    int m_flushCount = 256;                   ///< Размер пачки для записи без ожидания
+    bool m_flushOnError = true;               ///< Писать сразу при ошибке
+    bool m_urgentPending = false;             ///< В очереди есть запись для немедленной записи
+    bool m_flushRequested = false;            ///< Запрошена запись без ожидания
+    bool m_stopping = false;                  ///< Запрошена остановка потока
+    std::thread m_writerThread;               ///< Поток записи
+
+    // --- Файл журнала (под m_fileMutex) ---
+    std::mutex m_fileMutex;                   ///< Защита файла и пути от потока записи
+    QFile m_file;                             ///< Текущий сегмент журнала, открытый на дозапись
+    qint64 m_fileBytes = 0;                   ///< Размер текущего сегмента (без обращения к файловой системе)
+    QFile m_categoriesFile;                   ///< Справочник категорий, открытый на дозапись
+    QHash<quint32, quint32> m_categoryIds;    ///< Номер категории в LogStringTable -> номер в справочнике
+    QFile m_templatesFile;                    ///< Справочник шаблонов сообщений, открытый на дозапись
+    QHash<quint32, quint32> m_templateIds;    ///< Номер шаблона в LogStringTable -> номер в справочнике
+    QDate m_segmentDate;                      ///< Дата начала текущего сегмента
+    qint64 m_segmentBytes = 16LL * 1024 * 1024; ///< Размер сегмента (0 - без ограничения)
+    bool m_rotateDaily = true;                ///< Новый сегмент при смене суток
+    int m_retentionDays = 90;                 ///< Срок хранения закрытых сегментов, сутки
+    int m_maxSegments = 0;                    ///< Наибольшее число закрытых сегментов
+    QFuture<void> m_maintenance;              ///< Фоновое сжатие и удаление старых сегментов
+
+    /**
+     * @brief Добавляет запись в буфер и индекс (под m_mutex)
+     * @param entry Запись журнала
+     */
+    void appendEntry(const LogEntry& entry);
+
+    /**
+     * @brief Копии записей, удовлетворяющих запросу
+     * @param query Условия запроса
+     * @return Список записей журнала
+     */
+    QVector<LogEntry> entriesMatching(const LogQuery& query) const;
+
+    /**
+     * @brief Ставит в очередь записи незаконченную серию повторов (под m_mutex)
+     */
+    void endRepeatRun();
+
+    /**
+     * @brief Ждет записи всего, что поставлено в очередь (m_mutex можно держать)
+     */
+    void waitForWrites();
+
     /**
-     * @brief Запись в файл журнала
+     * @brief Ставит запись в очередь потока записи
      * @param entry Запись журнала
+     */
+    void enqueueWrite(const LogEntry& entry);
+
+    /**
+     * @brief Цикл потока записи
+     */
+    void writerLoop();
+
+    /**
+     * @brief Дописывает пачку записей в сегмент журнала одним вызовом write()
+     * @param batch Записи
      * @return true, если запись успешна
      */
-    bool writeToFile(const LogEntry& entry);
+    bool writeBatch(const std::deque<LogEntry>& batch);
+
+    /**
+     * @brief Открывает текущий сегмент на дозапись (под m_fileMutex)
+     *
+     * Оборванная при аварии запись в конце сегмента отбрасывается.
+     * @return true, если файл открыт
+     */
+    bool openSegment();
+
+    /**
+     * @brief Открывает справочники категорий и шаблонов на дозапись и читает их номера (под m_fileMutex)
+     * @return true, если справочники открыты
+     */
+    bool openDictionaries();
+
+    /**
+     * @brief Номер категории в справочнике; новая категория дописывается в справочник (под m_fileMutex)
+     * @param category Номер категории в LogStringTable::categories()
+     * @return Номер категории в справочнике или kNoDictionaryId, если справочник
+     *         не удалось открыть или дописать (он откроется заново при следующем вызове)
+     */
+    quint32 categoryId(quint32 category);
+
+    /**
+     * @brief Номер шаблона сообщения в справочнике; новый шаблон дописывается в справочник (под m_fileMutex)
+     * @param messageTemplate Номер шаблона в LogStringTable::templates()
+     * @return Номер шаблона в справочнике (0 - сообщение без шаблона) или kNoDictionaryId
+     */
+    quint32 templateId(quint32 messageTemplate);
+
+    /**
+     * @brief Закрывает текущий сегмент и переименовывает его в датированный (под m_fileMutex)
+     */
+    void rotateSegment();
+
+    /**
+     * @brief Запускает фоновое сжатие закрытых сегментов и удаление старых (под m_fileMutex)
+     */
+    void scheduleMaintenance();
+
+    /**
+     * @brief Закрывает файл журнала и меняет путь к нему (после flush())
+     * @param logFilePath Новый путь
+     */
+    void switchLogFile(const QString& logFilePath);
     
     /**
-     * @brief Чтение журнала из файла
+     * @brief Чтение последних записей журнала
      * @return true, если чтение успешно
      */
     bool readFromFile();
+
+    /**
+     * @brief Чтение последних записей текстового журнала прежнего формата
+     * @param filePath Путь к текстовому журналу
+     * @param maxEntries Наибольшее число записей
+     * @return Записи от старых к новым
+     */
+    QVector<LogEntry> readTextTail(const QString& filePath, int maxEntries) const;
     
     /**
      * @brief Форматирование записи журнала для записи в файл
@@ -183,7 +433,7 @@ private:
     QString formatLogEntry(const LogEntry& entry) const;
     
     /**
-     * @brief Парсинг строки журнала
+     * @brief Парсинг строки текстового журнала
      * @param line Строка журнала
      * @return Запись журнала
      */
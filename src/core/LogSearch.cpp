@@ -0,0 +1,263 @@
+// src/core/LogSearch.cpp
+#include "LogSearch.h"
+
+#include <QtAlgorithms> // Для qCountTrailingZeroBits
+#include <QtConcurrent>
+
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PARAMCONTROL_X86 1
+#include <emmintrin.h>
+#else
+#define PARAMCONTROL_X86 0
+#endif
+
+namespace ParamControl {
+
+namespace {
+
+/// Число записей в пачке сигнала resultsFound().
+constexpr int kResultBatch = 256;
+
+} // namespace
+
+LogSearch::LogSearch(QObject* parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<QVector<LogEntry>>("QVector<ParamControl::LogEntry>");
+}
+
+LogSearch::~LogSearch() {
+    cancel();
+}
+
+int LogSearch::start(const QString& logFilePath, const LogSearchOptions& options) {
+    cancel();
+    m_cancelled = false;
+
+    const int searchId = ++m_searchId;
+    m_future = QtConcurrent::run([this, logFilePath, options, searchId] {
+        const LogJournalReader reader(logFilePath);
+        const qint64 matches = search(
+            reader, options,
+            [this, searchId](const QVector<LogEntry>& entries) {
+                emit resultsFound(searchId, entries);
+                return !m_cancelled.load();
+            },
+            m_cancelled,
+            [this, searchId](int done, int total) { emit progressChanged(searchId, done, total); });
+        emit finished(searchId, matches, m_cancelled.load());
+    });
+    return searchId;
+}
+
+void LogSearch::cancel() {
+    m_cancelled = true;
+    m_future.waitForFinished();
+}
+
+bool LogSearch::isRunning() const {
+    return m_future.isRunning();
+}
+
+qint64 LogSearch::search(const LogJournalReader& reader, const LogSearchOptions& options,
+                         const Sink& sink, const std::atomic<bool>& cancelled,
+                         const std::function<void(int, int)>& progress) {
+    QByteArray needle = options.text.toUtf8();
+    if (needle.isEmpty()) {
+        return 0;
+    }
+    if (!options.caseSensitive) {
+        foldCase(reinterpret_cast<const uchar*>(needle.constData()),
+                 reinterpret_cast<uchar*>(needle.data()), needle.size());
+    }
+
+    // Записи категорий, содержащих подстроку, подходят без просмотра текста
+    const QStringList categories = reader.categories();
+    std::vector<bool> categoryMatches(size_t(categories.size()), false);
+    bool anyCategoryMatches = false;
+    for (int i = 0; i < categories.size(); ++i) {
+        QByteArray name = categories[i].toUtf8();
+        if (!options.caseSensitive) {
+            foldCase(reinterpret_cast<const uchar*>(name.constData()),
+                     reinterpret_cast<uchar*>(name.data()), name.size());
+        }
+        const uchar* begin = reinterpret_cast<const uchar*>(name.constData());
+        categoryMatches[size_t(i)] = find(begin, begin + name.size(), needle) != nullptr;
+        anyCategoryMatches = anyCategoryMatches || categoryMatches[size_t(i)];
+    }
+
+    const QStringList segments = reader.segmentFiles();
+    qint64 matches = 0;
+    QVector<LogEntry> batch;
+    for (int s = 0; s < segments.size() && !cancelled.load(std::memory_order_relaxed); ++s) {
+        // Все записи закрытого сегмента не позже времени его закрытия
+        const QDateTime closedAt = LogJournalReader::segmentClosedAt(reader.logFilePath(), segments[s]);
+        LogJournalReader::SegmentData segment;
+        if ((closedAt.isValid() && closedAt.toMSecsSinceEpoch() < options.fromMs) ||
+            !reader.loadSegment(segments[s], segment)) {
+            if (progress) {
+                progress(s + 1, segments.size());
+            }
+            continue;
+        }
+
+        // Без учета регистра ищем в приведенной копии: длина и смещения те же
+        const uchar* text = segment.data;
+        QByteArray folded;
+        if (!options.caseSensitive) {
+            folded.resize(int(segment.size));
+            foldCase(segment.data, reinterpret_cast<uchar*>(folded.data()), segment.size);
+            text = reinterpret_cast<const uchar*>(folded.constData());
+        }
+        const uchar* textEnd = text + segment.size;
+        const uchar* hit = find(text + kLogJournalHeaderBytes, textEnd, needle);
+
+        qint64 position = kLogJournalHeaderBytes;
+        while (position < segment.size && !cancelled.load(std::memory_order_relaxed)) {
+            if (!hit && !anyCategoryMatches) {
+                break;
+            }
+            const quint32 bytes = archiveGet<quint32>(segment.data + position);
+            const qint64 next = position + kLogJournalFrameBytes + bytes;
+
+            // До записи с найденным местом идем по длинам, не разбирая записи
+            if (!anyCategoryMatches && hit - text >= next) {
+                position = next;
+                continue;
+            }
+
+            LogJournalEvent event;
+            if (!logJournalReadEvent(segment.data + position + 4, bytes, event)) {
+                break;
+            }
+
+            bool matched = event.categoryId < categoryMatches.size() && categoryMatches[event.categoryId];
+
+            // Место засчитывается, только если подстрока целиком в сообщении или значении
+            const qint64 messageStart = reinterpret_cast<const uchar*>(event.message) - segment.data;
+            const qint64 valueStart = reinterpret_cast<const uchar*>(event.value) - segment.data;
+            while (!matched && hit && hit - text < next) {
+                const qint64 offset = hit - text;
+                const qint64 offsetEnd = offset + needle.size();
+                if ((offset >= messageStart && offsetEnd <= messageStart + event.messageBytes) ||
+                    (offset >= valueStart && offsetEnd <= valueStart + event.valueBytes)) {
+                    matched = true;
+                } else {
+                    hit = find(hit + 1, textEnd, needle);
+                }
+            }
+
+            // Запись, замененную следующей записью серии повторов, найдет сама серия
+            if (matched && next + kLogJournalFrameBytes <= segment.size &&
+                logJournalSupersedes(segment.data + next + 4)) {
+                matched = false;
+            }
+
+            if (matched && event.timestampMs >= options.fromMs && event.timestampMs <= options.toMs) {
+                batch.append(reader.toEntry(event));
+                ++matches;
+                if (batch.size() >= kResultBatch) {
+                    if (!sink(batch)) {
+                        return matches;
+                    }
+                    batch.clear();
+                }
+            }
+
+            // Следующие места ищем за концом записи
+            while (hit && hit - text < next) {
+                hit = find(hit + 1, textEnd, needle);
+            }
+            position = next;
+        }
+
+        if (!batch.isEmpty()) {
+            if (!sink(batch)) {
+                return matches;
+            }
+            batch.clear();
+        }
+        if (progress) {
+            progress(s + 1, segments.size());
+        }
+    }
+    return matches;
+}
+
+const uchar* LogSearch::find(const uchar* begin, const uchar* end, const QByteArray& needle) {
+    const qint64 length = needle.size();
+    if (length == 0 || end - begin < length) {
+        return nullptr;
+    }
+
+    const uchar* pattern = reinterpret_cast<const uchar*>(needle.constData());
+    const uchar* last = end - length;   // Последнее возможное начало
+    const uchar* position = begin;
+
+#if PARAMCONTROL_X86
+    // Кандидаты - позиции, где совпали и первый, и последний байт подстроки
+    const __m128i first = _mm_set1_epi8(char(pattern[0]));
+    const __m128i tail = _mm_set1_epi8(char(pattern[length - 1]));
+    for (; last - position >= 15; position += 16) {
+        const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+        const __m128i back = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position + length - 1));
+        quint32 mask = quint32(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(back, tail))));
+        while (mask != 0) {
+            const uchar* candidate = position + qCountTrailingZeroBits(mask);
+            if (length <= 2 || std::memcmp(candidate + 1, pattern + 1, size_t(length - 2)) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    while (position <= last) {
+        position = static_cast<const uchar*>(std::memchr(position, pattern[0], size_t(last - position + 1)));
+        if (!position) {
+            return nullptr;
+        }
+        if (std::memcmp(position + 1, pattern + 1, size_t(length - 1)) == 0) {
+            return position;
+        }
+        ++position;
+    }
+    return nullptr;
+}
+
+void LogSearch::foldCase(const uchar* source, uchar* target, qint64 size) {
+    for (qint64 i = 0; i < size; ++i) {
+        const uchar c = source[i];
+        if (c >= 'A' && c <= 'Z') {
+            target[i] = uchar(c + ('a' - 'A'));
+            continue;
+        }
+
+        // Кириллица: U+0400-U+040F -> U+0450-U+045F, U+0410-U+041F -> U+0430-U+043F,
+        // U+0420-U+042F -> U+0440-U+044F (два байта в два байта)
+        if (c == 0xD0 && i + 1 < size) {
+            const uchar next = source[i + 1];
+            if (next >= 0x80 && next <= 0xAF) {
+                if (next <= 0x8F) {
+                    target[i] = 0xD1;
+                    target[i + 1] = uchar(next + 0x10);
+                } else if (next <= 0x9F) {
+                    target[i] = 0xD0;
+                    target[i + 1] = uchar(next + 0x20);
+                } else {
+                    target[i] = 0xD1;
+                    target[i + 1] = uchar(next - 0x20);
+                }
+                ++i;
+                continue;
+            }
+        }
+        target[i] = c;
+    }
+}
+
+} // namespace ParamControl
@@ -0,0 +1,139 @@
+// src/core/LogSearch.h
+#pragma once
+
+#include <QByteArray>
+#include <QFuture>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <functional>
+#include <limits>
+
+#include "LogEntry.h"
+#include "LogJournalReader.h"
+
+namespace ParamControl {
+
+/**
+ * @brief Условия полнотекстового поиска по журналу.
+ */
+struct LogSearchOptions {
+    QString text;                                       ///< Искомая подстрока
+    bool caseSensitive = false;                         ///< Учитывать регистр
+    qint64 fromMs = std::numeric_limits<qint64>::min(); ///< Начало интервала времени (мс от эпохи)
+    qint64 toMs = std::numeric_limits<qint64>::max();   ///< Конец интервала (включительно)
+};
+
+/**
+ * @brief Полнотекстовый поиск по всем сегментам журнала на диске.
+ *
+ * Подстрока ищется в сообщении, значении и категории записей. Сегмент
+ * просматривается целиком: несжатый отображается в память, сжатый (.qz)
+ * распаковывается. Подстрока в UTF-8 ищется по байтам сегмента векторным
+ * сравнением (SSE2: первый и последний байт подстроки по 16 позиций за раз,
+ * затем сравнение остатка), и только найденные места сопоставляются
+ * с записями. Так просмотр сегмента стоит примерно как чтение его с диска.
+ *
+ * UTF-8 самосинхронизируется, поэтому совпадение корректной подстроки всегда
+ * начинается с начала символа. Без учета регистра подстрока и сегмент
+ * приводятся к нижнему регистру побайтно с сохранением длины: ASCII
+ * и кириллица U+0400-U+042F (включая Ё), так что смещения совпадений
+ * в приведенной копии совпадают со смещениями в сегменте.
+ *
+ * start() запускает поиск в пуле потоков Qt. Найденные записи передаются
+ * сигналом resultsFound() пачками по мере нахождения, от старых к новым.
+ * Каждый запуск получает номер; сигналы прерванного поиска, еще стоящие
+ * в очереди, можно отбросить по номеру.
+ */
+class LogSearch : public QObject {
+    Q_OBJECT
+
+public:
+    /// Получатель пачки найденных записей; false - прервать поиск.
+    using Sink = std::function<bool(const QVector<LogEntry>&)>;
+
+    /**
+     * @brief Конструктор.
+     * @param parent Родительский объект.
+     */
+    explicit LogSearch(QObject* parent = nullptr);
+
+    /**
+     * @brief Деструктор: прерывает поиск и ждет его окончания.
+     */
+    ~LogSearch() override;
+
+    /**
+     * @brief Запускает поиск, прерывая предыдущий.
+     * @param logFilePath Путь к журналу, как он передается LogManager.
+     * @param options Условия поиска.
+     * @return Номер поиска (передается в сигналах).
+     */
+    int start(const QString& logFilePath, const LogSearchOptions& options);
+
+    /**
+     * @brief Прерывает поиск и ждет его окончания.
+     */
+    void cancel();
+
+    /**
+     * @brief Поиск выполняется.
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Поиск в вызывающем потоке.
+     * @param reader Журнал.
+     * @param options Условия поиска.
+     * @param sink Получатель пачек найденных записей.
+     * @param cancelled Флаг прерывания (проверяется между записями).
+     * @param progress Вызывается после каждого сегмента (просмотрено, всего).
+     * @return Число найденных записей.
+     */
+    static qint64 search(const LogJournalReader& reader, const LogSearchOptions& options,
+                         const Sink& sink, const std::atomic<bool>& cancelled,
+                         const std::function<void(int, int)>& progress = nullptr);
+
+    /**
+     * @brief Позиция первого вхождения needle в [begin, end) или nullptr.
+     */
+    static const uchar* find(const uchar* begin, const uchar* end, const QByteArray& needle);
+
+    /**
+     * @brief Приводит UTF-8 к нижнему регистру с сохранением длины (ASCII и кириллица).
+     */
+    static void foldCase(const uchar* source, uchar* target, qint64 size);
+
+signals:
+    /**
+     * @brief Найдена пачка записей.
+     * @param searchId Номер поиска.
+     * @param entries Записи от старых к новым.
+     */
+    void resultsFound(int searchId, const QVector<ParamControl::LogEntry>& entries);
+
+    /**
+     * @brief Просмотрен очередной сегмент.
+     * @param searchId Номер поиска.
+     * @param done Просмотрено сегментов.
+     * @param total Всего сегментов.
+     */
+    void progressChanged(int searchId, int done, int total);
+
+    /**
+     * @brief Поиск закончен.
+     * @param searchId Номер поиска.
+     * @param matches Число найденных записей.
+     * @param cancelled Поиск прерван.
+     */
+    void finished(int searchId, qint64 matches, bool cancelled);
+
+private:
+    QFuture<void> m_future;                 ///< Выполняемый поиск
+    std::atomic<bool> m_cancelled{false};   ///< Запрошено прерывание
+    int m_searchId = 0;                     ///< Номер последнего поиска
+};
+
+} // namespace ParamControl
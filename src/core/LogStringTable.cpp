@@ -0,0 +1,100 @@
+// src/core/LogStringTable.cpp
+#include "LogStringTable.h"
+
+#include <QMutexLocker>
+
+namespace ParamControl {
+
+LogStringTable::LogStringTable() {
+    m_ids.insert(QString(), 0);
+    m_strings.append(QString());
+}
+
+LogStringTable& LogStringTable::categories() {
+    static LogStringTable table;
+    return table;
+}
+
+LogStringTable& LogStringTable::templates() {
+    static LogStringTable table;
+    return table;
+}
+
+quint32 LogStringTable::intern(const QString& text) {
+    if (text.isEmpty()) {
+        return 0;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_ids.constFind(text);
+    if (it != m_ids.constEnd()) {
+        return it.value();
+    }
+
+    const quint32 id = quint32(m_strings.size());
+    m_ids.insert(text, id);
+    m_strings.append(text);
+    return id;
+}
+
+quint32 LogStringTable::find(const QString& text) const {
+    if (text.isEmpty()) {
+        return 0;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    return m_ids.value(text, kNotFound);
+}
+
+QString LogStringTable::at(quint32 id) const {
+    QMutexLocker locker(&m_mutex);
+    return id < quint32(m_strings.size()) ? m_strings[int(id)] : QString();
+}
+
+QString LogStringTable::format(const QString& messageTemplate, const QStringList& args,
+                              QVector<int>* argSpans) {
+    if (argSpans) {
+        argSpans->fill(-1, 2 * args.size());
+        for (int i = 1; i < argSpans->size(); i += 2) {
+            (*argSpans)[i] = 0;
+        }
+    }
+    if (args.isEmpty()) {
+        return messageTemplate;
+    }
+
+    QString result;
+    result.reserve(messageTemplate.size() + 16 * args.size());
+    const int size = messageTemplate.size();
+    int i = 0;
+    while (i < size) {
+        const QChar c = messageTemplate[i];
+        if (c == QChar('%') && i + 1 < size) {
+            // Номер места - одна или две цифры
+            int number = 0;
+            int length = 1;
+            while (length < 3 && i + length < size) {
+                const ushort digit = messageTemplate[i + length].unicode();
+                if (digit < '0' || digit > '9') {
+                    break;
+                }
+                number = number * 10 + (digit - '0');
+                ++length;
+            }
+            if (number >= 1 && number <= args.size()) {
+                if (argSpans && (*argSpans)[2 * (number - 1)] < 0) {
+                    (*argSpans)[2 * (number - 1)] = result.size();
+                    (*argSpans)[2 * (number - 1) + 1] = args[number - 1].size();
+                }
+                result += args[number - 1];
+                i += length;
+                continue;
+            }
+        }
+        result += c;
+        ++i;
+    }
+    return result;
+}
+
+} // namespace ParamControl
@@ -0,0 +1,74 @@
+// src/core/LogStringTable.h
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace ParamControl {
+
+/**
+ * @brief Таблица строк журнала: каждой строке - постоянный номер.
+ *
+ * Записи журнала в памяти хранят вместо строк категорий и шаблонов
+ * сообщений их номера: одинаковые строки хранятся один раз на процесс,
+ * а категории в фильтрах сравниваются как целые числа. Таблицы только
+ * пополняются, поэтому номер действует до завершения программы.
+ * Номер 0 в каждой таблице - пустая строка.
+ *
+ * Класс потокобезопасен: записи из журнала на диске строятся и в фоновом
+ * потоке (LogSearch).
+ */
+class LogStringTable {
+public:
+    /// Номер, возвращаемый find() для строки, которой нет в таблице.
+    static constexpr quint32 kNotFound = 0xFFFFFFFF;
+
+    /**
+     * @brief Категории событий и имена параметров.
+     */
+    static LogStringTable& categories();
+
+    /**
+     * @brief Шаблоны сообщений ("Удален параметр %1 (%2)").
+     */
+    static LogStringTable& templates();
+
+    /**
+     * @brief Номер строки (строка добавляется, если ее еще нет).
+     */
+    quint32 intern(const QString& text);
+
+    /**
+     * @brief Номер строки или kNotFound (таблица не пополняется).
+     */
+    quint32 find(const QString& text) const;
+
+    /**
+     * @brief Строка по номеру (для неизвестного номера - пустая).
+     */
+    QString at(quint32 id) const;
+
+    /**
+     * @brief Подставляет аргументы в шаблон за один проход.
+     *
+     * %1..%99 заменяются аргументами по номеру; места без аргумента
+     * и '%' в подставленных аргументах остаются как есть.
+     * @param argSpans Если задан - положение первой подстановки каждого
+     *        аргумента в результате: пары (начало, длина) в символах QString,
+     *        (-1, 0) для аргумента, которого нет в шаблоне.
+     */
+    static QString format(const QString& messageTemplate, const QStringList& args,
+                          QVector<int>* argSpans = nullptr);
+
+private:
+    LogStringTable();
+
+    mutable QMutex m_mutex;                 ///< Защищает таблицу
+    QHash<QString, quint32> m_ids;          ///< Номера строк
+    QVector<QString> m_strings;             ///< Строки по номерам
+};
+
+} // namespace ParamControl
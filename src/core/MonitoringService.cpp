@@ -26,6 +26,7 @@ MonitoringService::MonitoringService(
     , m_running(false)
     , m_watchdogTriggered(false)
     , m_parameterListChanged(false)
+    , m_parameterListEdited(false)
     , m_tmiStatus(true)
 {
     // Настраиваем таймер мониторинга
@@ -52,6 +53,9 @@ MonitoringService::MonitoringService(
             this, &MonitoringService::onParameterListChanged);
     connect(m_parameterModel.get(), &ParameterModel::parameterUpdated,
             this, &MonitoringService::onParameterListChanged);
+    // Загрузка списка из файла перекомпилирует программу целиком
+    connect(m_parameterModel.get(), &ParameterModel::modelReset,
+            this, [this]() { m_parameterListChanged = true; });
             
     // Подключаем сигналы TmiAnalyzer
     connect(m_tmiAnalyzer.get(), &TmiAnalyzer::tmiStatusChanged,
@@ -171,8 +175,8 @@ void MonitoringService::checkParameters() {
     try {
         parameterValues = m_xmlParser->parseParameterResponse(*responseOpt);
     } catch (const std::exception& e) {
-        m_logManager->log(LogLevel::Error, "СОТМ", 
-                          QString("Ошибка при разборе ответа: %1").arg(e.what()), "", LogStatus::Error);
+        m_logManager->logTemplate(LogLevel::Error, "СОТМ", "Ошибка при разборе ответа: %1",
+                                  {QString(e.what())}, "", LogStatus::Error);
         
         // Включаем оповещение о проблемах с ТМИ
         m_alertManager->playAlert(AlertType::NoTmi);
@@ -249,25 +253,30 @@ void MonitoringService::resetWatchdog() {
 void MonitoringService::refreshParameterList() {
     // Обновляем список только если он изменился
     if (m_parameterListChanged) {
-        // Получаем актуальный список имен параметров
-        m_currentParameterNames = m_parameterModel->getAllParameterNames();
+        // Запрашиваем входы скомпилированной программы: идентификаторы выражений
+        // нужны для их вычисления, а имена правил-выражений у СОТМ не запрашиваются
+        m_currentParameterNames = m_parameterModel->getInputNames();
         m_parameterListChanged = false;
         
         // Логируем обновление списка
-        m_logManager->log(LogLevel::Info, "Мониторинг", 
-                          QString("Обновлен список контролируемых параметров (%1)")
-                          .arg(m_currentParameterNames.size()));
+        m_logManager->logTemplate(LogLevel::Info, "Мониторинг", 
+                                  "Обновлен список контролируемых параметров (%1)",
+                                  {QString::number(m_currentParameterNames.size())});
         
-        // Сохраняем параметры
-        const SotmSettings& settings = m_sotmClient->getSettings();
-        QString paramFileName = QString("parameters_ka%1.json").arg(settings.kaNumber);
-        m_parameterModel->saveParameters(paramFileName);
+        // Сохраняем параметры, только если их правили: после загрузки из
+        // файла перезаписывать его нечем
+        if (m_parameterListEdited.exchange(false)) {
+            const SotmSettings& settings = m_sotmClient->getSettings();
+            QString paramFileName = QString("parameters_ka%1.json").arg(settings.kaNumber);
+            m_parameterModel->saveParameters(paramFileName);
+        }
     }
 }
 
 void MonitoringService::onParameterListChanged(const QString& name, ParameterType type) {
     // Устанавливаем флаг необходимости обновления списка параметров
     m_parameterListChanged = true;
+    m_parameterListEdited = true;
     
     // Логируем изменение
     QString typeStr;
@@ -277,11 +286,15 @@ void MonitoringService::onParameterListChanged(const QString& name, ParameterTyp
         case ParameterType::InLimits: typeStr = "InLimits"; break;
         case ParameterType::OutOfLimits: typeStr = "OutOfLimits"; break;
         case ParameterType::Changed: typeStr = "Changed"; break;
+        case ParameterType::Expression: typeStr = "Expression"; break;
+        case ParameterType::RateOfChange: typeStr = "RateOfChange"; break;
+        case ParameterType::Trend: typeStr = "Trend"; break;
+        case ParameterType::Statistic: typeStr = "Statistic"; break;
         default: typeStr = "Unknown"; break;
     }
     
-    m_logManager->log(LogLevel::Info, "Мониторинг", 
-                     QString("Изменен список параметров: %1 (%2)").arg(name).arg(typeStr));
+    m_logManager->logTemplate(LogLevel::Info, "Мониторинг", 
+                              "Изменен список параметров: %1 (%2)", {name, typeStr});
 }
 
 void MonitoringService::onTmiAnalyzerStatusChanged(bool status) {
@@ -313,10 +326,11 @@ void MonitoringService::onTmiAnalyzerStatusChanged(bool status) {
 
 void MonitoringService::onTmiAnomalyDetected(int type, const QString& message) {
     // Логируем аномалию
-    m_logManager->log(
+    m_logManager->logTemplate(
         LogLevel::Error,
         "Телеметрия",
-        QString("Аномалия ТМИ тип %1: %2").arg(type).arg(message),
+        "Аномалия ТМИ тип %1: %2",
+        {QString::number(type), message},
         "",
         LogStatus::Error
     );
@@ -330,6 +344,9 @@ void MonitoringService::setPollingInterval(int interval) {
     if (interval > 0) {
         MONITORING_INTERVAL_MS = interval;
         
+        // Окна правил, заданные длительностью, должны вмещать отсчеты за это время
+        m_parameterModel->setSampleInterval(interval);
+        
         // Если мониторинг запущен, перезапускаем таймер
         if (m_running && m_monitoringTimer->isActive()) {
             m_monitoringTimer->setInterval(interval);
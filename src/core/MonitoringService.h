@@ -147,9 +147,10 @@ private:
     std::atomic<bool> m_running;                      ///< Флаг работы сервиса
     std::atomic<bool> m_watchdogTriggered;            ///< Флаг срабатывания сторожевого таймера
     std::atomic<bool> m_parameterListChanged;         ///< Флаг изменения списка параметров
+    std::atomic<bool> m_parameterListEdited;          ///< Список изменен пользователем (нужно сохранить файл)
     std::atomic<bool> m_tmiStatus;                    ///< Статус ТМИ
     
-    QVector<QString> m_currentParameterNames;         ///< Текущий список имен параметров
+    QVector<QString> m_currentParameterNames;         ///< Текущий список запрашиваемых входов программы
     
     /**
      * @brief Сброс сторожевого таймера
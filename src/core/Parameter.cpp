@@ -5,6 +5,10 @@
 #include "ParameterInLimits.h"
 #include "ParameterOutOfLimits.h"
 #include "ParameterChanged.h"
+#include "ParameterExpression.h"
+#include "ParameterRateOfChange.h"
+#include "ParameterTrend.h"
+#include "ParameterStatistic.h"
 
 #include <QVariantList>
 #include <QDebug> // Для логирования ошибок
@@ -40,6 +44,15 @@ bool Parameter::updateValue(const QVariant& value) {
     return oldStatus != m_status;
 }
 
+bool Parameter::applyEvaluation(const QVariant& value, ParameterStatus status) {
+    ParameterStatus oldStatus = m_status;
+
+    m_currentValue = value;
+    m_status = status;
+
+    return oldStatus != m_status;
+}
+
 // Фабричный метод для создания параметров
 std::shared_ptr<Parameter> Parameter::create(
     const QString& name,
@@ -90,6 +103,47 @@ std::shared_ptr<Parameter> Parameter::create(
             case ParameterType::Changed:
                 parameter = std::make_shared<ParameterChanged>(name);
                 break;
+            case ParameterType::Expression:
+                parameter = std::make_shared<ParameterExpression>(name, targetValue.toString());
+                break;
+            case ParameterType::RateOfChange:
+            case ParameterType::Trend: {
+                const QVariantList settings = targetValue.toList();
+                bool firstOk = false;
+                bool secondOk = false;
+                if (settings.size() >= 2) {
+                    settings[0].toDouble(&firstOk);
+                    settings[1].toDouble(&secondOk);
+                }
+                if (!firstOk || !secondOk) {
+                    qWarning() << "Parameter::create: Invalid target value for window parameter" << name;
+                } else if (type == ParameterType::RateOfChange) {
+                    parameter = std::make_shared<ParameterRateOfChange>(
+                        name, settings[0].toDouble(), settings[1].toDouble());
+                } else {
+                    parameter = std::make_shared<ParameterTrend>(
+                        name, settings[0].toInt(), settings[1].toDouble());
+                }
+                break;
+            }
+            case ParameterType::Statistic: {
+                const QVariantList settings = targetValue.toList();
+                WindowStatistic statistic;
+                bool thresholdOk = false;
+                bool windowOk = false;
+                if (settings.size() >= 3) {
+                    settings[1].toDouble(&thresholdOk);
+                    settings[2].toDouble(&windowOk);
+                }
+                if (thresholdOk && windowOk &&
+                    ParameterStatistic::parseStatistic(settings[0].toString(), statistic)) {
+                    parameter = std::make_shared<ParameterStatistic>(
+                        name, statistic, settings[1].toDouble(), settings[2].toDouble());
+                } else {
+                    qWarning() << "Parameter::create: Invalid target value for Statistic parameter" << name;
+                }
+                break;
+            }
             default:
                  qWarning() << "Parameter::create: Unknown parameter type for" << name;
                  break; // Не создаем параметр неизвестного типа
@@ -154,5 +208,18 @@ void Parameter::setDescription(const QString& description) {
     m_description = description;
 }
 
+ConditionFilter Parameter::getFilter() const {
+    return m_filter;
+}
+
+void Parameter::setFilter(const ConditionFilter& filter) {
+    m_filter = filter;
+    m_filter.hysteresis = qMax(0.0, filter.hysteresis);
+    m_filter.entrySamples = qMax(1, filter.entrySamples);
+    m_filter.entrySeconds = qMax(0.0, filter.entrySeconds);
+    m_filter.exitSamples = qMax(1, filter.exitSamples);
+    m_filter.exitSeconds = qMax(0.0, filter.exitSeconds);
+}
+
 
 } // namespace ParamControl
@@ -16,7 +16,11 @@ enum class ParameterType {
     NotEquals,      ///< Неравенство заданному значению
     InLimits,       ///< Нахождение в пределах диапазона [min, max]
     OutOfLimits,    ///< Выход за пределы диапазона [min, max]
-    Changed         ///< Изменение значения по сравнению с предыдущим
+    Changed,        ///< Изменение значения по сравнению с предыдущим
+    Expression,     ///< Выражение над несколькими параметрами (см. ParameterExpression)
+    RateOfChange,   ///< Скорость изменения за окно времени (см. ParameterRateOfChange)
+    Trend,          ///< Изменение за последние N отсчетов (см. ParameterTrend)
+    Statistic       ///< Статистика скользящего окна (см. ParameterStatistic)
 };
 Q_ENUM(ParameterType) // Позволяет использовать enum в метаобъектной системе Qt
 
@@ -30,6 +34,53 @@ enum class ParameterStatus {
 };
 Q_ENUM(ParameterStatus)
 
+/**
+ * @brief Настройки подавления дребезга статуса параметра.
+ *
+ * Гистерезис задает зону возврата для условий с границами (InLimits,
+ * OutOfLimits): после перехода в Error параметр возвращается в норму, только
+ * когда значение отходит от границы внутрь нормы на hysteresis.
+ *
+ * Подтверждение действует для всех типов условий: новый статус принимается,
+ * только если он держится не менее заданного числа тактов подряд и не менее
+ * заданного времени. Вход в Error и выход из него настраиваются отдельно.
+ * Значения по умолчанию (1 такт, 0 секунд, без гистерезиса) сохраняют
+ * мгновенное переключение статуса.
+ */
+struct ConditionFilter {
+    double hysteresis = 0.0;    ///< Ширина зоны возврата (в единицах параметра)
+    int entrySamples = 1;       ///< Тактов подряд для перехода в Error
+    double entrySeconds = 0.0;  ///< Секунд удержания для перехода в Error
+    int exitSamples = 1;        ///< Тактов подряд для возврата в норму
+    double exitSeconds = 0.0;   ///< Секунд удержания для возврата в норму
+
+    /**
+     * @brief Проверяет, что фильтр не требует подтверждения статуса.
+     */
+    bool isImmediate() const {
+        return entrySamples <= 1 && exitSamples <= 1 && entrySeconds <= 0.0 && exitSeconds <= 0.0;
+    }
+
+    /**
+     * @brief Проверяет, что все настройки имеют значения по умолчанию.
+     */
+    bool isDefault() const {
+        return isImmediate() && hysteresis <= 0.0;
+    }
+
+    /**
+     * @brief Проверяет, что из Error по гистерезису можно вернуться.
+     *
+     * Имеет смысл только для InLimits: зона возврата
+     * [lower + hysteresis, upper - hysteresis] должна быть непустой. Для
+     * OutOfLimits зона возврата лежит за границами и достижима при любом
+     * гистерезисе.
+     */
+    bool hysteresisFits(double lower, double upper) const {
+        return hysteresis <= 0.0 || 2.0 * hysteresis < upper - lower;
+    }
+};
+
 // Прямое объявление, чтобы избежать циклической зависимости, если ParameterModel включает Parameter.h
 class ParameterModel;
 
@@ -68,6 +119,17 @@ public:
      */
     virtual bool updateValue(const QVariant& value);
 
+    /**
+     * @brief Применяет результат проверки, вычисленный скомпилированной программой условий.
+     *
+     * Используется ParameterModel вместо updateValue(): условие уже проверено
+     * ConditionProgram, объект параметра только сохраняет значение и статус.
+     * @param value Новое значение параметра.
+     * @param status Вычисленный статус.
+     * @return true, если статус параметра изменился, иначе false.
+     */
+    bool applyEvaluation(const QVariant& value, ParameterStatus status);
+
     /**
      * @brief Чисто виртуальный метод для проверки условия контроля.
      *
@@ -134,6 +196,9 @@ public:
     QString getDescription() const;
     void setDescription(const QString& description);
 
+    ConditionFilter getFilter() const;
+    void setFilter(const ConditionFilter& filter);
+
 protected:
     QString m_name;                 ///< Имя параметра.
     ParameterType m_type;           ///< Тип условия контроля.
@@ -142,6 +207,7 @@ protected:
     bool m_soundEnabled;            ///< Флаг включения звукового оповещения.
     QString m_soundFile;            ///< Путь к звуковому файлу оповещения.
     QString m_description;          ///< Описание параметра.
+    ConditionFilter m_filter;       ///< Гистерезис и подтверждение статуса.
 };
 
 } // namespace ParamControl
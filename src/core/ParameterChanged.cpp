@@ -22,8 +22,7 @@ bool ParameterChanged::checkCondition(const QVariant& value) {
     }
 
     // Сравниваем текущее значение с последним
-    // Используем QVariant::compare для надежности
-    bool changed = (QVariant::compare(value, m_lastValue) != 0);
+    bool changed = valueChanged(m_lastValue, value);
 
     if (changed) {
         m_justChanged = true; // Запоминаем, что только что изменилось
@@ -75,5 +74,9 @@ bool ParameterChanged::updateValue(const QVariant& value) {
     return oldStatus != m_status;
 }
 
+bool ParameterChanged::valueChanged(const QVariant& previous, const QVariant& current) {
+    // Используем QVariant::compare для надежности
+    return QVariant::compare(current, previous) != 0;
+}
 
 } // namespace ParamControl
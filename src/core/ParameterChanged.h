@@ -52,6 +52,14 @@ public:
      */
     bool updateValue(const QVariant& value) override;
 
+    /**
+     * @brief Сравнение значений, по которому правило Changed фиксирует изменение.
+     *
+     * Общее для объекта параметра и ConditionProgram: значения сравниваются
+     * как QVariant, поэтому 1 и 1.0 равны, а строки "1" и "1.0" различаются.
+     * @return true, если значение изменилось.
+     */
+    static bool valueChanged(const QVariant& previous, const QVariant& current);
 
 private:
     QVariant m_lastValue;  ///< Последнее зафиксированное значение.
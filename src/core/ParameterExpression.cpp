@@ -0,0 +1,46 @@
+// src/core/ParameterExpression.cpp
+#include "ParameterExpression.h"
+#include "Expression.h"
+
+#include <QDebug>
+
+namespace ParamControl {
+
+ParameterExpression::ParameterExpression(const QString& name, const QString& expression)
+    : Parameter(name, ParameterType::Expression)
+    , m_expression(expression.trimmed())
+{
+}
+
+bool ParameterExpression::checkCondition(const QVariant& value) {
+    bool ok = false;
+    const double result = value.toDouble(&ok);
+    return ok && Expression::isTrue(result);
+}
+
+QString ParameterExpression::getConditionDescription() const {
+    return m_expression;
+}
+
+QVariant ParameterExpression::getTargetValue() const {
+    return m_expression;
+}
+
+void ParameterExpression::setTargetValue(const QVariant& value) {
+    QString error;
+    if (!setExpression(value.toString(), &error)) {
+        qWarning() << "ParameterExpression: Invalid expression for parameter" << getName() << "-" << error
+                   << "- keeping" << m_expression;
+    }
+}
+
+bool ParameterExpression::setExpression(const QString& expression, QString* errorMessage) {
+    const QString text = expression.trimmed();
+    if (!Expression::compile(text, errorMessage)) {
+        return false;
+    }
+    m_expression = text;
+    return true;
+}
+
+} // namespace ParamControl
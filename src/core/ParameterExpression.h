@@ -0,0 +1,73 @@
+// src/core/ParameterExpression.h
+#pragma once
+
+#include "Parameter.h"
+
+namespace ParamControl {
+
+/**
+ * @brief Класс параметра-выражения над несколькими параметрами ТМИ.
+ *
+ * Целевое значение - текст выражения (см. Expression), например
+ * "ТЕМП1 - ТЕМП2 > 15". Имя параметра - имя правила; по нему другие
+ * выражения могут ссылаться на результат этого выражения. Имя правила
+ * не должно совпадать с параметром ТМИ, который контролируют правила
+ * других типов: выражения, читающие такое имя, отключаются как
+ * неоднозначные. Параметр в норме, когда выражение истинно.
+ *
+ * Выражение вычисляется скомпилированной программой ConditionProgram,
+ * которой известны значения всех входов такта.
+ */
+class ParameterExpression : public Parameter {
+public:
+    /**
+     * @brief Конструктор.
+     * @param name Имя правила.
+     * @param expression Текст выражения.
+     */
+    ParameterExpression(const QString& name, const QString& expression);
+    ~ParameterExpression() override = default;
+
+    /**
+     * @brief Проверяет уже вычисленный результат выражения.
+     *
+     * Объект параметра не имеет доступа к другим параметрам такта, поэтому
+     * value трактуется как результат выражения, вычисленный ConditionProgram.
+     * @param value Результат выражения.
+     * @return true, если результат истинен (ненулевой и не NaN).
+     */
+    bool checkCondition(const QVariant& value) override;
+
+    /**
+     * @brief Возвращает описание условия контроля (текст выражения).
+     * @return Строка с описанием условия.
+     */
+    QString getConditionDescription() const override;
+
+    /**
+     * @brief Возвращает текст выражения.
+     * @return Текст выражения.
+     */
+    QVariant getTargetValue() const override;
+
+    /**
+     * @brief Устанавливает текст выражения.
+     *
+     * Выражение с синтаксической ошибкой не принимается (см. setExpression()).
+     * @param value Новый текст выражения.
+     */
+    void setTargetValue(const QVariant& value) override;
+
+    /**
+     * @brief Устанавливает текст выражения, если он компилируется.
+     * @param expression Новый текст выражения.
+     * @param errorMessage Описание синтаксической ошибки (может быть nullptr).
+     * @return false, если выражение не компилируется; прежний текст сохраняется.
+     */
+    bool setExpression(const QString& expression, QString* errorMessage = nullptr);
+
+private:
+    QString m_expression; ///< Текст выражения.
+};
+
+} // namespace ParamControl
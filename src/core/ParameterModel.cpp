@@ -6,6 +6,7 @@
 #include <QJsonObject>
 #include <QTextStream>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QDebug> // Для логирования
 
 // Включаем заголовки для всех типов параметров
@@ -14,12 +15,19 @@
 #include "ParameterInLimits.h"
 #include "ParameterOutOfLimits.h"
 #include "ParameterChanged.h"
+#include "ParameterExpression.h"
 
 namespace ParamControl {
 
 ParameterModel::ParameterModel(QObject* parent)
     : QObject(parent)
+    , m_history(std::make_shared<HistoryStore>())
 {
+    // Результат такта может передаваться в другой поток через очередь сигналов
+    qRegisterMetaType<TickResultPtr>("TickResultPtr");
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    publishSnapshot();
 }
 
 ParameterModel::~ParameterModel() {
@@ -35,17 +43,20 @@ bool ParameterModel::addParameter(const std::shared_ptr<Parameter>& parameter) {
     std::lock_guard<std::mutex> lock(m_mutex);
 
     // Проверяем, не существует ли уже параметр с таким именем и типом
-    for (const auto& existingParam : m_parameters) {
-        if (existingParam->getName() == parameter->getName() &&
-            existingParam->getType() == parameter->getType()) {
-            qWarning() << "ParameterModel::addParameter: Parameter" << parameter->getName()
-                       << "with type" << static_cast<int>(parameter->getType()) << "already exists.";
-            return false; // Параметр с таким именем и типом уже существует
-        }
+    const ParameterKey key = makeKey(parameter->getName(), parameter->getType());
+    if (m_keyIndex.contains(key)) {
+        qWarning() << "ParameterModel::addParameter: Parameter" << parameter->getName()
+                   << "with type" << static_cast<int>(parameter->getType()) << "already exists.";
+        return false; // Параметр с таким именем и типом уже существует
     }
 
-    // Добавляем параметр в список
+    // Добавляем параметр в список и в индексы
+    const int row = m_parameters.size();
     m_parameters.append(parameter);
+    m_keyIndex.insert(key, row);
+    m_nameIndex[parameter->getName()].append(row);
+    recompileProgram();
+    publishSnapshot();
 
     // Сигнализируем о добавлении параметра
     // Эмитируем сигнал *после* разблокировки мьютекса, если это возможно
@@ -64,14 +75,15 @@ bool ParameterModel::removeParameter(const QString& name, ParameterType type) {
         std::lock_guard<std::mutex> lock(m_mutex);
 
         // Ищем параметр с указанным именем и типом
-        for (int i = 0; i < m_parameters.size(); ++i) {
-            if (m_parameters[i]->getName() == name && m_parameters[i]->getType() == type) {
-                // Сохраняем указатель для сигнала перед удалением
-                removedParam = m_parameters[i];
-                // Удаляем параметр из списка
-                m_parameters.removeAt(i);
-                break; // Выходим из цикла после удаления
-            }
+        const int row = m_keyIndex.value(makeKey(name, type), -1);
+        if (row >= 0) {
+            // Сохраняем указатель для сигнала перед удалением
+            removedParam = m_parameters[row];
+            // Удаляем параметр из списка; строки после него сдвигаются, поэтому перестраиваем индексы
+            m_parameters.removeAt(row);
+            rebuildIndexes();
+            recompileProgram();
+            publishSnapshot();
         }
     } // Мьютекс разблокируется здесь
 
@@ -92,27 +104,37 @@ std::shared_ptr<Parameter> ParameterModel::getParameter(const QString& name, Par
     std::lock_guard<std::mutex> lock(m_mutex);
 
     // Ищем параметр с указанным именем и типом
-    for (const auto& parameter : m_parameters) {
-        if (parameter->getName() == name && parameter->getType() == type) {
-            return parameter;
-        }
-    }
-
-    return nullptr; // Параметр не найден
+    const int row = m_keyIndex.value(makeKey(name, type), -1);
+    return row >= 0 ? m_parameters[row] : nullptr; // nullptr, если параметр не найден
 }
 
 QVector<std::shared_ptr<Parameter>> ParameterModel::getParametersByName(const QString& name) const {
      // Блокируем мьютекс для безопасного доступа к параметрам
     std::lock_guard<std::mutex> lock(m_mutex);
     QVector<std::shared_ptr<Parameter>> result;
-    for (const auto& parameter : m_parameters) {
-        if (parameter->getName() == name) {
-            result.append(parameter);
+    const auto it = m_nameIndex.constFind(name);
+    if (it != m_nameIndex.constEnd()) {
+        result.reserve(it->size());
+        for (int row : *it) {
+            result.append(m_parameters[row]);
         }
     }
     return result;
 }
 
+int ParameterModel::indexOf(const QString& name, ParameterType type) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_keyIndex.value(makeKey(name, type), -1);
+}
+
+std::shared_ptr<Parameter> ParameterModel::getParameterAt(int row) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (row < 0 || row >= m_parameters.size()) {
+        return nullptr;
+    }
+    return m_parameters[row];
+}
+
 
 bool ParameterModel::updateParameter(const QString& name, ParameterType type,
                                     const QVariant& targetValue, const QString& description) {
@@ -122,17 +144,27 @@ bool ParameterModel::updateParameter(const QString& name, ParameterType type,
         std::lock_guard<std::mutex> lock(m_mutex);
 
         // Ищем параметр с указанным именем и типом
-        for (const auto& p : m_parameters) {
-            if (p->getName() == name && p->getType() == type) {
-                parameter = p;
-                break;
-            }
+        const int row = m_keyIndex.value(makeKey(name, type), -1);
+        if (row >= 0) {
+            parameter = m_parameters[row];
+        }
+
+        // Выражение с ошибкой не заменяет прежнее: вызывающий получает отказ, а не старое условие
+        QString error;
+        if (parameter && type == ParameterType::Expression &&
+            !static_cast<ParameterExpression&>(*parameter).setExpression(targetValue.toString(), &error)) {
+            qWarning() << "ParameterModel::updateParameter: Invalid expression for parameter" << name
+                       << "-" << error;
+            return false;
         }
 
         if (parameter) {
             // Обновляем целевое значение и описание параметра
             parameter->setTargetValue(targetValue);
             parameter->setDescription(description); // Обновляем описание
+            recompileProgram(); // Пороги изменились - перекомпилируем условия
+            m_program->resetRule(row); // Состояние, накопленное по старому условию, не переносим
+            publishRows({row});
         }
     } // Мьютекс разблокируется здесь
 
@@ -156,11 +188,18 @@ bool ParameterModel::updateParameterSound(const QString& name, ParameterType typ
         std::lock_guard<std::mutex> lock(m_mutex);
 
         // Ищем параметр с указанным именем и типом
-        for (const auto& p : m_parameters) {
-            if (p->getName() == name && p->getType() == type) {
-                parameter = p;
-                break;
-            }
+        const int row = m_keyIndex.value(makeKey(name, type), -1);
+        if (row >= 0) {
+            parameter = m_parameters[row];
+        }
+
+        // Выражение с ошибкой не заменяет прежнее: вызывающий получает отказ, а не старое условие
+        QString error;
+        if (parameter && type == ParameterType::Expression &&
+            !static_cast<ParameterExpression&>(*parameter).setExpression(targetValue.toString(), &error)) {
+            qWarning() << "ParameterModel::updateParameter: Invalid expression for parameter" << name
+                       << "-" << error;
+            return false;
         }
 
         if (parameter) {
@@ -170,6 +209,7 @@ bool ParameterModel::updateParameterSound(const QString& name, ParameterType typ
             if (!soundFile.isNull()) { // Проверяем на null, а не на empty, чтобы можно было передать пустой путь
                 parameter->setSoundFile(soundFile);
             }
+            publishRows({row});
         }
     } // Мьютекс разблокируется здесь
 
@@ -196,13 +236,27 @@ QVector<QString> ParameterModel::getAllParameterNames() const {
     // Блокируем мьютекс для безопасного доступа к параметрам
     std::lock_guard<std::mutex> lock(m_mutex);
 
+    // Ключи индекса имен уже уникальны
     QVector<QString> names;
-    QSet<QString> uniqueNames; // Используем Set для уникальности
+    names.reserve(m_nameIndex.size());
+    for (auto it = m_nameIndex.constBegin(); it != m_nameIndex.constEnd(); ++it) {
+        names.append(it.key());
+    }
 
-    for (const auto& parameter : m_parameters) {
-        QString name = parameter->getName();
-        if (!uniqueNames.contains(name)) {
-            uniqueNames.insert(name);
+    // Сортируем имена для единообразия
+    std::sort(names.begin(), names.end());
+
+    return names;
+}
+
+QVector<QString> ParameterModel::getInputNames() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    QVector<QString> names;
+    if (m_program) {
+        const QStringList inputs = m_program->inputNames();
+        names.reserve(inputs.size());
+        for (const QString& name : inputs) {
             names.append(name);
         }
     }
@@ -213,50 +267,121 @@ QVector<QString> ParameterModel::getAllParameterNames() const {
     return names;
 }
 
-void ParameterModel::checkParameters(const QVector<ParameterValue>& values) {
-    // Создаем временную мапу для быстрого поиска по имени
-    QMap<QString, QVariant> valueMap;
-    for (const auto& value : values) {
-        valueMap[value.name] = value.value;
-    }
+std::shared_ptr<const ParameterSnapshot> ParameterModel::snapshot() const {
+    return std::atomic_load(&m_snapshot);
+}
+
+std::shared_ptr<HistoryStore> ParameterModel::history() const {
+    return m_history;
+}
+
+void ParameterModel::setArchive(const std::shared_ptr<TelemetryArchive>& archive) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_archive = archive;
+}
+
+std::shared_ptr<TelemetryArchive> ParameterModel::archive() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_archive;
+}
 
-    // Используем копию списка параметров для безопасной итерации
-    // и для возможности модификации оригинала внутри цикла (хотя здесь не модифицируем)
+void ParameterModel::checkParameters(const QVector<ParameterValue>& values) {
+    // Берем копию списка параметров и программу, скомпилированную по этому же списку
     QVector<std::shared_ptr<Parameter>> paramsCopy;
+    std::shared_ptr<ConditionProgram> program;
+    std::shared_ptr<TelemetryArchive> archive;
     {
-        // Блокируем мьютекс только для копирования списка
+        // Блокируем мьютекс только для копирования указателей
         std::lock_guard<std::mutex> lock(m_mutex);
         paramsCopy = m_parameters;
+        program = m_program;
+        archive = m_archive;
     }
 
-    // Проверяем каждый параметр из копии
-    for (const auto& parameter : paramsCopy) {
-        QString name = parameter->getName();
+    // В архив попадают все значения такта, даже если условий еще нет
+    const qint64 timestampMs = QDateTime::currentMSecsSinceEpoch();
+    if (archive) {
+        archive->appendTick(values, timestampMs);
+    }
 
-        // Пропускаем параметр, если для него нет значения в текущем ответе
-        if (!valueMap.contains(name)) {
-            // Можно установить статус Unknown, если значение отсутствует?
-            // parameter->updateValue(QVariant()); // Или специальный маркер отсутствия значения
-            // emit parameterStatusChanged(name, parameter->getType(), ParameterStatus::Unknown);
-            continue;
+    if (!program) {
+        return;
+    }
+
+    // История пишется до проверки, чтобы правила, перекомпилированные позже, видели этот такт
+    m_history->appendTick(values, timestampMs);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Разбираем значения такта (один раз на имя) и проверяем все правила одним циклом.
+    // Параметры без значения в текущем ответе пропускаются.
+    program->loadInputs(values);
+    ConditionProgram::RunResult result;
+    program->run(result);
+
+    auto tick = std::make_shared<TickResult>();
+    tick->receivedValues = values.size();
+
+    // Переносим результаты в объекты параметров. В итог такта попадают только
+    // строки, данные которых изменились: значение, статус или статистика окна
+    for (int rule : result.evaluated) {
+        const auto& parameter = paramsCopy[rule];
+        const ParameterStatus previous = parameter->getStatus();
+        const QVariant value = program->inputValue(rule);
+        const bool valueChanged = value != parameter->getCurrentValue();
+        if (parameter->applyEvaluation(value, program->status(rule))) {
+            tick->transitions.append({rule, previous, parameter->getStatus()});
+            tick->changedValues.append(rule);
+        } else if (valueChanged || program->hasWindow(rule)) {
+            tick->changedValues.append(rule);
         }
+    }
+    tick->evaluationNs = timer.nsecsElapsed();
 
-        // Получаем значение параметра
-        QVariant value = valueMap[name];
+    publishTick(program, paramsCopy, std::move(tick));
+}
 
-        // Обновляем значение параметра и проверяем изменение статуса
-        // Метод updateValue сам обновит m_status и вернет true, если он изменился
-        bool statusChanged = parameter->updateValue(value);
+void ParameterModel::setSampleInterval(int intervalMs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_sampleIntervalMs == intervalMs) {
+        return;
+    }
+    m_sampleIntervalMs = intervalMs;
+    recompileProgram();
+    publishSnapshot(); // Окна правил пересозданы - строки снимка строятся по новой программе
+}
 
-        // Если статус изменился, сигнализируем об этом
-        if (statusChanged) {
-            emit parameterStatusChanged(name, parameter->getType(), parameter->getStatus());
-        }
+int ParameterModel::sampleInterval() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_sampleIntervalMs;
+}
+
+void ParameterModel::resetChangeTracking() {
+    QVector<std::shared_ptr<Parameter>> paramsCopy;
+    std::shared_ptr<ConditionProgram> program;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        paramsCopy = m_parameters;
+        program = m_program;
+    }
 
-        // В любом случае сигнализируем об изменении значения (даже если статус не изменился)
-        // Это нужно, например, для обновления отображения значения в UI
-        emit parameterValueChanged(name, value);
+    if (!program) {
+        return;
     }
+
+    auto tick = std::make_shared<TickResult>();
+    tick->changeTrackingReset = true;
+
+    for (int rule : program->resetChangeTracking()) {
+        const auto& parameter = paramsCopy[rule];
+        const ParameterStatus previous = parameter->getStatus();
+        if (parameter->applyEvaluation(parameter->getCurrentValue(), program->status(rule))) {
+            tick->transitions.append({rule, previous, parameter->getStatus()});
+        }
+    }
+
+    publishTick(program, paramsCopy, std::move(tick));
 }
 
 bool ParameterModel::saveParameters(const QString& filename) const {
@@ -294,6 +419,18 @@ bool ParameterModel::saveParameters(const QString& filename) const {
 
         paramObj["target_value"] = targetJsonValue;
 
+        // Настройки подтверждения записываем, только если они отличаются от умолчаний
+        const ConditionFilter filter = parameter->getFilter();
+        if (!filter.isDefault()) {
+            QJsonObject filterObj;
+            filterObj["hysteresis"] = filter.hysteresis;
+            filterObj["entry_samples"] = filter.entrySamples;
+            filterObj["entry_seconds"] = filter.entrySeconds;
+            filterObj["exit_samples"] = filter.exitSamples;
+            filterObj["exit_seconds"] = filter.exitSeconds;
+            paramObj["filter"] = filterObj;
+        }
+
         // Добавляем объект в массив
         parametersArray.append(paramObj);
     }
@@ -311,11 +448,17 @@ bool ParameterModel::saveParameters(const QString& filename) const {
         "# Format: JSON\n"
         "# Fields:\n"
         "#   - name: Parameter name (string)\n"
-        "#   - type: Parameter type (0=Equals, 1=NotEquals, 2=InLimits, 3=OutOfLimits, 4=Changed)\n"
-        "#   - target_value: Target value for comparison (string, number, boolean, array[2] for limits, or null for Changed)\n"
+        "#   - type: Parameter type (0=Equals, 1=NotEquals, 2=InLimits, 3=OutOfLimits, 4=Changed, 5=Expression, 6=RateOfChange, 7=Trend,\n"
+        "#             8=Statistic)\n"
+        "#   - target_value: Target value for comparison (string, number, boolean, array[2] for limits,\n"
+        "#                   [rate per minute, window seconds] for RateOfChange, [samples, delta] for Trend,\n"
+        "#                   [\"sigma\"|\"mean\"|\"stddev\"|\"min\"|\"max\", threshold, window seconds] for Statistic,\n"
+        "#                   or null for Changed)\n"
         "#   - sound_enabled: Whether sound alert is enabled (boolean: true/false)\n"
         "#   - sound_file: Path to sound file for alert (string)\n"
         "#   - description: Human-readable description of parameter (string)\n"
+        "#   - filter: Optional status confirmation (object: hysteresis, entry_samples, entry_seconds,\n"
+        "#             exit_samples, exit_seconds)\n"
         "# \n"
         "# Note: You can edit this file manually, but make sure the application is not running.\n"
         "# Date: " + QDateTime::currentDateTime().toString(Qt::ISODate) + "\n"
@@ -438,6 +581,26 @@ bool ParameterModel::loadParameters(const QString& filename) {
             name, type, targetValue, soundFile, soundEnabled, description);
 
         if (parameter) {
+            if (paramObj.value("filter").isObject()) {
+                const QJsonObject filterObj = paramObj.value("filter").toObject();
+                ConditionFilter filter;
+                filter.hysteresis = filterObj.value("hysteresis").toDouble(0.0);
+                filter.entrySamples = filterObj.value("entry_samples").toInt(1);
+                filter.entrySeconds = filterObj.value("entry_seconds").toDouble(0.0);
+                filter.exitSamples = filterObj.value("exit_samples").toInt(1);
+                filter.exitSeconds = filterObj.value("exit_seconds").toDouble(0.0);
+
+                // Гистерезис шире половины диапазона не даст InLimits вернуться
+                // в норму. Значение не исправляем: файл остается как есть,
+                // пользователь увидит предупреждение и поправит его сам
+                const QVariantList limits = targetValue.toList();
+                if (type == ParameterType::InLimits && limits.size() == 2 &&
+                    !filter.hysteresisFits(limits[0].toDouble(), limits[1].toDouble())) {
+                    qWarning() << "ParameterModel::loadParameters: hysteresis" << filter.hysteresis
+                               << "leaves no return zone inside the limits of parameter" << name;
+                }
+                parameter->setFilter(filter);
+            }
             loadedParameters.append(parameter);
         } else {
              qWarning() << "ParameterModel::loadParameters: Failed to create parameter" << name << "from file:" << filename;
@@ -450,6 +613,9 @@ bool ParameterModel::loadParameters(const QString& filename) {
          {
              std::lock_guard<std::mutex> lock(m_mutex);
              m_parameters = loadedParameters; // Заменяем старый список новым
+             rebuildIndexes();
+             recompileProgram();
+             publishSnapshot();
          }
          qDebug() << "ParameterModel: Loaded" << loadedParameters.size() << "parameters from" << filename;
          // Оповещаем UI о полной перезагрузке модели
@@ -460,5 +626,139 @@ bool ParameterModel::loadParameters(const QString& filename) {
     return loadSuccess; // Возвращаем true, если не было критических ошибок парсинга JSON
 }
 
+ParameterModel::ParameterKey ParameterModel::makeKey(const QString& name, ParameterType type) {
+    return qMakePair(name, static_cast<int>(type));
+}
+
+void ParameterModel::recompileProgram() {
+    m_program = ConditionProgram::compile(m_parameters, m_program.get(), m_history.get(), m_sampleIntervalMs);
+}
+
+ParameterRow ParameterModel::makeRow(int index) const {
+    const Parameter& parameter = *m_parameters[index];
+    ParameterRow row;
+    row.name = parameter.getName();
+    row.type = parameter.getType();
+    row.condition = parameter.getConditionDescription();
+    row.description = parameter.getDescription();
+    row.status = parameter.getStatus();
+    row.value = parameter.getCurrentValue();
+    row.soundEnabled = parameter.isSoundEnabled();
+    row.soundFile = parameter.getSoundFile();
+    if (m_program) {
+        row.window = m_program->windowStats(index);
+    }
+    return row;
+}
+
+void ParameterModel::publishTick(const std::shared_ptr<ConditionProgram>& program,
+                                 const QVector<std::shared_ptr<Parameter>>& parameters,
+                                 std::shared_ptr<TickResult> tick) {
+    if (tick->changedValues.isEmpty() && tick->transitions.isEmpty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Если список параметров успели изменить, статусы параметров такт уже
+        // изменил: переходы переносим на новые номера строк, чтобы их не потерять
+        if (m_program != program) {
+            remapTick(parameters, *tick);
+            if (tick->changedValues.isEmpty() && tick->transitions.isEmpty()) {
+                return;
+            }
+        }
+
+        // Строки, которые нужно обновить в снимке: получившие значение или сменившие статус
+        QVector<int> rows = tick->changedValues;
+        for (const auto& transition : tick->transitions) {
+            rows.append(transition.row);
+        }
+
+        tick->tick = ++m_tickCounter;
+        tick->snapshot = publishRows(rows);
+    }
+    tick->timestampMs = QDateTime::currentMSecsSinceEpoch();
+
+    // Снимок опубликован до сигнала, поэтому подписчики читают уже новые данные
+    emit tickEvaluated(TickResultPtr(std::move(tick)));
+}
+
+void ParameterModel::remapTick(const QVector<std::shared_ptr<Parameter>>& parameters, TickResult& tick) const {
+    // Строка такта -> строка текущего списка по ключу; удаленный параметр -> -1
+    const auto currentRow = [this, &parameters](int row) {
+        const auto& parameter = parameters[row];
+        const int current = m_keyIndex.value(makeKey(parameter->getName(), parameter->getType()), -1);
+        return current >= 0 && m_parameters[current] == parameter ? current : -1;
+    };
+
+    QVector<int> changedValues;
+    changedValues.reserve(tick.changedValues.size());
+    for (int row : tick.changedValues) {
+        const int current = currentRow(row);
+        if (current >= 0) {
+            changedValues.append(current);
+        }
+    }
+    std::sort(changedValues.begin(), changedValues.end());
+    tick.changedValues = changedValues;
+
+    QVector<StatusTransition> transitions;
+    transitions.reserve(tick.transitions.size());
+    for (StatusTransition transition : tick.transitions) {
+        transition.row = currentRow(transition.row);
+        if (transition.row >= 0) {
+            transitions.append(transition);
+        }
+    }
+    std::sort(transitions.begin(), transitions.end(),
+              [](const StatusTransition& a, const StatusTransition& b) { return a.row < b.row; });
+    tick.transitions = transitions;
+}
+
+std::shared_ptr<const ParameterSnapshot> ParameterModel::publishSnapshot() {
+    auto next = std::make_shared<ParameterSnapshot>();
+    next->version = ++m_snapshotVersion;
+    next->rows.reserve(m_parameters.size());
+    for (int row = 0; row < m_parameters.size(); ++row) {
+        next->rows.append(makeRow(row));
+    }
+    next->rowIndex = m_keyIndex; // Неявно разделяемая копия индекса
+
+    std::shared_ptr<const ParameterSnapshot> published(std::move(next));
+    std::atomic_store(&m_snapshot, published);
+    return published;
+}
+
+std::shared_ptr<const ParameterSnapshot> ParameterModel::publishRows(const QVector<int>& rows) {
+    const auto current = std::atomic_load(&m_snapshot);
+    if (!current || current->rows.size() != m_parameters.size()) {
+        return publishSnapshot();
+    }
+
+    auto next = std::make_shared<ParameterSnapshot>(*current);
+    next->version = ++m_snapshotVersion;
+    for (int row : rows) {
+        next->rows[row] = makeRow(row);
+    }
+
+    std::shared_ptr<const ParameterSnapshot> published(std::move(next));
+    std::atomic_store(&m_snapshot, published);
+    return published;
+}
+
+void ParameterModel::rebuildIndexes() {
+    m_keyIndex.clear();
+    m_nameIndex.clear();
+    m_keyIndex.reserve(m_parameters.size());
+
+    for (int row = 0; row < m_parameters.size(); ++row) {
+        const auto& parameter = m_parameters[row];
+        m_keyIndex.insert(makeKey(parameter->getName(), parameter->getType()), row);
+        m_nameIndex[parameter->getName()].append(row);
+    }
+}
+
 
 } // namespace ParamControl
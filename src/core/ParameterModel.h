@@ -7,11 +7,18 @@
 #include <QVariant>
 #include <QSet>
 #include <QMap>
+#include <QHash>
+#include <QPair>
 #include <memory> // Для std::shared_ptr
 #include <mutex>  // Для std::mutex
 #include <atomic> // Для std::atomic (если потребуется)
 
 #include "Parameter.h" // Включаем базовый класс Parameter
+#include "ConditionProgram.h"
+#include "HistoryStore.h"
+#include "TelemetryArchive.h"
+#include "ParameterSnapshot.h"
+#include "TickResult.h"
 
 // Прямое объявление не нужно, т.к. Parameter.h уже включен
 
@@ -77,6 +84,22 @@ public:
      */
      QVector<std::shared_ptr<Parameter>> getParametersByName(const QString& name) const;
 
+    /**
+     * @brief Возвращает номер строки параметра в порядке конфигурации.
+     *
+     * Поиск выполняется по хеш-индексу за O(1), без перебора списка.
+     * @param name Имя параметра.
+     * @param type Тип параметра.
+     * @return Номер строки или -1, если параметр не найден.
+     */
+    int indexOf(const QString& name, ParameterType type) const;
+
+    /**
+     * @brief Возвращает параметр по номеру строки.
+     * @param row Номер строки (см. indexOf()).
+     * @return Умный указатель на параметр или nullptr, если номер вне диапазона.
+     */
+    std::shared_ptr<Parameter> getParameterAt(int row) const;
 
     /**
      * @brief Возвращает копию вектора всех параметров в модели.
@@ -90,13 +113,58 @@ public:
      */
     QVector<QString> getAllParameterNames() const;
 
+    /**
+     * @brief Возвращает имена параметров ТМИ, которые читает скомпилированная программа.
+     *
+     * Это входы программы (ConditionProgram::inputNames()): имена правил
+     * сравнения и идентификаторы выражений. Имена самих правил-выражений
+     * в список не входят - их значения вычисляются, а не запрашиваются у СОТМ.
+     * @return QVector<QString> с отсортированными именами входов.
+     */
+    QVector<QString> getInputNames() const;
+
+    /**
+     * @brief Возвращает последний опубликованный снимок списка параметров.
+     *
+     * Снимок получается одной атомарной загрузкой указателя, без захвата
+     * мьютекса и без копирования списка. Снимок неизменяем: его можно читать
+     * из любого потока и хранить, пока он нужен; новые такты и правки
+     * публикуют новый снимок, не затрагивая уже выданные.
+     * @return Указатель на снимок (никогда не nullptr).
+     */
+    std::shared_ptr<const ParameterSnapshot> snapshot() const;
+
+    /**
+     * @brief Возвращает историю значений параметров ТМИ.
+     *
+     * В историю попадают все значения, полученные в checkParameters().
+     * Хранилище потокобезопасно и читается напрямую, без мьютекса модели.
+     * @return Указатель на хранилище истории (никогда не nullptr).
+     */
+    std::shared_ptr<HistoryStore> history() const;
+
+    /**
+     * @brief Подключает архив ТМИ на диске.
+     *
+     * Все значения, полученные в checkParameters(), ставятся в очередь
+     * записи архива. Запись идет в фоновом потоке архива и не задерживает такт.
+     * @param archive Открытый архив (nullptr - отключить запись).
+     */
+    void setArchive(const std::shared_ptr<TelemetryArchive>& archive);
+
+    /**
+     * @brief Возвращает подключенный архив ТМИ (может быть nullptr).
+     */
+    std::shared_ptr<TelemetryArchive> archive() const;
+
     /**
      * @brief Обновляет целевое значение и описание существующего параметра.
      * @param name Имя обновляемого параметра.
      * @param type Тип обновляемого параметра.
      * @param targetValue Новое целевое значение(я).
      * @param description Новое описание параметра.
-     * @return true, если параметр найден и обновлен, иначе false.
+     * @return true, если параметр найден и обновлен; false, если параметра нет
+     *         или новое выражение не компилируется (параметр не меняется).
      */
     bool updateParameter(const QString& name, ParameterType type,
                          const QVariant& targetValue, const QString& description);
@@ -130,12 +198,37 @@ public:
     /**
      * @brief Проверяет все параметры на соответствие условиям по новым значениям.
      *
-     * Обновляет текущие значения и статусы параметров.
-     * Эмитирует сигналы parameterValueChanged и parameterStatusChanged.
+     * Условия проверяются скомпилированной программой (ConditionProgram) одним
+     * циклом по такту; результаты переносятся в объекты параметров.
+     * Итог такта публикуется одним сигналом tickEvaluated.
      * @param values Вектор новых значений параметров (имя + значение).
      */
     void checkParameters(const QVector<ParameterValue>& values);
 
+    /**
+     * @brief Сбрасывает отслеживание изменений для параметров типа Changed.
+     *
+     * Текущие значения становятся опорными, статусы возвращаются в Ok.
+     * Изменения статусов публикуются сигналом tickEvaluated
+     * (TickResult::changeTrackingReset = true).
+     */
+    void resetChangeTracking();
+
+    /**
+     * @brief Задает интервал опроса, по которому рассчитывается емкость окон правил.
+     *
+     * Окна RateOfChange и Statistic заданы длительностью; чтобы они вмещали
+     * все отсчеты за это время, программа перекомпилируется с новой емкостью
+     * окон (накопленные отсчеты переносятся).
+     * @param intervalMs Интервал между тактами проверки, мс.
+     */
+    void setSampleInterval(int intervalMs);
+
+    /**
+     * @brief Интервал опроса, с которым скомпилированы окна правил, мс.
+     */
+    int sampleInterval() const;
+
 signals:
     // Сигналы для оповещения UI и других компонентов о изменениях в модели
 
@@ -169,19 +262,14 @@ signals:
     void parameterSoundChanged(const QString& name, ParameterType type, bool enabled);
 
     /**
-     * @brief Сигнал об изменении статуса параметра (Ok, Error, Unknown).
-     * @param name Имя параметра.
-     * @param type Тип параметра.
-     * @param status Новый статус параметра.
-     */
-    void parameterStatusChanged(const QString& name, ParameterType type, ParameterStatus status);
-
-    /**
-     * @brief Сигнал об изменении текущего значения параметра.
-     * @param name Имя параметра.
-     * @param value Новое текущее значение параметра.
+     * @brief Сигнал о завершении такта проверки.
+     *
+     * Один сигнал на такт вместо сигналов на каждый параметр: результат
+     * содержит строки, получившие значения, изменения статусов и снимок
+     * после такта. Не эмитируется, если такт ничего не изменил.
+     * @param result Итог такта.
      */
-    void parameterValueChanged(const QString& name, const QVariant& value);
+    void tickEvaluated(const ParamControl::TickResultPtr& result);
 
     /**
      * @brief Сигнал о полной перезагрузке модели (после loadParameters).
@@ -190,8 +278,97 @@ signals:
 
 
 private:
+    /// Ключ хеш-индекса: имя параметра и тип условия.
+    using ParameterKey = QPair<QString, int>;
+
     mutable std::mutex m_mutex; ///< Мьютекс для защиты доступа к вектору параметров.
     QVector<std::shared_ptr<Parameter>> m_parameters; ///< Вектор умных указателей на параметры.
+    QHash<ParameterKey, int> m_keyIndex;          ///< Индекс (имя, тип) → номер строки.
+    QHash<QString, QVector<int>> m_nameIndex;     ///< Индекс имя → номера строк (в порядке конфигурации).
+    std::shared_ptr<ConditionProgram> m_program;  ///< Скомпилированные условия (правило i ↔ строка i).
+    std::shared_ptr<const ParameterSnapshot> m_snapshot; ///< Опубликованный снимок (доступ через std::atomic_load/store).
+    std::shared_ptr<HistoryStore> m_history;      ///< История значений (своя синхронизация).
+    std::shared_ptr<TelemetryArchive> m_archive;  ///< Архив ТМИ на диске (может быть nullptr).
+    quint64 m_snapshotVersion = 0;                ///< Номер последней публикации.
+    quint64 m_tickCounter = 0;                    ///< Номер последнего опубликованного такта.
+    int m_sampleIntervalMs = WindowStore::kDefaultSampleIntervalMs; ///< Интервал опроса для емкости окон, мс.
+
+    /**
+     * @brief Формирует ключ хеш-индекса.
+     * @param name Имя параметра.
+     * @param type Тип параметра.
+     * @return Ключ для m_keyIndex.
+     */
+    static ParameterKey makeKey(const QString& name, ParameterType type);
+
+    /**
+     * @brief Перестраивает индексы по текущему содержимому m_parameters.
+     *
+     * Вызывается при удалении и полной перезагрузке, когда номера строк сдвигаются.
+     * Мьютекс должен быть захвачен вызывающей стороной.
+     */
+    void rebuildIndexes();
+
+    /**
+     * @brief Перекомпилирует программу условий по текущему списку параметров.
+     *
+     * Вызывается при добавлении, удалении, редактировании и загрузке параметров.
+     * Мьютекс должен быть захвачен вызывающей стороной.
+     */
+    void recompileProgram();
+
+    /**
+     * @brief Формирует строку снимка по текущему состоянию параметра.
+     *
+     * Статистика окна берется из текущей программы условий.
+     * Мьютекс должен быть захвачен вызывающей стороной.
+     * @param index Номер строки.
+     */
+    ParameterRow makeRow(int index) const;
+
+    /**
+     * @brief Публикует снимок, построенный заново по всему списку параметров.
+     *
+     * Вызывается при добавлении, удалении и загрузке параметров.
+     * Мьютекс должен быть захвачен вызывающей стороной.
+     * @return Опубликованный снимок.
+     */
+    std::shared_ptr<const ParameterSnapshot> publishSnapshot();
+
+    /**
+     * @brief Публикует копию текущего снимка с обновленными строками.
+     *
+     * Остальные строки переносятся из предыдущего снимка без обращения к объектам параметров.
+     * Мьютекс должен быть захвачен вызывающей стороной.
+     * @param rows Номера изменившихся строк.
+     * @return Опубликованный снимок.
+     */
+    std::shared_ptr<const ParameterSnapshot> publishRows(const QVector<int>& rows);
+
+    /**
+     * @brief Публикует снимок по итогам такта и эмитирует tickEvaluated.
+     *
+     * Мьютекс захватывается внутри. Если программа успела смениться
+     * (список параметров изменили во время такта), строки такта переносятся
+     * на текущие номера (см. remapTick()).
+     * @param program Программа, по которой выполнен такт.
+     * @param parameters Список параметров, по которому выполнен такт.
+     * @param tick Заполненные изменения такта.
+     */
+    void publishTick(const std::shared_ptr<ConditionProgram>& program,
+                     const QVector<std::shared_ptr<Parameter>>& parameters,
+                     std::shared_ptr<TickResult> tick);
+
+    /**
+     * @brief Переносит строки такта на номера строк текущего списка параметров.
+     *
+     * Строки сопоставляются по ключу (имя, тип) и объекту параметра;
+     * строки удаленных параметров отбрасываются, порядок по возрастанию сохраняется.
+     * Мьютекс должен быть захвачен вызывающей стороной.
+     * @param parameters Список параметров, по которому выполнен такт.
+     * @param tick Изменения такта.
+     */
+    void remapTick(const QVector<std::shared_ptr<Parameter>>& parameters, TickResult& tick) const;
 };
 
 } // namespace ParamControl
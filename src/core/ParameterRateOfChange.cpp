@@ -0,0 +1,89 @@
+// src/core/ParameterRateOfChange.cpp
+#include "ParameterRateOfChange.h"
+
+#include <QVariantList>
+#include <QDebug>
+
+#include <cmath>
+
+namespace ParamControl {
+
+ParameterRateOfChange::ParameterRateOfChange(const QString& name, double ratePerMinute, double windowSeconds)
+    : Parameter(name, ParameterType::RateOfChange)
+    , m_ratePerMinute(ratePerMinute)
+    , m_windowSeconds(windowSeconds)
+{
+    resetWindow();
+}
+
+bool ParameterRateOfChange::checkCondition(const QVariant& value) {
+    bool ok = false;
+    const double number = value.toDouble(&ok);
+    // Некорректные данные считаются нарушением условия
+    if (!ok || !std::isfinite(number)) {
+        return false;
+    }
+
+    if (!m_clock.isValid()) {
+        m_clock.start();
+    }
+    m_window.push(0, m_clock.elapsed(), number);
+
+    const double ratePerSecond = m_window.slopePerSecond(0);
+    if (std::isnan(ratePerSecond)) {
+        return true;
+    }
+
+    const double threshold = m_ratePerMinute / 60.0;
+    return (threshold >= 0.0) ? ratePerSecond <= threshold : ratePerSecond >= threshold;
+}
+
+QString ParameterRateOfChange::getConditionDescription() const {
+    if (m_ratePerMinute >= 0.0) {
+        return QString("рост <= %1/мин за %2 с").arg(m_ratePerMinute).arg(m_windowSeconds);
+    }
+    return QString("падение <= %1/мин за %2 с").arg(-m_ratePerMinute).arg(m_windowSeconds);
+}
+
+QVariant ParameterRateOfChange::getTargetValue() const {
+    QVariantList target;
+    target << m_ratePerMinute << m_windowSeconds;
+    return target;
+}
+
+void ParameterRateOfChange::setTargetValue(const QVariant& value) {
+    const QVariantList target = value.toList();
+    if (target.size() < 2) {
+        qWarning() << "ParameterRateOfChange: Invalid target value provided for parameter" << getName();
+        return;
+    }
+
+    bool rateOk = false;
+    bool windowOk = false;
+    const double rate = target[0].toDouble(&rateOk);
+    const double window = target[1].toDouble(&windowOk);
+    if (!rateOk || !windowOk || window <= 0.0) {
+        qWarning() << "ParameterRateOfChange: Invalid rate or window provided for parameter" << getName();
+        return;
+    }
+
+    m_ratePerMinute = rate;
+    m_windowSeconds = window;
+    resetWindow();
+}
+
+double ParameterRateOfChange::getRatePerMinute() const {
+    return m_ratePerMinute;
+}
+
+double ParameterRateOfChange::getWindowSeconds() const {
+    return m_windowSeconds;
+}
+
+void ParameterRateOfChange::resetWindow() {
+    m_window = WindowStore();
+    const qint64 spanMs = qRound64(m_windowSeconds * 1000.0);
+    m_window.addWindow(WindowStore::capacityForSpan(spanMs), spanMs);
+}
+
+} // namespace ParamControl
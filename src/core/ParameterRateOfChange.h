@@ -0,0 +1,78 @@
+// src/core/ParameterRateOfChange.h
+#pragma once
+
+#include "Parameter.h"
+#include "WindowStore.h"
+
+#include <QElapsedTimer>
+
+namespace ParamControl {
+
+/**
+ * @brief Класс параметра, контролирующий скорость изменения значения.
+ *
+ * Скорость - наклон прямой МНК по отсчетам (время, значение) за последние
+ * windowSeconds секунд. Положительный порог ограничивает рост
+ * ("растет быстрее 2 в минуту"), отрицательный - падение.
+ * Параметр в норме, пока скорость не превышает порог; при менее чем
+ * двух отсчетах в окне условие считается выполненным.
+ *
+ * Емкость окна рассчитывается по его длительности и интервалу опроса
+ * (WindowStore::capacityForSpan()), поэтому окно вмещает все отсчеты
+ * за заданное время. Окно объекта параметра рассчитано на интервал по
+ * умолчанию; правило ConditionProgram - на интервал, с которым скомпилирована программа.
+ *
+ * Целевое значение - QVariantList [порог в единицах в минуту, окно в секундах].
+ */
+class ParameterRateOfChange : public Parameter {
+public:
+    /**
+     * @brief Конструктор.
+     * @param name Имя параметра.
+     * @param ratePerMinute Порог скорости, единиц в минуту (знак задает направление).
+     * @param windowSeconds Длительность окна, секунды.
+     */
+    ParameterRateOfChange(const QString& name, double ratePerMinute, double windowSeconds);
+    ~ParameterRateOfChange() override = default;
+
+    /**
+     * @brief Добавляет отсчет в окно и проверяет скорость изменения.
+     * @param value Текущее значение параметра.
+     * @return true, если скорость не превышает порог, иначе false.
+     */
+    bool checkCondition(const QVariant& value) override;
+
+    /**
+     * @brief Возвращает описание условия контроля.
+     * @return Строка с описанием условия.
+     */
+    QString getConditionDescription() const override;
+
+    /**
+     * @brief Возвращает целевое значение.
+     * @return QVariantList с порогом (в минуту) и длительностью окна (в секундах).
+     */
+    QVariant getTargetValue() const override;
+
+    /**
+     * @brief Устанавливает порог и длительность окна. Окно отсчетов очищается.
+     * @param value QVariantList с порогом (в минуту) и длительностью окна (в секундах).
+     */
+    void setTargetValue(const QVariant& value) override;
+
+    double getRatePerMinute() const;
+    double getWindowSeconds() const;
+
+private:
+    double m_ratePerMinute;     ///< Порог скорости, единиц в минуту.
+    double m_windowSeconds;     ///< Длительность окна, секунды.
+    WindowStore m_window;       ///< Окно отсчетов для checkCondition().
+    QElapsedTimer m_clock;      ///< Монотонные часы отсчетов.
+
+    /**
+     * @brief Пересоздает окно отсчетов под текущие настройки.
+     */
+    void resetWindow();
+};
+
+} // namespace ParamControl
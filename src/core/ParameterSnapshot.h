@@ -0,0 +1,54 @@
+// src/core/ParameterSnapshot.h
+#pragma once
+
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+#include "Parameter.h" // Для ParameterType и ParameterStatus
+#include "WindowStore.h" // Для WindowStats
+
+namespace ParamControl {
+
+/**
+ * @brief Копия состояния одного параметра на момент публикации снимка.
+ */
+struct ParameterRow {
+    QString name;                   ///< Имя параметра
+    ParameterType type;             ///< Тип условия
+    QString condition;              ///< Текстовое описание условия
+    QString description;            ///< Описание параметра
+    ParameterStatus status;         ///< Статус
+    QVariant value;                 ///< Последнее полученное значение
+    bool soundEnabled;              ///< Звуковое оповещение включено
+    QString soundFile;              ///< Путь к звуковому файлу
+    WindowStats window;             ///< Статистика окна отсчетов (для правил с окном)
+};
+
+/**
+ * @brief Неизменяемый снимок списка параметров.
+ *
+ * ParameterModel публикует новый снимок после каждого такта и каждой правки
+ * списка. Строки снимка идут в порядке конфигурации (номер строки совпадает
+ * с ParameterModel::indexOf()). Опубликованный снимок больше не изменяется,
+ * поэтому читатель может держать его сколько угодно без блокировок.
+ */
+struct ParameterSnapshot {
+    quint64 version = 0;                        ///< Номер публикации, растет с каждым снимком
+    QVector<ParameterRow> rows;                 ///< Строки в порядке конфигурации
+    QHash<QPair<QString, int>, int> rowIndex;   ///< Индекс (имя, тип) → номер строки
+
+    /**
+     * @brief Возвращает номер строки параметра в этом снимке.
+     * @param name Имя параметра.
+     * @param type Тип параметра.
+     * @return Номер строки или -1, если параметра в снимке нет.
+     */
+    int indexOf(const QString& name, ParameterType type) const {
+        return rowIndex.value(qMakePair(name, static_cast<int>(type)), -1);
+    }
+};
+
+} // namespace ParamControl
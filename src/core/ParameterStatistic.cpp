@@ -0,0 +1,153 @@
+// src/core/ParameterStatistic.cpp
+#include "ParameterStatistic.h"
+
+#include <QVariantList>
+#include <QDebug>
+
+#include <cmath>
+
+namespace ParamControl {
+
+ParameterStatistic::ParameterStatistic(const QString& name, WindowStatistic statistic,
+                                       double threshold, double windowSeconds)
+    : Parameter(name, ParameterType::Statistic)
+    , m_statistic(statistic)
+    , m_threshold(threshold)
+    , m_windowSeconds(windowSeconds)
+{
+    resetWindow();
+}
+
+bool ParameterStatistic::checkCondition(const QVariant& value) {
+    bool ok = false;
+    const double number = value.toDouble(&ok);
+    // Некорректные данные считаются нарушением условия
+    if (!ok || !std::isfinite(number)) {
+        return false;
+    }
+
+    if (!m_clock.isValid()) {
+        m_clock.start();
+    }
+    return evaluate(m_statistic, m_threshold, m_window, 0, m_clock.elapsed(), number);
+}
+
+bool ParameterStatistic::evaluate(WindowStatistic statistic, double threshold,
+                                  WindowStore& store, int window, qint64 timeMs, double value) {
+    if (statistic == WindowStatistic::Deviation) {
+        // Значение сравнивается с окном до добавления, иначе выброс сам увеличил бы СКО
+        const double mean = store.mean(window);
+        const double deviation = store.standardDeviation(window);
+        store.push(window, timeMs, value);
+        return std::isnan(deviation) || std::fabs(value - mean) <= threshold * deviation;
+    }
+
+    store.push(window, timeMs, value);
+    switch (statistic) {
+        case WindowStatistic::Mean:
+            return !(store.mean(window) > threshold);
+        case WindowStatistic::StdDev:
+            return !(store.standardDeviation(window) > threshold);
+        case WindowStatistic::Minimum:
+            return !(store.minimum(window) < threshold);
+        case WindowStatistic::Maximum:
+            return !(store.maximum(window) > threshold);
+        default:
+            return false;
+    }
+}
+
+QString ParameterStatistic::getConditionDescription() const {
+    switch (m_statistic) {
+        case WindowStatistic::Deviation:
+            return QString("|значение - среднее| <= %1σ за %2 с").arg(m_threshold).arg(m_windowSeconds);
+        case WindowStatistic::Mean:
+            return QString("среднее <= %1 за %2 с").arg(m_threshold).arg(m_windowSeconds);
+        case WindowStatistic::StdDev:
+            return QString("СКО <= %1 за %2 с").arg(m_threshold).arg(m_windowSeconds);
+        case WindowStatistic::Minimum:
+            return QString("минимум >= %1 за %2 с").arg(m_threshold).arg(m_windowSeconds);
+        case WindowStatistic::Maximum:
+            return QString("максимум <= %1 за %2 с").arg(m_threshold).arg(m_windowSeconds);
+        default:
+            return QString();
+    }
+}
+
+QVariant ParameterStatistic::getTargetValue() const {
+    QVariantList target;
+    target << statisticCode(m_statistic) << m_threshold << m_windowSeconds;
+    return target;
+}
+
+void ParameterStatistic::setTargetValue(const QVariant& value) {
+    const QVariantList target = value.toList();
+    if (target.size() < 3) {
+        qWarning() << "ParameterStatistic: Invalid target value provided for parameter" << getName();
+        return;
+    }
+
+    WindowStatistic statistic;
+    bool thresholdOk = false;
+    bool windowOk = false;
+    const double threshold = target[1].toDouble(&thresholdOk);
+    const double window = target[2].toDouble(&windowOk);
+    if (!parseStatistic(target[0].toString(), statistic) || !thresholdOk || !windowOk || window <= 0.0) {
+        qWarning() << "ParameterStatistic: Invalid statistic, threshold or window provided for parameter" << getName();
+        return;
+    }
+
+    m_statistic = statistic;
+    m_threshold = threshold;
+    m_windowSeconds = window;
+    resetWindow();
+}
+
+WindowStatistic ParameterStatistic::getStatistic() const {
+    return m_statistic;
+}
+
+double ParameterStatistic::getThreshold() const {
+    return m_threshold;
+}
+
+double ParameterStatistic::getWindowSeconds() const {
+    return m_windowSeconds;
+}
+
+QString ParameterStatistic::statisticCode(WindowStatistic statistic) {
+    switch (statistic) {
+        case WindowStatistic::Deviation: return "sigma";
+        case WindowStatistic::Mean: return "mean";
+        case WindowStatistic::StdDev: return "stddev";
+        case WindowStatistic::Minimum: return "min";
+        case WindowStatistic::Maximum: return "max";
+        default: return QString();
+    }
+}
+
+bool ParameterStatistic::parseStatistic(const QString& code, WindowStatistic& statistic) {
+    const QString normalized = code.trimmed().toLower();
+    if (normalized == "sigma") {
+        statistic = WindowStatistic::Deviation;
+    } else if (normalized == "mean") {
+        statistic = WindowStatistic::Mean;
+    } else if (normalized == "stddev") {
+        statistic = WindowStatistic::StdDev;
+    } else if (normalized == "min") {
+        statistic = WindowStatistic::Minimum;
+    } else if (normalized == "max") {
+        statistic = WindowStatistic::Maximum;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void ParameterStatistic::resetWindow() {
+    m_window = WindowStore();
+    const qint64 spanMs = qRound64(m_windowSeconds * 1000.0);
+    m_window.addWindow(WindowStore::capacityForSpan(spanMs), spanMs);
+}
+
+} // namespace ParamControl
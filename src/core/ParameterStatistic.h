@@ -0,0 +1,121 @@
+// src/core/ParameterStatistic.h
+#pragma once
+
+#include "Parameter.h"
+#include "WindowStore.h"
+
+#include <QElapsedTimer>
+
+namespace ParamControl {
+
+/**
+ * @brief Статистика скользящего окна, контролируемая правилом
+ */
+enum class WindowStatistic : quint8 {
+    Deviation,  ///< Отклонение текущего значения от среднего окна, в СКО
+    Mean,       ///< Среднее окна
+    StdDev,     ///< СКО окна
+    Minimum,    ///< Минимум окна
+    Maximum     ///< Максимум окна
+};
+
+/**
+ * @brief Класс параметра, контролирующий статистику скользящего окна.
+ *
+ * Окно - отсчеты за последние windowSeconds секунд; емкость окна
+ * рассчитывается по длительности и интервалу опроса
+ * (WindowStore::capacityForSpan(): у объекта параметра - интервал по умолчанию,
+ * у правила ConditionProgram - интервал, с которым скомпилирована программа).
+ * Условия нарушены, когда:
+ * - Deviation: |значение - среднее| > порог * СКО (значение сравнивается
+ *   с окном до добавления в него, "отклонение больше 4σ от среднего за 10 минут");
+ * - Mean, StdDev, Maximum: статистика окна больше порога;
+ * - Minimum: минимум окна меньше порога.
+ * Пока статистика не определена (мало отсчетов), условие считается выполненным.
+ *
+ * Целевое значение - QVariantList [статистика ("sigma", "mean", "stddev",
+ * "min", "max"), порог, окно в секундах].
+ */
+class ParameterStatistic : public Parameter {
+public:
+    /**
+     * @brief Конструктор.
+     * @param name Имя параметра.
+     * @param statistic Контролируемая статистика.
+     * @param threshold Порог.
+     * @param windowSeconds Длительность окна, секунды.
+     */
+    ParameterStatistic(const QString& name, WindowStatistic statistic, double threshold, double windowSeconds);
+    ~ParameterStatistic() override = default;
+
+    /**
+     * @brief Добавляет отсчет в окно и проверяет статистику.
+     * @param value Текущее значение параметра.
+     * @return true, если статистика в норме, иначе false.
+     */
+    bool checkCondition(const QVariant& value) override;
+
+    /**
+     * @brief Возвращает описание условия контроля.
+     * @return Строка с описанием условия.
+     */
+    QString getConditionDescription() const override;
+
+    /**
+     * @brief Возвращает целевое значение.
+     * @return QVariantList с кодом статистики, порогом и длительностью окна (в секундах).
+     */
+    QVariant getTargetValue() const override;
+
+    /**
+     * @brief Устанавливает статистику, порог и окно. Окно отсчетов очищается.
+     * @param value QVariantList с кодом статистики, порогом и длительностью окна (в секундах).
+     */
+    void setTargetValue(const QVariant& value) override;
+
+    WindowStatistic getStatistic() const;
+    double getThreshold() const;
+    double getWindowSeconds() const;
+
+    /**
+     * @brief Добавляет отсчет в окно и проверяет статистику.
+     *
+     * Общая логика для checkCondition() и ConditionProgram.
+     * @param statistic Контролируемая статистика.
+     * @param threshold Порог.
+     * @param store Хранилище окон.
+     * @param window Номер окна.
+     * @param timeMs Время отсчета по монотонным часам, мс.
+     * @param value Значение отсчета.
+     * @return true, если статистика в норме, иначе false.
+     */
+    static bool evaluate(WindowStatistic statistic, double threshold,
+                         WindowStore& store, int window, qint64 timeMs, double value);
+
+    /**
+     * @brief Код статистики для целевого значения ("sigma", "mean", ...).
+     */
+    static QString statisticCode(WindowStatistic statistic);
+
+    /**
+     * @brief Разбирает код статистики.
+     * @param code Код статистики.
+     * @param statistic Заполняется при успехе.
+     * @return true, если код известен.
+     */
+    static bool parseStatistic(const QString& code, WindowStatistic& statistic);
+
+private:
+    WindowStatistic m_statistic;    ///< Контролируемая статистика.
+    double m_threshold;             ///< Порог.
+    double m_windowSeconds;         ///< Длительность окна, секунды.
+    WindowStore m_window;           ///< Окно отсчетов для checkCondition().
+    QElapsedTimer m_clock;          ///< Монотонные часы отсчетов.
+
+    /**
+     * @brief Пересоздает окно отсчетов под текущие настройки.
+     */
+    void resetWindow();
+};
+
+} // namespace ParamControl
@@ -0,0 +1,90 @@
+// src/core/ParameterTrend.cpp
+#include "ParameterTrend.h"
+
+#include <QVariantList>
+#include <QDebug>
+
+#include <cmath>
+
+namespace ParamControl {
+
+ParameterTrend::ParameterTrend(const QString& name, int samples, double delta)
+    : Parameter(name, ParameterType::Trend)
+    , m_samples(qBound(2, samples, kMaxSamples))
+    , m_delta(delta)
+{
+    resetWindow();
+}
+
+bool ParameterTrend::checkCondition(const QVariant& value) {
+    bool ok = false;
+    const double number = value.toDouble(&ok);
+    // Некорректные данные считаются нарушением условия
+    if (!ok || !std::isfinite(number)) {
+        return false;
+    }
+
+    if (!m_clock.isValid()) {
+        m_clock.start();
+    }
+    m_window.push(0, m_clock.elapsed(), number);
+
+    if (m_window.sampleCount(0) < m_samples) {
+        return true;
+    }
+
+    const double change = m_window.fittedChange(0);
+    if (std::isnan(change)) {
+        return true;
+    }
+    return (m_delta >= 0.0) ? change <= m_delta : change >= m_delta;
+}
+
+QString ParameterTrend::getConditionDescription() const {
+    if (m_delta >= 0.0) {
+        return QString("рост <= %1 за %2 отсч.").arg(m_delta).arg(m_samples);
+    }
+    return QString("падение <= %1 за %2 отсч.").arg(-m_delta).arg(m_samples);
+}
+
+QVariant ParameterTrend::getTargetValue() const {
+    QVariantList target;
+    target << m_samples << m_delta;
+    return target;
+}
+
+void ParameterTrend::setTargetValue(const QVariant& value) {
+    const QVariantList target = value.toList();
+    if (target.size() < 2) {
+        qWarning() << "ParameterTrend: Invalid target value provided for parameter" << getName();
+        return;
+    }
+
+    bool samplesOk = false;
+    bool deltaOk = false;
+    const int samples = target[0].toInt(&samplesOk);
+    const double delta = target[1].toDouble(&deltaOk);
+    if (!samplesOk || !deltaOk || samples < 2 || samples > kMaxSamples) {
+        qWarning() << "ParameterTrend: Invalid sample count or delta provided for parameter" << getName();
+        return;
+    }
+
+    m_samples = samples;
+    m_delta = delta;
+    resetWindow();
+}
+
+int ParameterTrend::getSamples() const {
+    return m_samples;
+}
+
+double ParameterTrend::getDelta() const {
+    return m_delta;
+}
+
+void ParameterTrend::resetWindow() {
+    m_window = WindowStore();
+    m_window.addWindow(m_samples);
+}
+
+} // namespace ParamControl
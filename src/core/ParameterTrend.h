@@ -0,0 +1,76 @@
+// src/core/ParameterTrend.h
+#pragma once
+
+#include "Parameter.h"
+#include "WindowStore.h"
+
+#include <QElapsedTimer>
+
+namespace ParamControl {
+
+/**
+ * @brief Класс параметра, контролирующий тренд за последние N отсчетов.
+ *
+ * Тренд - изменение значения вдоль прямой МНК по последним N отсчетам
+ * (время, значение); в отличие от разности первого и последнего отсчета
+ * он устойчив к единичным выбросам. Положительный порог ограничивает рост,
+ * отрицательный - падение ("давление падает на 5 за 30 отсчетов").
+ * Пока окно не заполнено, условие считается выполненным.
+ *
+ * Целевое значение - QVariantList [число отсчетов, порог изменения].
+ */
+class ParameterTrend : public Parameter {
+public:
+    /// Наибольшее число отсчетов в окне тренда.
+    static constexpr int kMaxSamples = 4096;
+
+    /**
+     * @brief Конструктор.
+     * @param name Имя параметра.
+     * @param samples Число отсчетов в окне (от 2 до kMaxSamples).
+     * @param delta Порог изменения за окно (знак задает направление).
+     */
+    ParameterTrend(const QString& name, int samples, double delta);
+    ~ParameterTrend() override = default;
+
+    /**
+     * @brief Добавляет отсчет в окно и проверяет тренд.
+     * @param value Текущее значение параметра.
+     * @return true, если изменение за окно не превышает порог, иначе false.
+     */
+    bool checkCondition(const QVariant& value) override;
+
+    /**
+     * @brief Возвращает описание условия контроля.
+     * @return Строка с описанием условия.
+     */
+    QString getConditionDescription() const override;
+
+    /**
+     * @brief Возвращает целевое значение.
+     * @return QVariantList с числом отсчетов и порогом изменения.
+     */
+    QVariant getTargetValue() const override;
+
+    /**
+     * @brief Устанавливает число отсчетов и порог. Окно отсчетов очищается.
+     * @param value QVariantList с числом отсчетов и порогом изменения.
+     */
+    void setTargetValue(const QVariant& value) override;
+
+    int getSamples() const;
+    double getDelta() const;
+
+private:
+    int m_samples;              ///< Число отсчетов в окне.
+    double m_delta;             ///< Порог изменения за окно.
+    WindowStore m_window;       ///< Окно отсчетов для checkCondition().
+    QElapsedTimer m_clock;      ///< Монотонные часы отсчетов.
+
+    /**
+     * @brief Пересоздает окно отсчетов под текущие настройки.
+     */
+    void resetWindow();
+};
+
+} // namespace ParamControl
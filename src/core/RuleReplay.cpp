@@ -0,0 +1,206 @@
+// src/core/RuleReplay.cpp
+#include "RuleReplay.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QJsonValue>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace ParamControl {
+
+namespace {
+
+/**
+ * @brief Пачка блоков архива, распаковываемая параллельно
+ */
+struct DecodeTask {
+    TelemetryArchiveReader::BlockRef block;
+    QVector<ArchiveTick> ticks;
+};
+
+/// Сколько первых тактов просматривается для оценки интервала опроса
+constexpr int kIntervalProbeTicks = 256;
+
+/// Пределы интервала опроса (как в настройках мониторинга)
+constexpr int kMinSampleIntervalMs = 100;
+constexpr int kMaxSampleIntervalMs = 10000;
+
+} // namespace
+
+RuleReplay::RuleReplay(const QVector<std::shared_ptr<Parameter>>& parameters)
+    : m_parameters(parameters)
+    , m_program(ConditionProgram::compile(parameters))
+{
+}
+
+void RuleReplay::setSampleInterval(int intervalMs) {
+    // Емкость окон вычисляется при компиляции: правила собираются заново
+    m_program = ConditionProgram::compile(m_parameters, nullptr, nullptr, intervalMs);
+}
+
+int RuleReplay::sampleInterval() const {
+    return m_program->sampleIntervalMs();
+}
+
+int RuleReplay::estimateSampleInterval(const QVector<qint64>& timestamps) {
+    QVector<qint64> steps;
+    for (int i = 1; i < timestamps.size(); ++i) {
+        if (timestamps[i] > timestamps[i - 1]) {
+            steps.append(timestamps[i] - timestamps[i - 1]);
+        }
+    }
+    if (steps.isEmpty()) {
+        return 0;
+    }
+
+    // Медиана устойчива к пропускам связи и повторным запросам
+    auto middle = steps.begin() + steps.size() / 2;
+    std::nth_element(steps.begin(), middle, steps.end());
+    return int(qBound<qint64>(kMinSampleIntervalMs, *middle, kMaxSampleIntervalMs));
+}
+
+int RuleReplay::archiveSampleInterval(const TelemetryArchiveReader& reader, qint64 fromMs, qint64 toMs) const {
+    const QVector<quint32> ids = inputIds(reader);
+    QVector<qint64> timestamps;
+    for (const TelemetryArchiveReader::BlockRef& block : reader.blocks(fromMs, toMs)) {
+        for (const ArchiveTick& tick : reader.blockTicks(block, ids)) {
+            if (tick.timestampMs >= fromMs && tick.timestampMs <= toMs) {
+                timestamps.append(tick.timestampMs);
+            }
+        }
+        if (timestamps.size() >= kIntervalProbeTicks) {
+            break;
+        }
+    }
+    return estimateSampleInterval(timestamps);
+}
+
+int RuleReplay::captureSampleInterval(QIODevice& device) {
+    QVector<qint64> timestamps;
+    while (!device.atEnd() && timestamps.size() < kIntervalProbeTicks) {
+        const QByteArray line = device.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        const QJsonValue timestamp = QJsonDocument::fromJson(line).object().value("timestampMs");
+        if (timestamp.isDouble()) {
+            timestamps.append(qint64(timestamp.toDouble()));
+        }
+    }
+    return estimateSampleInterval(timestamps);
+}
+
+QVector<quint32> RuleReplay::inputIds(const TelemetryArchiveReader& reader) const {
+    QVector<quint32> ids;
+    for (const QString& name : inputNames()) {
+        quint32 id = 0;
+        if (reader.nameId(name, id)) {
+            ids.append(id);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+QStringList RuleReplay::inputNames() const {
+    return m_program->inputNames();
+}
+
+qint64 RuleReplay::tickCount() const {
+    return m_ticks;
+}
+
+void RuleReplay::processTick(const QVector<ParameterValue>& values, qint64 timestampMs, const Sink& sink) {
+    ++m_ticks;
+
+    // Тот же путь, что и в ParameterModel::checkParameters(), но со временем такта из записи
+    m_program->loadInputs(values, timestampMs);
+    m_program->run(m_result);
+
+    for (int rule : m_result.evaluated) {
+        const auto& parameter = m_parameters[rule];
+        const ParameterStatus previous = parameter->getStatus();
+        if (parameter->applyEvaluation(m_program->inputValue(rule), m_program->status(rule)) && sink) {
+            ReplayTransition transition;
+            transition.timestampMs = timestampMs;
+            transition.name = parameter->getName();
+            transition.type = parameter->getType();
+            transition.previous = previous;
+            transition.current = parameter->getStatus();
+            transition.value = parameter->getCurrentValue();
+            transition.condition = parameter->getConditionDescription();
+            sink(transition);
+        }
+    }
+}
+
+qint64 RuleReplay::replayArchive(const TelemetryArchiveReader& reader, qint64 fromMs, qint64 toMs, const Sink& sink) {
+    const qint64 startTicks = m_ticks;
+
+    // Распаковываются только столбцы, которые читают правила
+    const QVector<quint32> ids = inputIds(reader);
+
+    // Блоки распаковываются пачками по числу потоков, такты выполняются по порядку:
+    // память ограничена пачкой, а не длиной записи
+    const QVector<TelemetryArchiveReader::BlockRef> blocks = reader.blocks(fromMs, toMs);
+    const int batchSize = qMax(1, QThreadPool::globalInstance()->maxThreadCount() * 2);
+    QVector<DecodeTask> batch;
+    for (int first = 0; first < blocks.size(); first += batchSize) {
+        batch.clear();
+        for (int i = first; i < qMin(first + batchSize, blocks.size()); ++i) {
+            batch.append({blocks[i], {}});
+        }
+
+        QtConcurrent::blockingMap(batch, [&reader, &ids](DecodeTask& task) {
+            task.ticks = reader.blockTicks(task.block, ids);
+        });
+
+        for (const DecodeTask& task : batch) {
+            for (const ArchiveTick& tick : task.ticks) {
+                if (tick.timestampMs >= fromMs && tick.timestampMs <= toMs) {
+                    processTick(tick.values, tick.timestampMs, sink);
+                }
+            }
+        }
+    }
+
+    return m_ticks - startTicks;
+}
+
+qint64 RuleReplay::replayCapture(QIODevice& device, const Sink& sink, QString* error) {
+    const qint64 startTicks = m_ticks;
+    QVector<ParameterValue> values;
+
+    for (int lineNumber = 1; !device.atEnd(); ++lineNumber) {
+        const QByteArray line = device.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        QJsonParseError parseError;
+        const QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+        const QJsonObject tick = document.object();
+        if (parseError.error != QJsonParseError::NoError || !tick.value("timestampMs").isDouble() ||
+            !tick.value("values").isObject()) {
+            if (error && error->isEmpty()) {
+                *error = QString("строка %1: ожидается {\"timestampMs\": ..., \"values\": {...}}").arg(lineNumber);
+            }
+            continue;
+        }
+
+        values.clear();
+        const QJsonObject object = tick.value("values").toObject();
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            values.append({it.key(), it.value().toVariant()});
+        }
+        processTick(values, qint64(tick.value("timestampMs").toDouble()), sink);
+    }
+
+    return m_ticks - startTicks;
+}
+
+} // namespace ParamControl
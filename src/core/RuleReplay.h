@@ -0,0 +1,141 @@
+// src/core/RuleReplay.h
+#pragma once
+
+#include <QIODevice>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+#include <functional>
+#include <memory>
+
+#include "ConditionProgram.h"
+#include "Parameter.h"
+#include "TelemetryArchiveReader.h"
+
+namespace ParamControl {
+
+/**
+ * @brief Изменение статуса параметра при повторном прогоне правил
+ */
+struct ReplayTransition {
+    qint64 timestampMs = 0;                             ///< Время такта (мс от эпохи UTC)
+    QString name;                                       ///< Имя параметра
+    ParameterType type = ParameterType::Equals;         ///< Тип условия
+    ParameterStatus previous = ParameterStatus::Unknown; ///< Статус до такта
+    ParameterStatus current = ParameterStatus::Unknown;  ///< Статус после такта
+    QVariant value;                                     ///< Значение, вызвавшее переход
+    QString condition;                                  ///< Описание условия
+};
+
+/**
+ * @brief Повторный прогон правил по записанной ТМИ без GUI и без ожидания тактов.
+ *
+ * Правила компилируются в ConditionProgram и применяются к параметрам тем же
+ * путем, что и в ParameterModel::checkParameters(), поэтому переходы
+ * совпадают с теми, что дал бы живой прогон по тем же тактам. Время для
+ * подтверждения статусов и окон отсчетов берется из времени тактов записи,
+ * а не из часов, поэтому такты обрабатываются с той скоростью, какую дает
+ * процессор. Емкость окон RateOfChange/Trend/Statistic зависит от интервала
+ * опроса, с которым скомпилированы правила: его нужно задать таким же, как
+ * в живом прогоне (ParameterModel::sampleInterval()), через setSampleInterval()
+ * до первого такта - явно или по шагу тактов записи (estimateSampleInterval()).
+ *
+ * Источники тактов:
+ * - архив ТМИ (TelemetryArchiveReader): блоки распаковываются параллельно
+ *   пачками, правила выполняются по тактам последовательно;
+ * - файл записи JSONL: по строке на такт, например
+ *   {"timestampMs": 1760745600000, "values": {"ТОК_АКБ": 1.2, "НОВФР": "1"}}.
+ */
+class RuleReplay {
+public:
+    /// Получатель переходов (вызывается в порядке тактов и строк конфигурации).
+    using Sink = std::function<void(const ReplayTransition&)>;
+
+    /**
+     * @brief Конструктор: компилирует правила.
+     * @param parameters Параметры в порядке конфигурации (их статусы меняются при прогоне).
+     */
+    explicit RuleReplay(const QVector<std::shared_ptr<Parameter>>& parameters);
+
+    /**
+     * @brief Задает интервал опроса и перекомпилирует правила.
+     *
+     * Вызывается до первого такта: состояние правил при перекомпиляции
+     * не переносится.
+     * @param intervalMs Интервал опроса живого прогона, мс.
+     */
+    void setSampleInterval(int intervalMs);
+
+    /**
+     * @brief Интервал опроса, с которым скомпилированы правила, мс.
+     */
+    int sampleInterval() const;
+
+    /**
+     * @brief Интервал опроса по времени тактов: медиана шага между соседними тактами.
+     * @param timestamps Время тактов по порядку.
+     * @return Интервал в пределах настройки опроса (100-10000 мс) или 0, если шагов нет.
+     */
+    static int estimateSampleInterval(const QVector<qint64>& timestamps);
+
+    /**
+     * @brief Интервал опроса по первому блоку архива из интервала [fromMs, toMs].
+     * @return Интервал или 0, если тактов недостаточно.
+     */
+    int archiveSampleInterval(const TelemetryArchiveReader& reader, qint64 fromMs, qint64 toMs) const;
+
+    /**
+     * @brief Интервал опроса по первым тактам файла записи JSONL.
+     * @param device Открытый для чтения файл (читается с текущей позиции).
+     * @return Интервал или 0, если тактов недостаточно.
+     */
+    static int captureSampleInterval(QIODevice& device);
+
+    /**
+     * @brief Имена параметров ТМИ, которые читают правила.
+     */
+    QStringList inputNames() const;
+
+    /**
+     * @brief Число обработанных тактов.
+     */
+    qint64 tickCount() const;
+
+    /**
+     * @brief Выполняет правила на одном такте.
+     * @param values Значения такта.
+     * @param timestampMs Время такта.
+     * @param sink Получатель переходов.
+     */
+    void processTick(const QVector<ParameterValue>& values, qint64 timestampMs, const Sink& sink);
+
+    /**
+     * @brief Прогоняет правила по тактам архива из интервала [fromMs, toMs].
+     * @return Число обработанных тактов.
+     */
+    qint64 replayArchive(const TelemetryArchiveReader& reader, qint64 fromMs, qint64 toMs, const Sink& sink);
+
+    /**
+     * @brief Прогоняет правила по тактам файла записи JSONL.
+     * @param device Открытый для чтения файл.
+     * @param sink Получатель переходов.
+     * @param error Описание первой ошибки разбора (строки с ошибками пропускаются).
+     * @return Число обработанных тактов.
+     */
+    qint64 replayCapture(QIODevice& device, const Sink& sink, QString* error = nullptr);
+
+private:
+    /**
+     * @brief Номера имен входов правил в справочнике архива (по возрастанию).
+     */
+    QVector<quint32> inputIds(const TelemetryArchiveReader& reader) const;
+
+    QVector<std::shared_ptr<Parameter>> m_parameters;   ///< Параметры (правило i ↔ параметр i)
+    std::shared_ptr<ConditionProgram> m_program;        ///< Скомпилированные правила
+    ConditionProgram::RunResult m_result;               ///< Результат такта (буфер переиспользуется)
+    qint64 m_ticks = 0;                                 ///< Обработано тактов
+};
+
+} // namespace ParamControl
@@ -0,0 +1,629 @@
+// src/core/TelemetryArchive.cpp
+#include "TelemetryArchive.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace ParamControl {
+
+namespace {
+
+constexpr qint64 kDayMs = 24LL * 60 * 60 * 1000;
+
+/// Сутки UTC, к которым относится время (с округлением вниз и для времени до эпохи).
+qint64 utcDay(qint64 timestampMs) {
+    return (timestampMs >= 0) ? timestampMs / kDayMs : -((-timestampMs - 1) / kDayMs) - 1;
+}
+
+} // namespace
+
+TelemetryArchive::TelemetryArchive() = default;
+
+TelemetryArchive::~TelemetryArchive() {
+    close();
+}
+
+bool TelemetryArchive::open(const QString& directory, quint32 kaNumber) {
+    close();
+
+    if (!QDir().mkpath(directory)) {
+        qWarning() << "TelemetryArchive: не удалось создать каталог" << directory;
+        return false;
+    }
+
+    m_kaNumber = kaNumber;
+    m_namesFile.setFileName(QDir(directory).filePath(kArchiveNamesFile));
+    if (!loadNames()) {
+        return false;
+    }
+
+    m_segmentDay = -1;
+    m_lastMs = 0;
+    m_blockTimes.clear();
+    m_columns.clear();
+    m_columnIndex.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_directory = directory;
+    }
+    openRollups();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.clear();
+        m_running = true;
+        m_stopping = false;
+        m_flushRequested = false;
+    }
+    m_thread = std::thread(&TelemetryArchive::writerLoop, this);
+    return true;
+}
+
+void TelemetryArchive::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = false;
+}
+
+bool TelemetryArchive::isOpen() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+QString TelemetryArchive::directory() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_directory;
+}
+
+void TelemetryArchive::setSegmentBytes(qint64 bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_segmentBytes = qMax<qint64>(1024 * 1024, bytes);
+}
+
+void TelemetryArchive::setFlushInterval(int ms) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_flushIntervalMs = qMax(100, ms);
+}
+
+void TelemetryArchive::appendTick(const QVector<ParameterValue>& values, qint64 timestampMs) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        if (int(m_pending.size()) >= kMaxPendingTicks) {
+            // Диск не успевает - теряем самые старые такты, а не память
+            m_pending.pop_front();
+            if (m_dropped.fetch_add(1) == 0) {
+                qWarning() << "TelemetryArchive: очередь записи переполнена, старые такты отбрасываются";
+            }
+        }
+        m_pending.push_back({timestampMs, values});
+    }
+    m_wake.notify_one();
+}
+
+void TelemetryArchive::flush() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_flushRequested = true;
+    }
+    m_wake.notify_one();
+}
+
+qint64 TelemetryArchive::droppedTicks() const {
+    return m_dropped.load();
+}
+
+void TelemetryArchive::writerLoop() {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point blockDeadline;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        const auto ready = [this] { return !m_pending.empty() || m_stopping || m_flushRequested; };
+        if (m_blockTimes.isEmpty()) {
+            m_wake.wait(lock, ready);
+        } else {
+            m_wake.wait_until(lock, blockDeadline, ready);
+        }
+
+        std::deque<PendingTick> batch;
+        batch.swap(m_pending);
+        const bool stopping = m_stopping;
+        const bool flushRequested = m_flushRequested;
+        m_flushRequested = false;
+        const auto interval = std::chrono::milliseconds(m_flushIntervalMs);
+        lock.unlock();
+
+        // Диск трогаем только без блокировки: appendTick() не ждет записи
+        for (const PendingTick& tick : batch) {
+            addTick(tick);
+            if (m_blockTimes.size() == 1) {
+                blockDeadline = Clock::now() + interval;
+            }
+        }
+        if (!m_blockTimes.isEmpty() && (stopping || flushRequested || Clock::now() >= blockDeadline)) {
+            writeBlock();
+        }
+
+        if (stopping) {
+            saveRollupState();
+            for (RollupLevel& level : m_rollups) {
+                level.file.close();
+            }
+            closeSegment();
+            m_namesFile.close();
+            return;
+        }
+        lock.lock();
+    }
+}
+
+void TelemetryArchive::addTick(const PendingTick& tick) {
+    // Время архива не убывает, чтобы индекс оставался упорядоченным
+    const qint64 timestampMs = qMax(tick.timestampMs, m_lastMs);
+    m_lastMs = timestampMs;
+
+    // Блок не пересекает границу суток: по ней начинается новый сегмент
+    if (m_blockTimes.size() >= kBlockTicks ||
+        (!m_blockTimes.isEmpty() && utcDay(timestampMs) != utcDay(m_blockTimes.first()))) {
+        writeBlock();
+    }
+
+    advanceRollups(timestampMs);
+
+    const quint16 tickNumber = quint16(m_blockTimes.size());
+    m_blockTimes.append(timestampMs);
+
+    for (const ParameterValue& value : tick.values) {
+        const quint32 id = nameId(value.name);
+        if (id == kNoNameId) {
+            continue;   // Имя не попало в справочник - столбец не пишется
+        }
+        int index = m_columnIndex.value(id, -1);
+        if (index < 0) {
+            index = int(m_columns.size());
+            m_columns.emplace_back();
+            m_columns.back().nameId = id;
+            m_columnIndex.insert(id, index);
+        }
+        Column& column = m_columns[index];
+
+        double number = 0.0;
+        const bool isNumber = archiveNumericValue(value.value, number);
+        if (!isNumber && column.numeric) {
+            // Первое строковое значение - столбец блока становится строковым
+            column.texts.reserve(column.numbers.size() + 1);
+            for (double previous : column.numbers) {
+                column.texts.append(QString::number(previous, 'g', 17));
+            }
+            column.numbers.clear();
+            column.numeric = false;
+        }
+
+        column.ticks.append(tickNumber);
+        if (isNumber) {
+            addRollupValue(id, number);
+        }
+        if (column.numeric) {
+            column.numbers.append(number);
+        } else {
+            column.texts.append(value.value.toString());
+        }
+    }
+}
+
+void TelemetryArchive::writeBlock() {
+    if (m_blockTimes.isEmpty()) {
+        return;
+    }
+
+    const qint64 firstMs = m_blockTimes.first();
+    const qint64 lastMs = m_blockTimes.last();
+
+    // Каталог столбцов упорядочен по номеру имени - читатель ищет столбец двоичным поиском
+    std::sort(m_columns.begin(), m_columns.end(),
+              [](const Column& a, const Column& b) { return a.nameId < b.nameId; });
+
+    const int columnCount = int(m_columns.size());
+    const quint32 dataStart = quint32(kArchiveBlockHeaderBytes + columnCount * kArchiveColumnEntryBytes);
+
+    // Столбец времени, затем данные столбцов параметров
+    QByteArray data;
+    for (qint64 timestampMs : m_blockTimes) {
+        archivePut<qint64>(data, timestampMs);
+    }
+
+    QByteArray directory;
+    directory.reserve(columnCount * kArchiveColumnEntryBytes);
+    for (const Column& column : m_columns) {
+        const quint32 offset = dataStart + quint32(data.size());
+        for (quint16 tickNumber : column.ticks) {
+            archivePut<quint16>(data, tickNumber);
+        }
+        if (column.numeric) {
+            for (double number : column.numbers) {
+                archivePutDouble(data, number);
+            }
+        } else {
+            QByteArray utf8;
+            for (const QString& text : column.texts) {
+                utf8.append(text.toUtf8());
+                archivePut<quint32>(data, quint32(utf8.size()));
+            }
+            data.append(utf8);
+        }
+
+        archivePut<quint32>(directory, column.nameId);
+        directory.append(char(column.numeric ? ArchiveColumnKind::Numeric : ArchiveColumnKind::Text));
+        directory.append(QByteArray(3, '\0'));
+        archivePut<quint32>(directory, quint32(column.ticks.size()));
+        archivePut<quint32>(directory, offset);
+        archivePut<quint32>(directory, dataStart + quint32(data.size()) - offset);
+    }
+
+    QByteArray block;
+    block.reserve(int(dataStart) + data.size());
+    archivePut<quint32>(block, kArchiveBlockMagic);
+    archivePut<quint32>(block, dataStart + quint32(data.size()));
+    archivePut<qint64>(block, firstMs);
+    archivePut<qint64>(block, lastMs);
+    archivePut<quint32>(block, quint32(m_blockTimes.size()));
+    archivePut<quint32>(block, quint32(columnCount));
+    block.append(directory);
+    block.append(data);
+
+    const quint32 ticks = quint32(m_blockTimes.size());
+    m_blockTimes.clear();
+    m_columns.clear();
+    m_columnIndex.clear();
+
+    qint64 segmentBytes;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        segmentBytes = m_segmentBytes;
+    }
+    if (m_segment && (utcDay(firstMs) != m_segmentDay ||
+                      (m_segment->size() > kArchiveSegmentHeaderBytes &&
+                       m_segment->size() + block.size() > segmentBytes))) {
+        closeSegment();
+    }
+    // Незакрытые сводки сохраняем вместе с каждым блоком: после сбоя теряется не больше блока
+    saveRollupState();
+
+    if (!m_segment && !openSegment(firstMs)) {
+        return;
+    }
+
+    // Имена, на которые ссылается блок, должны оказаться на диске раньше него
+    if (!m_namesFile.flush()) {
+        qWarning() << "TelemetryArchive: ошибка записи справочника имен" << m_namesFile.errorString();
+        return;
+    }
+
+    const qint64 offset = m_segment->size();
+    if (m_segment->write(block) != block.size() || !m_segment->flush()) {
+        qWarning() << "TelemetryArchive: ошибка записи сегмента" << m_segment->fileName()
+                   << m_segment->errorString();
+        closeSegment();
+        return;
+    }
+
+    // Запись индекса - после данных: читатель видит только целые блоки
+    QByteArray entry;
+    archivePut<qint64>(entry, firstMs);
+    archivePut<qint64>(entry, lastMs);
+    archivePut<quint64>(entry, quint64(offset));
+    archivePut<quint32>(entry, quint32(block.size()));
+    archivePut<quint32>(entry, ticks);
+    if (m_index->write(entry) != entry.size() || !m_index->flush()) {
+        qWarning() << "TelemetryArchive: ошибка записи индекса" << m_index->fileName()
+                   << m_index->errorString();
+        closeSegment();
+    }
+}
+
+quint32 TelemetryArchive::nameId(const QString& name) {
+    const auto it = m_nameIds.constFind(name);
+    if (it != m_nameIds.constEnd()) {
+        return it.value();
+    }
+
+    if (m_namesFailed) {
+        return kNoNameId;
+    }
+
+    const QByteArray utf8 = name.toUtf8().left(0xFFFF);
+    QByteArray record;
+    archivePut<quint16>(record, quint16(utf8.size()));
+    record.append(utf8);
+    const qint64 position = m_namesFile.pos();
+    if (m_namesFile.write(record) != record.size() || !m_namesFile.flush()) {
+        qWarning() << "TelemetryArchive: ошибка записи справочника имен" << m_namesFile.errorString();
+
+        // Недописанная запись сдвинула бы номера всех следующих имен
+        if (!m_namesFile.resize(position) || !m_namesFile.seek(position)) {
+            qWarning() << "TelemetryArchive: новые имена не архивируются" << m_namesFile.fileName();
+            m_namesFailed = true;
+        }
+        return kNoNameId;
+    }
+
+    // Номер в памяти совпадает с номером записи в справочнике
+    const quint32 id = quint32(m_nameIds.size());
+    m_nameIds.insert(name, id);
+    return id;
+}
+
+bool TelemetryArchive::loadNames() {
+    m_nameIds.clear();
+    m_namesFailed = false;
+    if (!m_namesFile.open(QIODevice::ReadWrite)) {
+        qWarning() << "TelemetryArchive: не удалось открыть" << m_namesFile.fileName()
+                   << m_namesFile.errorString();
+        return false;
+    }
+
+    const QByteArray content = m_namesFile.readAll();
+    const uchar* data = reinterpret_cast<const uchar*>(content.constData());
+    int position = 0;
+    while (position + 2 <= content.size()) {
+        const int length = archiveGet<quint16>(data + position);
+        if (position + 2 + length > content.size()) {
+            break;
+        }
+        m_nameIds.insert(QString::fromUtf8(content.constData() + position + 2, length),
+                         quint32(m_nameIds.size()));
+        position += 2 + length;
+    }
+
+    // Недописанная при аварийном завершении запись отбрасывается
+    if (position != content.size()) {
+        qWarning() << "TelemetryArchive: отброшен неполный хвост справочника имен";
+        m_namesFile.resize(position);
+    }
+    return m_namesFile.seek(position);
+}
+
+void TelemetryArchive::openRollups() {
+    const QDir directory(this->directory());
+    for (int index = 0; index < kArchiveRollupLevels; ++index) {
+        RollupLevel& level = m_rollups[index];
+        level.file.close();
+        level.file.setFileName(directory.filePath(kArchiveRollupFiles[index]));
+        level.startMs = -1;
+        level.lastWrittenMs = -1;
+        level.cells.clear();
+
+        if (!level.file.open(QIODevice::ReadWrite)) {
+            qWarning() << "TelemetryArchive: не удалось открыть" << level.file.fileName()
+                       << level.file.errorString();
+            continue;
+        }
+
+        qint64 size = level.file.size();
+        if (size < kArchiveRollupHeaderBytes) {
+            QByteArray header;
+            archivePut<quint32>(header, kArchiveRollupMagic);
+            archivePut<quint16>(header, kArchiveVersion);
+            archivePut<quint16>(header, quint16(kArchiveRollupHeaderBytes));
+            archivePut<quint32>(header, quint32(kArchiveRollupResolutionMs[index] / 1000));
+            archivePut<quint32>(header, 0);
+            level.file.resize(0);
+            level.file.seek(0);
+            level.file.write(header);
+            level.file.flush();
+            size = kArchiveRollupHeaderBytes;
+        }
+
+        level.file.seek(0);
+        const QByteArray header = level.file.read(kArchiveRollupHeaderBytes);
+        if (archiveGet<quint32>(reinterpret_cast<const uchar*>(header.constData())) != kArchiveRollupMagic) {
+            qWarning() << "TelemetryArchive: неизвестный формат сводок" << level.file.fileName();
+            level.file.close();
+            continue;
+        }
+
+        // Недописанная при аварийном завершении запись отбрасывается
+        const qint64 records = (size - kArchiveRollupHeaderBytes) / kArchiveRollupRecordBytes;
+        const qint64 validSize = kArchiveRollupHeaderBytes + records * kArchiveRollupRecordBytes;
+        if (validSize != size) {
+            level.file.resize(validSize);
+        }
+        if (records > 0) {
+            level.file.seek(validSize - kArchiveRollupRecordBytes);
+            const QByteArray last = level.file.read(kArchiveRollupRecordBytes);
+            level.lastWrittenMs = archiveReadRollupRecord(reinterpret_cast<const uchar*>(last.constData())).startMs;
+        }
+        level.file.seek(validSize);
+    }
+
+    // Незакрытые интервалы прошлого сеанса (если их еще нет в файлах)
+    QFile state(directory.filePath(kArchiveRollupStateFile));
+    if (!state.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const QByteArray content = state.readAll();
+    const uchar* data = reinterpret_cast<const uchar*>(content.constData());
+    const uchar* end = data + content.size();
+    if (content.size() < 4 || archiveGet<quint32>(data) != kArchiveRollupMagic) {
+        return;
+    }
+    data += 4;
+    for (RollupLevel& level : m_rollups) {
+        if (end - data < 12) {
+            break;
+        }
+        const qint64 startMs = archiveGet<qint64>(data);
+        const quint32 cells = archiveGet<quint32>(data + 8);
+        data += 12;
+        if (quint64(end - data) < quint64(cells) * 32) {
+            break;
+        }
+        const bool restore = level.file.isOpen() && startMs >= 0 && startMs > level.lastWrittenMs;
+        for (quint32 i = 0; i < cells; ++i, data += 32) {
+            if (restore) {
+                RollupCell& cell = level.cells[archiveGet<quint32>(data)];
+                cell.count = archiveGet<quint32>(data + 4);
+                cell.minimum = archiveGetDouble(data + 8);
+                cell.maximum = archiveGetDouble(data + 16);
+                cell.sum = archiveGetDouble(data + 24);
+            }
+        }
+        if (restore) {
+            level.startMs = startMs;
+        }
+    }
+}
+
+void TelemetryArchive::advanceRollups(qint64 timestampMs) {
+    for (int index = 0; index < kArchiveRollupLevels; ++index) {
+        RollupLevel& level = m_rollups[index];
+        const qint64 resolution = kArchiveRollupResolutionMs[index];
+
+        // Интервал не может начаться раньше уже записанного (часы переведены назад между сеансами)
+        qint64 startMs = archiveAlignDown(timestampMs, resolution);
+        if (level.lastWrittenMs >= 0) {
+            startMs = qMax(startMs, level.lastWrittenMs + resolution);
+        }
+        if (level.startMs >= 0 && startMs <= level.startMs) {
+            continue;
+        }
+        if (level.startMs >= 0) {
+            closeRollup(index);
+        }
+        level.startMs = startMs;
+    }
+}
+
+void TelemetryArchive::addRollupValue(quint32 nameId, double value) {
+    if (!std::isfinite(value)) {
+        return;
+    }
+    for (RollupLevel& level : m_rollups) {
+        RollupCell& cell = level.cells[nameId];
+        if (cell.count == 0) {
+            cell.minimum = cell.maximum = value;
+        } else {
+            cell.minimum = qMin(cell.minimum, value);
+            cell.maximum = qMax(cell.maximum, value);
+        }
+        cell.sum += value;
+        ++cell.count;
+    }
+}
+
+void TelemetryArchive::closeRollup(int index) {
+    RollupLevel& level = m_rollups[index];
+    if (level.cells.isEmpty()) {
+        return;
+    }
+
+    // Записи интервала - по возрастанию номера имени
+    QList<quint32> ids = level.cells.keys();
+    std::sort(ids.begin(), ids.end());
+
+    QByteArray records;
+    records.reserve(ids.size() * kArchiveRollupRecordBytes);
+    for (quint32 id : ids) {
+        const RollupCell& cell = level.cells[id];
+        ArchiveRollupRecord record;
+        record.startMs = level.startMs;
+        record.nameId = id;
+        record.count = cell.count;
+        record.minimum = cell.minimum;
+        record.maximum = cell.maximum;
+        record.sum = cell.sum;
+        archivePutRollupRecord(records, record);
+    }
+    level.cells.clear();
+
+    if (!level.file.isOpen()) {
+        return;
+    }
+    if (level.file.write(records) != records.size() || !level.file.flush()) {
+        qWarning() << "TelemetryArchive: ошибка записи сводок" << level.file.fileName()
+                   << level.file.errorString();
+        return;
+    }
+    level.lastWrittenMs = level.startMs;
+}
+
+void TelemetryArchive::saveRollupState() {
+    QByteArray content;
+    archivePut<quint32>(content, kArchiveRollupMagic);
+    for (const RollupLevel& level : m_rollups) {
+        archivePut<qint64>(content, level.startMs);
+        archivePut<quint32>(content, quint32(level.cells.size()));
+        for (auto it = level.cells.constBegin(); it != level.cells.constEnd(); ++it) {
+            archivePut<quint32>(content, it.key());
+            archivePut<quint32>(content, it.value().count);
+            archivePutDouble(content, it.value().minimum);
+            archivePutDouble(content, it.value().maximum);
+            archivePutDouble(content, it.value().sum);
+        }
+    }
+
+    QSaveFile state(QDir(directory()).filePath(kArchiveRollupStateFile));
+    if (!state.open(QIODevice::WriteOnly) || state.write(content) != content.size() || !state.commit()) {
+        qWarning() << "TelemetryArchive: не удалось сохранить незакрытые сводки" << state.fileName();
+    }
+}
+
+bool TelemetryArchive::openSegment(qint64 firstMs) {
+    const QDir directory(this->directory());
+    const QString base = QDateTime::fromMSecsSinceEpoch(firstMs, Qt::UTC).toString("yyyyMMdd_HHmmss_zzz");
+    QString name = base;
+    for (int suffix = 1; QFile::exists(directory.filePath(name + kArchiveSegmentSuffix)); ++suffix) {
+        name = QString("%1_%2").arg(base).arg(suffix);
+    }
+
+    auto segment = std::make_unique<QFile>(directory.filePath(name + kArchiveSegmentSuffix));
+    auto index = std::make_unique<QFile>(directory.filePath(name + kArchiveIndexSuffix));
+    if (!segment->open(QIODevice::WriteOnly) || !index->open(QIODevice::WriteOnly)) {
+        qWarning() << "TelemetryArchive: не удалось создать сегмент" << segment->fileName();
+        return false;
+    }
+
+    QByteArray header;
+    archivePut<quint32>(header, kArchiveSegmentMagic);
+    archivePut<quint16>(header, kArchiveVersion);
+    archivePut<quint16>(header, quint16(kArchiveSegmentHeaderBytes));
+    archivePut<quint32>(header, m_kaNumber);
+    archivePut<quint32>(header, 0);
+    if (segment->write(header) != header.size() || !segment->flush()) {
+        qWarning() << "TelemetryArchive: ошибка записи заголовка сегмента" << segment->fileName();
+        return false;
+    }
+
+    m_segment = std::move(segment);
+    m_index = std::move(index);
+    m_segmentDay = utcDay(firstMs);
+    return true;
+}
+
+void TelemetryArchive::closeSegment() {
+    m_segment.reset();
+    m_index.reset();
+    m_segmentDay = -1;
+}
+
+} // namespace ParamControl
@@ -0,0 +1,257 @@
+// src/core/TelemetryArchive.h
+#pragma once
+
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TelemetryArchiveFormat.h"
+#include "XmlParser.h" // Для ParameterValue
+
+namespace ParamControl {
+
+/**
+ * @brief Архив ТМИ на диске: запись всех значений каждого такта.
+ *
+ * Значения тактов ставятся в очередь без обращения к диску и пишутся
+ * фоновым потоком в сегментированный архив только на дописывание
+ * (формат описан в TelemetryArchiveFormat.h). Такты собираются в блок
+ * по столбцам; блок записывается, когда набрано kBlockTicks тактов или
+ * прошло flushInterval с первого такта блока. Новый сегмент начинается
+ * при открытии архива, по смене суток UTC и при превышении размера сегмента.
+ *
+ * Одновременно с тактами ведутся сводки числовых значений (число, минимум,
+ * максимум, сумма) за минуту, час и сутки; сводка интервала дописывается
+ * в файл своего уровня, как только время тактов уходит за его конец.
+ * Незакрытые интервалы сохраняются при каждой записи блока и при закрытии,
+ * и следующий сеанс их продолжает.
+ *
+ * Если диск не успевает, очередь ограничена kMaxPendingTicks тактами:
+ * самые старые такты отбрасываются и учитываются в droppedTicks().
+ *
+ * Для чтения используется TelemetryArchiveReader.
+ */
+class TelemetryArchive {
+public:
+    /// Наибольшее число тактов в блоке.
+    static constexpr int kBlockTicks = 1024;
+
+    /// Интервал записи неполного блока по умолчанию, мс.
+    static constexpr int kDefaultFlushIntervalMs = 60000;
+
+    /// Размер сегмента по умолчанию, байт.
+    static constexpr qint64 kDefaultSegmentBytes = 256LL * 1024 * 1024;
+
+    /// Наибольшее число тактов в очереди на запись.
+    static constexpr int kMaxPendingTicks = 65536;
+
+    /**
+     * @brief Конструктор.
+     */
+    TelemetryArchive();
+
+    /**
+     * @brief Деструктор: дописывает очередь и закрывает архив.
+     */
+    ~TelemetryArchive();
+
+    TelemetryArchive(const TelemetryArchive&) = delete;
+    TelemetryArchive& operator=(const TelemetryArchive&) = delete;
+
+    /**
+     * @brief Открывает (создает) архив и запускает поток записи.
+     * @param directory Каталог архива КА.
+     * @param kaNumber Номер КА (записывается в заголовок сегментов).
+     * @return true, если архив открыт.
+     */
+    bool open(const QString& directory, quint32 kaNumber);
+
+    /**
+     * @brief Дописывает очередь, закрывает сегмент и останавливает поток записи.
+     */
+    void close();
+
+    /**
+     * @brief Проверяет, открыт ли архив.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Возвращает каталог архива.
+     */
+    QString directory() const;
+
+    /**
+     * @brief Устанавливает размер сегмента (действует со следующего блока).
+     * @param bytes Размер, байт.
+     */
+    void setSegmentBytes(qint64 bytes);
+
+    /**
+     * @brief Устанавливает интервал записи неполного блока.
+     * @param ms Интервал, мс.
+     */
+    void setFlushInterval(int ms);
+
+    /**
+     * @brief Ставит значения такта в очередь на запись (без обращения к диску).
+     * @param values Значения параметров, полученные от СОТМ.
+     * @param timestampMs Время такта (мс от эпохи UTC).
+     */
+    void appendTick(const QVector<ParameterValue>& values, qint64 timestampMs);
+
+    /**
+     * @brief Просит поток записи записать неполный блок сейчас.
+     */
+    void flush();
+
+    /**
+     * @brief Число тактов, отброшенных из-за переполнения очереди.
+     */
+    qint64 droppedTicks() const;
+
+private:
+    /**
+     * @brief Такт в очереди на запись
+     */
+    struct PendingTick {
+        qint64 timestampMs = 0;             ///< Время такта
+        QVector<ParameterValue> values;     ///< Значения
+    };
+
+    /**
+     * @brief Столбец параметра в собираемом блоке
+     */
+    struct Column {
+        quint32 nameId = 0;                 ///< Номер имени
+        bool numeric = true;                ///< Все значения числовые
+        QVector<quint16> ticks;             ///< Номера тактов в блоке
+        QVector<double> numbers;            ///< Числовые значения (numeric)
+        QVector<QString> texts;             ///< Строковые значения (!numeric)
+    };
+
+    /**
+     * @brief Незакрытая сводка параметра
+     */
+    struct RollupCell {
+        quint32 count = 0;                  ///< Число значений
+        double minimum = 0.0;               ///< Минимум
+        double maximum = 0.0;               ///< Максимум
+        double sum = 0.0;                   ///< Сумма
+    };
+
+    /**
+     * @brief Уровень сводок (минута, час или сутки)
+     */
+    struct RollupLevel {
+        QFile file;                         ///< Файл закрытых сводок уровня
+        qint64 startMs = -1;                ///< Начало открытого интервала (-1 - нет)
+        qint64 lastWrittenMs = -1;          ///< Начало последнего записанного интервала
+        QHash<quint32, RollupCell> cells;   ///< Номер имени → сводка открытого интервала
+    };
+
+    // --- Общее с потоком записи (под m_mutex) ---
+    mutable std::mutex m_mutex;             ///< Защита очереди и флагов
+    std::condition_variable m_wake;         ///< Пробуждение потока записи
+    std::deque<PendingTick> m_pending;      ///< Очередь тактов
+    bool m_running = false;                 ///< Поток записи запущен
+    bool m_stopping = false;                ///< Запрошена остановка
+    bool m_flushRequested = false;          ///< Запрошена запись неполного блока
+    qint64 m_segmentBytes = kDefaultSegmentBytes;   ///< Размер сегмента
+    int m_flushIntervalMs = kDefaultFlushIntervalMs; ///< Интервал записи неполного блока
+    QString m_directory;                    ///< Каталог архива
+    std::atomic<qint64> m_dropped{0};       ///< Отброшенные такты
+    std::thread m_thread;                   ///< Поток записи
+
+    // --- Состояние потока записи ---
+    quint32 m_kaNumber = 0;                 ///< Номер КА
+    QFile m_namesFile;                      ///< Справочник имен
+    QHash<QString, quint32> m_nameIds;      ///< Имя → номер
+    bool m_namesFailed = false;             ///< Справочник не удалось восстановить после ошибки записи
+    std::unique_ptr<QFile> m_segment;       ///< Текущий сегмент
+    std::unique_ptr<QFile> m_index;         ///< Индекс текущего сегмента
+    qint64 m_segmentDay = -1;               ///< Сутки UTC текущего сегмента
+    QVector<qint64> m_blockTimes;           ///< Время тактов собираемого блока
+    std::vector<Column> m_columns;          ///< Столбцы собираемого блока
+    QHash<quint32, int> m_columnIndex;      ///< Номер имени → столбец
+    qint64 m_lastMs = 0;                    ///< Время последнего записанного такта
+    RollupLevel m_rollups[kArchiveRollupLevels]; ///< Сводки от мелкого уровня к крупному
+
+    /**
+     * @brief Цикл потока записи.
+     */
+    void writerLoop();
+
+    /**
+     * @brief Добавляет такт в собираемый блок.
+     */
+    void addTick(const PendingTick& tick);
+
+    /**
+     * @brief Записывает собираемый блок и запись индекса.
+     */
+    void writeBlock();
+
+    /// Номер, возвращаемый nameId(), если имя не удалось записать в справочник.
+    static constexpr quint32 kNoNameId = 0xFFFFFFFF;
+
+    /**
+     * @brief Возвращает номер имени, при необходимости дописывая его в справочник.
+     *
+     * Номер выдается только после того, как запись имени сохранена на диске:
+     * номер имени - порядковый номер его записи в справочнике.
+     * @return Номер имени или kNoNameId, если записать имя не удалось.
+     */
+    quint32 nameId(const QString& name);
+
+    /**
+     * @brief Загружает справочник имен (отбрасывая недописанную запись).
+     */
+    bool loadNames();
+
+    /**
+     * @brief Открывает файлы сводок и восстанавливает незакрытые интервалы.
+     */
+    void openRollups();
+
+    /**
+     * @brief Закрывает интервалы сводок, которые заканчиваются до timestampMs.
+     */
+    void advanceRollups(qint64 timestampMs);
+
+    /**
+     * @brief Добавляет числовое значение в открытые интервалы всех уровней.
+     */
+    void addRollupValue(quint32 nameId, double value);
+
+    /**
+     * @brief Дописывает сводки открытого интервала уровня в файл и очищает их.
+     */
+    void closeRollup(int level);
+
+    /**
+     * @brief Сохраняет незакрытые интервалы сводок.
+     */
+    void saveRollupState();
+
+    /**
+     * @brief Начинает новый сегмент с первым тактом в firstMs.
+     */
+    bool openSegment(qint64 firstMs);
+
+    /**
+     * @brief Закрывает текущий сегмент.
+     */
+    void closeSegment();
+};
+
+} // namespace ParamControl
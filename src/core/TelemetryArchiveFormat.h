@@ -0,0 +1,205 @@
+// src/core/TelemetryArchiveFormat.h
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+
+#include "BinaryFormat.h"
+
+/**
+ * @file TelemetryArchiveFormat.h
+ * @brief Формат архива ТМИ на диске (общий для записи и чтения).
+ *
+ * Архив одного КА - каталог со следующими файлами:
+ *
+ * - names.dir - справочник имен параметров, только дописывается.
+ *   Запись: u16 длина + UTF-8; номер имени - порядковый номер записи.
+ *
+ * - <UTC время первого такта>.seg - сегмент: заголовок сегмента и
+ *   следующие за ним блоки. Блок хранит до kArchiveBlockTicks тактов
+ *   по столбцам: столбец времени тактов, затем по столбцу на каждый
+ *   параметр, получавший значения в этих тактах (номера тактов и значения).
+ *
+ * - <то же имя>.idx - индекс времени сегмента: по записи на каждый
+ *   полностью записанный блок (время первого и последнего такта, смещение).
+ *   Запись индекса дописывается только после данных блока, поэтому
+ *   читатель видит лишь целые блоки.
+ *
+ * - rollup_1m.dat, rollup_1h.dat, rollup_1d.dat - сводки числовых значений
+ *   (число, минимум, максимум, сумма) за минуту, час и сутки UTC. Сводка
+ *   интервала дописывается, когда время тактов уходит за его конец; записи
+ *   упорядочены по (началу интервала, номеру имени) и имеют фиксированный
+ *   размер, поэтому ищутся двоичным поиском прямо в отображении файла.
+ *
+ * - rollup.open - незакрытые интервалы сводок (перезаписывается целиком),
+ *   чтобы следующий сеанс продолжил их, а не начал заново.
+ *
+ * Все числа - little-endian, структуры без выравнивания; числовые
+ * столбцы можно читать прямо из отображенного в память файла.
+ */
+
+namespace ParamControl {
+
+/// Сигнатура заголовка сегмента.
+constexpr quint32 kArchiveSegmentMagic = 0x41544350;    // "PCTA"
+/// Сигнатура заголовка блока.
+constexpr quint32 kArchiveBlockMagic = 0x314B4250;      // "PBK1"
+/// Версия формата.
+constexpr quint16 kArchiveVersion = 1;
+
+/// Размер заголовка сегмента: magic u32, version u16, headerBytes u16, kaNumber u32, reserved u32.
+constexpr int kArchiveSegmentHeaderBytes = 16;
+/// Размер заголовка блока: magic u32, bytes u32, firstMs i64, lastMs i64, ticks u32, columns u32.
+constexpr int kArchiveBlockHeaderBytes = 32;
+/// Размер записи каталога столбцов: nameId u32, kind u8, reserved u8[3], count u32, offset u32, bytes u32.
+constexpr int kArchiveColumnEntryBytes = 20;
+/// Размер записи индекса: firstMs i64, lastMs i64, offset u64, bytes u32, ticks u32.
+constexpr int kArchiveIndexEntryBytes = 32;
+
+/// Наибольшее число тактов в блоке (номер такта в столбце - u16).
+constexpr int kArchiveBlockTicks = 4096;
+
+/// Сигнатура заголовка файла сводок.
+constexpr quint32 kArchiveRollupMagic = 0x52544350;     // "PCTR"
+/// Размер заголовка файла сводок: magic u32, version u16, headerBytes u16, resolutionSec u32, reserved u32.
+constexpr int kArchiveRollupHeaderBytes = 16;
+/// Размер записи сводки: startMs i64, nameId u32, count u32, min f64, max f64, sum f64.
+constexpr int kArchiveRollupRecordBytes = 40;
+
+/// Число уровней сводок.
+constexpr int kArchiveRollupLevels = 3;
+/// Длительность интервала сводки по уровням (от мелкого к крупному), мс.
+constexpr qint64 kArchiveRollupResolutionMs[kArchiveRollupLevels] = {
+    60LL * 1000, 60LL * 60 * 1000, 24LL * 60 * 60 * 1000};
+/// Файлы сводок по уровням.
+constexpr const char* kArchiveRollupFiles[kArchiveRollupLevels] = {
+    "rollup_1m.dat", "rollup_1h.dat", "rollup_1d.dat"};
+/// Файл незакрытых интервалов сводок.
+constexpr char kArchiveRollupStateFile[] = "rollup.open";
+
+/// Имя файла справочника имен.
+constexpr char kArchiveNamesFile[] = "names.dir";
+/// Расширение файла сегмента.
+constexpr char kArchiveSegmentSuffix[] = ".seg";
+/// Расширение файла индекса сегмента.
+constexpr char kArchiveIndexSuffix[] = ".idx";
+
+/**
+ * @brief Вид значений столбца
+ */
+enum class ArchiveColumnKind : quint8 {
+    Numeric = 0,    ///< f64 на отсчет
+    Text = 1        ///< u32 смещение конца строки на отсчет + UTF-8 всех строк
+};
+
+/**
+ * @brief Запись индекса времени сегмента
+ */
+struct ArchiveIndexEntry {
+    qint64 firstMs = 0;     ///< Время первого такта блока (мс от эпохи UTC)
+    qint64 lastMs = 0;      ///< Время последнего такта блока
+    quint64 offset = 0;     ///< Смещение блока в сегменте
+    quint32 bytes = 0;      ///< Размер блока
+    quint32 ticks = 0;      ///< Число тактов в блоке
+};
+
+/**
+ * @brief Запись каталога столбцов блока
+ */
+struct ArchiveColumnEntry {
+    quint32 nameId = 0;                                 ///< Номер имени в справочнике
+    ArchiveColumnKind kind = ArchiveColumnKind::Numeric; ///< Вид значений
+    quint32 count = 0;                                  ///< Число отсчетов
+    quint32 offset = 0;                                 ///< Смещение данных от начала блока
+    quint32 bytes = 0;                                  ///< Размер данных
+};
+
+/**
+ * @brief Сводка числовых значений параметра за интервал
+ */
+struct ArchiveRollupRecord {
+    qint64 startMs = 0;     ///< Начало интервала (кратно длительности уровня)
+    quint32 nameId = 0;     ///< Номер имени в справочнике
+    quint32 count = 0;      ///< Число значений
+    double minimum = 0.0;   ///< Минимум
+    double maximum = 0.0;   ///< Максимум
+    double sum = 0.0;       ///< Сумма (среднее = sum / count)
+};
+
+// --- Записи индекса, каталога столбцов и сводок (archivePut/archiveGet - BinaryFormat.h) ---
+
+inline ArchiveIndexEntry archiveReadIndexEntry(const uchar* data) {
+    ArchiveIndexEntry entry;
+    entry.firstMs = archiveGet<qint64>(data);
+    entry.lastMs = archiveGet<qint64>(data + 8);
+    entry.offset = archiveGet<quint64>(data + 16);
+    entry.bytes = archiveGet<quint32>(data + 24);
+    entry.ticks = archiveGet<quint32>(data + 28);
+    return entry;
+}
+
+inline ArchiveColumnEntry archiveReadColumnEntry(const uchar* data) {
+    ArchiveColumnEntry entry;
+    entry.nameId = archiveGet<quint32>(data);
+    entry.kind = static_cast<ArchiveColumnKind>(data[4]);
+    entry.count = archiveGet<quint32>(data + 8);
+    entry.offset = archiveGet<quint32>(data + 12);
+    entry.bytes = archiveGet<quint32>(data + 16);
+    return entry;
+}
+
+inline void archivePutRollupRecord(QByteArray& out, const ArchiveRollupRecord& record) {
+    archivePut<qint64>(out, record.startMs);
+    archivePut<quint32>(out, record.nameId);
+    archivePut<quint32>(out, record.count);
+    archivePutDouble(out, record.minimum);
+    archivePutDouble(out, record.maximum);
+    archivePutDouble(out, record.sum);
+}
+
+inline ArchiveRollupRecord archiveReadRollupRecord(const uchar* data) {
+    ArchiveRollupRecord record;
+    record.startMs = archiveGet<qint64>(data);
+    record.nameId = archiveGet<quint32>(data + 8);
+    record.count = archiveGet<quint32>(data + 12);
+    record.minimum = archiveGetDouble(data + 16);
+    record.maximum = archiveGetDouble(data + 24);
+    record.sum = archiveGetDouble(data + 32);
+    return record;
+}
+
+/**
+ * @brief Начало интервала длительностью resolutionMs, содержащего момент времени
+ * (с округлением вниз и для времени до эпохи).
+ */
+inline qint64 archiveAlignDown(qint64 timestampMs, qint64 resolutionMs) {
+    const qint64 remainder = timestampMs % resolutionMs;
+    return timestampMs - (remainder < 0 ? remainder + resolutionMs : remainder);
+}
+
+/**
+ * @brief Разбирает значение ТМИ так же, как история и программа условий.
+ * @param value Значение от СОТМ.
+ * @param number Числовое значение (если разобрано).
+ * @return true, если значение числовое.
+ */
+inline bool archiveNumericValue(const QVariant& value, double& number) {
+    bool ok = false;
+    switch (static_cast<QMetaType::Type>(value.type())) {
+        case QMetaType::Int:
+        case QMetaType::LongLong:
+        case QMetaType::UInt:
+        case QMetaType::ULongLong:
+        case QMetaType::Double:
+        case QMetaType::Float:
+            number = value.toDouble(&ok);
+            break;
+        default:
+            number = value.toString().trimmed().toDouble(&ok);
+            break;
+    }
+    return ok;
+}
+
+} // namespace ParamControl
@@ -0,0 +1,716 @@
+// src/core/TelemetryArchiveReader.cpp
+#include "TelemetryArchiveReader.h"
+
+#include <QDebug>
+#include <QDir>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ParamControl {
+
+namespace {
+
+/**
+ * @brief Сводит числовые отсчеты в интервалы длиной widthMs (кратные от эпохи).
+ */
+void appendRawBuckets(const QVector<HistorySample>& samples, qint64 widthMs, QVector<TrendBucket>& out) {
+    TrendBucket bucket;
+    double sum = 0.0;
+    for (const HistorySample& sample : samples) {
+        double value = 0.0;
+        if (!archiveNumericValue(sample.value, value) || !std::isfinite(value)) {
+            continue;
+        }
+
+        const qint64 startMs = archiveAlignDown(sample.timestampMs, widthMs);
+        if (bucket.count > 0 && startMs != bucket.startMs) {
+            bucket.mean = sum / bucket.count;
+            out.append(bucket);
+            bucket.count = 0;
+        }
+        if (bucket.count == 0) {
+            bucket.startMs = startMs;
+            bucket.durationMs = widthMs;
+            bucket.minimum = bucket.maximum = value;
+            sum = 0.0;
+        }
+        bucket.minimum = qMin(bucket.minimum, value);
+        bucket.maximum = qMax(bucket.maximum, value);
+        sum += value;
+        ++bucket.count;
+    }
+    if (bucket.count > 0) {
+        bucket.mean = sum / bucket.count;
+        out.append(bucket);
+    }
+}
+
+/**
+ * @brief Сводит точки тренда (в порядке времени) в группы длиной widthMs от fromMs.
+ *
+ * Точка попадает в группу по своему началу; начало до fromMs относится
+ * к первой группе. Среднее группы взвешено числом значений.
+ */
+void mergeTrendBuckets(QVector<TrendBucket>& buckets, qint64 fromMs, qint64 widthMs, int maxPoints) {
+    int merged = -1;
+    qint64 mergedGroup = -1;
+    for (int i = 0; i < buckets.size(); ++i) {
+        const TrendBucket bucket = buckets.at(i);
+        const qint64 group = qMin<qint64>(maxPoints - 1, (qMax(bucket.startMs, fromMs) - fromMs) / widthMs);
+        if (merged >= 0 && group == mergedGroup) {
+            TrendBucket& target = buckets[merged];
+            const int count = target.count + bucket.count;
+            target.mean = (target.mean * target.count + bucket.mean * bucket.count) / count;
+            target.count = count;
+            target.minimum = qMin(target.minimum, bucket.minimum);
+            target.maximum = qMax(target.maximum, bucket.maximum);
+            target.durationMs = qMax(target.startMs + target.durationMs, bucket.startMs + bucket.durationMs)
+                                - target.startMs;
+            continue;
+        }
+        buckets[++merged] = bucket;
+        mergedGroup = group;
+    }
+    buckets.resize(merged + 1);
+}
+
+} // namespace
+
+TelemetryArchiveReader::TelemetryArchiveReader(const QString& directory)
+    : m_directory(directory)
+{
+    refresh();
+}
+
+TelemetryArchiveReader::~TelemetryArchiveReader() = default;
+
+bool TelemetryArchiveReader::isValid() const {
+    return m_valid;
+}
+
+void TelemetryArchiveReader::refresh() {
+    // Отображения освобождаются вместе с файлами
+    m_segments.clear();
+    loadNames();
+    mapRollups();
+
+    const QDir directory(m_directory);
+    const QStringList files = directory.entryList(
+        QStringList(QString("*") + kArchiveSegmentSuffix), QDir::Files, QDir::Name);
+    for (const QString& file : files) {
+        const QString dataPath = directory.filePath(file);
+        QString indexPath = dataPath;
+        indexPath.chop(int(qstrlen(kArchiveSegmentSuffix)));
+        indexPath += kArchiveIndexSuffix;
+
+        Segment segment;
+        if (mapSegment(dataPath, indexPath, segment)) {
+            m_segments.push_back(std::move(segment));
+        }
+    }
+}
+
+QString TelemetryArchiveReader::directory() const {
+    return m_directory;
+}
+
+QStringList TelemetryArchiveReader::names() const {
+    QStringList result;
+    result.reserve(m_names.size());
+    for (const QString& name : m_names) {
+        result.append(name);
+    }
+    return result;
+}
+
+qint64 TelemetryArchiveReader::firstTimestamp() const {
+    return m_segments.empty() ? 0 : indexEntry(m_segments.front(), 0).firstMs;
+}
+
+qint64 TelemetryArchiveReader::lastTimestamp() const {
+    if (m_segments.empty()) {
+        return 0;
+    }
+    const Segment& last = m_segments.back();
+    return indexEntry(last, last.blocks - 1).lastMs;
+}
+
+int TelemetryArchiveReader::blockCount() const {
+    int count = 0;
+    for (const Segment& segment : m_segments) {
+        count += segment.blocks;
+    }
+    return count;
+}
+
+QVector<HistorySample> TelemetryArchiveReader::samples(const QString& name, qint64 fromMs, qint64 toMs) const {
+    QVector<HistorySample> result;
+    quint32 id = 0;
+    if (!nameId(name, id)) {
+        return result;
+    }
+
+    for (const BlockRef& block : blocks(fromMs, toMs)) {
+        blockSamples(block, id, fromMs, toMs, result);
+    }
+
+    // Сегменты разных сеансов могут перекрываться, если часы переводили назад
+    const auto byTime = [](const HistorySample& a, const HistorySample& b) { return a.timestampMs < b.timestampMs; };
+    if (!std::is_sorted(result.cbegin(), result.cend(), byTime)) {
+        std::stable_sort(result.begin(), result.end(), byTime);
+    }
+    return result;
+}
+
+bool TelemetryArchiveReader::nameId(const QString& name, quint32& id) const {
+    const auto it = m_nameIds.constFind(name);
+    if (it == m_nameIds.constEnd()) {
+        return false;
+    }
+    id = it.value();
+    return true;
+}
+
+QVector<TelemetryArchiveReader::BlockRef> TelemetryArchiveReader::blocks(qint64 fromMs, qint64 toMs) const {
+    QVector<BlockRef> result;
+    if (fromMs > toMs) {
+        return result;
+    }
+
+    for (int index = 0; index < int(m_segments.size()); ++index) {
+        const Segment& segment = m_segments[index];
+        if (indexEntry(segment, 0).firstMs > toMs || indexEntry(segment, segment.blocks - 1).lastMs < fromMs) {
+            continue;
+        }
+
+        // Время в сегменте не убывает: первый нужный блок ищем по индексу двоичным поиском
+        int low = 0;
+        int high = segment.blocks;
+        while (low < high) {
+            const int middle = (low + high) / 2;
+            if (indexEntry(segment, middle).lastMs < fromMs) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        for (int block = low; block < segment.blocks; ++block) {
+            const ArchiveIndexEntry entry = indexEntry(segment, block);
+            if (entry.firstMs > toMs) {
+                break;
+            }
+            result.append({index, block, entry.firstMs, entry.lastMs});
+        }
+    }
+    return result;
+}
+
+void TelemetryArchiveReader::blockSamples(const BlockRef& block, quint32 nameId, qint64 fromMs, qint64 toMs,
+                                          QVector<HistorySample>& out) const {
+    if (block.segment < 0 || block.segment >= int(m_segments.size())) {
+        return;
+    }
+    const Segment& segment = m_segments[block.segment];
+    if (block.block < 0 || block.block >= segment.blocks) {
+        return;
+    }
+
+    ArchiveColumnEntry column;
+    if (const uchar* data = findColumn(segment, indexEntry(segment, block.block), nameId, column)) {
+        decodeColumn(data, column, fromMs, toMs, out);
+    }
+}
+
+void TelemetryArchiveReader::blockNumbers(const BlockRef& block, quint32 nameId, qint64 fromMs, qint64 toMs,
+                                          QVector<qint64>& times, QVector<double>& values) const {
+    if (block.segment < 0 || block.segment >= int(m_segments.size())) {
+        return;
+    }
+    const Segment& segment = m_segments[block.segment];
+    if (block.block < 0 || block.block >= segment.blocks) {
+        return;
+    }
+
+    ArchiveColumnEntry column;
+    const uchar* data = findColumn(segment, indexEntry(segment, block.block), nameId, column);
+    if (!data) {
+        return;
+    }
+    if (column.kind == ArchiveColumnKind::Numeric) {
+        decodeNumbers(data, column, fromMs, toMs, times, values);
+        return;
+    }
+
+    // Строковый столбец: числа разбираются так же, как при записи сводок
+    QVector<HistorySample> samples;
+    decodeColumn(data, column, fromMs, toMs, samples);
+    for (const HistorySample& sample : samples) {
+        double value = 0.0;
+        if (archiveNumericValue(sample.value, value)) {
+            times.append(sample.timestampMs);
+            values.append(value);
+        }
+    }
+}
+
+QVector<ArchiveTick> TelemetryArchiveReader::blockTicks(const BlockRef& block, const QVector<quint32>& nameIds) const {
+    QVector<ArchiveTick> ticks;
+    if (block.segment < 0 || block.segment >= int(m_segments.size())) {
+        return ticks;
+    }
+    const Segment& segment = m_segments[block.segment];
+    if (block.block < 0 || block.block >= segment.blocks) {
+        return ticks;
+    }
+    const ArchiveIndexEntry entry = indexEntry(segment, block.block);
+    const uchar* data = checkedBlock(segment, entry);
+    if (!data) {
+        return ticks;
+    }
+
+    const quint32 tickCount = archiveGet<quint32>(data + 24);
+    const quint32 columns = archiveGet<quint32>(data + 28);
+    const uchar* directory = data + kArchiveBlockHeaderBytes;
+    const uchar* times = directory + columns * kArchiveColumnEntryBytes;
+    ticks.resize(int(tickCount));
+    for (quint32 tick = 0; tick < tickCount; ++tick) {
+        ticks[int(tick)].timestampMs = archiveGet<qint64>(times + tick * 8);
+    }
+
+    if (nameIds.isEmpty()) {
+        for (quint32 i = 0; i < columns; ++i) {
+            const quint32 id = archiveGet<quint32>(directory + i * kArchiveColumnEntryBytes);
+            ArchiveColumnEntry column;
+            if (id < quint32(m_names.size()) && findColumn(segment, entry, id, column)) {
+                decodeTicks(data, column, m_names[int(id)], ticks);
+            }
+        }
+    } else {
+        for (quint32 id : nameIds) {
+            ArchiveColumnEntry column;
+            if (id < quint32(m_names.size()) && findColumn(segment, entry, id, column)) {
+                decodeTicks(data, column, m_names[int(id)], ticks);
+            }
+        }
+    }
+    return ticks;
+}
+
+bool TelemetryArchiveReader::valueAt(const QString& name, qint64 timeMs, HistorySample& sample) const {
+    const auto id = m_nameIds.constFind(name);
+    if (id == m_nameIds.constEnd()) {
+        return false;
+    }
+
+    // Идем от последнего блока, начавшегося не позже timeMs, к более ранним
+    for (auto segment = m_segments.crbegin(); segment != m_segments.crend(); ++segment) {
+        if (indexEntry(*segment, 0).firstMs > timeMs) {
+            continue;
+        }
+
+        int low = 0;
+        int high = segment->blocks;
+        while (low < high) {
+            const int middle = (low + high) / 2;
+            if (indexEntry(*segment, middle).firstMs <= timeMs) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        for (int block = low - 1; block >= 0; --block) {
+            const ArchiveIndexEntry entry = indexEntry(*segment, block);
+            ArchiveColumnEntry column;
+            const uchar* data = findColumn(*segment, entry, id.value(), column);
+            if (!data) {
+                continue;
+            }
+            QVector<HistorySample> found;
+            decodeColumn(data, column, entry.firstMs, timeMs, found);
+            if (!found.isEmpty()) {
+                sample = found.last();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+QVector<TrendBucket> TelemetryArchiveReader::rollups(const QString& name, qint64 fromMs, qint64 toMs, int level) const {
+    QVector<TrendBucket> result;
+    const auto id = m_nameIds.constFind(name);
+    if (id == m_nameIds.constEnd() || level < 0 || level >= kArchiveRollupLevels || fromMs > toMs) {
+        return result;
+    }
+
+    const RollupFile& file = m_rollupFiles[level];
+    const qint64 resolution = kArchiveRollupResolutionMs[level];
+    const auto startOf = [&file](qint64 record) {
+        return archiveGet<qint64>(file.records + record * kArchiveRollupRecordBytes);
+    };
+
+    // Записи упорядочены по (началу интервала, номеру имени): находим первый интервал,
+    // затем в каждом интервале - запись параметра, оба раза двоичным поиском
+    const qint64 firstStart = archiveAlignDown(fromMs, resolution);
+    qint64 low = 0;
+    qint64 high = file.count;
+    while (low < high) {
+        const qint64 middle = (low + high) / 2;
+        if (startOf(middle) < firstStart) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    for (qint64 group = low; group < file.count;) {
+        const qint64 startMs = startOf(group);
+        if (startMs > toMs) {
+            break;
+        }
+
+        qint64 groupEnd = group + 1;
+        qint64 limit = file.count;
+        while (groupEnd < limit) {
+            const qint64 middle = (groupEnd + limit) / 2;
+            if (startOf(middle) == startMs) {
+                groupEnd = middle + 1;
+            } else {
+                limit = middle;
+            }
+        }
+
+        qint64 first = group;
+        qint64 last = groupEnd;
+        while (first < last) {
+            const qint64 middle = (first + last) / 2;
+            if (archiveGet<quint32>(file.records + middle * kArchiveRollupRecordBytes + 8) < id.value()) {
+                first = middle + 1;
+            } else {
+                last = middle;
+            }
+        }
+        if (first < groupEnd) {
+            const ArchiveRollupRecord record =
+                archiveReadRollupRecord(file.records + first * kArchiveRollupRecordBytes);
+            if (record.nameId == id.value() && record.count > 0) {
+                TrendBucket bucket;
+                bucket.startMs = record.startMs;
+                bucket.durationMs = resolution;
+                bucket.count = int(record.count);
+                bucket.minimum = record.minimum;
+                bucket.maximum = record.maximum;
+                bucket.mean = record.sum / record.count;
+                result.append(bucket);
+            }
+        }
+        group = groupEnd;
+    }
+    return result;
+}
+
+QVector<TrendBucket> TelemetryArchiveReader::trend(const QString& name, qint64 fromMs, qint64 toMs, int maxPoints) const {
+    QVector<TrendBucket> result;
+    if (maxPoints <= 0 || fromMs > toMs || !m_nameIds.contains(name)) {
+        return result;
+    }
+
+    const qint64 widthMs = qMax<qint64>(1, (toMs - fromMs + maxPoints) / maxPoints);
+    appendTrend(name, fromMs, toMs, trendLevel(fromMs, toMs, maxPoints), widthMs, result);
+    // Сводки уровня (и участки, достроенные уровнем ниже) мельче точки:
+    // сводим их, чтобы точек было не больше maxPoints
+    mergeTrendBuckets(result, fromMs, widthMs, maxPoints);
+    return result;
+}
+
+int TelemetryArchiveReader::trendLevel(qint64 fromMs, qint64 toMs, int maxPoints) {
+    if (maxPoints <= 0 || fromMs > toMs) {
+        return -1;
+    }
+
+    // Самый крупный уровень, интервал которого не шире одной точки
+    const qint64 widthMs = (toMs - fromMs + maxPoints) / maxPoints;
+    int level = -1;
+    for (int candidate = 0; candidate < kArchiveRollupLevels; ++candidate) {
+        if (kArchiveRollupResolutionMs[candidate] <= widthMs) {
+            level = candidate;
+        }
+    }
+    return level;
+}
+
+void TelemetryArchiveReader::appendTrend(const QString& name, qint64 fromMs, qint64 toMs, int level,
+                                         qint64 rawWidthMs, QVector<TrendBucket>& out) const {
+    if (fromMs > toMs) {
+        return;
+    }
+    if (level < 0) {
+        appendRawBuckets(samples(name, fromMs, toMs), rawWidthMs, out);
+        return;
+    }
+
+    // Сводки уровня покрывают [coveredBegin, coveredEnd); остальное - уровнем ниже.
+    // Ниже минутного уровня отсчеты сводятся в минутные интервалы.
+    const RollupFile& file = m_rollupFiles[level];
+    const qint64 resolution = kArchiveRollupResolutionMs[level];
+    const qint64 finerWidthMs = (level == 0) ? resolution : rawWidthMs;
+    if (file.count == 0) {
+        appendTrend(name, fromMs, toMs, level - 1, finerWidthMs, out);
+        return;
+    }
+
+    const qint64 coveredBegin = archiveGet<qint64>(file.records);
+    const qint64 coveredEnd = archiveGet<qint64>(file.records + (file.count - 1) * kArchiveRollupRecordBytes) + resolution;
+
+    appendTrend(name, fromMs, qMin(toMs, coveredBegin - 1), level - 1, finerWidthMs, out);
+    if (fromMs < coveredEnd && toMs >= coveredBegin) {
+        out += rollups(name, qMax(fromMs, coveredBegin), qMin(toMs, coveredEnd - 1), level);
+    }
+    appendTrend(name, qMax(fromMs, coveredEnd), toMs, level - 1, finerWidthMs, out);
+}
+
+void TelemetryArchiveReader::mapRollups() {
+    const QDir directory(m_directory);
+    for (int level = 0; level < kArchiveRollupLevels; ++level) {
+        RollupFile& rollup = m_rollupFiles[level];
+        rollup.file = std::make_unique<QFile>(directory.filePath(kArchiveRollupFiles[level]));
+        rollup.records = nullptr;
+        rollup.count = 0;
+
+        if (!rollup.file->open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        const qint64 count = (rollup.file->size() - kArchiveRollupHeaderBytes) / kArchiveRollupRecordBytes;
+        if (count <= 0) {
+            continue;
+        }
+
+        const uchar* map = rollup.file->map(0, kArchiveRollupHeaderBytes + count * kArchiveRollupRecordBytes);
+        if (!map || archiveGet<quint32>(map) != kArchiveRollupMagic) {
+            qWarning() << "TelemetryArchiveReader: не удалось прочитать сводки" << rollup.file->fileName();
+            continue;
+        }
+        rollup.records = map + kArchiveRollupHeaderBytes;
+        rollup.count = count;
+    }
+}
+
+void TelemetryArchiveReader::loadNames() {
+    m_names.clear();
+    m_nameIds.clear();
+
+    QFile file(QDir(m_directory).filePath(kArchiveNamesFile));
+    m_valid = file.open(QIODevice::ReadOnly);
+    if (!m_valid) {
+        return;
+    }
+
+    const QByteArray content = file.readAll();
+    const uchar* data = reinterpret_cast<const uchar*>(content.constData());
+    int position = 0;
+    while (position + 2 <= content.size()) {
+        const int length = archiveGet<quint16>(data + position);
+        if (position + 2 + length > content.size()) {
+            break;
+        }
+        const QString name = QString::fromUtf8(content.constData() + position + 2, length);
+        m_nameIds.insert(name, quint32(m_names.size()));
+        m_names.append(name);
+        position += 2 + length;
+    }
+}
+
+bool TelemetryArchiveReader::mapSegment(const QString& dataPath, const QString& indexPath, Segment& segment) const {
+    // Индекс отображаем раньше сегмента: блоки дописываются раньше своих записей индекса,
+    // поэтому все записи отображенного индекса указывают на уже записанные данные
+    segment.index = std::make_unique<QFile>(indexPath);
+    segment.data = std::make_unique<QFile>(dataPath);
+    if (!segment.index->open(QIODevice::ReadOnly) || !segment.data->open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 indexSize = segment.index->size() - segment.index->size() % kArchiveIndexEntryBytes;
+    segment.dataSize = segment.data->size();
+    if (indexSize == 0 || segment.dataSize < kArchiveSegmentHeaderBytes) {
+        return false;
+    }
+
+    segment.indexMap = segment.index->map(0, indexSize);
+    segment.dataMap = segment.data->map(0, segment.dataSize);
+    if (!segment.indexMap || !segment.dataMap) {
+        qWarning() << "TelemetryArchiveReader: не удалось отобразить" << dataPath;
+        return false;
+    }
+
+    if (archiveGet<quint32>(segment.dataMap) != kArchiveSegmentMagic ||
+        archiveGet<quint16>(segment.dataMap + 4) != kArchiveVersion) {
+        qWarning() << "TelemetryArchiveReader: неизвестный формат сегмента" << dataPath;
+        return false;
+    }
+
+    // Отбрасываем записи, выходящие за отображенные данные (сегмент усечен)
+    segment.blocks = int(indexSize / kArchiveIndexEntryBytes);
+    while (segment.blocks > 0) {
+        const ArchiveIndexEntry last = indexEntry(segment, segment.blocks - 1);
+        if (last.offset + last.bytes <= quint64(segment.dataSize)) {
+            break;
+        }
+        --segment.blocks;
+    }
+    return segment.blocks > 0;
+}
+
+ArchiveIndexEntry TelemetryArchiveReader::indexEntry(const Segment& segment, int block) {
+    return archiveReadIndexEntry(segment.indexMap + qint64(block) * kArchiveIndexEntryBytes);
+}
+
+const uchar* TelemetryArchiveReader::checkedBlock(const Segment& segment, const ArchiveIndexEntry& entry) {
+    const uchar* block = segment.dataMap + entry.offset;
+    if (entry.bytes < quint32(kArchiveBlockHeaderBytes) ||
+        archiveGet<quint32>(block) != kArchiveBlockMagic ||
+        archiveGet<quint32>(block + 4) != entry.bytes) {
+        return nullptr;
+    }
+
+    const quint32 ticks = archiveGet<quint32>(block + 24);
+    const quint32 columns = archiveGet<quint32>(block + 28);
+    if (quint64(kArchiveBlockHeaderBytes) + quint64(columns) * kArchiveColumnEntryBytes +
+        quint64(ticks) * 8 > entry.bytes) {
+        return nullptr;
+    }
+    return block;
+}
+
+const uchar* TelemetryArchiveReader::findColumn(const Segment& segment, const ArchiveIndexEntry& entry,
+                                                quint32 nameId, ArchiveColumnEntry& column) {
+    const uchar* block = checkedBlock(segment, entry);
+    if (!block) {
+        return nullptr;
+    }
+    const quint32 columns = archiveGet<quint32>(block + 28);
+
+    // Каталог столбцов упорядочен по номеру имени
+    const uchar* directory = block + kArchiveBlockHeaderBytes;
+    quint32 low = 0;
+    quint32 high = columns;
+    while (low < high) {
+        const quint32 middle = (low + high) / 2;
+        if (archiveGet<quint32>(directory + middle * kArchiveColumnEntryBytes) < nameId) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == columns) {
+        return nullptr;
+    }
+
+    column = archiveReadColumnEntry(directory + low * kArchiveColumnEntryBytes);
+    const quint64 fixedBytes = quint64(column.count) * (column.kind == ArchiveColumnKind::Numeric ? 10 : 6);
+    if (column.nameId != nameId || quint64(column.offset) + column.bytes > entry.bytes ||
+        fixedBytes > column.bytes) {
+        return nullptr;
+    }
+    return block;
+}
+
+void TelemetryArchiveReader::decodeColumn(const uchar* block, const ArchiveColumnEntry& column,
+                                          qint64 fromMs, qint64 toMs, QVector<HistorySample>& out) {
+    const quint32 ticks = archiveGet<quint32>(block + 24);
+    const quint32 columns = archiveGet<quint32>(block + 28);
+    const uchar* times = block + kArchiveBlockHeaderBytes + columns * kArchiveColumnEntryBytes;
+    const uchar* tickNumbers = block + column.offset;
+    const uchar* values = tickNumbers + column.count * 2;
+
+    // Для строк: смещения концов строк, затем сами строки
+    const uchar* text = values + column.count * 4;
+    const quint32 textBytes = column.bytes - column.count * 6;
+    quint32 textStart = 0;
+
+    for (quint32 i = 0; i < column.count; ++i) {
+        const quint16 tick = archiveGet<quint16>(tickNumbers + i * 2);
+        if (tick >= ticks) {
+            break;
+        }
+        const qint64 timestampMs = archiveGet<qint64>(times + tick * 8);
+
+        if (column.kind == ArchiveColumnKind::Numeric) {
+            if (timestampMs > toMs) {
+                break;
+            }
+            if (timestampMs >= fromMs) {
+                out.append({timestampMs, QVariant(archiveGetDouble(values + i * 8))});
+            }
+        } else {
+            const quint32 textEnd = archiveGet<quint32>(values + i * 4);
+            if (textEnd < textStart || textEnd > textBytes || timestampMs > toMs) {
+                break;
+            }
+            if (timestampMs >= fromMs) {
+                out.append({timestampMs, QVariant(QString::fromUtf8(
+                    reinterpret_cast<const char*>(text + textStart), int(textEnd - textStart)))});
+            }
+            textStart = textEnd;
+        }
+    }
+}
+
+void TelemetryArchiveReader::decodeTicks(const uchar* block, const ArchiveColumnEntry& column, const QString& name,
+                                         QVector<ArchiveTick>& ticks) {
+    const uchar* tickNumbers = block + column.offset;
+    const uchar* values = tickNumbers + column.count * 2;
+    const uchar* text = values + column.count * 4;
+    const quint32 textBytes = column.bytes - column.count * 6;
+    quint32 textStart = 0;
+
+    for (quint32 i = 0; i < column.count; ++i) {
+        const quint16 tick = archiveGet<quint16>(tickNumbers + i * 2);
+        if (tick >= ticks.size()) {
+            break;
+        }
+
+        if (column.kind == ArchiveColumnKind::Numeric) {
+            ticks[tick].values.append({name, QVariant(archiveGetDouble(values + i * 8))});
+        } else {
+            const quint32 textEnd = archiveGet<quint32>(values + i * 4);
+            if (textEnd < textStart || textEnd > textBytes) {
+                break;
+            }
+            ticks[tick].values.append({name, QVariant(QString::fromUtf8(
+                reinterpret_cast<const char*>(text + textStart), int(textEnd - textStart)))});
+            textStart = textEnd;
+        }
+    }
+}
+
+void TelemetryArchiveReader::decodeNumbers(const uchar* block, const ArchiveColumnEntry& column, qint64 fromMs,
+                                           qint64 toMs, QVector<qint64>& times, QVector<double>& values) {
+    const quint32 ticks = archiveGet<quint32>(block + 24);
+    const quint32 columns = archiveGet<quint32>(block + 28);
+    const uchar* tickTimes = block + kArchiveBlockHeaderBytes + columns * kArchiveColumnEntryBytes;
+    const uchar* tickNumbers = block + column.offset;
+    const uchar* numbers = tickNumbers + column.count * 2;
+
+    times.reserve(times.size() + int(column.count));
+    values.reserve(values.size() + int(column.count));
+    for (quint32 i = 0; i < column.count; ++i) {
+        const quint16 tick = archiveGet<quint16>(tickNumbers + i * 2);
+        if (tick >= ticks) {
+            break;
+        }
+        const qint64 timestampMs = archiveGet<qint64>(tickTimes + tick * 8);
+        if (timestampMs > toMs) {
+            break;
+        }
+        if (timestampMs >= fromMs) {
+            times.append(timestampMs);
+            values.append(archiveGetDouble(numbers + i * 8));
+        }
+    }
+}
+
+} // namespace ParamControl
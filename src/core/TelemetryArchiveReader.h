@@ -0,0 +1,297 @@
+// src/core/TelemetryArchiveReader.h
+#pragma once
+
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <memory>
+#include <vector>
+
+#include "HistoryStore.h"          // Для HistorySample
+#include "TelemetryArchiveFormat.h"
+
+namespace ParamControl {
+
+/**
+ * @brief Точка тренда: сводка значений параметра за интервал времени
+ */
+struct TrendBucket {
+    qint64 startMs = 0;         ///< Начало интервала (мс от эпохи UTC)
+    qint64 durationMs = 0;      ///< Длительность интервала
+    int count = 0;              ///< Число числовых значений
+    double minimum = 0.0;       ///< Минимум
+    double maximum = 0.0;       ///< Максимум
+    double mean = 0.0;          ///< Среднее
+};
+
+/**
+ * @brief Такт из архива: время и значения, записанные в этом такте
+ */
+struct ArchiveTick {
+    qint64 timestampMs = 0;             ///< Время такта (мс от эпохи UTC)
+    QVector<ParameterValue> values;     ///< Значения параметров такта
+};
+
+/**
+ * @brief Чтение архива ТМИ, записанного TelemetryArchive.
+ *
+ * Сегменты и их индексы отображаются в память (QFile::map) и читаются
+ * без копирования файлов: по индексу времени выбираются только блоки,
+ * пересекающиеся с запрошенным интервалом, а в блоке - только столбец
+ * нужного параметра. Архив можно читать во время записи: видны блоки,
+ * записанные до открытия или последнего вызова refresh().
+ *
+ * Для длинных интервалов trend() берет готовые сводки за минуту, час
+ * или сутки - самые крупные, которых еще хватает на запрошенное число
+ * точек; участки, для которых сводок этого уровня нет (например, текущий
+ * незакрытый час), достраиваются по более мелкому уровню или по отсчетам.
+ */
+class TelemetryArchiveReader {
+public:
+    /**
+     * @brief Ссылка на блок архива (для поблочной обработки)
+     */
+    struct BlockRef {
+        int segment = 0;        ///< Номер сегмента
+        int block = 0;          ///< Номер блока в сегменте
+        qint64 firstMs = 0;     ///< Время первого такта блока
+        qint64 lastMs = 0;      ///< Время последнего такта блока
+    };
+
+    /**
+     * @brief Конструктор: открывает архив.
+     * @param directory Каталог архива КА.
+     */
+    explicit TelemetryArchiveReader(const QString& directory);
+
+    /**
+     * @brief Деструктор
+     */
+    ~TelemetryArchiveReader();
+
+    TelemetryArchiveReader(const TelemetryArchiveReader&) = delete;
+    TelemetryArchiveReader& operator=(const TelemetryArchiveReader&) = delete;
+
+    /**
+     * @brief Проверяет, найден ли архив (справочник имен).
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Заново отображает файлы архива, чтобы увидеть дописанные блоки.
+     */
+    void refresh();
+
+    /**
+     * @brief Возвращает каталог архива.
+     */
+    QString directory() const;
+
+    /**
+     * @brief Возвращает имена всех параметров архива.
+     */
+    QStringList names() const;
+
+    /**
+     * @brief Время первого такта архива (0 для пустого архива).
+     */
+    qint64 firstTimestamp() const;
+
+    /**
+     * @brief Время последнего такта архива (0 для пустого архива).
+     */
+    qint64 lastTimestamp() const;
+
+    /**
+     * @brief Общее число блоков во всех сегментах.
+     */
+    int blockCount() const;
+
+    /**
+     * @brief Возвращает отсчеты параметра за интервал времени [fromMs, toMs].
+     * @param name Имя параметра ТМИ.
+     * @param fromMs Начало интервала (мс от эпохи UTC).
+     * @param toMs Конец интервала.
+     * @return Отсчеты в порядке времени.
+     */
+    QVector<HistorySample> samples(const QString& name, qint64 fromMs, qint64 toMs) const;
+
+    /**
+     * @brief Возвращает номер имени параметра в справочнике архива.
+     * @return true, если имя есть в архиве.
+     */
+    bool nameId(const QString& name, quint32& id) const;
+
+    /**
+     * @brief Выбирает по индексу времени блоки, пересекающиеся с [fromMs, toMs].
+     * @return Блоки в порядке сегментов и времени.
+     */
+    QVector<BlockRef> blocks(qint64 fromMs, qint64 toMs) const;
+
+    /**
+     * @brief Распаковывает отсчеты параметра из одного блока.
+     *
+     * Только читает отображение файла, поэтому разные блоки можно
+     * распаковывать из нескольких потоков одновременно.
+     * @param block Блок из blocks().
+     * @param nameId Номер имени из nameId().
+     * @param fromMs Начало интервала.
+     * @param toMs Конец интервала.
+     * @param out Отсчеты дописываются сюда.
+     */
+    void blockSamples(const BlockRef& block, quint32 nameId, qint64 fromMs, qint64 toMs,
+                      QVector<HistorySample>& out) const;
+
+    /**
+     * @brief Распаковывает числовые значения параметра из одного блока
+     * без построения QVariant (нечисловые значения пропускаются).
+     * @param times Время отсчетов дописывается сюда.
+     * @param values Значения дописываются сюда.
+     */
+    void blockNumbers(const BlockRef& block, quint32 nameId, qint64 fromMs, qint64 toMs,
+                      QVector<qint64>& times, QVector<double>& values) const;
+
+    /**
+     * @brief Восстанавливает такты блока (для повторного прогона правил).
+     *
+     * Как и blockSamples(), только читает отображение и безопасен
+     * для параллельного вызова по разным блокам.
+     * @param block Блок из blocks().
+     * @param nameIds Номера имен, значения которых нужны; пусто - все.
+     * @return Такты блока по порядку записи (включая такты без выбранных значений).
+     */
+    QVector<ArchiveTick> blockTicks(const BlockRef& block, const QVector<quint32>& nameIds = {}) const;
+
+    /**
+     * @brief Находит значение параметра на момент времени (последний отсчет не позже timeMs).
+     * @param name Имя параметра ТМИ.
+     * @param timeMs Момент времени (мс от эпохи UTC).
+     * @param sample Найденный отсчет.
+     * @return true, если отсчет найден.
+     */
+    bool valueAt(const QString& name, qint64 timeMs, HistorySample& sample) const;
+
+    /**
+     * @brief Возвращает закрытые сводки параметра одного уровня.
+     * @param name Имя параметра ТМИ.
+     * @param fromMs Начало интервала (включается и сводка, содержащая fromMs).
+     * @param toMs Конец интервала.
+     * @param level Уровень сводок: 0 - минута, 1 - час, 2 - сутки.
+     * @return Сводки в порядке времени.
+     */
+    QVector<TrendBucket> rollups(const QString& name, qint64 fromMs, qint64 toMs, int level) const;
+
+    /**
+     * @brief Возвращает тренд параметра не более чем на maxPoints точек.
+     *
+     * Уровень выбирается самым крупным, интервал которого не длиннее
+     * (toMs - fromMs) / maxPoints; если такого нет, отсчеты сводятся
+     * в интервалы этой длины. Сводки уровня затем объединяются в группы
+     * этой длины от fromMs (минимум минимумов, максимум максимумов,
+     * среднее, взвешенное числом значений).
+     * @param name Имя параметра ТМИ.
+     * @param fromMs Начало интервала.
+     * @param toMs Конец интервала.
+     * @param maxPoints Число точек (например, ширина графика в пикселях).
+     * @return Точки тренда в порядке времени.
+     */
+    QVector<TrendBucket> trend(const QString& name, qint64 fromMs, qint64 toMs, int maxPoints) const;
+
+    /**
+     * @brief Уровень сводок, который trend() выберет для интервала.
+     * @return Номер уровня или -1, если нужны исходные отсчеты.
+     */
+    static int trendLevel(qint64 fromMs, qint64 toMs, int maxPoints);
+
+private:
+    /**
+     * @brief Отображенный в память файл сводок уровня
+     */
+    struct RollupFile {
+        std::unique_ptr<QFile> file;        ///< Файл сводок
+        const uchar* records = nullptr;     ///< Первая запись в отображении
+        qint64 count = 0;                   ///< Число целых записей
+    };
+
+    /**
+     * @brief Отображенный в память сегмент с индексом
+     */
+    struct Segment {
+        std::unique_ptr<QFile> data;        ///< Файл сегмента
+        std::unique_ptr<QFile> index;       ///< Файл индекса
+        const uchar* dataMap = nullptr;     ///< Отображение сегмента
+        qint64 dataSize = 0;                ///< Отображенный размер сегмента
+        const uchar* indexMap = nullptr;    ///< Отображение индекса
+        int blocks = 0;                     ///< Число целых блоков
+    };
+
+    QString m_directory;                    ///< Каталог архива
+    bool m_valid = false;                   ///< Справочник имен найден
+    std::vector<Segment> m_segments;        ///< Сегменты по возрастанию времени
+    QVector<QString> m_names;               ///< Номер → имя
+    QHash<QString, quint32> m_nameIds;      ///< Имя → номер
+    RollupFile m_rollupFiles[kArchiveRollupLevels]; ///< Сводки по уровням
+
+    /**
+     * @brief Загружает справочник имен.
+     */
+    void loadNames();
+
+    /**
+     * @brief Отображает сегмент и его индекс; false, если сегмент пуст или поврежден.
+     */
+    bool mapSegment(const QString& dataPath, const QString& indexPath, Segment& segment) const;
+
+    /**
+     * @brief Отображает файлы сводок.
+     */
+    void mapRollups();
+
+    /**
+     * @brief Добавляет точки тренда уровня level; участки без сводок уровня
+     * достраиваются по более мелкому уровню (level == -1 - по отсчетам).
+     * @param rawWidthMs Длина интервала при сведении отсчетов.
+     */
+    void appendTrend(const QString& name, qint64 fromMs, qint64 toMs, int level,
+                     qint64 rawWidthMs, QVector<TrendBucket>& out) const;
+
+    /**
+     * @brief Запись индекса блока сегмента.
+     */
+    static ArchiveIndexEntry indexEntry(const Segment& segment, int block);
+
+    /**
+     * @brief Проверяет заголовок блока и возвращает его начало (nullptr, если блок поврежден).
+     */
+    static const uchar* checkedBlock(const Segment& segment, const ArchiveIndexEntry& entry);
+
+    /**
+     * @brief Находит столбец параметра в блоке.
+     * @return Указатель на начало блока или nullptr, если столбца нет или блок поврежден.
+     */
+    static const uchar* findColumn(const Segment& segment, const ArchiveIndexEntry& entry,
+                                   quint32 nameId, ArchiveColumnEntry& column);
+
+    /**
+     * @brief Распаковывает отсчеты столбца из интервала [fromMs, toMs].
+     */
+    static void decodeColumn(const uchar* block, const ArchiveColumnEntry& column,
+                             qint64 fromMs, qint64 toMs, QVector<HistorySample>& out);
+
+    /**
+     * @brief Раскладывает значения столбца по тактам блока.
+     */
+    static void decodeTicks(const uchar* block, const ArchiveColumnEntry& column, const QString& name,
+                            QVector<ArchiveTick>& ticks);
+
+    /**
+     * @brief Распаковывает числовые значения столбца из интервала [fromMs, toMs].
+     */
+    static void decodeNumbers(const uchar* block, const ArchiveColumnEntry& column, qint64 fromMs, qint64 toMs,
+                              QVector<qint64>& times, QVector<double>& values);
+};
+
+} // namespace ParamControl
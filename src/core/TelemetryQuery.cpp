@@ -0,0 +1,263 @@
+// src/core/TelemetryQuery.cpp
+#include "TelemetryQuery.h"
+
+#include <QRegExp>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ParamControl {
+
+namespace {
+
+/**
+ * @brief Интервал прореженного ряда (сумма вместо среднего до объединения)
+ */
+struct SeriesBucket {
+    qint64 startMs = 0;
+    qint64 count = 0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+    double sum = 0.0;
+};
+
+/**
+ * @brief Частичная сводка параметра по одному блоку (или нескольким подряд)
+ */
+struct Partial {
+    qint64 count = 0;
+    qint64 firstMs = 0;
+    qint64 lastMs = 0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+    double sum = 0.0;
+    bool lastAbove = false;         ///< Последний отсчет выше порога
+    qint64 aboveMs = 0;
+    QVector<SeriesBucket> series;
+    QVector<double> values;         ///< Все значения (только для процентилей)
+};
+
+/**
+ * @brief Задача распаковки одного блока
+ */
+struct BlockTask {
+    TelemetryArchiveReader::BlockRef block;
+    QVector<Partial> partials;      ///< По выбранным именам
+};
+
+/**
+ * @brief Добавляет интервал в ряд, упорядоченный по началу интервала
+ *
+ * Обычно интервал совпадает с последним или идет за ним; более ранний
+ * (перекрывающиеся сегменты, перевод часов назад) ищется по началу.
+ */
+void addToSeries(QVector<SeriesBucket>& series, const SeriesBucket& bucket) {
+    auto it = series.end();
+    if (!series.isEmpty() && series.last().startMs >= bucket.startMs) {
+        it = std::lower_bound(series.begin(), series.end(), bucket.startMs,
+                              [](const SeriesBucket& item, qint64 startMs) { return item.startMs < startMs; });
+    }
+    if (it != series.end() && it->startMs == bucket.startMs) {
+        it->minimum = qMin(it->minimum, bucket.minimum);
+        it->maximum = qMax(it->maximum, bucket.maximum);
+        it->sum += bucket.sum;
+        it->count += bucket.count;
+    } else {
+        series.insert(it, bucket);
+    }
+}
+
+void accumulate(Partial& partial, const QVector<qint64>& times, const QVector<double>& values,
+                const TelemetryQueryOptions& options) {
+    const bool keepValues = !options.percentiles.isEmpty();
+    for (int i = 0; i < values.size(); ++i) {
+        const double value = values[i];
+        const qint64 timestampMs = times[i];
+        if (!std::isfinite(value)) {
+            continue;
+        }
+
+        if (partial.count == 0) {
+            partial.firstMs = timestampMs;
+            partial.minimum = partial.maximum = value;
+        } else {
+            partial.minimum = qMin(partial.minimum, value);
+            partial.maximum = qMax(partial.maximum, value);
+            if (partial.lastAbove) {
+                partial.aboveMs += qMax<qint64>(0, timestampMs - partial.lastMs);
+            }
+        }
+        partial.lastMs = timestampMs;
+        partial.lastAbove = options.hasThreshold && value > options.threshold;
+        partial.sum += value;
+        ++partial.count;
+
+        if (options.stepMs > 0) {
+            addToSeries(partial.series, {archiveAlignDown(timestampMs, options.stepMs), 1, value, value, value});
+        }
+        if (keepValues) {
+            partial.values.append(value);
+        }
+    }
+}
+
+void merge(Partial& into, const Partial& next) {
+    if (next.count == 0) {
+        return;
+    }
+    if (into.count == 0) {
+        into = next;
+        return;
+    }
+
+    // Промежуток между частями учитывается, только если следующая часть идет после предыдущей
+    if (into.lastAbove) {
+        into.aboveMs += qMax<qint64>(0, next.firstMs - into.lastMs);
+    }
+    into.aboveMs += next.aboveMs;
+    into.count += next.count;
+    into.firstMs = qMin(into.firstMs, next.firstMs);
+    if (next.lastMs >= into.lastMs) {
+        into.lastMs = next.lastMs;
+        into.lastAbove = next.lastAbove;
+    }
+    into.minimum = qMin(into.minimum, next.minimum);
+    into.maximum = qMax(into.maximum, next.maximum);
+    into.sum += next.sum;
+    for (const SeriesBucket& bucket : next.series) {
+        addToSeries(into.series, bucket);
+    }
+    into.values += next.values;
+}
+
+/**
+ * @brief Процентиль отсортированных значений с линейной интерполяцией между рангами.
+ */
+double percentileOf(const QVector<double>& sorted, double percentile) {
+    const double rank = qBound(0.0, percentile, 100.0) / 100.0 * (sorted.size() - 1);
+    const int lower = int(std::floor(rank));
+    const int upper = qMin(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - lower);
+}
+
+} // namespace
+
+TelemetryQuery::TelemetryQuery(const TelemetryArchiveReader& reader)
+    : m_reader(reader)
+{
+}
+
+QStringList TelemetryQuery::matchNames(const QStringList& patterns) const {
+    QStringList result = m_reader.names();
+    if (!patterns.isEmpty()) {
+        QVector<QRegExp> masks;
+        masks.reserve(patterns.size());
+        for (const QString& pattern : patterns) {
+            masks.append(QRegExp(pattern, Qt::CaseSensitive, QRegExp::WildcardUnix));
+        }
+
+        QStringList matched;
+        for (const QString& name : result) {
+            for (const QRegExp& mask : masks) {
+                if (mask.exactMatch(name)) {
+                    matched.append(name);
+                    break;
+                }
+            }
+        }
+        result = matched;
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+QVector<TelemetryAggregate> TelemetryQuery::run(const TelemetryQueryOptions& options) const {
+    QVector<TelemetryAggregate> result;
+
+    const QStringList names = matchNames(options.names);
+    QVector<quint32> ids;
+    ids.reserve(names.size());
+    for (const QString& name : names) {
+        quint32 id = 0;
+        m_reader.nameId(name, id);
+        ids.append(id);
+    }
+    if (ids.isEmpty()) {
+        return result;
+    }
+
+    // Индекс времени отсекает блоки вне интервала; остальные распаковываются параллельно
+    QVector<BlockTask> tasks;
+    for (const TelemetryArchiveReader::BlockRef& block : m_reader.blocks(options.fromMs, options.toMs)) {
+        tasks.append({block, {}});
+    }
+
+    // Блоки идут по сегментам; сегменты после перевода часов или перезапуска
+    // могут перекрываться по времени, поэтому части объединяются по времени блоков
+    std::stable_sort(tasks.begin(), tasks.end(), [](const BlockTask& a, const BlockTask& b) {
+        return a.block.firstMs < b.block.firstMs;
+    });
+
+    QtConcurrent::blockingMap(tasks, [this, &ids, &options](BlockTask& task) {
+        task.partials.resize(ids.size());
+        QVector<qint64> times;
+        QVector<double> values;
+        for (int i = 0; i < ids.size(); ++i) {
+            times.clear();
+            values.clear();
+            m_reader.blockNumbers(task.block, ids[i], options.fromMs, options.toMs, times, values);
+            accumulate(task.partials[i], times, values, options);
+        }
+    });
+
+    // Объединение в порядке времени блоков, затем окончательные сводки по параметрам
+    QVector<Partial> totals(ids.size());
+    for (BlockTask& task : tasks) {
+        for (int i = 0; i < ids.size(); ++i) {
+            merge(totals[i], task.partials[i]);
+        }
+        task.partials.clear();
+    }
+
+    for (int i = 0; i < ids.size(); ++i) {
+        Partial& total = totals[i];
+        if (total.count == 0) {
+            continue;
+        }
+
+        TelemetryAggregate aggregate;
+        aggregate.name = names[i];
+        aggregate.count = total.count;
+        aggregate.firstMs = total.firstMs;
+        aggregate.lastMs = total.lastMs;
+        aggregate.minimum = total.minimum;
+        aggregate.maximum = total.maximum;
+        aggregate.mean = total.sum / total.count;
+        aggregate.aboveMs = total.aboveMs;
+
+        aggregate.series.reserve(total.series.size());
+        for (const SeriesBucket& bucket : total.series) {
+            TrendBucket point;
+            point.startMs = bucket.startMs;
+            point.durationMs = options.stepMs;
+            point.count = int(bucket.count);
+            point.minimum = bucket.minimum;
+            point.maximum = bucket.maximum;
+            point.mean = bucket.sum / bucket.count;
+            aggregate.series.append(point);
+        }
+
+        if (!options.percentiles.isEmpty()) {
+            std::sort(total.values.begin(), total.values.end());
+            for (double percentile : options.percentiles) {
+                aggregate.percentiles.append(percentileOf(total.values, percentile));
+            }
+            total.values = QVector<double>();
+        }
+        result.append(aggregate);
+    }
+    return result;
+}
+
+} // namespace ParamControl
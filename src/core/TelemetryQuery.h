@@ -0,0 +1,81 @@
+// src/core/TelemetryQuery.h
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <limits>
+
+#include "TelemetryArchiveReader.h"
+
+namespace ParamControl {
+
+/**
+ * @brief Параметры запроса к архиву ТМИ
+ */
+struct TelemetryQueryOptions {
+    qint64 fromMs = std::numeric_limits<qint64>::min(); ///< Начало интервала (мс от эпохи UTC)
+    qint64 toMs = std::numeric_limits<qint64>::max();   ///< Конец интервала (включительно)
+    QStringList names;              ///< Имена или маски (*, ?); пусто - все параметры
+    qint64 stepMs = 0;              ///< Шаг прореживания ряда (0 - ряд не нужен)
+    QVector<double> percentiles;    ///< Процентили, 0..100 (требуют хранить все значения)
+    bool hasThreshold = false;      ///< Считать время выше порога
+    double threshold = 0.0;         ///< Порог
+};
+
+/**
+ * @brief Результат запроса по одному параметру
+ */
+struct TelemetryAggregate {
+    QString name;                   ///< Имя параметра
+    qint64 count = 0;               ///< Число числовых отсчетов в интервале
+    qint64 firstMs = 0;             ///< Время первого отсчета
+    qint64 lastMs = 0;              ///< Время последнего отсчета
+    double minimum = 0.0;           ///< Минимум
+    double maximum = 0.0;           ///< Максимум
+    double mean = 0.0;              ///< Среднее
+    QVector<double> percentiles;    ///< Значения процентилей в порядке TelemetryQueryOptions::percentiles
+    qint64 aboveMs = 0;             ///< Время, когда значение было выше порога
+    QVector<TrendBucket> series;    ///< Прореженный ряд с шагом stepMs
+};
+
+/**
+ * @brief Запросы к архиву ТМИ: выборка по времени и именам, прореживание и сводки.
+ *
+ * Блоки, пересекающиеся с интервалом, выбираются по индексу времени;
+ * остальные не читаются. Выбранные блоки распаковываются параллельно
+ * в пуле потоков (по блоку на задачу), каждая задача сразу сводит
+ * отсчеты блока, после чего частичные сводки объединяются по порядку.
+ * Поэтому память расходуется только на сводки, а не на отсчеты,
+ * кроме случая, когда запрошены процентили.
+ *
+ * Время выше порога считается по ступенчатой интерполяции: значение
+ * действует от своего отсчета до следующего отсчета того же параметра.
+ */
+class TelemetryQuery {
+public:
+    /**
+     * @brief Конструктор.
+     * @param reader Открытый архив (должен жить дольше запроса).
+     */
+    explicit TelemetryQuery(const TelemetryArchiveReader& reader);
+
+    /**
+     * @brief Возвращает имена архива, подходящие под имена или маски.
+     * @param patterns Имена или маски (*, ?); пусто - все имена.
+     */
+    QStringList matchNames(const QStringList& patterns) const;
+
+    /**
+     * @brief Выполняет запрос.
+     * @param options Параметры запроса.
+     * @return Результаты по параметрам (в порядке имен), в которых есть числовые отсчеты.
+     */
+    QVector<TelemetryAggregate> run(const TelemetryQueryOptions& options) const;
+
+private:
+    const TelemetryArchiveReader& m_reader; ///< Архив
+};
+
+} // namespace ParamControl
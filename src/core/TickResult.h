@@ -0,0 +1,46 @@
+// src/core/TickResult.h
+#pragma once
+
+#include <QMetaType>
+#include <QVector>
+#include <memory>
+
+#include "Parameter.h" // Для ParameterStatus
+#include "ParameterSnapshot.h"
+
+namespace ParamControl {
+
+/**
+ * @brief Изменение статуса одного параметра за такт.
+ */
+struct StatusTransition {
+    int row;                        ///< Номер строки в снимке результата
+    ParameterStatus previous;       ///< Статус до такта
+    ParameterStatus current;        ///< Статус после такта
+};
+
+/**
+ * @brief Итог одного такта проверки, публикуемый одним сигналом.
+ *
+ * Заменяет поток сигналов на каждый параметр: подписчик получает
+ * все изменения такта сразу и обрабатывает их за один проход.
+ * Номера строк относятся к snapshot - снимку, опубликованному по итогам
+ * этого такта, поэтому данные строк читаются из него без обращения к модели.
+ */
+struct TickResult {
+    quint64 tick = 0;                                   ///< Номер такта (с запуска приложения)
+    qint64 timestampMs = 0;                             ///< Время завершения проверки, мс от эпохи
+    qint64 evaluationNs = 0;                            ///< Длительность проверки условий, нс
+    int receivedValues = 0;                             ///< Сколько значений пришло в ответе
+    bool changeTrackingReset = false;                   ///< Итог сброса отслеживания, а не опроса
+    std::shared_ptr<const ParameterSnapshot> snapshot;  ///< Снимок после такта
+    QVector<int> changedValues;                         ///< Строки, у которых изменились значение, статус или статистика окна (по возрастанию)
+    QVector<StatusTransition> transitions;              ///< Изменения статусов (по возрастанию строк)
+};
+
+/// Результат такта передается по указателю: подписчики разделяют один объект.
+using TickResultPtr = std::shared_ptr<const TickResult>;
+
+} // namespace ParamControl
+
+Q_DECLARE_METATYPE(ParamControl::TickResultPtr)
@@ -0,0 +1,307 @@
+// src/core/WindowStore.cpp
+#include "WindowStore.h"
+
+#include <cmath>
+
+namespace ParamControl {
+
+namespace {
+
+/// Минимальный запас относительного времени перед пересчетом сумм, мс.
+constexpr double kRebaseSlackMs = 60000.0;
+
+double notANumber() {
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+} // namespace
+
+int WindowStore::capacityForSpan(qint64 spanMs, int sampleIntervalMs) {
+    // Отсчеты на обоих концах окна плюс один на неравномерность опроса
+    const qint64 samples = spanMs / qMax(1, sampleIntervalMs) + 2;
+    return int(qBound<qint64>(2, samples, kMaxSpanCapacity));
+}
+
+int WindowStore::addWindow(int capacity, qint64 spanMs) {
+    capacity = qMax(2, capacity);
+
+    const int window = m_offset.size();
+    m_offset.append(m_time.size());
+    m_capacity.append(capacity);
+    m_spanMs.append(qMax<qint64>(0, spanMs));
+    m_head.append(0);
+    m_count.append(0);
+    m_originMs.append(0);
+    m_valueOrigin.append(0.0);
+    m_sumT.append(0.0);
+    m_sumV.append(0.0);
+    m_sumTT.append(0.0);
+    m_sumTV.append(0.0);
+    m_mean.append(0.0);
+    m_m2.append(0.0);
+    m_minHead.append(0);
+    m_minCount.append(0);
+    m_maxHead.append(0);
+    m_maxCount.append(0);
+
+    m_time.resize(m_time.size() + capacity);
+    m_value.resize(m_value.size() + capacity);
+    m_minQueue.resize(m_minQueue.size() + capacity);
+    m_maxQueue.resize(m_maxQueue.size() + capacity);
+
+    return window;
+}
+
+int WindowStore::windowCount() const {
+    return m_offset.size();
+}
+
+int WindowStore::capacity(int window) const {
+    return m_capacity[window];
+}
+
+qint64 WindowStore::span(int window) const {
+    return m_spanMs[window];
+}
+
+void WindowStore::push(int window, qint64 timeMs, double value) {
+    if (!std::isfinite(value)) {
+        return;
+    }
+
+    // Вытесняем отсчеты, вышедшие за длительность окна, и самый старый при переполнении
+    const qint64 span = m_spanMs[window];
+    if (span > 0) {
+        while (m_count[window] > 0 &&
+               double(timeMs - m_originMs[window]) - m_time[m_offset[window] + m_head[window]] > double(span)) {
+            popOldest(window);
+        }
+    }
+    if (m_count[window] == m_capacity[window]) {
+        popOldest(window);
+    }
+
+    // Пустое окно начинает отсчет с нового отсчета
+    if (m_count[window] == 0) {
+        clear(window, timeMs, value);
+    }
+
+    // Относительное время выросло намного больше ширины окна - переносим начало отсчета.
+    // Пересчет стоит O(capacity), но происходит не чаще, чем раз в несколько заполнений окна.
+    double t = double(timeMs - m_originMs[window]);
+    const int offset = m_offset[window];
+    const int capacity = m_capacity[window];
+    if (m_count[window] > 0) {
+        const double oldest = m_time[offset + m_head[window]];
+        if (t > 2.0 * (t - oldest) + kRebaseSlackMs) {
+            rebase(window, m_originMs[window] + qint64(oldest), m_value[offset + m_head[window]] + m_valueOrigin[window]);
+            t = double(timeMs - m_originMs[window]);
+        }
+    }
+
+    const double v = value - m_valueOrigin[window];
+    const int cell = (m_head[window] + m_count[window]) % capacity;
+    m_time[offset + cell] = t;
+    m_value[offset + cell] = v;
+    const int n = ++m_count[window];
+
+    m_sumT[window] += t;
+    m_sumV[window] += v;
+    m_sumTT[window] += t * t;
+    m_sumTV[window] += t * v;
+
+    const double delta = v - m_mean[window];
+    m_mean[window] += delta / n;
+    m_m2[window] += delta * (v - m_mean[window]);
+
+    pushQueue(window, cell, true);
+    pushQueue(window, cell, false);
+}
+
+int WindowStore::sampleCount(int window) const {
+    return m_count[window];
+}
+
+double WindowStore::slopePerSecond(int window) const {
+    const int n = m_count[window];
+    if (n < 2) {
+        return notANumber();
+    }
+
+    const double denominator = n * m_sumTT[window] - m_sumT[window] * m_sumT[window];
+    if (!(denominator > 0.0)) {
+        return notANumber();
+    }
+
+    const double slopePerMs = (n * m_sumTV[window] - m_sumT[window] * m_sumV[window]) / denominator;
+    return slopePerMs * 1000.0;
+}
+
+double WindowStore::fittedChange(int window) const {
+    const int n = m_count[window];
+    const double slope = slopePerSecond(window);
+    if (std::isnan(slope)) {
+        return slope;
+    }
+
+    const int offset = m_offset[window];
+    const double first = m_time[offset + m_head[window]];
+    const double last = m_time[offset + (m_head[window] + n - 1) % m_capacity[window]];
+    return slope * (last - first) / 1000.0;
+}
+
+double WindowStore::mean(int window) const {
+    if (m_count[window] == 0) {
+        return notANumber();
+    }
+    return m_mean[window] + m_valueOrigin[window];
+}
+
+double WindowStore::standardDeviation(int window) const {
+    const int n = m_count[window];
+    if (n < 2) {
+        return notANumber();
+    }
+    return std::sqrt(qMax(0.0, m_m2[window]) / (n - 1));
+}
+
+double WindowStore::minimum(int window) const {
+    if (m_minCount[window] == 0) {
+        return notANumber();
+    }
+    const int offset = m_offset[window];
+    return m_value[offset + m_minQueue[offset + m_minHead[window]]] + m_valueOrigin[window];
+}
+
+double WindowStore::maximum(int window) const {
+    if (m_maxCount[window] == 0) {
+        return notANumber();
+    }
+    const int offset = m_offset[window];
+    return m_value[offset + m_maxQueue[offset + m_maxHead[window]]] + m_valueOrigin[window];
+}
+
+WindowStats WindowStore::stats(int window) const {
+    WindowStats result;
+    result.samples = m_count[window];
+    result.mean = mean(window);
+    result.stddev = standardDeviation(window);
+    result.minimum = minimum(window);
+    result.maximum = maximum(window);
+    return result;
+}
+
+void WindowStore::copyWindow(int window, const WindowStore& other, int otherWindow) {
+    clear(window, 0, 0.0);
+
+    const int otherCount = other.m_count[otherWindow];
+    const int skip = qMax(0, otherCount - m_capacity[window]);
+    const int otherOffset = other.m_offset[otherWindow];
+    for (int i = skip; i < otherCount; ++i) {
+        const int position = otherOffset + (other.m_head[otherWindow] + i) % other.m_capacity[otherWindow];
+        push(window, other.m_originMs[otherWindow] + qint64(other.m_time[position]),
+             other.m_value[position] + other.m_valueOrigin[otherWindow]);
+    }
+}
+
+void WindowStore::clear(int window, qint64 originMs, double valueOrigin) {
+    m_head[window] = 0;
+    m_count[window] = 0;
+    m_originMs[window] = originMs;
+    m_valueOrigin[window] = valueOrigin;
+    m_sumT[window] = m_sumV[window] = m_sumTT[window] = m_sumTV[window] = 0.0;
+    m_mean[window] = m_m2[window] = 0.0;
+    m_minHead[window] = m_minCount[window] = 0;
+    m_maxHead[window] = m_maxCount[window] = 0;
+}
+
+void WindowStore::pushQueue(int window, int cell, bool ascending) {
+    const int offset = m_offset[window];
+    const int capacity = m_capacity[window];
+    QVector<int>& queue = ascending ? m_minQueue : m_maxQueue;
+    const int head = ascending ? m_minHead[window] : m_maxHead[window];
+    int& count = ascending ? m_minCount[window] : m_maxCount[window];
+    const double value = m_value[offset + cell];
+
+    // Кандидаты, которые хуже нового отсчета и вытесняются раньше него, больше не понадобятся
+    while (count > 0) {
+        const double back = m_value[offset + queue[offset + (head + count - 1) % capacity]];
+        if (ascending ? back < value : back > value) {
+            break;
+        }
+        --count;
+    }
+
+    queue[offset + (head + count) % capacity] = cell;
+    ++count;
+}
+
+void WindowStore::popOldest(int window) {
+    const int offset = m_offset[window];
+    const int capacity = m_capacity[window];
+    const int cell = m_head[window];
+    const double t = m_time[offset + cell];
+    const double v = m_value[offset + cell];
+
+    m_sumT[window] -= t;
+    m_sumV[window] -= v;
+    m_sumTT[window] -= t * t;
+    m_sumTV[window] -= t * v;
+
+    // Обратный шаг Уэлфорда
+    const int n = --m_count[window];
+    if (n == 0) {
+        m_mean[window] = m_m2[window] = 0.0;
+    } else {
+        const double delta = v - m_mean[window];
+        m_mean[window] -= delta / n;
+        m_m2[window] -= delta * (v - m_mean[window]);
+    }
+
+    // Самый старый отсчет может стоять только в начале очередей
+    if (m_minCount[window] > 0 && m_minQueue[offset + m_minHead[window]] == cell) {
+        m_minHead[window] = (m_minHead[window] + 1) % capacity;
+        --m_minCount[window];
+    }
+    if (m_maxCount[window] > 0 && m_maxQueue[offset + m_maxHead[window]] == cell) {
+        m_maxHead[window] = (m_maxHead[window] + 1) % capacity;
+        --m_maxCount[window];
+    }
+
+    m_head[window] = (cell + 1) % capacity;
+}
+
+void WindowStore::rebase(int window, qint64 originMs, double valueOrigin) {
+    const int offset = m_offset[window];
+    const int capacity = m_capacity[window];
+    const double shiftT = double(m_originMs[window] - originMs);
+    const double shiftV = m_valueOrigin[window] - valueOrigin;
+
+    m_originMs[window] = originMs;
+    m_valueOrigin[window] = valueOrigin;
+    m_sumT[window] = m_sumV[window] = m_sumTT[window] = m_sumTV[window] = 0.0;
+
+    // Сдвигаем отсчеты и заново накапливаем суммы - это заодно сбрасывает ошибку округления
+    for (int i = 0; i < m_count[window]; ++i) {
+        const int position = offset + (m_head[window] + i) % capacity;
+        const double t = m_time[position] + shiftT;
+        const double v = m_value[position] + shiftV;
+        m_time[position] = t;
+        m_value[position] = v;
+        m_sumT[window] += t;
+        m_sumV[window] += v;
+        m_sumTT[window] += t * t;
+        m_sumTV[window] += t * v;
+    }
+
+    // Среднее и дисперсию пересчитываем точно (двухпроходно)
+    const int n = m_count[window];
+    m_mean[window] = (n > 0) ? m_sumV[window] / n : 0.0;
+    m_m2[window] = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double d = m_value[offset + (m_head[window] + i) % capacity] - m_mean[window];
+        m_m2[window] += d * d;
+    }
+}
+
+} // namespace ParamControl
@@ -0,0 +1,190 @@
+// src/core/WindowStore.h
+#pragma once
+
+#include <QVector>
+
+#include <limits>
+
+namespace ParamControl {
+
+/**
+ * @brief Статистика окна отсчетов на момент запроса.
+ */
+struct WindowStats {
+    int samples = 0;                                            ///< Число отсчетов в окне
+    double mean = std::numeric_limits<double>::quiet_NaN();     ///< Среднее
+    double stddev = std::numeric_limits<double>::quiet_NaN();   ///< Выборочное СКО (NaN при < 2 отсчетах)
+    double minimum = std::numeric_limits<double>::quiet_NaN();  ///< Минимум
+    double maximum = std::numeric_limits<double>::quiet_NaN();  ///< Максимум
+};
+
+/**
+ * @brief Хранилище скользящих окон отсчетов (время, значение) для правил.
+ *
+ * Все окна лежат в общих массивах фиксированного размера: у каждого окна
+ * свой кольцевой участок емкостью capacity, выделяемый один раз при
+ * компиляции программы. Добавление отсчета не выделяет память.
+ *
+ * Для каждого окна поддерживаются суммы метода наименьших квадратов,
+ * поэтому наклон прямой по окну и изменение вдоль нее вычисляются за O(1).
+ * Среднее и дисперсия ведутся по Уэлфорду (с удалением вытесняемых
+ * отсчетов), минимум и максимум - монотонными очередями номеров ячеек;
+ * обновление при каждом отсчете стоит амортизированно O(1).
+ * Время хранится относительно начала отсчета окна, значения - относительно
+ * опорного значения; при заметном удалении от них окно пересчитывает
+ * суммы заново (амортизированно O(1)), что ограничивает накопление ошибок.
+ */
+class WindowStore {
+public:
+    /// Интервал между отсчетами по умолчанию (период опроса СОТМ), мс.
+    static constexpr int kDefaultSampleIntervalMs = 1000;
+
+    /// Наибольшая емкость окна, заданного длительностью (ограничивает память правила).
+    static constexpr int kMaxSpanCapacity = 1 << 18;
+
+    /**
+     * @brief Емкость окна, вмещающая все отсчеты за spanMs при интервале отсчетов sampleIntervalMs.
+     *
+     * Если окно не помещается в kMaxSpanCapacity, емкость ограничивается
+     * и окно охватывает только последние отсчеты.
+     * @param spanMs Длительность окна, мс.
+     * @param sampleIntervalMs Интервал между отсчетами, мс (интервал опроса,
+     *        с которым скомпилирована программа, см. ConditionProgram::compile()).
+     */
+    static int capacityForSpan(qint64 spanMs, int sampleIntervalMs = kDefaultSampleIntervalMs);
+
+    /**
+     * @brief Добавляет окно.
+     * @param capacity Максимальное число отсчетов в окне (не меньше 2).
+     * @param spanMs Длительность окна в мс; более старые отсчеты вытесняются
+     *        (0 - окно ограничено только емкостью).
+     * @return Номер окна.
+     */
+    int addWindow(int capacity, qint64 spanMs = 0);
+
+    /**
+     * @brief Количество окон.
+     */
+    int windowCount() const;
+
+    /**
+     * @brief Емкость окна.
+     */
+    int capacity(int window) const;
+
+    /**
+     * @brief Длительность окна, мс (0 - окно ограничено только емкостью).
+     */
+    qint64 span(int window) const;
+
+    /**
+     * @brief Добавляет отсчет в окно, вытесняя самые старые при переполнении
+     * и вышедшие за длительность окна.
+     * @param window Номер окна.
+     * @param timeMs Время отсчета по монотонным часам, мс (не убывает).
+     * @param value Значение.
+     */
+    void push(int window, qint64 timeMs, double value);
+
+    /**
+     * @brief Число отсчетов в окне.
+     */
+    int sampleCount(int window) const;
+
+    /**
+     * @brief Наклон прямой МНК по отсчетам окна, единиц в секунду.
+     * @return Наклон или NaN, если отсчетов меньше двух или все в один момент времени.
+     */
+    double slopePerSecond(int window) const;
+
+    /**
+     * @brief Изменение значения вдоль прямой МНК от первого до последнего отсчета окна.
+     * @return Изменение или NaN (см. slopePerSecond()).
+     */
+    double fittedChange(int window) const;
+
+    /**
+     * @brief Среднее значение отсчетов окна (NaN для пустого окна).
+     */
+    double mean(int window) const;
+
+    /**
+     * @brief Выборочное СКО отсчетов окна (NaN, если отсчетов меньше двух).
+     */
+    double standardDeviation(int window) const;
+
+    /**
+     * @brief Минимум отсчетов окна (NaN для пустого окна).
+     */
+    double minimum(int window) const;
+
+    /**
+     * @brief Максимум отсчетов окна (NaN для пустого окна).
+     */
+    double maximum(int window) const;
+
+    /**
+     * @brief Возвращает всю статистику окна одним вызовом.
+     */
+    WindowStats stats(int window) const;
+
+    /**
+     * @brief Копирует содержимое окна из другого хранилища (перенос состояния
+     * при перекомпиляции). Если емкости различаются, переносятся последние отсчеты.
+     * @param window Номер окна в этом хранилище.
+     * @param other Исходное хранилище.
+     * @param otherWindow Номер окна в исходном хранилище.
+     */
+    void copyWindow(int window, const WindowStore& other, int otherWindow);
+
+private:
+    // --- Кольцевые буферы всех окон (общие массивы) ---
+    QVector<double> m_time;         ///< Время отсчета относительно m_originMs, мс
+    QVector<double> m_value;        ///< Значение относительно m_valueOrigin
+
+    // --- Описание и состояние окон (структура массивов) ---
+    QVector<int> m_offset;          ///< Начало участка окна в m_time/m_value
+    QVector<int> m_capacity;        ///< Емкость окна
+    QVector<qint64> m_spanMs;       ///< Длительность окна, мс (0 - без ограничения)
+    QVector<int> m_head;            ///< Позиция самого старого отсчета в участке
+    QVector<int> m_count;           ///< Число отсчетов
+    QVector<qint64> m_originMs;     ///< Начало отсчета времени окна
+    QVector<double> m_valueOrigin;  ///< Опорное значение окна
+    QVector<double> m_sumT;         ///< Сумма t
+    QVector<double> m_sumV;         ///< Сумма v
+    QVector<double> m_sumTT;        ///< Сумма t * t
+    QVector<double> m_sumTV;        ///< Сумма t * v
+    QVector<double> m_mean;         ///< Среднее v (Уэлфорд)
+    QVector<double> m_m2;           ///< Сумма квадратов отклонений от среднего (Уэлфорд)
+
+    // --- Монотонные очереди номеров ячеек (участки той же емкости, что и окно) ---
+    QVector<int> m_minQueue;        ///< Ячейки кандидатов в минимум, значения по возрастанию
+    QVector<int> m_maxQueue;        ///< Ячейки кандидатов в максимум, значения по убыванию
+    QVector<int> m_minHead;         ///< Начало очереди минимума
+    QVector<int> m_minCount;        ///< Длина очереди минимума
+    QVector<int> m_maxHead;         ///< Начало очереди максимума
+    QVector<int> m_maxCount;        ///< Длина очереди максимума
+
+    /**
+     * @brief Очищает окно и задает начало отсчета.
+     */
+    void clear(int window, qint64 originMs, double valueOrigin);
+
+    /**
+     * @brief Добавляет ячейку в конец монотонной очереди, удаляя вытесненных кандидатов.
+     * @param ascending true - очередь минимума, false - очередь максимума.
+     */
+    void pushQueue(int window, int cell, bool ascending);
+
+    /**
+     * @brief Удаляет самый старый отсчет окна.
+     */
+    void popOldest(int window);
+
+    /**
+     * @brief Переносит начало отсчета к самому старому отсчету и пересчитывает суммы и среднее.
+     */
+    void rebase(int window, qint64 originMs, double valueOrigin);
+};
+
+} // namespace ParamControl
@@ -9,6 +9,7 @@
 
 #include "ui/MainWindow.h"
 #include "core/ParameterModel.h"
+#include "core/TelemetryArchive.h"
 #include "core/SotmClient.h"
 #include "core/XmlParser.h"
 #include "core/MonitoringService.h"
@@ -107,7 +108,14 @@ int main(int argc, char *argv[])
     // Загружаем настройки и инициализируем компоненты
     QSettings settings(QSettings::IniFormat, QSettings::UserScope, "ParamControl", "ParamControl");
     
-    // Инициализация логирования
+    // Инициализация логирования: записи пишутся пачками в фоновом потоке
+    logManager->setFlushInterval(settings.value("log/flushIntervalMs", 1000).toInt());
+    logManager->setFlushCount(settings.value("log/flushCount", 256).toInt());
+    logManager->setFlushOnError(settings.value("log/flushOnError", true).toBool());
+    logManager->setSegmentBytes(settings.value("log/segmentMb", 16).toLongLong() * 1024 * 1024);
+    logManager->setRotateDaily(settings.value("log/rotateDaily", true).toBool());
+    logManager->setRetention(settings.value("log/retentionDays", 90).toInt(),
+                             settings.value("log/maxSegments", 0).toInt());
     logManager->initialize("./data/LOG_main.txt");
     
     // Получаем номер КА и ЗС из настроек или запрашиваем у пользователя
@@ -119,6 +127,25 @@ int main(int argc, char *argv[])
     sotmSettings.responseTimeoutMs = settings.value("sotm/responseTimeoutMs", 5000).toInt();
     sotmClient->setSettings(sotmSettings);
     
+    // Бюджет памяти истории значений параметров
+    parameterModel->history()->setMemoryBudget(
+        settings.value("history/memoryBudgetMb", 64).toLongLong() * 1024 * 1024);
+    
+    // Архив ТМИ на диске: отдельный каталог на каждый КА
+    if (settings.value("archive/enabled", true).toBool()) {
+        auto archive = std::make_shared<TelemetryArchive>();
+        archive->setSegmentBytes(settings.value("archive/segmentMb", 256).toLongLong() * 1024 * 1024);
+        archive->setFlushInterval(settings.value("archive/flushIntervalSec", 60).toInt() * 1000);
+        const QString archivePath = QString("%1/ka%2")
+            .arg(settings.value("archive/path", "./data/archive").toString())
+            .arg(sotmSettings.kaNumber);
+        if (archive->open(archivePath, sotmSettings.kaNumber)) {
+            parameterModel->setArchive(archive);
+        } else {
+            qWarning() << "Не удалось открыть архив ТМИ" << archivePath;
+        }
+    }
+    
     // Загружаем настройки обновлений
     QString updatePath = settings.value("updates/updatePath", "./updates").toString();
     bool checkAtStartup = settings.value("updates/checkAtStartup", true).toBool();
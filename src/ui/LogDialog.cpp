@@ -3,7 +3,6 @@
 
 #include <QMessageBox>
 #include <QFileDialog>
-#include <QSet>
 #include <QStandardItemModel>
 #include <QHeaderView>
 #include <QDateTime>
@@ -27,6 +26,8 @@ LogDialog::LogDialog(const std::shared_ptr<LogManager>& logManager, QWidget* par
     ui->logTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     ui->logTableView->horizontalHeader()->setSectionResizeMode(LogTableModel::TimestampColumn, QHeaderView::ResizeToContents);
     ui->logTableView->horizontalHeader()->setSectionResizeMode(LogTableModel::CategoryColumn, QHeaderView::ResizeToContents);
+    // Ширина колонок - по видимым строкам: история читается с диска только для них
+    ui->logTableView->horizontalHeader()->setResizeContentsPrecision(0);
     ui->logTableView->setAlternatingRowColors(true);
     ui->logTableView->setSortingEnabled(true);
     ui->logTableView->verticalHeader()->setVisible(false);
@@ -66,6 +67,14 @@ LogDialog::LogDialog(const std::shared_ptr<LogManager>& logManager, QWidget* par
     connect(ui->levelComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &LogDialog::onLevelFilterChanged);
     connect(ui->searchLineEdit, &QLineEdit::textChanged, this, &LogDialog::onSearchTextChanged);
     
+    // Поиск запускается после паузы в наборе текста, а не на каждый символ
+    m_searchTimer.setSingleShot(true);
+    m_searchTimer.setInterval(300);
+    connect(&m_searchTimer, &QTimer::timeout, this, &LogDialog::startSearch);
+    connect(&m_search, &LogSearch::resultsFound, this, &LogDialog::onSearchResults);
+    connect(&m_search, &LogSearch::progressChanged, this, &LogDialog::onSearchProgress);
+    connect(&m_search, &LogSearch::finished, this, &LogDialog::onSearchFinished);
+    
     // Подключаем сигнал добавления новой записи в журнал
     connect(m_logManager.get(), &LogManager::logEntryAdded, this, &LogDialog::onLogEntryAdded);
     
@@ -76,6 +85,7 @@ LogDialog::LogDialog(const std::shared_ptr<LogManager>& logManager, QWidget* par
 
 LogDialog::~LogDialog()
 {
+    m_search.cancel();
     delete ui;
 }
 
@@ -87,13 +97,19 @@ void LogDialog::onCloseClicked()
 void LogDialog::onClearClicked()
 {
     if (QMessageBox::question(this, "Подтверждение", 
-                            "Вы уверены, что хотите очистить журнал?",
+                            "Вы уверены, что хотите очистить журнал?\n"
+                            "Будут удалены все записи, включая архивные сегменты на диске.",
                             QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
         // Очищаем журнал
         m_logManager->clearLog();
         
         // Обновляем модель
         m_model->onLogCleared();
+        
+        // Найденные записи удалены вместе с журналом
+        if (m_searchId != 0) {
+            startSearch();
+        }
     }
 }
 
@@ -103,7 +119,11 @@ void LogDialog::onRefreshClicked()
     fillCategoryList();
     
     // Обновляем модель
-    m_model->refresh();
+    if (m_searchId != 0) {
+        startSearch();
+    } else {
+        m_model->refresh();
+    }
 }
 
 void LogDialog::onExportClicked()
@@ -131,6 +151,11 @@ void LogDialog::onCategoryFilterChanged(int index)
     // Применяем фильтр
     QString category = ui->categoryComboBox->itemData(index).toString();
     m_model->setCategoryFilter(category);
+    
+    // Найденные записи фильтруются при поступлении: ищем заново
+    if (m_searchId != 0) {
+        startSearch();
+    }
 }
 
 void LogDialog::onLevelFilterChanged(int index)
@@ -138,19 +163,83 @@ void LogDialog::onLevelFilterChanged(int index)
     // Применяем фильтр
     int level = ui->levelComboBox->itemData(index).toInt();
     m_model->setLevelFilter(level);
+    
+    if (m_searchId != 0) {
+        startSearch();
+    }
 }
 
 void LogDialog::onSearchTextChanged(const QString& text)
 {
-    // TODO: Реализовать поиск по тексту
-    // Это не сложно сделать с помощью QSortFilterProxyModel,
-    // но для простоты опустим в данной реализации
+    Q_UNUSED(text);
+    m_searchTimer.start();
+}
+
+void LogDialog::startSearch()
+{
+    m_searchTimer.stop();
+    m_search.cancel();
+    
+    const QString text = ui->searchLineEdit->text();
+    if (text.isEmpty()) {
+        m_searchId = 0;
+        m_model->endSearch();
+        setWindowTitle("Журнал событий");
+        return;
+    }
+    
+    // Поиск читает файлы журнала: дописываем записи, ожидающие в очереди
+    m_logManager->flush();
+    
+    LogSearchOptions options;
+    options.text = text;
+    m_model->beginSearch();
+    m_searchId = m_search.start(m_logManager->getLogFilePath(), options);
+    updateSearchTitle("поиск...");
+}
+
+void LogDialog::onSearchResults(int searchId, const QVector<LogEntry>& entries)
+{
+    // Пачки прерванного поиска могут еще стоять в очереди
+    if (searchId != m_searchId) {
+        return;
+    }
+    m_model->appendSearchResults(entries);
+}
+
+void LogDialog::onSearchProgress(int searchId, int done, int total)
+{
+    if (searchId != m_searchId) {
+        return;
+    }
+    updateSearchTitle(QString("поиск... сегмент %1 из %2").arg(done).arg(total));
+}
+
+void LogDialog::onSearchFinished(int searchId, qint64 matches, bool cancelled)
+{
+    Q_UNUSED(matches);
+    if (searchId != m_searchId || cancelled) {
+        return;
+    }
+    updateSearchTitle("поиск завершен");
+}
+
+void LogDialog::updateSearchTitle(const QString& state)
+{
+    const qint64 dropped = m_model->droppedSearchResults();
+    if (dropped > 0) {
+        // Модель хранит только самые новые найденные записи
+        setWindowTitle(QString("Журнал событий - найдено: %1, показаны последние %2 (%3)")
+                           .arg(m_model->rowCount() + dropped).arg(m_model->rowCount()).arg(state));
+        return;
+    }
+    setWindowTitle(QString("Журнал событий - найдено: %1 (%2)").arg(m_model->rowCount()).arg(state));
 }
 
 void LogDialog::onLogEntryAdded(const LogEntry& entry)
 {
     // Обновляем список категорий при необходимости
-    QString category = entry.category;
+    QString category = entry.category();
     if (ui->categoryComboBox->findData(category) == -1) {
         ui->categoryComboBox->addItem(category, category);
     }
@@ -158,14 +247,8 @@ void LogDialog::onLogEntryAdded(const LogEntry& entry)
 
 void LogDialog::fillCategoryList()
 {
-    // Получаем все записи журнала
-    QVector<LogEntry> entries = m_logManager->getAllEntries();
-    
-    // Собираем уникальные категории
-    QSet<QString> categories;
-    for (const auto& entry : entries) {
-        categories.insert(entry.category);
-    }
+    // Категории берутся из индекса журнала (записи не просматриваются)
+    const QStringList categories = m_logManager->categories();
     
     // Заполняем выпадающий список категорий
     ui->categoryComboBox->clear();
@@ -5,9 +5,11 @@
 #include <QPushButton>
 #include <QTableView>
 #include <QLineEdit>
+#include <QTimer>
 #include <memory>
 
 #include "../core/LogManager.h"
+#include "../core/LogSearch.h"
 #include "LogTableModel.h"
 
 namespace Ui {
@@ -22,6 +24,11 @@ namespace ParamControl {
  * Этот диалог позволяет просматривать записи журнала,
  * фильтровать их по категории и уровню, а также
  * выполнять поиск по тексту.
+ *
+ * Поиск по тексту идет по всему журналу на диске, включая закрытые
+ * сегменты, в фоновом потоке (LogSearch). Найденные записи появляются
+ * в таблице по мере нахождения; новый текст прерывает предыдущий поиск,
+ * пустой текст возвращает таблицу к записям журнала в памяти.
  */
 class LogDialog : public QDialog {
     Q_OBJECT
@@ -84,10 +91,36 @@ private slots:
      */
     void onLogEntryAdded(const LogEntry& entry);
 
+    /**
+     * @brief Обработчик пачки записей, найденных поиском
+     * @param searchId Номер поиска
+     * @param entries Найденные записи
+     */
+    void onSearchResults(int searchId, const QVector<ParamControl::LogEntry>& entries);
+
+    /**
+     * @brief Обработчик хода поиска
+     * @param searchId Номер поиска
+     * @param done Просмотрено сегментов
+     * @param total Всего сегментов
+     */
+    void onSearchProgress(int searchId, int done, int total);
+
+    /**
+     * @brief Обработчик окончания поиска
+     * @param searchId Номер поиска
+     * @param matches Число найденных записей
+     * @param cancelled Поиск прерван
+     */
+    void onSearchFinished(int searchId, qint64 matches, bool cancelled);
+
 private:
     Ui::LogDialog* ui;                         ///< UI диалога
     std::shared_ptr<LogManager> m_logManager;  ///< Менеджер журнала
     std::unique_ptr<LogTableModel> m_model;    ///< Модель данных для таблицы
+    LogSearch m_search;                        ///< Поиск по журналу на диске
+    QTimer m_searchTimer;                      ///< Задержка запуска поиска при наборе текста
+    int m_searchId = 0;                        ///< Номер текущего поиска (0 - поиска нет)
     
     /**
      * @brief Заполнение списка категорий
@@ -98,6 +131,16 @@ private:
      * @brief Применение фильтров
      */
     void applyFilters();
+
+    /**
+     * @brief Запуск поиска по тексту из строки поиска (пустой текст - выход из поиска)
+     */
+    void startSearch();
+
+    /**
+     * @brief Заголовок окна с состоянием поиска
+     */
+    void updateSearchTitle(const QString& state);
 };
 
 } // namespace ParamControl
@@ -2,14 +2,23 @@
 
 namespace ParamControl {
 
+namespace {
+
+/// Число записей истории, подгружаемых за один fetchMore().
+constexpr int kHistoryPage = 500;
+
+/// Число записей истории, строящихся по обе стороны от запрошенной строки.
+constexpr int kHistoryWindowMargin = 100;
+
+} // namespace
+
 LogTableModel::LogTableModel(const std::shared_ptr<LogManager>& logManager, 
                             QObject* parent)
     : QAbstractTableModel(parent)
     , m_logManager(logManager)
-    , m_levelFilter(-1)  // Без фильтра по умолчанию
 {
-    // Получаем все записи журнала
-    m_filteredEntries = m_logManager->getAllEntries();
+    // Получаем снимок записей журнала
+    rebuildRows();
 }
 
 LogTableModel::~LogTableModel() {
@@ -20,7 +29,10 @@ int LogTableModel::rowCount(const QModelIndex& parent) const {
         return 0;
     }
     
-    return m_filteredEntries.size();
+    if (m_searching) {
+        return m_searchResults.size();
+    }
+    return liveRowCount() + m_retained.size() + m_historyRows.size();
 }
 
 int LogTableModel::columnCount(const QModelIndex& parent) const {
@@ -34,13 +46,13 @@ int LogTableModel::columnCount(const QModelIndex& parent) const {
 QVariant LogTableModel::data(const QModelIndex& index, int role) const {
     if (!index.isValid() || 
         index.row() < 0 || 
-        index.row() >= m_filteredEntries.size() || 
+        index.row() >= rowCount() || 
         index.column() < 0 || 
         index.column() >= ColumnCount) {
         return QVariant();
     }
     
-    const LogEntry& entry = m_filteredEntries[index.row()];
+    const LogEntry& entry = entryAt(index.row());
     
     switch (role) {
         case Qt::DisplayRole: {
@@ -49,10 +61,14 @@ QVariant LogTableModel::data(const QModelIndex& index, int role) const {
                     return entry.timestamp.toString("dd/MM/yyyy hh:mm:ss");
                     
                 case CategoryColumn:
-                    return entry.category;
+                    return entry.category();
                     
                 case MessageColumn:
-                    return entry.message;
+                    // Текст сообщения строится из шаблона только для видимых строк
+                    if (entry.repeatCount > 1) {
+                        return QString("%1 (повторов: %2)").arg(entry.message()).arg(entry.repeatCount);
+                    }
+                    return entry.message();
                     
                 case ValueColumn:
                     return entry.value;
@@ -103,13 +119,19 @@ QVariant LogTableModel::data(const QModelIndex& index, int role) const {
             // Подсказка с полным текстом записи
             QString tooltip = QString("%1\n%2\n%3")
                               .arg(entry.timestamp.toString("dd/MM/yyyy hh:mm:ss"))
-                              .arg(entry.category)
-                              .arg(entry.message);
+                              .arg(entry.category())
+                              .arg(entry.message());
             
             if (!entry.value.isEmpty()) {
                 tooltip += QString("\nЗначение: %1").arg(entry.value);
             }
             
+            if (entry.repeatCount > 1) {
+                tooltip += QString("\nПовторов: %1, последний: %2")
+                           .arg(entry.repeatCount)
+                           .arg(entry.lastTimestamp.toString("dd/MM/yyyy hh:mm:ss"));
+            }
+            
             return tooltip;
         }
         
@@ -178,59 +200,205 @@ Qt::ItemFlags LogTableModel::flags(const QModelIndex& index) const {
     return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
 }
 
+bool LogTableModel::canFetchMore(const QModelIndex& parent) const {
+    if (parent.isValid() || m_searching) {
+        return false;
+    }
+    
+    // До первой подгрузки неизвестно, есть ли история: курсор создается лениво
+    return !m_history || !m_history->atStart();
+}
+
+void LogTableModel::fetchMore(const QModelIndex& parent) {
+    if (!canFetchMore(parent)) {
+        return;
+    }
+    
+    // История начинается перед самой старой записью снимка, показанного моделью
+    if (!m_history) {
+        m_history = m_logManager->journalBefore(m_snapshot.firstSequence());
+    }
+    
+    const QVector<LogJournalPosition> rows = m_history->previous(m_query, kHistoryPage);
+    if (rows.isEmpty()) {
+        return;
+    }
+    
+    const int first = rowCount();
+    beginInsertRows(QModelIndex(), first, first + rows.size() - 1);
+    m_historyRows += rows;
+    endInsertRows();
+}
+
 void LogTableModel::onLogEntryAdded(const LogEntry& entry) {
-    // Проверяем, соответствует ли новая запись фильтрам
-    bool matchesFilters = true;
+    Q_UNUSED(entry);
+    if (m_searching) {
+        return;
+    }
+    const LogSnapshot snapshot = m_logManager->snapshot();
     
-    if (!m_categoryFilter.isEmpty() && entry.category != m_categoryFilter) {
-        matchesFilters = false;
+    // Строки, вытесненные из буфера журнала (пока они еще есть в старом снимке)
+    int evicted = 0;
+    while (m_firstRow + evicted < m_rows.size() && m_rows[m_firstRow + evicted] < snapshot.firstSequence()) {
+        ++evicted;
+    }
+    if (evicted > 0) {
+        const int live = liveRowCount();
+        // За ними уже идет история с диска: записи копируются, но не больше
+        // емкости буфера, иначе история сбрасывается и подгружается заново
+        const bool retain = m_history
+            && m_retained.size() + evicted <= m_logManager->getMaxEntries();
+        if (retain) {
+            for (int i = 0; i < evicted; ++i) {
+                m_retained.append(m_snapshot.at(m_snapshot.indexOf(m_rows[m_firstRow + i])));
+            }
+        } else {
+            beginRemoveRows(QModelIndex(), live - evicted, rowCount() - 1);
+        }
+        m_firstRow += evicted;
+        // Сдвигаем массив номеров редко, а не при каждой вытесненной строке
+        if (m_firstRow > m_rows.size() / 2) {
+            m_rows.remove(0, m_firstRow);
+            m_firstRow = 0;
+        }
+        if (!retain) {
+            clearHistory();
+            endRemoveRows();
+        }
     }
     
-    if (m_levelFilter >= 0 && static_cast<int>(entry.level) != m_levelFilter) {
-        matchesFilters = false;
+    m_snapshot = snapshot;
+    
+    // Добавляем новые записи, соответствующие фильтрам (новые строки - сверху)
+    QVector<quint64> added;
+    for (quint64 sequence = qMax(m_nextSequence, snapshot.firstSequence());
+         sequence < snapshot.endSequence(); ++sequence) {
+        if (matchesFilters(snapshot.at(snapshot.indexOf(sequence)))) {
+            added.append(sequence);
+        }
     }
+    m_nextSequence = snapshot.endSequence();
     
-    // Если соответствует, добавляем в модель
-    if (matchesFilters) {
-        beginInsertRows(QModelIndex(), m_filteredEntries.size(), m_filteredEntries.size());
-        m_filteredEntries.append(entry);
+    if (!added.isEmpty()) {
+        beginInsertRows(QModelIndex(), 0, added.size() - 1);
+        m_rows += added;
         endInsertRows();
     }
 }
 
+void LogTableModel::onLogEntryUpdated(const LogEntry& entry) {
+    // Новый снимок видит обновленную запись; заодно добавляются записи, пришедшие после нее
+    onLogEntryAdded(entry);
+    
+    // Обновленная запись - самая новая в журнале, а значит в верхней строке
+    if (!m_searching && liveRowCount() > 0 && m_rows.last() + 1 == m_snapshot.endSequence()) {
+        emit dataChanged(index(0, 0), index(0, ColumnCount - 1));
+    }
+}
+
 void LogTableModel::onLogCleared() {
     beginResetModel();
-    m_filteredEntries.clear();
+    m_searchResults.clear();
+    m_searchDropped = 0;
+    rebuildRows();
     endResetModel();
 }
 
 void LogTableModel::setCategoryFilter(const QString& category) {
-    if (m_categoryFilter != category) {
-        m_categoryFilter = category;
+    // Фильтр сравнивает номера категорий, а не строки
+    const QVector<quint32> categories = category.isEmpty()
+        ? QVector<quint32>() : QVector<quint32>{LogStringTable::categories().find(category)};
+    if (m_query.categories != categories) {
+        m_query.categories = categories;
         applyFilters();
     }
 }
 
 void LogTableModel::setLevelFilter(int level) {
-    if (m_levelFilter != level) {
-        m_levelFilter = level;
+    if (m_query.level != level) {
+        m_query.level = level;
         applyFilters();
     }
 }
 
+void LogTableModel::setQuery(const LogQuery& query) {
+    m_query = query;
+    applyFilters();
+}
+
 void LogTableModel::refresh() {
     beginResetModel();
-    // Получаем все записи журнала
-    if (m_categoryFilter.isEmpty() && m_levelFilter < 0) {
-        // Без фильтров
-        m_filteredEntries = m_logManager->getAllEntries();
-    } else {
-        // С фильтрами
-        applyFilters();
+    rebuildRows();
+    endResetModel();
+}
+
+void LogTableModel::beginSearch() {
+    beginResetModel();
+    m_searching = true;
+    m_searchResults.clear();
+    m_searchDropped = 0;
+    endResetModel();
+}
+
+void LogTableModel::appendSearchResults(const QVector<LogEntry>& entries) {
+    if (!m_searching) {
+        return;
+    }
+    
+    // Найденные записи тоже проходят фильтры категории и уровня
+    QVector<LogEntry> added;
+    for (const LogEntry& entry : entries) {
+        if (matchesFilters(entry)) {
+            added.append(entry);
+        }
+    }
+    if (added.isEmpty()) {
+        return;
+    }
+    
+    // Хранятся только самые новые найденные записи, не больше емкости буфера
+    const int capacity = qMax(1, m_logManager->getMaxEntries());
+    if (added.size() > capacity) {
+        m_searchDropped += added.size() - capacity;
+        added.remove(0, added.size() - capacity);
+    }
+    const int overflow = m_searchResults.size() + added.size() - capacity;
+    if (overflow > 0) {
+        // Самые старые записи - последние строки
+        beginRemoveRows(QModelIndex(), m_searchResults.size() - overflow, m_searchResults.size() - 1);
+        m_searchResults.remove(0, overflow);
+        m_searchDropped += overflow;
+        endRemoveRows();
+    }
+    
+    // Найденные записи идут от старых к новым, а строки - от новых к старым
+    beginInsertRows(QModelIndex(), 0, added.size() - 1);
+    m_searchResults += added;
+    endInsertRows();
+}
+
+qint64 LogTableModel::droppedSearchResults() const {
+    return m_searchDropped;
+}
+
+void LogTableModel::endSearch() {
+    if (!m_searching) {
+        return;
     }
+    
+    beginResetModel();
+    m_searching = false;
+    m_searchResults.clear();
+    m_searchResults.squeeze();
+    m_searchDropped = 0;
+    rebuildRows();
     endResetModel();
 }
 
+bool LogTableModel::isSearching() const {
+    return m_searching;
+}
+
 QColor LogTableModel::getStatusColor(LogStatus status) const {
     switch (status) {
         case LogStatus::Normal:
@@ -247,27 +415,63 @@ QColor LogTableModel::getStatusColor(LogStatus status) const {
 
 void LogTableModel::applyFilters() {
     beginResetModel();
+    rebuildRows();
+    endResetModel();
+}
+
+void LogTableModel::rebuildRows() {
+    clearHistory();
+    
+    // Строки выбирает индекс журнала: весь буфер не просматривается
+    LogQueryResult result = m_logManager->query(m_query);
+    m_snapshot = result.snapshot;
+    m_rows = std::move(result.rows);
+    m_firstRow = 0;
+    m_nextSequence = m_snapshot.endSequence();
+}
+
+bool LogTableModel::matchesFilters(const LogEntry& entry) const {
+    return m_query.matches(entry);
+}
+
+int LogTableModel::liveRowCount() const {
+    return m_rows.size() - m_firstRow;
+}
+
+void LogTableModel::clearHistory() {
+    m_history.reset();
+    m_historyRows.clear();
+    m_retained.clear();
+    m_window.clear();
+    m_windowFirst = 0;
+}
+
+const LogEntry& LogTableModel::entryAt(int row) const {
+    if (m_searching) {
+        return m_searchResults[m_searchResults.size() - 1 - row];
+    }
     
-    QVector<LogEntry> allEntries = m_logManager->getAllEntries();
-    m_filteredEntries.clear();
+    const int live = liveRowCount();
+    if (row < live) {
+        return m_snapshot.at(m_snapshot.indexOf(m_rows[m_firstRow + live - 1 - row]));
+    }
+    row -= live;
+    if (row < m_retained.size()) {
+        return m_retained[m_retained.size() - 1 - row];
+    }
+    row -= m_retained.size();
     
-    for (const LogEntry& entry : allEntries) {
-        bool matchesFilters = true;
-        
-        if (!m_categoryFilter.isEmpty() && entry.category != m_categoryFilter) {
-            matchesFilters = false;
-        }
-        
-        if (m_levelFilter >= 0 && static_cast<int>(entry.level) != m_levelFilter) {
-            matchesFilters = false;
-        }
-        
-        if (matchesFilters) {
-            m_filteredEntries.append(entry);
+    // Записи истории строятся с диска только для окна вокруг запрошенной строки
+    if (row < m_windowFirst || row >= m_windowFirst + m_window.size()) {
+        m_windowFirst = qMax(0, row - kHistoryWindowMargin);
+        const int windowEnd = qMin(m_historyRows.size(), row + kHistoryWindowMargin + 1);
+        m_window.clear();
+        m_window.reserve(windowEnd - m_windowFirst);
+        for (int i = m_windowFirst; i < windowEnd; ++i) {
+            m_window.append(m_history->entryAt(m_historyRows[i]));
         }
     }
-    
-    endResetModel();
+    return m_window[row - m_windowFirst];
 }
 
 } // namespace ParamControl
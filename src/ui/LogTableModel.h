@@ -16,6 +16,28 @@ namespace ParamControl {
  * Эта модель отображает записи журнала из LogManager в виде таблицы
  * для отображения в QTableView. Она предоставляет доступ к основным
  * свойствам записей: время, категория, сообщение, значение, статус.
+ *
+ * Строки идут от новых записей к старым. Модель не копирует записи
+ * журнала в памяти: она держит снимок журнала (LogSnapshot) и порядковые
+ * номера записей, прошедших фильтры. Строки при смене фильтров выбираются
+ * запросом к индексу журнала (LogManager::query()).
+ *
+ * Более старые записи подгружаются с диска по мере прокрутки
+ * (canFetchMore()/fetchMore()): курсор LogJournalCursor отдает страницу
+ * положений записей в журнале, а сами записи строятся только для окна
+ * вокруг запрошенных строк. Поэтому открытие журнала за год стоит столько
+ * же, сколько журнала за минуту. Записи, вытесненные из кольцевого буфера
+ * журнала, удаляются из модели, а если история уже подгружена -
+ * копируются в модель, чтобы между памятью и историей не было разрыва.
+ * Копий не больше емкости буфера: дальше история сбрасывается, и
+ * вытесненные записи подгружаются из журнала на диске, как и остальные.
+ *
+ * В режиме поиска (beginSearch()) модель показывает записи, найденные
+ * полнотекстовым поиском по журналу на диске (LogSearch), по мере их
+ * поступления; новые записи журнала в этом режиме не добавляются.
+ * Найденных записей хранится не больше емкости буфера журнала: при
+ * переполнении отбрасываются самые старые, их число возвращает
+ * droppedSearchResults().
  */
 class LogTableModel : public QAbstractTableModel {
     Q_OBJECT
@@ -84,12 +106,31 @@ public:
      */
     Qt::ItemFlags flags(const QModelIndex& index) const override;
 
+    /**
+     * @brief Есть ли более старые записи в журнале на диске
+     * @param parent Родительский индекс
+     */
+    bool canFetchMore(const QModelIndex& parent) const override;
+
+    /**
+     * @brief Подгрузка следующей страницы более старых записей с диска
+     * @param parent Родительский индекс
+     */
+    void fetchMore(const QModelIndex& parent) override;
+
 public slots:
     /**
      * @brief Обработчик добавления записи в журнал
-     * @param entry Новая запись
+     * @param entry Новая запись (строки берутся из нового снимка журнала,
+     *        поэтому записи, добавленные до доставки сигнала, тоже попадают в модель)
      */
     void onLogEntryAdded(const LogEntry& entry);
+
+    /**
+     * @brief Обработчик обновления последней записи журнала (повтор события)
+     * @param entry Запись с новым числом повторов
+     */
+    void onLogEntryUpdated(const LogEntry& entry);
     
     /**
      * @brief Обработчик очистки журнала
@@ -107,17 +148,61 @@ public slots:
      * @param level Уровень для фильтрации (-1 - без фильтра)
      */
     void setLevelFilter(int level);
+
+    /**
+     * @brief Установка всех условий фильтрации сразу (время, категории, уровень, статус)
+     * @param query Условия запроса к журналу
+     */
+    void setQuery(const LogQuery& query);
     
     /**
      * @brief Обновление данных модели
      */
     void refresh();
 
+    /**
+     * @brief Переход в режим поиска: строки модели очищаются
+     */
+    void beginSearch();
+
+    /**
+     * @brief Добавление найденных записей в конец модели (в режиме поиска)
+     * @param entries Найденные записи (добавляются только прошедшие фильтры)
+     */
+    void appendSearchResults(const QVector<LogEntry>& entries);
+
+    /**
+     * @brief Число найденных записей, отброшенных из-за ограничения емкости
+     */
+    qint64 droppedSearchResults() const;
+
+    /**
+     * @brief Возврат из режима поиска к записям журнала в памяти
+     */
+    void endSearch();
+
+    /**
+     * @brief Модель в режиме поиска
+     */
+    bool isSearching() const;
+
 private:
     std::shared_ptr<LogManager> m_logManager;  ///< Менеджер журнала
-    QVector<LogEntry> m_filteredEntries;      ///< Отфильтрованные записи
-    QString m_categoryFilter;                 ///< Фильтр по категории
-    int m_levelFilter;                        ///< Фильтр по уровню
+    LogSnapshot m_snapshot;                   ///< Снимок журнала, из которого читаются строки
+    QVector<quint64> m_rows;                  ///< Порядковые номера записей, прошедших фильтры
+    int m_firstRow = 0;                       ///< Первый действующий элемент m_rows
+    quint64 m_nextSequence = 0;               ///< Первая запись журнала, еще не рассмотренная моделью
+    LogQuery m_query;                         ///< Фильтры (условия запроса к журналу)
+    bool m_searching = false;                 ///< Режим поиска
+    QVector<LogEntry> m_searchResults;        ///< Записи, найденные поиском (от старых к новым, не больше емкости буфера)
+    qint64 m_searchDropped = 0;               ///< Найденные записи, отброшенные сверх емкости
+
+    // --- История с диска (строки после записей в памяти) ---
+    std::unique_ptr<LogJournalCursor> m_history;  ///< Курсор по журналу (создается при первой подгрузке)
+    QVector<LogJournalPosition> m_historyRows;    ///< Положения подгруженных записей, от новых к старым
+    QVector<LogEntry> m_retained;             ///< Вытесненные из памяти записи при подгруженной истории (от старых к новым, не больше емкости буфера)
+    mutable QVector<LogEntry> m_window;       ///< Записи истории, построенные для окна строк
+    mutable int m_windowFirst = 0;            ///< Номер первой записи окна в m_historyRows
 
     /**
      * @brief Получение цвета для отображения статуса записи
@@ -130,6 +215,31 @@ private:
      * @brief Применение фильтров
      */
     void applyFilters();
+
+    /**
+     * @brief Заново заполняет строки по новому снимку журнала (без сигналов сброса)
+     */
+    void rebuildRows();
+
+    /**
+     * @brief Проверяет запись на соответствие фильтрам
+     */
+    bool matchesFilters(const LogEntry& entry) const;
+
+    /**
+     * @brief Число строк записей в памяти
+     */
+    int liveRowCount() const;
+
+    /**
+     * @brief Сбрасывает подгруженную историю
+     */
+    void clearHistory();
+
+    /**
+     * @brief Запись строки модели
+     */
+    const LogEntry& entryAt(int row) const;
 };
 
 } // namespace ParamControl
@@ -52,6 +52,7 @@ MainWindow::MainWindow(
     
     // Инициализируем логирование
     m_logManager->initialize(QString("LOG_%1.txt").arg(m_sotmClient->getSettings().kaNumber));
+    m_logTableModel->refresh();
     
     // Устанавливаем звук для оповещения о пропадании ТМИ
     if (ui->textBoxNoTmiSound && !ui->textBoxNoTmiSound->text().isEmpty()) {
@@ -74,8 +75,8 @@ MainWindow::MainWindow(
             this, &MainWindow::onTmiStatusChanged);
     connect(m_tmiAnalyzer.get(), &TmiAnalyzer::anomalyDetected,
             [this](int type, const QString& message) {
-                m_logManager->log(LogLevel::Error, "Телеметрия", 
-                                 QString("Аномалия ТМИ: %1").arg(message));
+                m_logManager->logTemplate(LogLevel::Error, "Телеметрия", 
+                                          "Аномалия ТМИ: %1", {message});
             });
 }
 
@@ -165,8 +166,8 @@ void MainWindow::setupConnections() {
             this, &MainWindow::onParameterValueChanged);
     
     // Подключаем события от модели параметров
-    connect(m_parameterModel.get(), &ParameterModel::parameterStatusChanged,
-            m_parameterTableModel.get(), &ParameterTableModel::onParameterStatusChanged);
+    connect(m_parameterModel.get(), &ParameterModel::tickEvaluated,
+            m_parameterTableModel.get(), &ParameterTableModel::onTickEvaluated);
     connect(m_parameterModel.get(), &ParameterModel::parameterAdded,
             m_parameterTableModel.get(), &ParameterTableModel::onParameterAdded);
     connect(m_parameterModel.get(), &ParameterModel::parameterRemoved,
@@ -175,10 +176,14 @@ void MainWindow::setupConnections() {
             m_parameterTableModel.get(), &ParameterTableModel::onParameterUpdated);
     connect(m_parameterModel.get(), &ParameterModel::parameterSoundChanged,
             m_parameterTableModel.get(), &ParameterTableModel::onParameterSoundChanged);
+    connect(m_parameterModel.get(), &ParameterModel::modelReset,
+            m_parameterTableModel.get(), &ParameterTableModel::onModelReset);
     
     // Подключаем события логирования
     connect(m_logManager.get(), &LogManager::logEntryAdded,
             m_logTableModel.get(), &LogTableModel::onLogEntryAdded);
+    connect(m_logManager.get(), &LogManager::logEntryUpdated,
+            m_logTableModel.get(), &LogTableModel::onLogEntryUpdated);
 }
 
 void MainWindow::loadSettings() {
@@ -264,7 +269,7 @@ void MainWindow::onStartMonitoringClicked() {
         return;
     }
     
-    if (m_parameterModel->getAllParameters().isEmpty()) {
+    if (m_parameterModel->snapshot()->rows.isEmpty()) {
         QMessageBox::warning(this, "Ошибка",
                            "Требуется сперва задать параметры для контроля.",
                            QMessageBox::Ok);
@@ -307,10 +312,8 @@ void MainWindow::onAddParameterClicked() {
             QString paramFileName = QString("parameters_ka%1.json").arg(settings.kaNumber);
             m_parameterModel->saveParameters(paramFileName);
             
-            m_logManager->log(LogLevel::Info, "Параметры", 
-                             QString("Добавлен параметр %1 (%2)")
-                             .arg(parameter->getName())
-                             .arg(parameter->getDescription()));
+            m_logManager->logTemplate(LogLevel::Info, "Параметры", "Добавлен параметр %1 (%2)",
+                                      {parameter->getName(), parameter->getDescription()});
         }
     }
 }
@@ -341,7 +344,10 @@ void MainWindow::onRemoveParameterClicked() {
     if (result == QMessageBox::Yes) {
         // Получаем параметр
         int paramIndex = index.row();
-        std::shared_ptr<Parameter> param = m_parameterModel->getAllParameters()[paramIndex];
+        std::shared_ptr<Parameter> param = m_parameterModel->getParameterAt(paramIndex);
+        if (!param) {
+            return;
+        }
         
         // Удаляем параметр
         m_parameterModel->removeParameter(param->getName(), param->getType());
@@ -351,10 +357,8 @@ void MainWindow::onRemoveParameterClicked() {
         QString paramFileName = QString("parameters_ka%1.json").arg(settings.kaNumber);
         m_parameterModel->saveParameters(paramFileName);
         
-        m_logManager->log(LogLevel::Info, "Параметры", 
-                         QString("Удален параметр %1 (%2)")
-                         .arg(param->getName())
-                         .arg(param->getDescription()));
+        m_logManager->logTemplate(LogLevel::Info, "Параметры", "Удален параметр %1 (%2)",
+                                  {param->getName(), param->getDescription()});
     }
 }
 
@@ -370,7 +374,10 @@ void MainWindow::onEditParameterClicked() {
     
     // Получаем параметр
     int paramIndex = index.row();
-    std::shared_ptr<Parameter> param = m_parameterModel->getAllParameters()[paramIndex];
+    std::shared_ptr<Parameter> param = m_parameterModel->getParameterAt(paramIndex);
+    if (!param) {
+        return;
+    }
     
     // Открываем диалог редактирования
     ParameterDialog dialog(this);
@@ -392,10 +399,8 @@ void MainWindow::onEditParameterClicked() {
             QString paramFileName = QString("parameters_ka%1.json").arg(settings.kaNumber);
             m_parameterModel->saveParameters(paramFileName);
             
-            m_logManager->log(LogLevel::Info, "Параметры", 
-                             QString("Изменен параметр %1 (%2)")
-                             .arg(updatedParam->getName())
-                             .arg(updatedParam->getDescription()));
+            m_logManager->logTemplate(LogLevel::Info, "Параметры", "Изменен параметр %1 (%2)",
+                                      {updatedParam->getName(), updatedParam->getDescription()});
         }
     }
 }
@@ -414,10 +419,9 @@ void MainWindow::onConfigureConnectionClicked() {
         // Сохраняем настройки
         saveSettings();
         
-        m_logManager->log(LogLevel::Info, "Настройки", 
-                         QString("Изменены настройки подключения к СОТМ: %1:%2")
-                         .arg(newSettings.ipAddress)
-                         .arg(newSettings.port));
+        m_logManager->logTemplate(LogLevel::Info, "Настройки", 
+                                  "Изменены настройки подключения к СОТМ: %1:%2",
+                                  {newSettings.ipAddress, QString::number(newSettings.port)});
     }
 }
 
@@ -432,7 +436,7 @@ void MainWindow::onToggleTmiSoundClicked() {
     updateTmiSoundButton();
     
     m_logManager->log(LogLevel::Info, "Настройки", 
-                     QString("Звук ТМИ %1").arg(!tmiSoundEnabled ? "включен" : "отключен"));
+                     !tmiSoundEnabled ? "Звук ТМИ включен" : "Звук ТМИ отключен");
 }
 
 void MainWindow::onShowLogClicked() {
@@ -563,7 +567,10 @@ void MainWindow::onParameterContextMenu(const QPoint& pos) {
     
     // Получаем данные выбранного параметра
     int paramIndex = index.row();
-    std::shared_ptr<Parameter> param = m_parameterModel->getAllParameters()[paramIndex];
+    std::shared_ptr<Parameter> param = m_parameterModel->getParameterAt(paramIndex);
+    if (!param) {
+        return;
+    }
     
     // Создаем контекстное меню
     QMenu menu(this);
@@ -599,10 +606,10 @@ void MainWindow::onParameterContextMenu(const QPoint& pos) {
         QString paramFileName = QString("parameters_ka%1.json").arg(settings.kaNumber);
         m_parameterModel->saveParameters(paramFileName);
         
-        m_logManager->log(LogLevel::Info, "Параметры", 
-                         QString("Звук для параметра %1 %2")
-                         .arg(param->getName())
-                         .arg(param->isSoundEnabled() ? "включен" : "отключен"));
+        m_logManager->logTemplate(LogLevel::Info, "Параметры", 
+                                  param->isSoundEnabled() ? "Звук для параметра %1 включен"
+                                                          : "Звук для параметра %1 отключен",
+                                  {param->getName()});
     }
 }
 
@@ -625,7 +632,8 @@ void MainWindow::onLogContextMenu(const QPoint& pos) {
 void MainWindow::onClearLog() {
     // Запрашиваем подтверждение
     int result = QMessageBox::question(this, "Подтверждение",
-                                     "Удалить все строки?",
+                                     "Удалить все строки?\n"
+                                     "Журнал будет очищен полностью, включая архивные сегменты на диске.",
                                      QMessageBox::Yes | QMessageBox::No);
     
     if (result == QMessageBox::Yes) {
@@ -674,11 +682,7 @@ void MainWindow::keyPressEvent(QKeyEvent* event) {
         m_alertManager->stopAllAlerts();
         
         // Сбрасываем состояние параметров изменения в исходное
-        for (const auto& param : m_parameterModel->getAllParameters()) {
-            if (param->getType() == ParameterType::Changed) {
-                param->updateValue(param->getCurrentValue());
-            }
-        }
+        m_parameterModel->resetChangeTracking();
     } else {
         // Передаем событие родителю
         QMainWindow::keyPressEvent(event);
@@ -8,6 +8,8 @@
 #include <QGridLayout>
 #include <QScrollArea>
 #include <QDateTime>
+#include <algorithm>
+#include <cmath>
 
 namespace ParamControl {
 
@@ -29,6 +31,10 @@ ParameterCardView::ParameterCardView(const std::shared_ptr<ParameterModel>& para
     // Установка модели для таблицы условий
     m_conditionsTable->setModel(m_conditionsModel.get());
     
+    // Модель истории значений
+    m_historyModel = std::make_unique<ParameterHistoryTableModel>(this);
+    m_historyTable->setModel(m_historyModel.get());
+    
     // Подключение сигналов
     connect(m_editButton, &QPushButton::clicked, this, &ParameterCardView::onEditButtonClicked);
     connect(m_deleteButton, &QPushButton::clicked, this, &ParameterCardView::onDeleteButtonClicked);
@@ -37,10 +43,8 @@ ParameterCardView::ParameterCardView(const std::shared_ptr<ParameterModel>& para
     connect(m_soundEnabledCheckBox, &QCheckBox::stateChanged, this, &ParameterCardView::onSoundEnabledChanged);
     
     // Подключение сигналов модели параметров
-    connect(m_parameterModel.get(), &ParameterModel::parameterValueChanged, 
-            this, &ParameterCardView::onValueChanged);
-    connect(m_parameterModel.get(), &ParameterModel::parameterStatusChanged, 
-            this, &ParameterCardView::onStatusChanged);
+    connect(m_parameterModel.get(), &ParameterModel::tickEvaluated, 
+            this, &ParameterCardView::onTickEvaluated);
 }
 
 ParameterCardView::~ParameterCardView() {
@@ -119,17 +123,28 @@ void ParameterCardView::onSoundEnabledChanged(int state) {
     emit soundEnabledChanged(m_parameterName, m_parameterType, enabled);
 }
 
-void ParameterCardView::onValueChanged(const QString& name, const QVariant& value) {
-    // Проверяем, это ли наш параметр
-    if (name == m_parameterName) {
-        // Обновляем метку значения
-        m_valueLabel->setText(value.toString());
+void ParameterCardView::onTickEvaluated(const TickResultPtr& result) {
+    // Ищем нашу строку в снимке такта по хеш-индексу
+    const int row = result->snapshot->indexOf(m_parameterName, m_parameterType);
+    if (row < 0) {
+        return;
     }
-}
-
-void ParameterCardView::onStatusChanged(const QString& name, ParameterType type, ParameterStatus status) {
-    // Проверяем, это ли наш параметр
-    if (name == m_parameterName && type == m_parameterType) {
+    
+    // Строки в результате упорядочены, поэтому достаточно двоичного поиска
+    if (std::binary_search(result->changedValues.cbegin(), result->changedValues.cend(), row)) {
+        // Обновляем метку значения и статистику окна (уже посчитанную программой условий)
+        m_valueLabel->setText(QString("Значение: %1").arg(result->snapshot->rows[row].value.toString()));
+        updateWindowStats(result->snapshot->rows[row]);
+    }
+    
+    // История пишет каждый такт, даже с тем же значением, поэтому таблицу
+    // дополняем из нее на каждом такте, а не только при изменении значения
+    appendNewHistory();
+    
+    const auto transition = std::lower_bound(
+        result->transitions.cbegin(), result->transitions.cend(), row,
+        [](const StatusTransition& item, int value) { return item.row < value; });
+    if (transition != result->transitions.cend() && transition->row == row) {
         // Обновляем статус
         updateStatus();
     }
@@ -170,6 +185,11 @@ void ParameterCardView::setupUi() {
     
     mainLayout->addLayout(headerLayout);
     
+    // Статистика окна отсчетов (только для правил с окном)
+    m_windowLabel = new QLabel(this);
+    m_windowLabel->setVisible(false);
+    mainLayout->addWidget(m_windowLabel);
+    
     // Группа с описанием
     auto descriptionGroup = new QGroupBox("Описание", this);
     auto descriptionLayout = new QVBoxLayout(descriptionGroup);
@@ -197,7 +217,7 @@ void ParameterCardView::setupUi() {
     splitter->addWidget(conditionsGroup);
     
     // Группа с историей изменений
-    auto historyGroup = new QGroupBox("История изменений", this);
+    auto historyGroup = new QGroupBox("История значений", this);
     auto historyLayout = new QVBoxLayout(historyGroup);
     
     m_historyTable = new QTableView(historyGroup);
@@ -217,18 +237,20 @@ void ParameterCardView::setupUi() {
 }
 
 void ParameterCardView::updateParameterData() {
-    // Получаем параметр
-    auto parameter = m_parameterModel->getParameter(m_parameterName, m_parameterType);
+    // Получаем строку параметра из опубликованного снимка модели
+    const auto snapshot = m_parameterModel->snapshot();
+    const int row = snapshot->indexOf(m_parameterName, m_parameterType);
     
-    if (!parameter) {
+    if (row < 0) {
         return;
     }
+    const ParameterRow& parameter = snapshot->rows[row];
     
     // Обновляем метки
-    m_nameLabel->setText(QString("Параметр: %1").arg(parameter->getName()));
+    m_nameLabel->setText(QString("Параметр: %1").arg(parameter.name));
     
     QString typeText;
-    switch (parameter->getType()) {
+    switch (parameter.type) {
         case ParameterType::Equals:
             typeText = "Равенство";
             break;
@@ -244,33 +266,108 @@ void ParameterCardView::updateParameterData() {
         case ParameterType::Changed:
             typeText = "Изменение";
             break;
+        case ParameterType::Expression:
+            typeText = "Выражение";
+            break;
+        case ParameterType::RateOfChange:
+            typeText = "Скорость изменения";
+            break;
+        case ParameterType::Trend:
+            typeText = "Тренд";
+            break;
+        case ParameterType::Statistic:
+            typeText = "Статистика окна";
+            break;
         default:
             typeText = "Неизвестный";
             break;
     }
     
     m_typeLabel->setText(QString("Тип: %1").arg(typeText));
-    m_valueLabel->setText(QString("Значение: %1").arg(parameter->getCurrentValue().toString()));
+    m_valueLabel->setText(QString("Значение: %1").arg(parameter.value.toString()));
+    updateWindowStats(parameter);
     
     // Обновляем описание
-    m_descriptionEdit->setPlainText(parameter->getDescription());
+    m_descriptionEdit->setPlainText(parameter.description);
     
     // Обновляем состояние звука
-    m_soundEnabledCheckBox->setChecked(parameter->isSoundEnabled());
+    m_soundEnabledCheckBox->setChecked(parameter.soundEnabled);
+}
+
+void ParameterCardView::updateWindowStats(const ParameterRow& row) {
+    const WindowStats& stats = row.window;
+    if (stats.samples == 0) {
+        m_windowLabel->setVisible(false);
+        return;
+    }
+    
+    // СКО не определено для одного отсчета - выводим прочерк
+    const QString stddev = std::isnan(stats.stddev) ? QString("—") : QString::number(stats.stddev, 'g', 6);
+    m_windowLabel->setText(QString("Окно: %1 отсч., среднее %2, СКО %3, мин %4, макс %5")
+                               .arg(stats.samples)
+                               .arg(QString::number(stats.mean, 'g', 6))
+                               .arg(stddev)
+                               .arg(QString::number(stats.minimum, 'g', 6))
+                               .arg(QString::number(stats.maximum, 'g', 6)));
+    m_windowLabel->setVisible(true);
 }
 
 void ParameterCardView::updateHistory() {
-    // Получаем историю из логов
-    QVector<LogEntry> allEntries = m_logManager->getEntriesByCategory(m_parameterName);
+    // Берем последние отсчеты из истории значений модели
+    const QVector<HistorySample> samples = m_parameterModel->history()->latest(
+        m_parameterName, ParameterHistoryTableModel::kMaxRows);
+    m_historyModel->setSamples(samples);
+    
+    m_historyLastMs = std::numeric_limits<qint64>::min();
+    m_historyLastCount = 0;
+    rememberHistoryTail(samples);
+}
+
+void ParameterCardView::appendNewHistory() {
+    // Запрос начинается с времени последнего показанного отсчета включительно:
+    // несколько тактов могут прийтись на одну миллисекунду
+    QVector<HistorySample> samples = m_parameterModel->history()->samples(
+        m_parameterName, m_historyLastMs, std::numeric_limits<qint64>::max());
+    
+    int shown = 0;
+    while (shown < samples.size() && shown < m_historyLastCount &&
+           samples[shown].timestampMs == m_historyLastMs) {
+        ++shown;
+    }
+    samples.remove(0, shown);
+    if (samples.isEmpty()) {
+        return;
+    }
+    
+    // Если новых отсчетов больше, чем строк в таблице, проще загрузить ее заново
+    if (samples.size() >= ParameterHistoryTableModel::kMaxRows) {
+        updateHistory();
+        return;
+    }
     
-    // TODO: Создать модель для истории и отобразить ее в таблице
+    for (const HistorySample& sample : samples) {
+        m_historyModel->addSample(sample);
+    }
+    rememberHistoryTail(samples);
+}
+
+void ParameterCardView::rememberHistoryTail(const QVector<HistorySample>& samples) {
+    for (const HistorySample& sample : samples) {
+        if (sample.timestampMs == m_historyLastMs) {
+            ++m_historyLastCount;
+        } else {
+            m_historyLastMs = sample.timestampMs;
+            m_historyLastCount = 1;
+        }
+    }
 }
 
 void ParameterCardView::updateStatus() {
-    // Получаем параметр
-    auto parameter = m_parameterModel->getParameter(m_parameterName, m_parameterType);
+    // Получаем строку параметра из опубликованного снимка модели
+    const auto snapshot = m_parameterModel->snapshot();
+    const int row = snapshot->indexOf(m_parameterName, m_parameterType);
     
-    if (!parameter) {
+    if (row < 0) {
         return;
     }
     
@@ -278,7 +375,7 @@ void ParameterCardView::updateStatus() {
     QString statusText;
     QString styleSheet;
     
-    switch (parameter->getStatus()) {
+    switch (snapshot->rows[row].status) {
         case ParameterStatus::Ok:
             statusText = "В норме";
             styleSheet = "color: green; font-weight: bold;";
@@ -358,6 +455,18 @@ QVariant ParameterCardTableModel::data(const QModelIndex& index, int role) const
                         case ParameterType::Changed:
                             typeText = "Изменение";
                             break;
+                        case ParameterType::Expression:
+                            typeText = "Выражение";
+                            break;
+                        case ParameterType::RateOfChange:
+                            typeText = "Скорость изменения";
+                            break;
+                        case ParameterType::Trend:
+                            typeText = "Тренд";
+                            break;
+                        case ParameterType::Statistic:
+                            typeText = "Статистика окна";
+                            break;
                         default:
                             typeText = "Неизвестный";
                             break;
@@ -497,17 +606,124 @@ void ParameterCardTableModel::setParameterName(const QString& name) {
 void ParameterCardTableModel::refresh() {
     beginResetModel();
     
-    // Получаем все параметры с указанным именем
-    m_parameters.clear();
-    const auto& allParameters = m_parameterModel->getAllParameters();
+    // Получаем все параметры с указанным именем (через индекс имен модели)
+    m_parameters = m_parameterModel->getParametersByName(m_parameterName);
+    
+    endResetModel();
+}
+
+// ---------------------------------------------------------------------
+
+ParameterHistoryTableModel::ParameterHistoryTableModel(QObject* parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int ParameterHistoryTableModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    
+    return m_samples.size();
+}
+
+int ParameterHistoryTableModel::columnCount(const QModelIndex& parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    
+    return 2; // Время, Значение
+}
+
+QVariant ParameterHistoryTableModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= m_samples.size()) {
+        return QVariant();
+    }
+    
+    const HistorySample& sample = m_samples[index.row()];
     
-    for (const auto& parameter : allParameters) {
-        if (parameter->getName() == m_parameterName) {
-            m_parameters.append(parameter);
+    switch (role) {
+        case Qt::DisplayRole: {
+            switch (index.column()) {
+                case 0:
+                    return QDateTime::fromMSecsSinceEpoch(sample.timestampMs)
+                        .toString("dd.MM.yyyy hh:mm:ss.zzz");
+                    
+                case 1:
+                    return sample.value.toString();
+                    
+                default:
+                    return QVariant();
+            }
+        }
+        
+        case Qt::TextAlignmentRole: {
+            return Qt::AlignCenter;
+        }
+        
+        default:
+            return QVariant();
+    }
+}
+
+QVariant ParameterHistoryTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal) {
+        return QVariant();
+    }
+    
+    switch (role) {
+        case Qt::DisplayRole: {
+            switch (section) {
+                case 0:
+                    return QString("Время");
+                    
+                case 1:
+                    return QString("Значение");
+                    
+                default:
+                    return QVariant();
+            }
         }
+        
+        case Qt::TextAlignmentRole: {
+            return Qt::AlignCenter;
+        }
+        
+        case Qt::FontRole: {
+            QFont font;
+            font.setBold(true);
+            return font;
+        }
+        
+        default:
+            return QVariant();
+    }
+}
+
+void ParameterHistoryTableModel::setSamples(const QVector<HistorySample>& samples) {
+    beginResetModel();
+    
+    // Отсчеты приходят в порядке времени, а показываются новые сверху
+    m_samples.clear();
+    m_samples.reserve(samples.size());
+    for (auto it = samples.crbegin(); it != samples.crend(); ++it) {
+        m_samples.append(*it);
     }
     
     endResetModel();
 }
 
+void ParameterHistoryTableModel::addSample(const HistorySample& sample) {
+    beginInsertRows(QModelIndex(), 0, 0);
+    m_samples.prepend(sample);
+    endInsertRows();
+    
+    // Ограничиваем число строк, удаляя самые старые
+    if (m_samples.size() > kMaxRows) {
+        beginRemoveRows(QModelIndex(), kMaxRows, m_samples.size() - 1);
+        m_samples.resize(kMaxRows);
+        endRemoveRows();
+    }
+}
+
 } // namespace ParamControl
@@ -8,6 +8,7 @@
 #include <QVBoxLayout>
 #include <QGroupBox>
 #include <memory>
+#include <limits>
 
 #include "ParameterModel.h"
 #include "LogManager.h"
@@ -15,6 +16,7 @@
 namespace ParamControl {
 
 class ParameterCardTableModel;
+class ParameterHistoryTableModel;
 
 /**
  * @brief Виджет для отображения детальной информации о параметре
@@ -131,19 +133,10 @@ private slots:
     void onSoundEnabledChanged(int state);
     
     /**
-     * @brief Обработчик изменения значения параметра
-     * @param name Имя параметра
-     * @param value Новое значение
+     * @brief Обработчик завершения такта проверки
+     * @param result Итог такта (новые значения, изменения статусов и снимок)
      */
-    void onValueChanged(const QString& name, const QVariant& value);
-    
-    /**
-     * @brief Обработчик изменения статуса параметра
-     * @param name Имя параметра
-     * @param type Тип параметра
-     * @param status Новый статус
-     */
-    void onStatusChanged(const QString& name, ParameterType type, ParameterStatus status);
+    void onTickEvaluated(const ParamControl::TickResultPtr& result);
 
 private:
     std::shared_ptr<ParameterModel> m_parameterModel;  ///< Модель параметров
@@ -155,15 +148,19 @@ private:
     QLabel* m_typeLabel;                  ///< Метка с типом параметра
     QLabel* m_valueLabel;                 ///< Метка с текущим значением
     QLabel* m_statusLabel;                ///< Метка со статусом
+    QLabel* m_windowLabel;                ///< Метка со статистикой окна отсчетов
     QTextEdit* m_descriptionEdit;         ///< Поле для редактирования описания
     QTableView* m_conditionsTable;        ///< Таблица с условиями контроля
-    QTableView* m_historyTable;           ///< Таблица с историей изменений
+    QTableView* m_historyTable;           ///< Таблица с историей значений
     QPushButton* m_editButton;            ///< Кнопка редактирования
     QPushButton* m_deleteButton;          ///< Кнопка удаления
     QPushButton* m_addButton;             ///< Кнопка добавления
     QCheckBox* m_soundEnabledCheckBox;    ///< Флажок включения звука
     
     std::unique_ptr<ParameterCardTableModel> m_conditionsModel;  ///< Модель для таблицы условий
+    std::unique_ptr<ParameterHistoryTableModel> m_historyModel;  ///< Модель для таблицы истории
+    qint64 m_historyLastMs = std::numeric_limits<qint64>::min();  ///< Время последнего показанного отсчета
+    int m_historyLastCount = 0;           ///< Число показанных отсчетов с этим временем
     
     /**
      * @brief Инициализация интерфейса
@@ -176,14 +173,31 @@ private:
     void updateParameterData();
     
     /**
-     * @brief Обновление истории изменений параметра
+     * @brief Загрузка истории значений параметра
      */
     void updateHistory();
     
+    /**
+     * @brief Дозапись в таблицу отсчетов, появившихся в истории после последнего показанного
+     */
+    void appendNewHistory();
+    
+    /**
+     * @brief Запоминание последнего показанного отсчета
+     * @param samples Показанные отсчеты в порядке времени
+     */
+    void rememberHistoryTail(const QVector<HistorySample>& samples);
+    
     /**
      * @brief Обновление статуса параметра
      */
     void updateStatus();
+    
+    /**
+     * @brief Обновление статистики окна отсчетов из строки снимка
+     * @param row Строка параметра в снимке
+     */
+    void updateWindowStats(const ParameterRow& row);
 };
 
 /**
@@ -250,4 +264,71 @@ private:
     QVector<std::shared_ptr<Parameter>> m_parameters;  ///< Список параметров с указанным именем
 };
 
+/**
+ * @brief Модель для отображения истории значений параметра
+ *
+ * Показывает последние отсчеты из хранилища истории модели параметров,
+ * новые сверху. Число строк ограничено kMaxRows.
+ */
+class ParameterHistoryTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    /// Наибольшее число отображаемых отсчетов.
+    static constexpr int kMaxRows = 500;
+
+    /**
+     * @brief Конструктор
+     * @param parent Родительский объект
+     */
+    explicit ParameterHistoryTableModel(QObject* parent = nullptr);
+    
+    /**
+     * @brief Получение количества строк
+     * @param parent Родительский индекс
+     * @return Количество строк
+     */
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    
+    /**
+     * @brief Получение количества столбцов
+     * @param parent Родительский индекс
+     * @return Количество столбцов
+     */
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    
+    /**
+     * @brief Получение данных для отображения
+     * @param index Индекс элемента
+     * @param role Роль данных
+     * @return Данные для отображения
+     */
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    
+    /**
+     * @brief Получение заголовков
+     * @param section Номер секции
+     * @param orientation Ориентация
+     * @param role Роль данных
+     * @return Данные заголовка
+     */
+    QVariant headerData(int section, Qt::Orientation orientation, 
+                        int role = Qt::DisplayRole) const override;
+    
+    /**
+     * @brief Замена всех отсчетов
+     * @param samples Отсчеты в порядке времени
+     */
+    void setSamples(const QVector<HistorySample>& samples);
+    
+    /**
+     * @brief Добавление нового отсчета в начало таблицы
+     * @param sample Отсчет
+     */
+    void addSample(const HistorySample& sample);
+
+private:
+    QVector<HistorySample> m_samples;  ///< Отсчеты, новые первыми
+};
+
 } // namespace ParamControl
@@ -5,6 +5,10 @@
 #include <QMessageBox>
 #include <QVariantList>
 
+#include "Expression.h"
+#include "ParameterStatistic.h"
+#include "WindowStore.h"
+
 ParameterDialog::ParameterDialog(QWidget* parent)
     : QDialog(parent)
     , ui(new Ui::ParameterDialog)
@@ -68,6 +72,14 @@ void ParameterDialog::setupConnections() {
             this, &ParameterDialog::onParameterTypeChanged);
     connect(m_changedRadio, &QRadioButton::toggled,
             this, &ParameterDialog::onParameterTypeChanged);
+    connect(ui->expressionRadio, &QRadioButton::toggled,
+            this, &ParameterDialog::onParameterTypeChanged);
+    connect(ui->rateRadio, &QRadioButton::toggled,
+            this, &ParameterDialog::onParameterTypeChanged);
+    connect(ui->trendRadio, &QRadioButton::toggled,
+            this, &ParameterDialog::onParameterTypeChanged);
+    connect(ui->statisticRadio, &QRadioButton::toggled,
+            this, &ParameterDialog::onParameterTypeChanged);
     
     // Подключаем выбор звукового файла
     connect(m_soundFileBrowseButton, &QPushButton::clicked,
@@ -101,6 +113,28 @@ void ParameterDialog::updateControlsState() {
     m_lowerOutLimitEdit->setEnabled(m_outOfLimitsRadio->isChecked());
     m_upperOutLimitEdit->setEnabled(m_outOfLimitsRadio->isChecked());
     
+    // Поле для Expression
+    ui->expressionEdit->setEnabled(ui->expressionRadio->isChecked());
+    
+    // Поля для RateOfChange и Trend
+    ui->rateEdit->setEnabled(ui->rateRadio->isChecked());
+    ui->rateWindowSpin->setEnabled(ui->rateRadio->isChecked());
+    ui->labelRateWindow->setEnabled(ui->rateRadio->isChecked());
+    ui->trendDeltaEdit->setEnabled(ui->trendRadio->isChecked());
+    ui->trendSamplesSpin->setEnabled(ui->trendRadio->isChecked());
+    ui->labelTrendSamples->setEnabled(ui->trendRadio->isChecked());
+    
+    // Поля для Statistic
+    ui->statisticCombo->setEnabled(ui->statisticRadio->isChecked());
+    ui->statisticThresholdEdit->setEnabled(ui->statisticRadio->isChecked());
+    ui->statisticWindowSpin->setEnabled(ui->statisticRadio->isChecked());
+    ui->labelStatisticWindow->setEnabled(ui->statisticRadio->isChecked());
+    
+    // Гистерезис применяется только к условиям с границами
+    const bool limits = m_inLimitsRadio->isChecked() || m_outOfLimitsRadio->isChecked();
+    ui->hysteresisSpin->setEnabled(limits);
+    ui->labelHysteresis->setEnabled(limits);
+    
     // Статусы Label
     ui->labelLowerLimit->setEnabled(m_inLimitsRadio->isChecked());
     ui->labelUpperLimit->setEnabled(m_inLimitsRadio->isChecked());
@@ -168,6 +202,14 @@ bool ParameterDialog::validateInputs() {
             QMessageBox::warning(this, "Ошибка", "Нижняя граница должна быть меньше верхней.");
             return false;
         }
+        
+        // Зона возврата должна оставаться непустой
+        ConditionFilter filter;
+        filter.hysteresis = ui->hysteresisSpin->value();
+        if (!filter.hysteresisFits(lowerLimit, upperLimit)) {
+            QMessageBox::warning(this, "Ошибка", "Гистерезис должен быть меньше половины диапазона.");
+            return false;
+        }
     } else if (m_outOfLimitsRadio->isChecked()) {
         if (m_lowerOutLimitEdit->text().trimmed().isEmpty()) {
             QMessageBox::warning(this, "Ошибка", "Не заполнено поле нижней границы.");
@@ -192,6 +234,48 @@ bool ParameterDialog::validateInputs() {
             QMessageBox::warning(this, "Ошибка", "Нижняя граница должна быть меньше верхней.");
             return false;
         }
+    } else if (ui->expressionRadio->isChecked()) {
+        // Выражение должно компилироваться
+        QString error;
+        if (!Expression::compile(ui->expressionEdit->text(), &error)) {
+            QMessageBox::warning(this, "Ошибка", QString("Ошибка в выражении: %1").arg(error));
+            return false;
+        }
+    } else if (ui->rateRadio->isChecked() || ui->trendRadio->isChecked() || ui->statisticRadio->isChecked()) {
+        QString threshold;
+        if (ui->rateRadio->isChecked()) {
+            threshold = ui->rateEdit->text().trimmed();
+        } else if (ui->trendRadio->isChecked()) {
+            threshold = ui->trendDeltaEdit->text().trimmed();
+        } else {
+            threshold = ui->statisticThresholdEdit->text().trimmed();
+        }
+        if (threshold.isEmpty()) {
+            QMessageBox::warning(this, "Ошибка", "Не заполнено поле порога.");
+            return false;
+        }
+        
+        bool ok;
+        threshold.toDouble(&ok);
+        if (!ok) {
+            QMessageBox::warning(this, "Ошибка", "Неверный формат чисел. Используйте точку в качестве разделителя дробной части.");
+            return false;
+        }
+        
+        // Окно должно вместить все отсчеты за заданное время при интервале опроса по умолчанию;
+        // при другом интервале ConditionProgram::compile() предупреждает об ограничении окна
+        if (ui->rateRadio->isChecked() || ui->statisticRadio->isChecked()) {
+            const double windowSeconds = ui->rateRadio->isChecked() ? ui->rateWindowSpin->value()
+                                                                    : ui->statisticWindowSpin->value();
+            const qint64 windowMs = qRound64(windowSeconds * 1000.0);
+            const qint64 maxWindowMs = qint64(WindowStore::kMaxSpanCapacity - 2) * WindowStore::kDefaultSampleIntervalMs;
+            if (windowMs > maxWindowMs) {
+                QMessageBox::warning(this, "Ошибка",
+                                     QString("Окно не должно превышать %1 с при интервале опроса по умолчанию.")
+                                     .arg(maxWindowMs / 1000));
+                return false;
+            }
+        }
     }
     
     // Проверяем звуковой файл, если включен звук
@@ -231,6 +315,30 @@ std::shared_ptr<Parameter> ParameterDialog::getParameter() const {
         targetValue = limits;
     } else if (m_changedRadio->isChecked()) {
         type = ParameterType::Changed;
+    } else if (ui->expressionRadio->isChecked()) {
+        type = ParameterType::Expression;
+        targetValue = ui->expressionEdit->text().trimmed();
+    } else if (ui->rateRadio->isChecked()) {
+        type = ParameterType::RateOfChange;
+        QVariantList settings;
+        settings.append(ui->rateEdit->text().trimmed().toDouble());
+        settings.append(ui->rateWindowSpin->value());
+        targetValue = settings;
+    } else if (ui->trendRadio->isChecked()) {
+        type = ParameterType::Trend;
+        QVariantList settings;
+        settings.append(ui->trendSamplesSpin->value());
+        settings.append(ui->trendDeltaEdit->text().trimmed().toDouble());
+        targetValue = settings;
+    } else if (ui->statisticRadio->isChecked()) {
+        type = ParameterType::Statistic;
+        // Порядок пунктов списка совпадает с WindowStatistic
+        QVariantList settings;
+        settings.append(ParameterStatistic::statisticCode(
+            static_cast<WindowStatistic>(ui->statisticCombo->currentIndex())));
+        settings.append(ui->statisticThresholdEdit->text().trimmed().toDouble());
+        settings.append(ui->statisticWindowSpin->value());
+        targetValue = settings;
     }
     
     // Создаем параметр
@@ -241,6 +349,18 @@ std::shared_ptr<Parameter> ParameterDialog::getParameter() const {
         m_soundFileEdit->text(),
         m_enableSoundCheckBox->isChecked());
     
+    if (parameter) {
+        ConditionFilter filter;
+        if (type == ParameterType::InLimits || type == ParameterType::OutOfLimits) {
+            filter.hysteresis = ui->hysteresisSpin->value();
+        }
+        filter.entrySamples = ui->entrySamplesSpin->value();
+        filter.entrySeconds = ui->entrySecondsSpin->value();
+        filter.exitSamples = ui->exitSamplesSpin->value();
+        filter.exitSeconds = ui->exitSecondsSpin->value();
+        parameter->setFilter(filter);
+    }
+    
     return parameter;
 }
 
@@ -290,10 +410,51 @@ void ParameterDialog::setParameter(const std::shared_ptr<Parameter>& parameter)
         case ParameterType::Changed:
             m_changedRadio->setChecked(true);
             break;
+        case ParameterType::Expression:
+            ui->expressionRadio->setChecked(true);
+            ui->expressionEdit->setText(targetValue.toString());
+            break;
+        case ParameterType::RateOfChange: {
+            ui->rateRadio->setChecked(true);
+            QVariantList settings = targetValue.toList();
+            if (settings.size() >= 2) {
+                ui->rateEdit->setText(settings[0].toString());
+                ui->rateWindowSpin->setValue(settings[1].toDouble());
+            }
+            break;
+        }
+        case ParameterType::Trend: {
+            ui->trendRadio->setChecked(true);
+            QVariantList settings = targetValue.toList();
+            if (settings.size() >= 2) {
+                ui->trendSamplesSpin->setValue(settings[0].toInt());
+                ui->trendDeltaEdit->setText(settings[1].toString());
+            }
+            break;
+        }
+        case ParameterType::Statistic: {
+            ui->statisticRadio->setChecked(true);
+            QVariantList settings = targetValue.toList();
+            WindowStatistic statistic;
+            if (settings.size() >= 3 && ParameterStatistic::parseStatistic(settings[0].toString(), statistic)) {
+                ui->statisticCombo->setCurrentIndex(static_cast<int>(statistic));
+                ui->statisticThresholdEdit->setText(settings[1].toString());
+                ui->statisticWindowSpin->setValue(settings[2].toDouble());
+            }
+            break;
+        }
         default:
             break;
     }
     
+    // Устанавливаем настройки подавления дребезга
+    const ConditionFilter filter = parameter->getFilter();
+    ui->hysteresisSpin->setValue(filter.hysteresis);
+    ui->entrySamplesSpin->setValue(filter.entrySamples);
+    ui->entrySecondsSpin->setValue(filter.entrySeconds);
+    ui->exitSamplesSpin->setValue(filter.exitSamples);
+    ui->exitSecondsSpin->setValue(filter.exitSeconds);
+    
     // Обновляем состояние элементов управления
     updateControlsState();
 }
@@ -6,6 +6,7 @@ ParameterTableModel::ParameterTableModel(const std::shared_ptr<ParameterModel>&
                                         QObject* parent)
     : QAbstractTableModel(parent)
     , m_parameterModel(parameterModel)
+    , m_snapshot(parameterModel->snapshot())
 {
     // Загрузка иконок для отображения статуса звука
     m_soundEnabledIcon = QIcon(":/icons/sound_on.png");
@@ -29,7 +30,7 @@ int ParameterTableModel::rowCount(const QModelIndex& parent) const {
         return 0;
     }
     
-    return m_parameterModel->getAllParameters().size();
+    return m_snapshot->rows.size();
 }
 
 int ParameterTableModel::columnCount(const QModelIndex& parent) const {
@@ -42,15 +43,17 @@ int ParameterTableModel::columnCount(const QModelIndex& parent) const {
 
 QVariant ParameterTableModel::data(const QModelIndex& index, int role) const {
     if (!index.isValid() || 
-        index.row() < 0 || 
-        index.row() >= m_parameterModel->getAllParameters().size() || 
         index.column() < 0 || 
         index.column() >= ColumnCount) {
         return QVariant();
     }
     
-    const auto& parameters = m_parameterModel->getAllParameters();
-    const auto& parameter = parameters[index.row()];
+    // Строки читаются из снимка, закрепленного за моделью: без блокировок
+    // и без обращения к объектам параметров, которые меняет поток опроса
+    if (index.row() < 0 || index.row() >= m_snapshot->rows.size()) {
+        return QVariant();
+    }
+    const ParameterRow& parameter = m_snapshot->rows[index.row()];
     
     switch (role) {
         case Qt::DisplayRole: {
@@ -60,10 +63,10 @@ QVariant ParameterTableModel::data(const QModelIndex& index, int role) const {
                     return QVariant();
                     
                 case NameColumn:
-                    return parameter->getName();
+                    return parameter.name;
                     
                 case ConditionColumn:
-                    return parameter->getConditionDescription();
+                    return parameter.condition;
                     
                 default:
                     return QVariant();
@@ -73,7 +76,7 @@ QVariant ParameterTableModel::data(const QModelIndex& index, int role) const {
         
         case Qt::DecorationRole: {
             if (index.column() == SoundColumn) {
-                return parameter->isSoundEnabled() ? m_soundEnabledIcon : m_soundDisabledIcon;
+                return parameter.soundEnabled ? m_soundEnabledIcon : m_soundDisabledIcon;
             }
             return QVariant();
         }
@@ -97,27 +100,27 @@ QVariant ParameterTableModel::data(const QModelIndex& index, int role) const {
         
         case Qt::BackgroundRole: {
             // Цвет фона в зависимости от статуса параметра
-            return getStatusColor(parameter->getStatus());
+            return getStatusColor(parameter.status);
         }
         
         case Qt::ForegroundRole: {
             // Цвет текста в зависимости от статуса параметра
-            return parameter->getStatus() == ParameterStatus::Error ? 
+            return parameter.status == ParameterStatus::Error ? 
                    QColor(Qt::white) : QColor(Qt::black);
         }
         
         case Qt::ToolTipRole: {
             // Подсказка с описанием параметра
             QString tooltip = QString("%1\n%2\n\nСтатус: %3\nЗвук: %4")
-                              .arg(parameter->getName())
-                              .arg(parameter->getConditionDescription())
-                              .arg(parameter->getStatus() == ParameterStatus::Error ? 
-                                   "Ошибка" : (parameter->getStatus() == ParameterStatus::Ok ? 
+                              .arg(parameter.name)
+                              .arg(parameter.condition)
+                              .arg(parameter.status == ParameterStatus::Error ? 
+                                   "Ошибка" : (parameter.status == ParameterStatus::Ok ? 
                                               "В норме" : "Неизвестно"))
-                              .arg(parameter->isSoundEnabled() ? "Включен" : "Отключен");
+                              .arg(parameter.soundEnabled ? "Включен" : "Отключен");
             
-            if (!parameter->getDescription().isEmpty()) {
-                tooltip += "\n\nОписание: " + parameter->getDescription();
+            if (!parameter.description.isEmpty()) {
+                tooltip += "\n\nОписание: " + parameter.description;
             }
             
             return tooltip;
@@ -125,7 +128,7 @@ QVariant ParameterTableModel::data(const QModelIndex& index, int role) const {
         
         case Qt::FontRole: {
             // Выделяем текст жирным, если параметр в ошибке
-            if (parameter->getStatus() == ParameterStatus::Error) {
+            if (parameter.status == ParameterStatus::Error) {
                 QFont font;
                 font.setBold(true);
                 return font;
@@ -196,18 +199,19 @@ bool ParameterTableModel::setData(const QModelIndex& index, const QVariant& valu
         return false;
     }
     
-    const auto& parameters = m_parameterModel->getAllParameters();
-    if (index.row() < 0 || index.row() >= parameters.size()) {
+    if (index.row() >= m_snapshot->rows.size()) {
         return false;
     }
-    
-    const auto& parameter = parameters[index.row()];
+    // Копируем ключ: обработчик сигнала модели заменит снимок во время вызова
+    const QString name = m_snapshot->rows[index.row()].name;
+    const ParameterType type = m_snapshot->rows[index.row()].type;
     
     // Меняем состояние звука параметра
     bool enabled = value.toBool();
-    m_parameterModel->updateParameterSound(parameter->getName(), parameter->getType(), enabled);
+    m_parameterModel->updateParameterSound(name, type, enabled);
     
     // Оповещаем о изменении данных
+    updateSnapshot();
     emit dataChanged(index, index, {Qt::DisplayRole, Qt::DecorationRole});
     
     return true;
@@ -219,6 +223,7 @@ void ParameterTableModel::onParameterAdded(const QString& name, ParameterType ty
     
     // Оповещаем о добавлении строки
     beginResetModel();
+    m_snapshot = m_parameterModel->snapshot();
     endResetModel();
 }
 
@@ -228,10 +233,13 @@ void ParameterTableModel::onParameterRemoved(const QString& name, ParameterType
     
     // Оповещаем о удалении строки
     beginResetModel();
+    m_snapshot = m_parameterModel->snapshot();
     endResetModel();
 }
 
 void ParameterTableModel::onParameterUpdated(const QString& name, ParameterType type) {
+    updateSnapshot();
+    
     // Находим индекс параметра
     int row = findParameterIndex(name, type);
     if (row >= 0) {
@@ -243,6 +251,8 @@ void ParameterTableModel::onParameterUpdated(const QString& name, ParameterType
 void ParameterTableModel::onParameterSoundChanged(const QString& name, ParameterType type, bool enabled) {
     Q_UNUSED(enabled);
     
+    updateSnapshot();
+    
     // Находим индекс параметра
     int row = findParameterIndex(name, type);
     if (row >= 0) {
@@ -251,15 +261,51 @@ void ParameterTableModel::onParameterSoundChanged(const QString& name, Parameter
     }
 }
 
-void ParameterTableModel::onParameterStatusChanged(const QString& name, ParameterType type, ParameterStatus status) {
-    Q_UNUSED(status);
+void ParameterTableModel::onTickEvaluated(const TickResultPtr& result) {
+    // Таблица показывает только статусы: такт без переходов не требует перерисовки
+    if (result->transitions.isEmpty()) {
+        return;
+    }
     
-    // Находим индекс параметра
-    int row = findParameterIndex(name, type);
-    if (row >= 0) {
-        // Оповещаем о изменении данных
-        emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+    updateSnapshot();
+    
+    // Переходы упорядочены по строкам: один dataChanged на каждую серию соседних строк,
+    // чтобы две далекие друг от друга строки не перерисовывали всю таблицу между ними
+    const auto& transitions = result->transitions;
+    if (transitions.last().row >= m_snapshot->rows.size()) {
+        return;
+    }
+    int runStart = transitions.first().row;
+    int runEnd = runStart;
+    for (int i = 1; i < transitions.size(); ++i) {
+        const int row = transitions[i].row;
+        if (row > runEnd + 1) {
+            emit dataChanged(index(runStart, 0), index(runEnd, ColumnCount - 1));
+            runStart = row;
+        }
+        runEnd = row;
     }
+    emit dataChanged(index(runStart, 0), index(runEnd, ColumnCount - 1));
+}
+
+void ParameterTableModel::onModelReset() {
+    beginResetModel();
+    m_snapshot = m_parameterModel->snapshot();
+    endResetModel();
+}
+
+void ParameterTableModel::updateSnapshot() {
+    auto snapshot = m_parameterModel->snapshot();
+    
+    // Если число строк разошлось с отображаемым, представлению нужен полный сброс
+    if (snapshot->rows.size() != m_snapshot->rows.size()) {
+        beginResetModel();
+        m_snapshot = std::move(snapshot);
+        endResetModel();
+        return;
+    }
+    
+    m_snapshot = std::move(snapshot);
 }
 
 QColor ParameterTableModel::getStatusColor(ParameterStatus status) const {
@@ -279,15 +325,9 @@ QColor ParameterTableModel::getStatusColor(ParameterStatus status) const {
 }
 
 int ParameterTableModel::findParameterIndex(const QString& name, ParameterType type) const {
-    const auto& parameters = m_parameterModel->getAllParameters();
-    
-    for (int i = 0; i < parameters.size(); ++i) {
-        if (parameters[i]->getName() == name && parameters[i]->getType() == type) {
-            return i;
-        }
-    }
-    
-    return -1;
+    // Строки таблицы совпадают со строками снимка, поэтому используем
+    // хеш-индекс снимка вместо перебора
+    return m_snapshot->indexOf(name, type);
 }
 
 } // namespace ParamControl
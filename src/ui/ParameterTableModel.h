@@ -124,15 +124,19 @@ public slots:
     void onParameterSoundChanged(const QString& name, ParameterType type, bool enabled);
     
     /**
-     * @brief Обработчик изменения статуса параметра
-     * @param name Имя параметра
-     * @param type Тип параметра
-     * @param status Статус параметра
+     * @brief Обработчик завершения такта проверки
+     * @param result Итог такта (изменения статусов и снимок)
      */
-    void onParameterStatusChanged(const QString& name, ParameterType type, ParameterStatus status);
+    void onTickEvaluated(const ParamControl::TickResultPtr& result);
+    
+    /**
+     * @brief Обработчик полной перезагрузки модели параметров
+     */
+    void onModelReset();
 
 private:
     std::shared_ptr<ParameterModel> m_parameterModel;  ///< Модель параметров
+    std::shared_ptr<const ParameterSnapshot> m_snapshot; ///< Отображаемый снимок (обновляется по сигналам модели)
     QIcon m_soundEnabledIcon;                         ///< Иконка включенного звука
     QIcon m_soundDisabledIcon;                        ///< Иконка отключенного звука
 
@@ -143,6 +147,11 @@ private:
      */
     QColor getStatusColor(ParameterStatus status) const;
     
+    /**
+     * @brief Закрепляет за моделью последний опубликованный снимок параметров
+     */
+    void updateSnapshot();
+    
     /**
      * @brief Поиск индекса параметра в модели
      * @param name Имя параметра
@@ -0,0 +1,47 @@
+# Тест векторного ядра проверки пределов: SSE2/AVX2 против скалярной
+# реализации и скомпилированная программа против Parameter::updateValue(),
+# в том числе при параллельной проверке; подтверждение статусов и
+# статистика окон отсчетов против пересчета по всем отсчетам.
+#
+# Сборка и запуск (из корня репозитория):
+#   qmake tests/LimitKernelTest && make && make check
+
+QT += core xml concurrent testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = LimitKernelTest
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    tst_limitkernel.cpp \
+    $$ROOT/src/core/Parameter.cpp \
+    $$ROOT/src/core/ParameterEquals.cpp \
+    $$ROOT/src/core/ParameterNotEquals.cpp \
+    $$ROOT/src/core/ParameterInLimits.cpp \
+    $$ROOT/src/core/ParameterOutOfLimits.cpp \
+    $$ROOT/src/core/ParameterChanged.cpp \
+    $$ROOT/src/core/ParameterExpression.cpp \
+    $$ROOT/src/core/ParameterRateOfChange.cpp \
+    $$ROOT/src/core/ParameterTrend.cpp \
+    $$ROOT/src/core/ParameterStatistic.cpp \
+    $$ROOT/src/core/ConditionProgram.cpp \
+    $$ROOT/src/core/Expression.cpp \
+    $$ROOT/src/core/LimitKernel.cpp \
+    $$ROOT/src/core/WindowStore.cpp \
+    $$ROOT/src/core/HistoryStore.cpp
+
+HEADERS += \
+    $$ROOT/src/core/Parameter.h \
+    $$ROOT/src/core/ConditionProgram.h \
+    $$ROOT/src/core/LimitKernel.h \
+    $$ROOT/src/core/WindowStore.h \
+    $$ROOT/src/core/HistoryStore.h
+
+INCLUDEPATH += $$ROOT/src/core
@@ -0,0 +1,548 @@
+// tests/LimitKernelTest/tst_limitkernel.cpp
+#include <QtTest>
+#include <QScopeGuard>
+#include <QThreadPool>
+#include <QVariantList>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <random>
+
+#include "Parameter.h"
+#include "ConditionProgram.h"
+#include "LimitKernel.h"
+#include "WindowStore.h"
+
+using namespace ParamControl;
+
+namespace {
+
+/**
+ * @brief Реализации ядра, доступные на текущем процессоре.
+ */
+QVector<LimitKernelPath> availablePaths() {
+    QVector<LimitKernelPath> paths = {LimitKernelPath::Scalar};
+    if (LimitKernel::detectedPath() != LimitKernelPath::Scalar) {
+        paths << LimitKernelPath::Sse2;
+    }
+    if (LimitKernel::detectedPath() == LimitKernelPath::Avx2) {
+        paths << LimitKernelPath::Avx2;
+    }
+    return paths;
+}
+
+bool bitSet(const QVector<quint64>& bits, int lane) {
+    return (bits[lane / 64] >> (lane % 64)) & 1;
+}
+
+/**
+ * @brief Случайное значение такта: обычные числа, точные границы, NaN и нечисловые строки.
+ */
+QVariant tickValue(std::mt19937& rng, double lower, double upper) {
+    switch (std::uniform_int_distribution<int>(0, 9)(rng)) {
+        case 0: return QVariant(lower);
+        case 1: return QVariant(upper);
+        case 2: return QVariant(std::numeric_limits<double>::quiet_NaN());
+        case 3: return QVariant(QString("abc"));
+        case 4: return QVariant(QString::number(lower, 'g', 17));
+        default: return QVariant(std::uniform_real_distribution<double>(-150.0, 150.0)(rng));
+    }
+}
+
+/**
+ * @brief Случайное значение такта для правила равенства, неравенства или изменения.
+ */
+QVariant discreteValue(std::mt19937& rng, ParameterType type) {
+    if (type == ParameterType::NotEquals) {
+        return QVariant(QString(rng() % 2 == 0 ? "ВКЛ" : "ВЫКЛ"));
+    }
+    return QVariant(double(rng() % 3));
+}
+
+/**
+ * @brief Окно отсчетов с пересчетом статистики по всем отсчетам - для сверки с WindowStore.
+ */
+struct NaiveWindow {
+    int capacity = 2;
+    qint64 spanMs = 0;
+    std::deque<std::pair<qint64, double>> samples;
+
+    void push(qint64 timeMs, double value) {
+        if (!std::isfinite(value)) {
+            return;
+        }
+        while (spanMs > 0 && !samples.empty() && timeMs - samples.front().first > spanMs) {
+            samples.pop_front();
+        }
+        if (int(samples.size()) == capacity) {
+            samples.pop_front();
+        }
+        samples.emplace_back(timeMs, value);
+    }
+
+    WindowStats stats() const {
+        WindowStats result;
+        result.samples = int(samples.size());
+        if (samples.empty()) {
+            return result;
+        }
+        double sum = 0.0;
+        result.minimum = samples.front().second;
+        result.maximum = samples.front().second;
+        for (const auto& sample : samples) {
+            sum += sample.second;
+            result.minimum = std::min(result.minimum, sample.second);
+            result.maximum = std::max(result.maximum, sample.second);
+        }
+        result.mean = sum / double(samples.size());
+        if (samples.size() >= 2) {
+            double squares = 0.0;
+            for (const auto& sample : samples) {
+                squares += (sample.second - result.mean) * (sample.second - result.mean);
+            }
+            result.stddev = std::sqrt(squares / double(samples.size() - 1));
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Сверка статистики окна с пересчитанной по всем отсчетам.
+ * @param scale Порядок значений (допуск для среднего, минимума и максимума).
+ */
+void compareStats(const WindowStats& actual, const WindowStats& expected, double scale) {
+    QCOMPARE(actual.samples, expected.samples);
+    const auto close = [](double a, double b, double tolerance) {
+        return (std::isnan(a) && std::isnan(b)) || std::fabs(a - b) <= tolerance;
+    };
+    const double tolerance = 1e-9 * std::max(1.0, scale);
+    QVERIFY2(close(actual.mean, expected.mean, tolerance),
+             qPrintable(QString("mean %1 != %2").arg(actual.mean, 0, 'g', 17).arg(expected.mean, 0, 'g', 17)));
+    // Дисперсия ведется с удалением вытесненных отсчетов: допуск относительно порядка значений
+    QVERIFY2(close(actual.stddev, expected.stddev, tolerance + 1e-6 * std::max(1.0, expected.stddev)),
+             qPrintable(QString("stddev %1 != %2").arg(actual.stddev, 0, 'g', 17).arg(expected.stddev, 0, 'g', 17)));
+    QVERIFY(close(actual.minimum, expected.minimum, tolerance));
+    QVERIFY(close(actual.maximum, expected.maximum, tolerance));
+}
+
+} // namespace
+
+/**
+ * @brief Проверки LimitKernel, LimitTable и пути пределов ConditionProgram.
+ */
+class LimitKernelTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void kernelPathsMatchScalar_data();
+    void kernelPathsMatchScalar();
+    void tableHysteresisMatchesAcrossPaths();
+    void programMatchesVirtualPath_data();
+    void programMatchesVirtualPath();
+    void expressionDependencyWarnings();
+    void parallelRunIsDeterministic();
+    void filterConfirmsStatus();
+    void windowStatsMatchNaive();
+    void statisticRulesMatchNaive();
+};
+
+void LimitKernelTest::kernelPathsMatchScalar_data() {
+    QTest::addColumn<int>("count");
+
+    // Полные слова, хвост короче слова и хвост короче одной SIMD-итерации
+    QTest::newRow("one") << 1;
+    QTest::newRow("word") << 64;
+    QTest::newRow("word+tail") << 67;
+    QTest::newRow("many") << 1000;
+}
+
+void LimitKernelTest::kernelPathsMatchScalar() {
+    QFETCH(int, count);
+
+    std::mt19937 rng(20240601 + count);
+    std::uniform_real_distribution<double> limit(-100.0, 100.0);
+    std::uniform_real_distribution<double> value(-150.0, 150.0);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    QVector<double> values(count);
+    QVector<double> lower(count);
+    QVector<double> upper(count);
+    for (int i = 0; i < count; ++i) {
+        lower[i] = limit(rng);
+        upper[i] = lower[i] + 20.0;
+        switch (i % 7) {
+            case 0: values[i] = lower[i]; break;
+            case 1: values[i] = upper[i]; break;
+            case 2: values[i] = nan; break;
+            default: values[i] = value(rng); break;
+        }
+    }
+
+    const int words = (count + 63) / 64;
+    QVector<quint64> expected(words, 0);
+    LimitKernel::evaluate(LimitKernelPath::Scalar, values.constData(), lower.constData(),
+                          upper.constData(), count, expected.data());
+
+    for (int i = 0; i < count; ++i) {
+        const bool inside = values[i] >= lower[i] && values[i] <= upper[i];
+        QCOMPARE(bitSet(expected, i), inside);
+    }
+
+    for (LimitKernelPath path : availablePaths()) {
+        QVector<quint64> actual(words, ~quint64(0));
+        LimitKernel::evaluate(path, values.constData(), lower.constData(),
+                              upper.constData(), count, actual.data());
+        for (int i = 0; i < count; ++i) {
+            QVERIFY2(bitSet(actual, i) == bitSet(expected, i),
+                     qPrintable(QString("%1: lane %2").arg(LimitKernel::pathName(path)).arg(i)));
+        }
+    }
+}
+
+void LimitKernelTest::tableHysteresisMatchesAcrossPaths() {
+    const int rows = 131;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> value(-30.0, 30.0);
+
+    // Одинаковые ряды значений проверяются каждой реализацией в своей таблице
+    QVector<QVector<double>> ticks(50, QVector<double>(rows));
+    for (auto& tick : ticks) {
+        for (double& v : tick) {
+            v = value(rng);
+        }
+    }
+
+    QVector<QVector<ParameterStatus>> reference;
+    for (LimitKernelPath path : availablePaths()) {
+        LimitTable table;
+        for (int row = 0; row < rows; ++row) {
+            table.addRow(-10.0, 10.0, row % 3 == 0, ParameterStatus::Unknown, row % 2 ? 2.0 : 0.0);
+        }
+
+        QVector<QVector<ParameterStatus>> statuses;
+        for (const auto& tick : ticks) {
+            table.beginTick();
+            for (int row = 0; row < rows; ++row) {
+                table.setValue(row, tick[row]);
+            }
+            table.evaluate(path);
+
+            QVector<ParameterStatus> status(rows);
+            for (int row = 0; row < rows; ++row) {
+                status[row] = table.status(row);
+            }
+            statuses.append(status);
+        }
+
+        if (reference.isEmpty()) {
+            reference = statuses;
+        } else {
+            QCOMPARE(statuses, reference);
+        }
+    }
+
+    // InLimits [-10, 10] с гистерезисом 2: из Error возврат только внутри [-8, 8]
+    LimitTable table;
+    const int lane = table.addRow(-10.0, 10.0, false, ParameterStatus::Unknown, 2.0);
+    const auto step = [&table, lane](double v) {
+        table.beginTick();
+        table.setValue(lane, v);
+        table.evaluate();
+        return table.status(lane);
+    };
+    QCOMPARE(step(0.0), ParameterStatus::Ok);
+    QCOMPARE(step(10.0), ParameterStatus::Ok);
+    QCOMPARE(step(10.5), ParameterStatus::Error);
+    QCOMPARE(step(9.0), ParameterStatus::Error);
+    QCOMPARE(step(8.0), ParameterStatus::Ok);
+    QVERIFY(table.changedBits()[0] & 1);
+}
+
+void LimitKernelTest::programMatchesVirtualPath_data() {
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("single thread") << 203;
+    QTest::newRow("parallel") << ConditionProgram::kParallelThreshold + 333;
+}
+
+void LimitKernelTest::programMatchesVirtualPath() {
+    QFETCH(int, count);
+
+    std::mt19937 rng(20240602);
+    std::uniform_real_distribution<double> limit(-100.0, 100.0);
+    std::uniform_real_distribution<double> width(5.0, 50.0);
+
+    QVector<std::shared_ptr<Parameter>> parameters;
+    QVector<std::shared_ptr<Parameter>> reference;
+    for (int i = 0; i < count; ++i) {
+        const double lower = limit(rng);
+        QVariantList limits;
+        limits << lower << lower + width(rng);
+        const ParameterType type = (i % 4 == 0) ? ParameterType::OutOfLimits : ParameterType::InLimits;
+        parameters.append(Parameter::create(QString("T%1").arg(i), type, limits));
+        reference.append(Parameter::create(QString("T%1").arg(i), type, limits));
+    }
+
+    auto program = ConditionProgram::compile(parameters);
+    QCOMPARE(program->ruleCount(), count);
+    for (int rule = 0; rule < count; ++rule) {
+        QCOMPARE(program->status(rule), ParameterStatus::Unknown);
+    }
+
+    ConditionProgram::RunResult result;
+    for (int tick = 0; tick < 20; ++tick) {
+        QVector<ParameterValue> values;
+        QVector<int> expectedTransitions;
+        for (int i = 0; i < count; ++i) {
+            // Часть параметров пропускает такт: их правила не проверяются
+            if ((i + tick) % 11 == 0) {
+                continue;
+            }
+            const QVariantList limits = reference[i]->getTargetValue().toList();
+            const QVariant value = tickValue(rng, limits[0].toDouble(), limits[1].toDouble());
+            values.append(ParameterValue{reference[i]->getName(), value});
+            if (reference[i]->updateValue(value)) {
+                expectedTransitions.append(i);
+            }
+        }
+
+        program->loadInputs(values);
+        program->run(result);
+
+        QCOMPARE(result.transitions, expectedTransitions);
+        for (int rule = 0; rule < count; ++rule) {
+            QCOMPARE(program->status(rule), reference[rule]->getStatus());
+        }
+    }
+}
+
+void LimitKernelTest::expressionDependencyWarnings() {
+    QVariantList limits;
+    limits << 0.0 << 10.0;
+    const QVector<std::shared_ptr<Parameter>> parameters = {
+        Parameter::create("T1", ParameterType::InLimits, limits),
+        Parameter::create("T1", ParameterType::Expression, "T2 > 0"),       // Имя совпадает с параметром ТМИ
+        Parameter::create("A", ParameterType::Expression, "T1 > 0"),        // Неоднозначное имя
+        Parameter::create("B", ParameterType::Expression, "A + 1 > 0"),     // Зависит от отключенного
+        Parameter::create("Bad", ParameterType::Expression, "T2 >"),        // Не компилируется
+        Parameter::create("C", ParameterType::Expression, "Bad > 0"),       // Зависит от ошибочного
+        Parameter::create("Cyc1", ParameterType::Expression, "Cyc2 > 0"),
+        Parameter::create("Cyc2", ParameterType::Expression, "Cyc1 > 0"),
+        Parameter::create("G", ParameterType::Expression, "T2 * 2 > 1"),
+    };
+
+    // О цикле сообщается только для правил цикла, для остальных - настоящая причина
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Invalid expression for parameter \"Bad\""));
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Identifier \"T1\" in expression \"A\" names both"));
+    QTest::ignoreMessage(QtWarningMsg,
+                         QRegularExpression("Expression \"B\" depends on disabled expression \"A\""));
+    QTest::ignoreMessage(QtWarningMsg,
+                         QRegularExpression("Expression \"C\" depends on invalid expression \"Bad\""));
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Cyclic dependency in expression \"Cyc1\""));
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Cyclic dependency in expression \"Cyc2\""));
+    auto program = ConditionProgram::compile(parameters);
+
+    // Имя ошибочного выражения не запрашивается у СОТМ как параметр ТМИ
+    QVERIFY(!program->inputNames().contains("Bad"));
+
+    ConditionProgram::RunResult result;
+    program->loadInputs({ParameterValue{"T1", 5.0}, ParameterValue{"T2", 1.0}});
+    program->run(result);
+    std::sort(result.evaluated.begin(), result.evaluated.end());
+    QCOMPARE(result.evaluated, QVector<int>({0, 1, 8}));
+}
+
+void LimitKernelTest::parallelRunIsDeterministic() {
+    const int count = ConditionProgram::kParallelThreshold + 1500;
+    const ParameterType types[] = {ParameterType::InLimits, ParameterType::OutOfLimits, ParameterType::Equals,
+                                   ParameterType::NotEquals, ParameterType::Changed};
+
+    // Три копии правил: программа в одном потоке, программа в нескольких и объекты Parameter
+    QVector<std::shared_ptr<Parameter>> sequentialRules;
+    QVector<std::shared_ptr<Parameter>> parallelRules;
+    QVector<std::shared_ptr<Parameter>> reference;
+    for (int i = 0; i < count; ++i) {
+        const ParameterType type = types[i % 5];
+        QVariant target;
+        if (type == ParameterType::InLimits || type == ParameterType::OutOfLimits) {
+            target = QVariantList{-10.0 - i % 7, 10.0 + i % 5};
+        } else if (type == ParameterType::Equals) {
+            target = double(i % 3);
+        } else if (type == ParameterType::NotEquals) {
+            target = QString("ВКЛ");
+        }
+        const QString name = QString("P%1").arg(i);
+        sequentialRules.append(Parameter::create(name, type, target));
+        parallelRules.append(Parameter::create(name, type, target));
+        reference.append(Parameter::create(name, type, target));
+    }
+    auto sequential = ConditionProgram::compile(sequentialRules);
+    auto parallel = ConditionProgram::compile(parallelRules);
+
+    QThreadPool* pool = QThreadPool::globalInstance();
+    const int threads = pool->maxThreadCount();
+    const auto restoreThreads = qScopeGuard([pool, threads] { pool->setMaxThreadCount(threads); });
+    std::mt19937 rng(20240603);
+    ConditionProgram::RunResult sequentialResult;
+    ConditionProgram::RunResult parallelResult;
+    for (int tick = 0; tick < 30; ++tick) {
+        QVector<ParameterValue> values;
+        QVector<int> expectedTransitions;
+        for (int i = 0; i < count; ++i) {
+            if ((i + tick) % 13 == 0) {
+                continue;
+            }
+            const ParameterType type = reference[i]->getType();
+            const QVariant value = (type == ParameterType::InLimits || type == ParameterType::OutOfLimits)
+                ? tickValue(rng, -10.0, 10.0) : discreteValue(rng, type);
+            values.append(ParameterValue{reference[i]->getName(), value});
+            if (reference[i]->updateValue(value)) {
+                expectedTransitions.append(i);
+            }
+        }
+
+        pool->setMaxThreadCount(1);
+        sequential->loadInputs(values);
+        sequential->run(sequentialResult);
+        pool->setMaxThreadCount(qMax(4, threads));
+        parallel->loadInputs(values);
+        parallel->run(parallelResult);
+
+        // Переходы и проверенные правила - по возрастанию номеров при любом числе потоков
+        QVERIFY(std::is_sorted(parallelResult.evaluated.cbegin(), parallelResult.evaluated.cend()));
+        QCOMPARE(parallelResult.evaluated, sequentialResult.evaluated);
+        QCOMPARE(parallelResult.transitions, sequentialResult.transitions);
+        QCOMPARE(parallelResult.transitions, expectedTransitions);
+        for (int rule = 0; rule < count; ++rule) {
+            QCOMPARE(parallel->status(rule), reference[rule]->getStatus());
+        }
+    }
+}
+
+void LimitKernelTest::filterConfirmsStatus() {
+    // A: подтверждение 3 тактами входа и 2 тактами выхода;
+    // B: гистерезис 2 у выхода за пределы; C: удержание 2 секунды перед Error
+    ConditionFilter samples;
+    samples.entrySamples = 3;
+    samples.exitSamples = 2;
+    ConditionFilter hysteresis;
+    hysteresis.hysteresis = 2.0;
+    ConditionFilter seconds;
+    seconds.entrySeconds = 2.0;
+
+    const QVector<std::shared_ptr<Parameter>> parameters = {
+        Parameter::create("A", ParameterType::InLimits, QVariantList{0.0, 10.0}),
+        Parameter::create("B", ParameterType::OutOfLimits, QVariantList{0.0, 10.0}),
+        Parameter::create("C", ParameterType::Equals, QString("ВКЛ")),
+    };
+    parameters[0]->setFilter(samples);
+    parameters[1]->setFilter(hysteresis);
+    parameters[2]->setFilter(seconds);
+    auto program = ConditionProgram::compile(parameters);
+
+    const ParameterStatus ok = ParameterStatus::Ok;
+    const ParameterStatus error = ParameterStatus::Error;
+    const QVector<double> a = {5, 11, 12, 5, 11, 11, 11, 5, 11, 5, 5};
+    const QVector<ParameterStatus> aStatus = {ok, ok, ok, ok, ok, ok, error, error, error, error, ok};
+    const QVector<double> b = {20, 5, 11, 13, 11, -1, 5, -1, -3, 20, 20};
+    const QVector<ParameterStatus> bStatus = {ok, error, error, ok, ok, ok, error, error, ok, ok, ok};
+    const QStringList c = {"ВКЛ", "ВЫКЛ", "ВЫКЛ", "ВЫКЛ", "ВКЛ", "ВЫКЛ", "ВЫКЛ", "ВКЛ", "ВЫКЛ", "ВЫКЛ", "ВЫКЛ"};
+    const QVector<ParameterStatus> cStatus = {ok, ok, ok, error, ok, ok, ok, ok, ok, ok, error};
+
+    // Такты раз в секунду: время удержания берется из времени такта
+    const qint64 startMs = 1700000000000;
+    ConditionProgram::RunResult result;
+    QVector<ParameterStatus> previous(parameters.size(), ParameterStatus::Unknown);
+    for (int tick = 0; tick < a.size(); ++tick) {
+        program->loadInputs({ParameterValue{"A", a[tick]}, ParameterValue{"B", b[tick]},
+                             ParameterValue{"C", c[tick]}},
+                            startMs + tick * 1000);
+        program->run(result);
+
+        const QVector<ParameterStatus> expected = {aStatus[tick], bStatus[tick], cStatus[tick]};
+        QVector<int> expectedTransitions;
+        for (int rule = 0; rule < expected.size(); ++rule) {
+            QCOMPARE(program->status(rule), expected[rule]);
+            if (expected[rule] != previous[rule]) {
+                expectedTransitions.append(rule);
+            }
+        }
+        QCOMPARE(result.transitions, expectedTransitions);
+        previous = expected;
+    }
+}
+
+void LimitKernelTest::windowStatsMatchNaive() {
+    // Окно по емкости, короткое окно по времени и окно на минуту при опросе раз в секунду
+    WindowStore store;
+    QVector<NaiveWindow> naive = {
+        {16, 0, {}},
+        {64, 5000, {}},
+        {WindowStore::capacityForSpan(60000, 1000), 60000, {}},
+    };
+    for (const NaiveWindow& window : naive) {
+        store.addWindow(window.capacity, window.spanMs);
+    }
+
+    std::mt19937 rng(20240604);
+    std::uniform_int_distribution<int> step(0, 2500);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    qint64 timeMs = 1000;
+    for (int i = 0; i < 20000; ++i) {
+        // Участки с большим смещением значений проверяют перенос опорного значения
+        const double offset = (i / 2000) % 2 == 0 ? 0.0 : 1e6;
+        timeMs += step(rng);
+        double value = offset + 10.0 * noise(rng);
+        if (i % 997 == 0) {
+            value = std::numeric_limits<double>::quiet_NaN();
+        } else if (i % 1999 == 0) {
+            value = std::numeric_limits<double>::infinity();
+        }
+
+        for (int window = 0; window < naive.size(); ++window) {
+            store.push(window, timeMs, value);
+            naive[window].push(timeMs, value);
+            QCOMPARE(store.sampleCount(window), int(naive[window].samples.size()));
+            compareStats(store.stats(window), naive[window].stats(), 1e6);
+        }
+    }
+}
+
+void LimitKernelTest::statisticRulesMatchNaive() {
+    // Окно 10 с при опросе раз в секунду: емкость 12, в окне 11 последних отсчетов
+    const QVector<std::shared_ptr<Parameter>> parameters = {
+        Parameter::create("T", ParameterType::Statistic, QVariantList{"max", 50.0, 10.0}),
+        Parameter::create("T", ParameterType::Statistic, QVariantList{"sigma", 2.0, 10.0}),
+    };
+    auto program = ConditionProgram::compile(parameters, nullptr, nullptr, 1000);
+    QCOMPARE(program->sampleIntervalMs(), 1000);
+    NaiveWindow naive{WindowStore::capacityForSpan(10000, 1000), 10000, {}};
+
+    std::mt19937 rng(20240605);
+    std::normal_distribution<double> noise(40.0, 5.0);
+    const qint64 startMs = 1700000000000;
+    ConditionProgram::RunResult result;
+    for (int tick = 0; tick < 500; ++tick) {
+        const double value = tick % 37 == 0 ? 80.0 : noise(rng);
+        const WindowStats before = naive.stats();
+        naive.push(startMs + tick * 1000, value);
+        const WindowStats after = naive.stats();
+
+        program->loadInputs({ParameterValue{"T", value}}, startMs + tick * 1000);
+        program->run(result);
+
+        // Отклонение сравнивается с окном до добавления значения, максимум - после
+        const bool deviationOk = std::isnan(before.stddev) || std::fabs(value - before.mean) <= 2.0 * before.stddev;
+        QCOMPARE(program->status(0), after.maximum > 50.0 ? ParameterStatus::Error : ParameterStatus::Ok);
+        QCOMPARE(program->status(1), deviationOk ? ParameterStatus::Ok : ParameterStatus::Error);
+        compareStats(program->windowStats(0), after, 100.0);
+        compareStats(program->windowStats(1), after, 100.0);
+    }
+}
+
+QTEST_GUILESS_MAIN(LimitKernelTest)
+
+#include "tst_limitkernel.moc"
@@ -0,0 +1,30 @@
+# Тест кольцевого буфера записей журнала: вытеснение старых записей
+# при переходе через границы участков, снимки и замена последней записи.
+#
+# Сборка и запуск (из корня репозитория):
+#   qmake tests/LogBufferTest && make && make check
+
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = LogBufferTest
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    tst_logbuffer.cpp \
+    $$ROOT/src/core/LogBuffer.cpp \
+    $$ROOT/src/core/LogStringTable.cpp
+
+HEADERS += \
+    $$ROOT/src/core/LogBuffer.h \
+    $$ROOT/src/core/LogEntry.h \
+    $$ROOT/src/core/LogStringTable.h
+
+INCLUDEPATH += $$ROOT/src/core
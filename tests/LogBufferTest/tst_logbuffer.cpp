@@ -0,0 +1,216 @@
+// tests/LogBufferTest/tst_logbuffer.cpp
+#include <QtTest>
+#include <deque>
+#include <random>
+
+#include "LogBuffer.h"
+
+using namespace ParamControl;
+
+namespace {
+
+/**
+ * @brief Запись, опознаваемая по значению.
+ */
+LogEntry numberedEntry(int number) {
+    LogEntry entry;
+    entry.value = QString::number(number);
+    return entry;
+}
+
+/**
+ * @brief Сверка буфера с эталонной очередью номеров записей.
+ */
+void compareWithModel(const LogBuffer& buffer, const std::deque<int>& model, quint64 endSequence) {
+    QCOMPARE(buffer.size(), int(model.size()));
+    QCOMPARE(buffer.isEmpty(), model.empty());
+    QCOMPARE(buffer.endSequence(), endSequence);
+    QCOMPARE(buffer.firstSequence(), endSequence - quint64(model.size()));
+    for (int i = 0; i < buffer.size(); ++i) {
+        QCOMPARE(buffer.at(i).value, QString::number(model[size_t(i)]));
+    }
+}
+
+/**
+ * @brief Сверка снимка с ожидаемыми номерами записей.
+ */
+void compareSnapshot(const LogSnapshot& snapshot, int firstNumber, int size, quint64 firstSequence) {
+    QCOMPARE(snapshot.size(), size);
+    QCOMPARE(snapshot.firstSequence(), firstSequence);
+    QCOMPARE(snapshot.endSequence(), firstSequence + quint64(size));
+    for (int i = 0; i < size; ++i) {
+        QCOMPARE(snapshot.at(i).value, QString::number(firstNumber + i));
+        QCOMPARE(snapshot.indexOf(firstSequence + quint64(i)), i);
+    }
+    QCOMPARE(snapshot.indexOf(firstSequence + quint64(size)), -1);
+    if (firstSequence > 0) {
+        QCOMPARE(snapshot.indexOf(firstSequence - 1), -1);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Проверки LogBuffer и LogSnapshot.
+ */
+class LogBufferTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void wraparoundKeepsNewest_data();
+    void wraparoundKeepsNewest();
+    void randomOperationsMatchModel();
+    void snapshotSurvivesEviction();
+    void replaceLastKeepsSnapshots();
+    void clearContinuesSequence();
+};
+
+void LogBufferTest::wraparoundKeepsNewest_data() {
+    QTest::addColumn<int>("capacity");
+    QTest::addColumn<int>("count");
+
+    // Емкость внутри участка, ровно на границе участка и через несколько участков
+    QTest::newRow("one") << 1 << 10;
+    QTest::newRow("small") << 100 << 1000;
+    QTest::newRow("chunk") << LogBuffer::kChunkSize << 5 * LogBuffer::kChunkSize + 3;
+    QTest::newRow("chunk+1") << LogBuffer::kChunkSize + 1 << 4 * LogBuffer::kChunkSize;
+    QTest::newRow("many chunks") << 1000 << 10000;
+}
+
+void LogBufferTest::wraparoundKeepsNewest() {
+    QFETCH(int, capacity);
+    QFETCH(int, count);
+
+    LogBuffer buffer(capacity);
+    std::deque<int> model;
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(buffer.append(numberedEntry(i)), quint64(i));
+        model.push_back(i);
+        if (int(model.size()) > capacity) {
+            model.pop_front();
+        }
+        QCOMPARE(buffer.size(), int(model.size()));
+        QCOMPARE(buffer.at(0).value, QString::number(model.front()));
+        QCOMPARE(buffer.at(buffer.size() - 1).value, QString::number(i));
+    }
+    compareWithModel(buffer, model, quint64(count));
+}
+
+void LogBufferTest::randomOperationsMatchModel() {
+    std::mt19937 rng(20241003);
+    LogBuffer buffer(300);
+    std::deque<int> model;
+    int capacity = 300;
+    int number = 0;
+    quint64 endSequence = 0;
+
+    for (int step = 0; step < 20000; ++step) {
+        const int operation = std::uniform_int_distribution<int>(0, 99)(rng);
+        if (operation < 90) {
+            buffer.append(numberedEntry(number));
+            model.push_back(number++);
+            ++endSequence;
+            if (int(model.size()) > capacity) {
+                model.pop_front();
+            }
+        } else if (operation < 95 && !model.empty()) {
+            buffer.replaceLast(numberedEntry(number));
+            model.back() = number++;
+        } else if (operation < 99) {
+            capacity = std::uniform_int_distribution<int>(1, 700)(rng);
+            buffer.setCapacity(capacity);
+            QCOMPARE(buffer.capacity(), capacity);
+            while (int(model.size()) > capacity) {
+                model.pop_front();
+            }
+        } else {
+            buffer.clear();
+            model.clear();
+        }
+
+        if (step % 500 == 0) {
+            compareWithModel(buffer, model, endSequence);
+        }
+    }
+    compareWithModel(buffer, model, endSequence);
+}
+
+void LogBufferTest::snapshotSurvivesEviction() {
+    const int capacity = 2 * LogBuffer::kChunkSize;
+    LogBuffer buffer(capacity);
+    for (int i = 0; i < capacity + 10; ++i) {
+        buffer.append(numberedEntry(i));
+    }
+    const LogSnapshot before = buffer.snapshot();
+    compareSnapshot(before, 10, capacity, 10);
+
+    // Новые записи вытесняют все записи снимка; участки снимка не переиспользуются
+    for (int i = capacity + 10; i < 4 * capacity; ++i) {
+        buffer.append(numberedEntry(i));
+    }
+    compareSnapshot(before, 10, capacity, 10);
+    compareSnapshot(buffer.snapshot(), 3 * capacity, capacity, quint64(3 * capacity));
+}
+
+void LogBufferTest::replaceLastKeepsSnapshots() {
+    LogBuffer buffer(LogBuffer::kChunkSize + 5);
+    for (int i = 0; i < 10; ++i) {
+        buffer.append(numberedEntry(i));
+    }
+
+    // Без снимков запись меняется на месте
+    buffer.replaceLast(numberedEntry(100));
+    QCOMPARE(buffer.at(9).value, QString("100"));
+    QCOMPARE(buffer.endSequence(), quint64(10));
+
+    // Снимок видит прежнюю запись, буфер - новую
+    const LogSnapshot before = buffer.snapshot();
+    buffer.replaceLast(numberedEntry(200));
+    QCOMPARE(before.at(9).value, QString("100"));
+    QCOMPARE(buffer.at(9).value, QString("200"));
+    QCOMPARE(before.size(), 10);
+    QCOMPARE(buffer.size(), 10);
+
+    // Запись, добавленная после снимка, снимку не видна и не портит его участок
+    buffer.append(numberedEntry(10));
+    buffer.replaceLast(numberedEntry(300));
+    QCOMPARE(before.size(), 10);
+    QCOMPARE(before.at(9).value, QString("100"));
+    QCOMPARE(buffer.at(10).value, QString("300"));
+    QCOMPARE(buffer.at(9).value, QString("200"));
+
+    // Замена после перехода через границу участка и вытеснения старых записей
+    for (int i = 11; i < LogBuffer::kChunkSize + 20; ++i) {
+        buffer.append(numberedEntry(i));
+    }
+    const LogSnapshot wrapped = buffer.snapshot();
+    buffer.replaceLast(numberedEntry(-1));
+    QCOMPARE(wrapped.at(wrapped.size() - 1).value, QString::number(LogBuffer::kChunkSize + 19));
+    QCOMPARE(buffer.at(buffer.size() - 1).value, QString("-1"));
+    QCOMPARE(buffer.at(0).value, wrapped.at(0).value);
+    QCOMPARE(buffer.firstSequence(), quint64(15));
+}
+
+void LogBufferTest::clearContinuesSequence() {
+    LogBuffer buffer(50);
+    for (int i = 0; i < 70; ++i) {
+        buffer.append(numberedEntry(i));
+    }
+    const LogSnapshot before = buffer.snapshot();
+
+    buffer.clear();
+    QVERIFY(buffer.isEmpty());
+    QCOMPARE(buffer.firstSequence(), quint64(70));
+    QCOMPARE(buffer.endSequence(), quint64(70));
+    QVERIFY(buffer.snapshot().isEmpty());
+    compareSnapshot(before, 20, 50, 20);
+
+    // Порядковые номера продолжаются, снимок до очистки не меняется
+    QCOMPARE(buffer.append(numberedEntry(70)), quint64(70));
+    QCOMPARE(buffer.at(0).value, QString("70"));
+    compareSnapshot(before, 20, 50, 20);
+}
+
+QTEST_GUILESS_MAIN(LogBufferTest)
+
+#include "tst_logbuffer.moc"
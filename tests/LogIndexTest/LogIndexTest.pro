@@ -0,0 +1,32 @@
+# Тест индекса журнала в памяти: запросы по спискам номеров (posting lists)
+# сверяются с последовательным просмотром записей буфера.
+#
+# Сборка и запуск (из корня репозитория):
+#   qmake tests/LogIndexTest && make && make check
+
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = LogIndexTest
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    tst_logindex.cpp \
+    $$ROOT/src/core/LogBuffer.cpp \
+    $$ROOT/src/core/LogIndex.cpp \
+    $$ROOT/src/core/LogStringTable.cpp
+
+HEADERS += \
+    $$ROOT/src/core/LogBuffer.h \
+    $$ROOT/src/core/LogEntry.h \
+    $$ROOT/src/core/LogIndex.h \
+    $$ROOT/src/core/LogStringTable.h
+
+INCLUDEPATH += $$ROOT/src/core
@@ -0,0 +1,223 @@
+// tests/LogIndexTest/tst_logindex.cpp
+#include <QtTest>
+#include <QVector>
+#include <algorithm>
+#include <random>
+
+#include "LogBuffer.h"
+#include "LogIndex.h"
+
+using namespace ParamControl;
+
+namespace {
+
+const qint64 kStartMs = 1700000000000;
+
+/**
+ * @brief Буфер и индекс, заполняемые так же, как в LogManager.
+ */
+struct IndexedLog {
+    LogBuffer buffer;
+    LogIndex index;
+
+    explicit IndexedLog(int capacity) : buffer(capacity) {}
+
+    void append(const LogEntry& entry) {
+        index.append(buffer.append(entry), entry);
+        index.evictBefore(buffer.firstSequence());
+    }
+
+    /**
+     * @brief Порядковые номера записей буфера, удовлетворяющих запросу (последовательный просмотр).
+     */
+    QVector<quint64> scan(const LogQuery& query, quint64 fromSequence = 0) const {
+        QVector<quint64> rows;
+        for (int i = 0; i < buffer.size(); ++i) {
+            const quint64 sequence = buffer.firstSequence() + quint64(i);
+            if (sequence >= fromSequence && query.matches(buffer.at(i))) {
+                rows.append(sequence);
+            }
+        }
+        return rows;
+    }
+};
+
+LogEntry makeEntry(qint64 timestampMs, const QString& category, LogLevel level, LogStatus status) {
+    LogEntry entry;
+    entry.timestamp = QDateTime::fromMSecsSinceEpoch(timestampMs);
+    entry.level = level;
+    entry.status = status;
+    entry.setCategory(category);
+    entry.setText("Событие");
+    return entry;
+}
+
+/**
+ * @brief Случайная запись: категории с разной частотой, ошибки реже, время не убывает.
+ */
+LogEntry randomEntry(std::mt19937& rng, qint64& timestampMs) {
+    timestampMs += std::uniform_int_distribution<int>(0, 3)(rng) * 250;
+    const int category = std::min(std::geometric_distribution<int>(0.4)(rng), 7);
+    const bool error = std::uniform_int_distribution<int>(0, 9)(rng) == 0;
+    return makeEntry(timestampMs, QString("ИНД%1").arg(category),
+                     error ? LogLevel::Error : LogLevel::Info,
+                     error || std::uniform_int_distribution<int>(0, 19)(rng) == 0 ? LogStatus::Error
+                                                                                 : LogStatus::Normal);
+}
+
+/**
+ * @brief Случайный запрос: каждое условие задано или нет.
+ */
+LogQuery randomQuery(std::mt19937& rng, qint64 firstMs, qint64 lastMs) {
+    LogQuery query;
+    std::uniform_int_distribution<qint64> time(firstMs - 1000, lastMs + 1000);
+    if (rng() % 2) {
+        query.fromMs = time(rng);
+    }
+    if (rng() % 2) {
+        query.toMs = time(rng);
+    }
+    const int categories = int(rng() % 4);
+    for (int i = 0; i < categories; ++i) {
+        // ИНД9 в журнал не попадает
+        query.categories.append(LogStringTable::categories().intern(QString("ИНД%1").arg(rng() % 10)));
+    }
+    query.level = int(rng() % 3) - 1;
+    query.status = int(rng() % 3) - 1;
+    return query;
+}
+
+} // namespace
+
+/**
+ * @brief Проверки LogIndex против последовательного просмотра LogBuffer.
+ */
+class LogIndexTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void queryMatchesScan_data();
+    void queryMatchesScan();
+    void queryStartsAtSequence();
+    void clockSetBack();
+    void clearKeepsSequences();
+};
+
+void LogIndexTest::queryMatchesScan_data() {
+    QTest::addColumn<int>("capacity");
+    QTest::addColumn<int>("entries");
+
+    QTest::newRow("not full") << 5000 << 3000;
+    QTest::newRow("evicted") << 700 << 5000;
+    QTest::newRow("one entry") << 1 << 10;
+}
+
+void LogIndexTest::queryMatchesScan() {
+    QFETCH(int, capacity);
+    QFETCH(int, entries);
+
+    std::mt19937 rng(20240901 + capacity);
+    IndexedLog log(capacity);
+    qint64 timestampMs = kStartMs;
+    for (int i = 0; i < entries; ++i) {
+        log.append(randomEntry(rng, timestampMs));
+    }
+    QCOMPARE(log.buffer.size(), qMin(capacity, entries));
+
+    // Запрос без условий и по одному условию
+    QCOMPARE(log.index.query(LogQuery()), log.scan(LogQuery()));
+    LogQuery errors;
+    errors.level = int(LogLevel::Error);
+    QCOMPARE(log.index.query(errors), log.scan(errors));
+
+    const qint64 firstMs = log.buffer.at(0).timestamp.toMSecsSinceEpoch();
+    for (int i = 0; i < 500; ++i) {
+        const LogQuery query = randomQuery(rng, firstMs, timestampMs);
+        QCOMPARE(log.index.query(query), log.scan(query));
+    }
+}
+
+void LogIndexTest::queryStartsAtSequence() {
+    std::mt19937 rng(20240902);
+    IndexedLog log(1000);
+    qint64 timestampMs = kStartMs;
+    for (int i = 0; i < 1500; ++i) {
+        log.append(randomEntry(rng, timestampMs));
+    }
+
+    // Номера до начала буфера, внутри и после конца
+    const quint64 first = log.buffer.firstSequence();
+    for (quint64 fromSequence : {quint64(0), first, first + 1, first + 999, first + 1000, first + 5000}) {
+        for (int i = 0; i < 50; ++i) {
+            const LogQuery query = randomQuery(rng, kStartMs, timestampMs);
+            QCOMPARE(log.index.query(query, fromSequence), log.scan(query, fromSequence));
+        }
+    }
+}
+
+void LogIndexTest::clockSetBack() {
+    IndexedLog log(100);
+    const QString category = "ЧАСЫ";
+    log.append(makeEntry(kStartMs + 1000, category, LogLevel::Info, LogStatus::Normal));
+    log.append(makeEntry(kStartMs + 2000, category, LogLevel::Error, LogStatus::Error));
+    log.append(makeEntry(kStartMs + 500, category, LogLevel::Info, LogStatus::Normal));
+    log.append(makeEntry(kStartMs + 3000, category, LogLevel::Info, LogStatus::Normal));
+
+    // Запись после перевода часов находится, а интервал по-прежнему проверяется по ее времени
+    LogQuery query;
+    query.fromMs = kStartMs;
+    query.toMs = kStartMs + 2500;
+    QCOMPARE(log.index.query(query), QVector<quint64>({0, 1, 2}));
+    query.fromMs = kStartMs + 1500;
+    QCOMPARE(log.index.query(query), QVector<quint64>({1}));
+    query.fromMs = kStartMs + 2500;
+    query.toMs = kStartMs + 3000;
+    QCOMPARE(log.index.query(query), QVector<quint64>({3}));
+    query.fromMs = kStartMs + 3500;
+    query.toMs = kStartMs + 2500;
+    QVERIFY(log.index.query(query).isEmpty());
+
+    // Интервал раньше всех записей до перевода часов: находится только запись после него
+    query.fromMs = kStartMs + 400;
+    query.toMs = kStartMs + 600;
+    QCOMPARE(log.index.query(query), QVector<quint64>({2}));
+    query.toMs = kStartMs + 1000;
+    QCOMPARE(log.index.query(query), QVector<quint64>({0, 2}));
+
+    // Случайные переводы часов назад против последовательного просмотра
+    std::mt19937 rng(20240903);
+    IndexedLog stepped(700);
+    qint64 timestampMs = kStartMs;
+    for (int i = 0; i < 3000; ++i) {
+        if (i % 97 == 0) {
+            timestampMs -= std::uniform_int_distribution<int>(0, 120)(rng) * 1000;
+        }
+        stepped.append(randomEntry(rng, timestampMs));
+    }
+    for (int i = 0; i < 300; ++i) {
+        const LogQuery random = randomQuery(rng, kStartMs - 120000, timestampMs);
+        QCOMPARE(stepped.index.query(random), stepped.scan(random));
+    }
+}
+
+void LogIndexTest::clearKeepsSequences() {
+    IndexedLog log(10);
+    for (int i = 0; i < 25; ++i) {
+        log.append(makeEntry(kStartMs + i, "ОЧИСТКА", LogLevel::Info, LogStatus::Normal));
+    }
+    QCOMPARE(log.index.query(LogQuery()).first(), quint64(15));
+
+    // После очистки номера продолжают расти, а категория без записей не выдается
+    log.buffer.clear();
+    log.index.clear();
+    QVERIFY(log.index.query(LogQuery()).isEmpty());
+    QVERIFY(!log.index.categories().contains("ОЧИСТКА"));
+
+    log.append(makeEntry(kStartMs + 100, "ОЧИСТКА2", LogLevel::Error, LogStatus::Error));
+    QCOMPARE(log.index.query(LogQuery()), QVector<quint64>({25}));
+    QCOMPARE(log.index.categories(), QStringList({"ОЧИСТКА2"}));
+}
+
+QTEST_GUILESS_MAIN(LogIndexTest)
+
+#include "tst_logindex.moc"
@@ -0,0 +1,42 @@
+# Тест двоичного журнала событий: формат записей, отбрасывание оборванной
+# записи, чтение сегментов (в том числе сжатых), запись через LogManager
+# и ротация сегментов по размеру со сжатием и сроком хранения.
+#
+# Сборка и запуск (из корня репозитория):
+#   qmake tests/LogJournalTest && make && make check
+
+QT += core concurrent testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = LogJournalTest
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    tst_logjournal.cpp \
+    $$ROOT/src/core/LogBuffer.cpp \
+    $$ROOT/src/core/LogIndex.cpp \
+    $$ROOT/src/core/LogJournalCursor.cpp \
+    $$ROOT/src/core/LogJournalReader.cpp \
+    $$ROOT/src/core/LogManager.cpp \
+    $$ROOT/src/core/LogStringTable.cpp
+
+HEADERS += \
+    $$PWD/../common/LogJournalTestUtils.h \
+    $$ROOT/src/core/BinaryFormat.h \
+    $$ROOT/src/core/LogBuffer.h \
+    $$ROOT/src/core/LogEntry.h \
+    $$ROOT/src/core/LogIndex.h \
+    $$ROOT/src/core/LogJournalCursor.h \
+    $$ROOT/src/core/LogJournalFormat.h \
+    $$ROOT/src/core/LogJournalReader.h \
+    $$ROOT/src/core/LogManager.h \
+    $$ROOT/src/core/LogStringTable.h
+
+INCLUDEPATH += $$ROOT/src/core $$PWD/../common
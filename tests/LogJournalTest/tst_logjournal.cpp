@@ -0,0 +1,682 @@
+// tests/LogJournalTest/tst_logjournal.cpp
+#include <QtTest>
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include "LogJournalFormat.h"
+#include "LogJournalReader.h"
+#include "LogManager.h"
+#include "LogStringTable.h"
+#include "LogJournalTestUtils.h"
+
+using namespace ParamControl;
+using namespace LogJournalTestUtils;
+
+namespace {
+
+/// Время первого события сегментов, собранных тестом.
+const qint64 kStartMs = QDateTime(QDate(2025, 10, 1), QTime(12, 0)).toMSecsSinceEpoch();
+
+LogEntry textEntry(qint64 timestampMs, LogLevel level, const QString& category, const QString& text,
+                   const QString& value, LogStatus status) {
+    LogEntry entry;
+    entry.timestamp = QDateTime::fromMSecsSinceEpoch(timestampMs);
+    entry.level = level;
+    entry.setCategory(category);
+    entry.setText(text);
+    entry.value = value;
+    entry.status = status;
+    return entry;
+}
+
+/**
+ * @brief Записи для сегментов: сообщения с '|' и кириллицей, пустое значение.
+ */
+QVector<LogEntry> sampleEntries() {
+    return {
+        textEntry(kStartMs, LogLevel::Info, "Система", "Запуск программы", "", LogStatus::Normal),
+        textEntry(kStartMs + 1000, LogLevel::Error, "ТЕМП1", "Выход | за пределы", "42.5", LogStatus::Error),
+        textEntry(kStartMs + 2000, LogLevel::Info, "ТЕМП1", "Возврат в норму", "20", LogStatus::Normal),
+    };
+}
+
+void compareEntries(const QVector<LogEntry>& actual, const QVector<LogEntry>& expected) {
+    QCOMPARE(actual.size(), expected.size());
+    for (int i = 0; i < actual.size(); ++i) {
+        QCOMPARE(actual[i].timestamp, expected[i].timestamp);
+        QCOMPARE(actual[i].level, expected[i].level);
+        QCOMPARE(actual[i].category(), expected[i].category());
+        QCOMPARE(actual[i].message(), expected[i].message());
+        QCOMPARE(actual[i].value, expected[i].value);
+        QCOMPARE(actual[i].status, expected[i].status);
+        QCOMPARE(actual[i].repeatCount, expected[i].repeatCount);
+    }
+}
+
+/**
+ * @brief Число записей в сегменте на диске (вместе с замененными записями серий).
+ */
+int recordCount(const QString& segmentPath) {
+    QFile file(segmentPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QByteArray segment = file.readAll();
+    const uchar* data = reinterpret_cast<const uchar*>(segment.constData());
+    int count = 0;
+    qint64 position = kLogJournalHeaderBytes;
+    for (qint64 bytes; (bytes = logJournalRecordAt(data, segment.size(), position)) >= 0; ++count) {
+        position += kLogJournalFrameBytes + bytes;
+    }
+    return count;
+}
+
+QVector<LogEntry> readAll(const LogJournalReader& reader, const QString& segmentPath) {
+    QVector<LogEntry> entries;
+    reader.readSegment(segmentPath, [&entries](const LogEntry& entry) {
+        entries.append(entry);
+        return true;
+    });
+    return entries;
+}
+
+/// Записей в одном сегменте теста ротации (сегмент - 1 МиБ, запись - около 100 КБ).
+constexpr int kEntriesPerSegment = 10;
+
+/**
+ * @brief Пишет записи "Событие first" ... "Событие end - 1" со значением около 100 КБ.
+ *
+ * После записи ждет несколько миллисекунд: время закрытия входит в имя сегмента,
+ * и соседние сегменты не должны закрыться в одну миллисекунду.
+ */
+void logLargeEvents(LogManager& manager, int first, int end) {
+    const QString value(100000, QChar('y'));
+    for (int i = first; i < end; ++i) {
+        manager.log(LogLevel::Info, "ЗАПОЛНЕНИЕ", QString("Событие %1").arg(i), value);
+    }
+    manager.flush();
+    QThread::msleep(5);
+}
+
+/**
+ * @brief Сегменты на диске: closedCount сжатых закрытых сегментов и текущий.
+ */
+void compareSegments(const QString& logFile, int closedCount) {
+    const QStringList segments = LogJournalReader(logFile).segmentFiles();
+    QCOMPARE(segments.size(), closedCount + 1);
+    for (int i = 0; i < closedCount; ++i) {
+        QVERIFY2(segments[i].endsWith(kLogCompressedSuffix), qPrintable(segments[i]));
+    }
+    QCOMPARE(segments.last(), LogJournalReader::journalPath(logFile));
+
+    // Несжатых закрытых сегментов и недописанных сжатых не осталось
+    const QDir dir = QFileInfo(logFile).absoluteDir();
+    const QString pattern = LogJournalReader::segmentPattern(logFile);
+    QVERIFY(dir.entryList({pattern, pattern + kLogCompressedSuffix + ".part"}, QDir::Files).isEmpty());
+}
+
+/**
+ * @brief Журнал содержит записи "Событие first" ... "Событие end - 1" по порядку.
+ */
+void compareLargeEvents(const QVector<LogEntry>& entries, int first, int end) {
+    QCOMPARE(entries.size(), end - first);
+    for (int i = 0; i < entries.size(); ++i) {
+        QCOMPARE(entries[i].message(), QString("Событие %1").arg(first + i));
+        QCOMPARE(entries[i].value.size(), 100000);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Проверки формата и чтения двоичного журнала событий.
+ */
+class LogJournalTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void eventRoundTrip();
+    void headerChecksVersion();
+    void validEndDropsTornRecord();
+    void readerReadsSegment();
+    void readerReadsCompressedSegments();
+    void managerWritesJournal();
+    void managerTruncatesTornRecord();
+    void managerCoalescesRepeats();
+    void repeatRunContinuesAfterFlush();
+    void repeatRunStaysInFullSegment();
+    void managerRotatesBySize();
+    void managerReadsTextTail_data();
+    void managerReadsTextTail();
+    void formatRecordsSpans_data();
+    void formatRecordsSpans();
+    void templatedEventRoundTrip();
+    void unknownTemplateFallsBackToText();
+    void managerWritesTemplates();
+};
+
+void LogJournalTest::eventRoundTrip() {
+    const LogEntry entry = sampleEntries().at(1);
+    QByteArray record;
+    logJournalPutEvent(record, entry, 7, 0);
+
+    const uchar* data = reinterpret_cast<const uchar*>(record.constData());
+    const qint64 bytes = logJournalRecordAt(data, record.size(), 0);
+    QCOMPARE(bytes + kLogJournalFrameBytes, qint64(record.size()));
+
+    LogJournalEvent event;
+    QVERIFY(logJournalReadEvent(data + 4, quint32(bytes), event));
+    QCOMPARE(event.timestampMs, entry.timestamp.toMSecsSinceEpoch());
+    QCOMPARE(event.categoryId, quint32(7));
+    QCOMPARE(event.level, LogLevel::Error);
+    QCOMPARE(event.status, LogStatus::Error);
+    QCOMPARE(QString::fromUtf8(event.message, event.messageBytes), QString("Выход | за пределы"));
+    QCOMPARE(QString::fromUtf8(event.value, event.valueBytes), QString("42.5"));
+    QCOMPARE(event.repeatCount, quint32(1));
+    QVERIFY(!event.supersedes);
+    QVERIFY(!event.templated);
+    QVERIFY(!logJournalSupersedes(data + 4));
+
+    // Длина, не совпадающая с содержимым, - признак поврежденных данных
+    QVERIFY(!logJournalReadEvent(data + 4, quint32(bytes) - 1, event));
+    QVERIFY(!logJournalReadEvent(data + 4, kLogJournalEventFixedBytes, event));
+
+    qint64 startMs = 0;
+    const QByteArray header = logJournalHeader(kStartMs);
+    QVERIFY(logJournalReadHeader(reinterpret_cast<const uchar*>(header.constData()), header.size(), startMs));
+    QCOMPARE(startMs, kStartMs);
+    QVERIFY(!logJournalReadHeader(data, record.size(), startMs));
+}
+
+void LogJournalTest::headerChecksVersion() {
+    QByteArray header = logJournalHeader(kStartMs);
+    qint64 startMs = 0;
+    QVERIFY(logJournalReadHeader(reinterpret_cast<const uchar*>(header.constData()), header.size(), startMs));
+    QCOMPARE(startMs, kStartMs);
+
+    // Старые версии читаются, сегмент более новой версии - нет
+    for (quint16 version : {kLogJournalMinVersion, quint16(kLogJournalVersion + 1)}) {
+        QByteArray patched;
+        archivePut<quint16>(patched, version);
+        header.replace(4, 2, patched);
+        QCOMPARE(logJournalReadHeader(reinterpret_cast<const uchar*>(header.constData()), header.size(), startMs),
+                 version <= kLogJournalVersion);
+    }
+}
+
+void LogJournalTest::validEndDropsTornRecord() {
+    const QStringList categories = {"Система", "ТЕМП1"};
+    const QByteArray segment = buildSegment(sampleEntries(), categories);
+    const uchar* data = reinterpret_cast<const uchar*>(segment.constData());
+
+    // Конец второй записи - по длине в конце последней записи
+    const quint32 lastBytes = archiveGet<quint32>(data + segment.size() - 4);
+    const qint64 secondEnd = segment.size() - kLogJournalFrameBytes - lastBytes;
+
+    QCOMPARE(logJournalValidEnd(data, segment.size()), qint64(segment.size()));
+    QCOMPARE(logJournalValidEnd(data, kLogJournalHeaderBytes), qint64(kLogJournalHeaderBytes));
+    QCOMPARE(logJournalValidEnd(data, kLogJournalHeaderBytes - 1), qint64(0));
+
+    // Запись, оборванная на любом байте, отбрасывается целиком
+    for (qint64 size = secondEnd + 1; size < segment.size(); ++size) {
+        QCOMPARE(logJournalValidEnd(data, size), secondEnd);
+    }
+
+    // Испорченная длина в конце записи: целые записи ищутся с начала
+    QByteArray corrupted = segment;
+    corrupted[corrupted.size() - 1] = char(0x7f);
+    QCOMPARE(logJournalValidEnd(reinterpret_cast<const uchar*>(corrupted.constData()), corrupted.size()),
+             secondEnd);
+}
+
+void LogJournalTest::readerReadsSegment() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+    const QStringList categories = {"Система", "ТЕМП1"};
+    const QVector<LogEntry> entries = sampleEntries();
+
+    writeDictionary(LogJournalReader::categoriesPath(logFile), categories);
+    const QByteArray segment = buildSegment(entries, categories);
+    writeFile(LogJournalReader::journalPath(logFile), segment);
+
+    {
+        const LogJournalReader reader(logFile);
+        QCOMPARE(reader.categories(), categories);
+        QCOMPARE(reader.segmentFiles(), QStringList({LogJournalReader::journalPath(logFile)}));
+        compareEntries(readAll(reader, LogJournalReader::journalPath(logFile)), entries);
+        compareEntries(reader.tail(2), entries.mid(1));
+        compareEntries(reader.tail(10), entries);
+    }
+
+    // Оборванная запись в конце сегмента не читается ни с начала, ни с конца
+    writeFile(LogJournalReader::journalPath(logFile), segment + segment.mid(kLogJournalHeaderBytes, 11));
+    const LogJournalReader reader(logFile);
+    compareEntries(readAll(reader, LogJournalReader::journalPath(logFile)), entries);
+    compareEntries(reader.tail(10), entries);
+
+    QBuffer text;
+    QVERIFY(text.open(QIODevice::WriteOnly));
+    QCOMPARE(reader.exportText(text, kStartMs + 1000, kStartMs + 2000), qint64(2));
+    const QString exported = QString::fromUtf8(text.data());
+    QVERIFY(exported.contains(" | ERROR | ТЕМП1 | Выход | за пределы | 42.5 | Error"));
+    QVERIFY(!exported.contains("Запуск программы"));
+}
+
+void LogJournalTest::readerReadsCompressedSegments() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+    const QStringList categories = {"Система", "ТЕМП1"};
+    const QVector<LogEntry> entries = sampleEntries();
+    writeDictionary(LogJournalReader::categoriesPath(logFile), categories);
+
+    // Закрытый сжатый сегмент, закрытый несжатый сегмент и текущий
+    const QDateTime firstClosed = QDateTime::fromMSecsSinceEpoch(kStartMs + 1500);
+    const QDateTime secondClosed = QDateTime::fromMSecsSinceEpoch(kStartMs + 2500);
+    const QString compressed = LogJournalReader::closedSegmentPath(logFile, firstClosed) + kLogCompressedSuffix;
+    const QString closed = LogJournalReader::closedSegmentPath(logFile, secondClosed);
+    writeFile(compressed, qCompress(buildSegment(entries.mid(0, 2), categories)));
+    writeFile(closed, buildSegment(entries.mid(2), categories));
+    writeFile(LogJournalReader::journalPath(logFile), logJournalHeader(kStartMs));
+
+    const LogJournalReader reader(logFile);
+    const QStringList segments = reader.segmentFiles();
+    QCOMPARE(segments, QStringList({QFileInfo(compressed).absoluteFilePath(), QFileInfo(closed).absoluteFilePath(),
+                                    LogJournalReader::journalPath(logFile)}));
+    QCOMPARE(LogJournalReader::segmentClosedAt(logFile, compressed), firstClosed);
+    QVERIFY(!LogJournalReader::segmentClosedAt(logFile, LogJournalReader::journalPath(logFile)).isValid());
+
+    compareEntries(readAll(reader, segments[0]), entries.mid(0, 2));
+    compareEntries(readAll(reader, segments[1]), entries.mid(2));
+    QVERIFY(readAll(reader, segments[2]).isEmpty());
+    QVERIFY(reader.tail(10).isEmpty());
+
+    // Сегмент, закрытый до начала интервала, пропускается целиком
+    QBuffer text;
+    QVERIFY(text.open(QIODevice::WriteOnly));
+    QCOMPARE(reader.exportText(text, kStartMs + 2000, kStartMs + 3000), qint64(1));
+    QBuffer all;
+    QVERIFY(all.open(QIODevice::WriteOnly));
+    QCOMPARE(reader.exportText(all, 0, kStartMs + 3000), qint64(3));
+}
+
+void LogJournalTest::managerWritesJournal() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+
+    {
+        LogManager manager;
+        QVERIFY(manager.initialize(logFile, 100));
+        manager.log(LogLevel::Info, "Система", "Запуск программы");
+        manager.log(LogLevel::Error, "ТЕМП1", "Выход | за пределы", "42.5", LogStatus::Error);
+        manager.flush();
+
+        const LogJournalReader reader(logFile);
+        compareEntries(readAll(reader, LogJournalReader::journalPath(logFile)), manager.getAllEntries());
+    }
+
+    // Новый сеанс загружает последние записи из конца сегмента
+    LogManager manager;
+    QVERIFY(manager.initialize(logFile, 1));
+    const QVector<LogEntry> loaded = manager.getAllEntries();
+    QCOMPARE(loaded.size(), 1);
+    QCOMPARE(loaded.first().message(), QString("Выход | за пределы"));
+    QCOMPARE(loaded.first().category(), QString("ТЕМП1"));
+}
+
+void LogJournalTest::managerTruncatesTornRecord() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+    const QString journal = LogJournalReader::journalPath(logFile);
+
+    {
+        LogManager manager;
+        QVERIFY(manager.initialize(logFile, 100));
+        manager.log(LogLevel::Info, "Система", "Запуск программы");
+        manager.flush();
+    }
+
+    // Авария посреди записи: следующий сеанс отбрасывает ее и пишет за целыми записями
+    QFile file(journal);
+    QVERIFY(file.open(QIODevice::Append));
+    file.write(QByteArray("\x40\x00\x00\x00torn", 8));
+    file.close();
+
+    LogManager manager;
+    QVERIFY(manager.initialize(logFile, 100));
+    QCOMPARE(manager.getAllEntries().size(), 1);
+    manager.log(LogLevel::Info, "Система", "Остановка программы");
+    manager.flush();
+
+    const QVector<LogEntry> entries = readAll(LogJournalReader(logFile), journal);
+    QCOMPARE(entries.size(), 2);
+    QCOMPARE(entries[0].message(), QString("Запуск программы"));
+    QCOMPARE(entries[1].message(), QString("Остановка программы"));
+}
+
+void LogJournalTest::managerCoalescesRepeats() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+    const QString journal = LogJournalReader::journalPath(logFile);
+
+    LogManager manager;
+    QVERIFY(manager.initialize(logFile, 100));
+    for (int i = 0; i < 3; ++i) {
+        manager.log(LogLevel::Error, "ТЕМП1", "Выход за пределы", "42.5", LogStatus::Error);
+    }
+    manager.log(LogLevel::Info, "ТЕМП1", "Возврат в норму", "20");
+    manager.flush();
+
+    // На диске первое событие серии и заменяющая его запись серии, в журнале - одна запись
+    QCOMPARE(recordCount(journal), 3);
+    const QVector<LogEntry> entries = manager.getAllEntries();
+    QCOMPARE(entries.size(), 2);
+    QCOMPARE(entries[0].repeatCount, 3);
+    QCOMPARE(entries[1].repeatCount, 1);
+
+    const LogJournalReader reader(logFile);
+    compareEntries(readAll(reader, journal), entries);
+    compareEntries(reader.tail(10), entries);
+    compareEntries(reader.tail(1), entries.mid(1));
+
+    QBuffer text;
+    QVERIFY(text.open(QIODevice::WriteOnly));
+    QCOMPARE(reader.exportText(text, 0, QDateTime::currentMSecsSinceEpoch() + 1000), qint64(2));
+    QVERIFY(QString::fromUtf8(text.data()).contains("Выход за пределы (повторов: 3, последний "));
+
+    // Без объединения каждое событие - отдельная запись
+    manager.setCoalesceRepeats(false);
+    manager.log(LogLevel::Info, "ТЕМП1", "Возврат в норму", "20");
+    manager.log(LogLevel::Info, "ТЕМП1", "Возврат в норму", "20");
+    manager.flush();
+    QCOMPARE(recordCount(journal), 5);
+    QCOMPARE(manager.getAllEntries().size(), 4);
+    QCOMPARE(readAll(reader, journal).size(), 4);
+}
+
+void LogJournalTest::repeatRunContinuesAfterFlush() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+    const QString journal = LogJournalReader::journalPath(logFile);
+
+    LogManager manager;
+    QVERIFY(manager.initialize(logFile, 100));
+    manager.log(LogLevel::Error, "ТЕМП1", "Выход за пределы", "42.5", LogStatus::Error);
+    manager.log(LogLevel::Error, "ТЕМП1", "Выход за пределы", "42.5", LogStatus::Error);
+    manager.flush();
+
+    // Сброс записывает незаконченную серию, но не прерывает ее
+    const LogJournalReader reader(logFile);
+    QCOMPARE(reader.tail(10).size(), 1);
+    QCOMPARE(reader.tail(10).first().repeatCount, 2);
+
+    manager.log(LogLevel::Error, "ТЕМП1", "Выход за пределы", "42.5", LogStatus::Error);
+    manager.log(LogLevel::Error, "ТЕМП1", "Выход за пределы", "42.5", LogStatus::Error);
+    manager.flush();
+
+    QCOMPARE(recordCount(journal), 3);
+    QCOMPARE(manager.getAllEntries().size(), 1);
+    QCOMPARE(manager.getAllEntries().first().repeatCount, 4);
+    compareEntries(readAll(reader, journal), manager.getAllEntries());
+    compareEntries(reader.tail(10), manager.getAllEntries());
+
+    // Другое значение заканчивает серию
+    manager.log(LogLevel::Error, "ТЕМП1", "Выход за пределы", "43", LogStatus::Error);
+    manager.flush();
+    QCOMPARE(recordCount(journal), 4);
+    compareEntries(readAll(reader, journal), manager.getAllEntries());
+    QCOMPARE(manager.getAllEntries().size(), 2);
+}
+
+void LogJournalTest::repeatRunStaysInFullSegment() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+    const QString value(40000, QChar('x'));
+
+    {
+        LogManager manager;
+        QVERIFY(manager.initialize(logFile, 100));
+        manager.setSegmentBytes(1024 * 1024);
+
+        // Сегмент почти заполнен: первое событие серии помещается, запись серии - уже нет
+        for (int i = 0; i < 10; ++i) {
+            manager.log(LogLevel::Info, "ЗАПОЛНЕНИЕ", QString("Событие %1").arg(i), QString(100000, QChar('y')));
+        }
+        manager.log(LogLevel::Error, "ТЕМП1", "Выход за пределы", value, LogStatus::Error);
+        manager.flush();
+        QCOMPARE(LogJournalReader(logFile).segmentFiles().size(), 1);
+
+        manager.log(LogLevel::Error, "ТЕМП1", "Выход за пределы", value, LogStatus::Error);
+        manager.flush();
+        QCOMPARE(LogJournalReader(logFile).segmentFiles().size(), 2);
+    } // Деструктор дожидается сжатия закрытого сегмента
+
+    // Запись серии заменила свое первое событие в старом сегменте, а не продублировала его в новом
+    const QVector<LogEntry> entries = LogJournalReader(logFile).tail(100);
+    QCOMPARE(entries.size(), 11);
+    QCOMPARE(entries.last().message(), QString("Выход за пределы"));
+    QCOMPARE(entries.last().repeatCount, 2);
+    QCOMPARE(recordCount(LogJournalReader::journalPath(logFile)), 0);
+}
+
+void LogJournalTest::managerRotatesBySize() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+
+    {
+        LogManager manager;
+        QVERIFY(manager.initialize(logFile, 100));
+        manager.setSegmentBytes(1024 * 1024);
+
+        // Первая запись каждой следующей партии уже не помещается в сегмент
+        for (int round = 0; round < 4; ++round) {
+            logLargeEvents(manager, round * kEntriesPerSegment, (round + 1) * kEntriesPerSegment);
+        }
+    } // Деструктор дожидается сжатия закрытых сегментов
+
+    compareSegments(logFile, 3);
+    const LogJournalReader reader(logFile);
+    const QStringList segments = reader.segmentFiles();
+    for (int i = 0; i < segments.size(); ++i) {
+        compareLargeEvents(readAll(reader, segments[i]), i * kEntriesPerSegment, (i + 1) * kEntriesPerSegment);
+    }
+    compareLargeEvents(reader.tail(100), 0, 4 * kEntriesPerSegment);
+    compareLargeEvents(reader.tail(15), 4 * kEntriesPerSegment - 15, 4 * kEntriesPerSegment);
+
+    // Новый сеанс продолжает заполненный сегмент; лишние закрытые сегменты удаляются
+    {
+        LogManager manager;
+        QVERIFY(manager.initialize(logFile, 100));
+        manager.setSegmentBytes(1024 * 1024);
+        manager.setRetention(0, 2);
+        logLargeEvents(manager, 4 * kEntriesPerSegment, 5 * kEntriesPerSegment);
+    }
+
+    compareSegments(logFile, 2);
+    compareLargeEvents(LogJournalReader(logFile).tail(100), 2 * kEntriesPerSegment, 5 * kEntriesPerSegment);
+
+    // Очистка журнала удаляет и закрытые сегменты
+    LogManager manager;
+    QVERIFY(manager.initialize(logFile, 100));
+    manager.clearLog();
+    compareSegments(logFile, 0);
+    QVERIFY(LogJournalReader(logFile).tail(100).isEmpty());
+}
+
+void LogJournalTest::managerReadsTextTail_data() {
+    QTest::addColumn<int>("entryCount");
+    QTest::addColumn<int>("maxEntries");
+    QTest::addColumn<QString>("lineEnding");
+    QTest::addColumn<bool>("trailingNewline");
+
+    QTest::newRow("tail") << 50 << 10 << "\n" << true;
+    QTest::newRow("tail crlf") << 50 << 10 << "\r\n" << true;
+    QTest::newRow("no trailing newline") << 50 << 10 << "\n" << false;
+    QTest::newRow("crlf no trailing newline") << 50 << 1 << "\r\n" << false;
+    QTest::newRow("whole file") << 50 << 100 << "\n" << true;
+    QTest::newRow("header only") << 0 << 10 << "\n" << true;
+}
+
+void LogJournalTest::managerReadsTextTail() {
+    QFETCH(int, entryCount);
+    QFETCH(int, maxEntries);
+    QFETCH(QString, lineEnding);
+    QFETCH(bool, trailingNewline);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+
+    // Текстовый журнал прежнего формата: заголовок, пустые строки среди записей
+    QVector<LogEntry> entries;
+    QString text = LogJournalReader::textHeader();
+    for (int i = 0; i < entryCount; ++i) {
+        const bool error = i % 7 == 3;
+        entries.append(textEntry(kStartMs + i * 1000, error ? LogLevel::Error : LogLevel::Info,
+                                 i % 2 == 0 ? "ТЕМП1" : "Система", QString("Событие %1").arg(i),
+                                 QString::number(i), error ? LogStatus::Error : LogStatus::Normal));
+        text += LogJournalReader::formatText(entries.last()) + "\n";
+        if (i == entryCount - 3) {
+            text += "\n";
+        }
+    }
+    if (!trailingNewline) {
+        text.chop(1);
+    }
+    text.replace("\n", lineEnding);
+    writeFile(logFile, text.toUtf8());
+
+    // Двоичного журнала нет: последние записи читаются с конца текстового
+    LogManager manager;
+    QVERIFY(manager.initialize(logFile, maxEntries));
+    compareEntries(manager.getAllEntries(), entries.mid(qMax(0, entryCount - maxEntries)));
+}
+
+void LogJournalTest::formatRecordsSpans_data() {
+    QTest::addColumn<QString>("messageTemplate");
+    QTest::addColumn<QStringList>("args");
+    QTest::addColumn<QString>("expected");
+    QTest::addColumn<QVector<int>>("spans");
+
+    QTest::newRow("in order") << "Параметр %1 = %2" << QStringList({"ТЕМП1", "42"})
+                              << "Параметр ТЕМП1 = 42" << QVector<int>({9, 5, 17, 2});
+    QTest::newRow("first occurrence") << "%2 и %1, снова %1" << QStringList({"а", "бв"})
+                                      << "бв и а, снова а" << QVector<int>({5, 1, 0, 2});
+    QTest::newRow("unused argument") << "Значение %1" << QStringList({"1", "2"})
+                                     << "Значение 1" << QVector<int>({9, 1, -1, 0});
+    QTest::newRow("percent in argument") << "%1 из %2" << QStringList({"50%2", "%1"})
+                                         << "50%2 из %1" << QVector<int>({0, 4, 8, 2});
+    QTest::newRow("two digits") << "%10%1" << QStringList({"x"})
+                                << "%10x" << QVector<int>({3, 1});
+    QTest::newRow("no arguments") << "Запуск %1" << QStringList()
+                                  << "Запуск %1" << QVector<int>();
+}
+
+void LogJournalTest::formatRecordsSpans() {
+    QFETCH(QString, messageTemplate);
+    QFETCH(QStringList, args);
+    QFETCH(QString, expected);
+    QFETCH(QVector<int>, spans);
+
+    QVector<int> actual;
+    QCOMPARE(LogStringTable::format(messageTemplate, args, &actual), expected);
+    QCOMPARE(actual, spans);
+    QCOMPARE(LogStringTable::format(messageTemplate, args), expected);
+}
+
+void LogJournalTest::templatedEventRoundTrip() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+    const QString messageTemplate = "Параметр %1 вне пределов: %2";
+    writeDictionary(LogJournalReader::categoriesPath(logFile), {"ТЕМП1"});
+    writeDictionary(LogJournalReader::templatesPath(logFile), {"Запуск программы", messageTemplate});
+
+    // Аргументы с '|' и '%'; третьего места в шаблоне нет
+    LogEntry entry = textEntry(kStartMs, LogLevel::Error, "ТЕМП1", "", "42.5", LogStatus::Error);
+    entry.setMessage(messageTemplate, {"ТЕМП|1", "%1", ""});
+    QByteArray segment = logJournalHeader(kStartMs);
+    logJournalPutEvent(segment, entry, 0, 1);
+
+    const uchar* data = reinterpret_cast<const uchar*>(segment.constData());
+    LogJournalEvent event;
+    const qint64 bytes = logJournalRecordAt(data, segment.size(), kLogJournalHeaderBytes);
+    QVERIFY(logJournalReadEvent(data + kLogJournalHeaderBytes + 4, quint32(bytes), event));
+    QVERIFY(event.templated);
+    QCOMPARE(event.templateId, quint32(1));
+    QCOMPARE(event.argCount, 3);
+    QCOMPARE(QString::fromUtf8(event.message, event.messageBytes), QString("Параметр ТЕМП|1 вне пределов: %1"));
+
+    writeFile(LogJournalReader::journalPath(logFile), segment);
+    const LogJournalReader reader(logFile);
+    const QVector<LogEntry> entries = readAll(reader, LogJournalReader::journalPath(logFile));
+    QCOMPARE(entries.size(), 1);
+    QCOMPARE(entries[0].templateId, LogStringTable::templates().find(messageTemplate));
+    QCOMPARE(entries[0].args, QStringList({"ТЕМП|1", "%1", ""}));
+    QVERIFY(entries[0].sameEvent(entry));
+    compareEntries(reader.tail(1), entries);
+}
+
+void LogJournalTest::unknownTemplateFallsBackToText() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+    writeDictionary(LogJournalReader::categoriesPath(logFile), {"ТЕМП1"});
+
+    // Справочника шаблонов нет: сообщение читается готовым текстом
+    LogEntry entry = textEntry(kStartMs, LogLevel::Info, "ТЕМП1", "", "", LogStatus::Normal);
+    entry.setMessage("Неизвестный шаблон %1", {"7"});
+    QByteArray segment = logJournalHeader(kStartMs);
+    logJournalPutEvent(segment, entry, 0, 5);
+    writeFile(LogJournalReader::journalPath(logFile), segment);
+
+    const LogJournalReader reader(logFile);
+    const QVector<LogEntry> entries = readAll(reader, LogJournalReader::journalPath(logFile));
+    QCOMPARE(entries.size(), 1);
+    QCOMPARE(entries[0].templateId, quint32(0));
+    QCOMPARE(entries[0].message(), QString("Неизвестный шаблон 7"));
+    QCOMPARE(entries[0].category(), QString("ТЕМП1"));
+}
+
+void LogJournalTest::managerWritesTemplates() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+    const QString journal = LogJournalReader::journalPath(logFile);
+    const QString messageTemplate = "Выход %1 за пределы [%2, %3]";
+
+    LogManager manager;
+    QVERIFY(manager.initialize(logFile, 100));
+    manager.logTemplate(LogLevel::Error, "ТЕМП1", messageTemplate, {"ТЕМП1", "-10", "10"}, "12",
+                        LogStatus::Error);
+    manager.logTemplate(LogLevel::Error, "ТЕМП2", messageTemplate, {"ТЕМП2", "0", "5"}, "7",
+                        LogStatus::Error);
+    manager.log(LogLevel::Info, "Система", "Остановка программы");
+    manager.flush();
+
+    // Шаблон записан в справочник один раз
+    QCOMPARE(LogJournalReader::readDictionary(LogJournalReader::templatesPath(logFile)).count(messageTemplate), 1);
+
+    const QVector<LogEntry> expected = manager.getAllEntries();
+    const LogJournalReader reader(logFile);
+    const QVector<LogEntry> entries = readAll(reader, journal);
+    compareEntries(entries, expected);
+    QCOMPARE(entries[0].message(), QString("Выход ТЕМП1 за пределы [-10, 10]"));
+    QCOMPARE(entries[1].args, QStringList({"ТЕМП2", "0", "5"}));
+    QCOMPARE(entries[0].templateId, entries[1].templateId);
+    QVERIFY(entries[1].sameEvent(expected[1]));
+}
+
+QTEST_GUILESS_MAIN(LogJournalTest)
+
+#include "tst_logjournal.moc"
@@ -0,0 +1,36 @@
+# Тест полнотекстового поиска по журналу: векторный поиск подстроки
+# и приведение регистра против простых реализаций, поиск по сегментам
+# против последовательного просмотра записей.
+#
+# Сборка и запуск (из корня репозитория):
+#   qmake tests/LogSearchTest && make && make check
+
+QT += core concurrent testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = LogSearchTest
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    tst_logsearch.cpp \
+    $$ROOT/src/core/LogJournalReader.cpp \
+    $$ROOT/src/core/LogSearch.cpp \
+    $$ROOT/src/core/LogStringTable.cpp
+
+HEADERS += \
+    $$PWD/../common/LogJournalTestUtils.h \
+    $$ROOT/src/core/BinaryFormat.h \
+    $$ROOT/src/core/LogEntry.h \
+    $$ROOT/src/core/LogJournalFormat.h \
+    $$ROOT/src/core/LogJournalReader.h \
+    $$ROOT/src/core/LogSearch.h \
+    $$ROOT/src/core/LogStringTable.h
+
+INCLUDEPATH += $$ROOT/src/core $$PWD/../common
@@ -0,0 +1,303 @@
+// tests/LogSearchTest/tst_logsearch.cpp
+#include <QtTest>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <cstring>
+#include <random>
+
+#include "LogJournalFormat.h"
+#include "LogJournalReader.h"
+#include "LogSearch.h"
+#include "LogJournalTestUtils.h"
+
+using namespace ParamControl;
+using namespace LogJournalTestUtils;
+
+namespace {
+
+const qint64 kStartMs = 1700000000000;
+
+/// Категории журнала; номер категории в записи - номер в списке.
+const QStringList kCategories = {"ЁМКОСТЬ1", "ДАВЛ", "Система"};
+
+/**
+ * @brief Простой поиск подстроки для сверки с LogSearch::find().
+ */
+const uchar* naiveFind(const uchar* begin, const uchar* end, const QByteArray& needle) {
+    for (const uchar* position = begin; end - position >= needle.size(); ++position) {
+        if (std::memcmp(position, needle.constData(), size_t(needle.size())) == 0) {
+            return position;
+        }
+    }
+    return nullptr;
+}
+
+QByteArray folded(const QByteArray& text) {
+    QByteArray result(text.size(), '\0');
+    LogSearch::foldCase(reinterpret_cast<const uchar*>(text.constData()),
+                        reinterpret_cast<uchar*>(result.data()), text.size());
+    return result;
+}
+
+/**
+ * @brief Случайная запись из слов с разным регистром, с буквами Ё/ё и Е/е.
+ */
+LogEntry randomEntry(std::mt19937& rng, qint64 timestampMs) {
+    static const QStringList words = {"Ёмкость", "ёмкость", "ЁМКОСТЬ", "Давление", "ДАТЧИК", "датчик",
+                                      "предел", "ПРЕДЕЛ превышен", "Ошибка", "норма", "Temp", "TEMP",
+                                      "ещё", "Еще", "ЕЩЁ", "|"};
+    QStringList message;
+    const int count = std::uniform_int_distribution<int>(1, 4)(rng);
+    for (int i = 0; i < count; ++i) {
+        message << words[int(rng() % uint(words.size()))];
+    }
+
+    LogEntry entry;
+    entry.timestamp = QDateTime::fromMSecsSinceEpoch(timestampMs);
+    entry.level = rng() % 5 == 0 ? LogLevel::Error : LogLevel::Info;
+    entry.status = entry.level == LogLevel::Error ? LogStatus::Error : LogStatus::Normal;
+    entry.setCategory(kCategories[int(rng() % uint(kCategories.size()))]);
+    entry.setText(message.join(' '));
+    if (rng() % 3 != 0) {
+        entry.value = QString::number(std::uniform_real_distribution<double>(-50.0, 50.0)(rng), 'f', 1);
+    }
+    return entry;
+}
+
+/**
+ * @brief Записи журнала, удовлетворяющие условиям (последовательный просмотр).
+ */
+QVector<LogEntry> scan(const LogJournalReader& reader, const LogSearchOptions& options) {
+    const Qt::CaseSensitivity sensitivity = options.caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    QVector<LogEntry> entries;
+    for (const QString& segmentPath : reader.segmentFiles()) {
+        reader.readSegment(segmentPath, [&](const LogEntry& entry) {
+            const qint64 timestampMs = entry.timestamp.toMSecsSinceEpoch();
+            if (timestampMs >= options.fromMs && timestampMs <= options.toMs &&
+                (entry.message().contains(options.text, sensitivity) ||
+                 entry.value.contains(options.text, sensitivity) ||
+                 entry.category().contains(options.text, sensitivity))) {
+                entries.append(entry);
+            }
+            return true;
+        });
+    }
+    return entries;
+}
+
+} // namespace
+
+/**
+ * @brief Проверки LogSearch: поиск подстроки, приведение регистра и поиск по журналу.
+ */
+class LogSearchTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void findMatchesNaive();
+    void foldCaseMatchesToLower();
+    void foldCaseKeepsOtherBytes();
+    void searchMatchesScan_data();
+    void searchMatchesScan();
+    void searchSkipsSupersededRecords();
+};
+
+void LogSearchTest::findMatchesNaive() {
+    std::mt19937 rng(20241001);
+
+    // Алфавит из трех букв: много совпадений первого и последнего байта
+    QByteArray haystack(700, '\0');
+    for (char& c : haystack) {
+        c = char('a' + rng() % 3);
+    }
+    const uchar* data = reinterpret_cast<const uchar*>(haystack.constData());
+
+    for (int length : {1, 2, 3, 5, 15, 16, 17, 31, 40}) {
+        for (int attempt = 0; attempt < 20; ++attempt) {
+            // Половина подстрок взята из самого текста, в том числе у самого конца
+            QByteArray needle;
+            if (attempt % 2) {
+                const int start = attempt == 1 ? haystack.size() - length
+                                               : int(rng() % uint(haystack.size() - length + 1));
+                needle = haystack.mid(start, length);
+            } else {
+                for (int i = 0; i < length; ++i) {
+                    needle.append(char('a' + rng() % 3));
+                }
+            }
+
+            // Начало и конец сдвигаются, чтобы начало не было выровнено на 16 байт
+            for (int offset : {0, 1, 7, 15, 16}) {
+                for (int cut : {0, 1, 9}) {
+                    const uchar* begin = data + offset;
+                    const uchar* end = data + haystack.size() - cut;
+                    QVERIFY2(LogSearch::find(begin, end, needle) == naiveFind(begin, end, needle),
+                             qPrintable(QString("%1 at %2..-%3").arg(QString(needle)).arg(offset).arg(cut)));
+                }
+            }
+        }
+    }
+
+    // Подстрока длиннее текста и пустая подстрока
+    QVERIFY(!LogSearch::find(data, data + 3, "abcd"));
+    QVERIFY(!LogSearch::find(data, data + 3, QByteArray()));
+    QVERIFY(!LogSearch::find(data, data, "a"));
+}
+
+void LogSearchTest::foldCaseMatchesToLower() {
+    // ASCII и кириллица U+0400-U+045F, включая Ё и Ѐ-Џ
+    QString text;
+    for (ushort c = 0x20; c < 0x7f; ++c) {
+        text.append(QChar(c));
+    }
+    for (ushort c = 0x0400; c < 0x0460; ++c) {
+        text.append(QChar(c));
+    }
+    text += "Ёлка ёлка ЕЛКА";
+
+    const QByteArray utf8 = text.toUtf8();
+    const QByteArray result = folded(utf8);
+    QCOMPARE(result.size(), utf8.size());
+    QCOMPARE(QString::fromUtf8(result), text.toLower());
+
+    // На месте: источник и приемник - один буфер
+    QByteArray inPlace = utf8;
+    LogSearch::foldCase(reinterpret_cast<const uchar*>(inPlace.constData()),
+                        reinterpret_cast<uchar*>(inPlace.data()), inPlace.size());
+    QCOMPARE(inPlace, result);
+
+    QCOMPARE(folded(QString("ЁМКОСТЬ").toUtf8()), QString("ёмкость").toUtf8());
+    QVERIFY(folded(QString("ЕЩЁ").toUtf8()) != QString("еще").toUtf8());
+}
+
+void LogSearchTest::foldCaseKeepsOtherBytes() {
+    // Другие алфавиты, оборванный символ в конце и двоичные данные не меняются
+    const QByteArray other = QString("ΣÄѠ€ßѐё").toUtf8();
+    QCOMPARE(folded(other), other);
+    QCOMPARE(folded(QByteArray("\xD0", 1)), QByteArray("\xD0", 1));
+    QCOMPARE(folded(QByteArray("\xD0\xD0\xC0\xFF", 4)), QByteArray("\xD0\xD0\xC0\xFF", 4));
+    QCOMPARE(folded(QByteArray("\xD0\xB0", 2)), QByteArray("\xD0\xB0", 2));
+}
+
+void LogSearchTest::searchMatchesScan_data() {
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<bool>("caseSensitive");
+
+    QTest::newRow("cyrillic") << "ёмкость" << false;
+    QTest::newRow("cyrillic case") << "ёмкость" << true;
+    QTest::newRow("yo") << "ещё" << false;
+    QTest::newRow("ye") << "еще" << false;
+    QTest::newRow("phrase") << "ПРЕДЕЛ ПРЕВЫШЕН" << false;
+    QTest::newRow("ascii") << "temp" << false;
+    QTest::newRow("ascii case") << "TEMP" << true;
+    QTest::newRow("across words") << "ость д" << false;
+    QTest::newRow("separator") << "|" << false;
+    QTest::newRow("value") << ".5" << false;
+    QTest::newRow("category") << "давл" << false;
+    QTest::newRow("single letter") << "Ё" << false;
+    QTest::newRow("absent") << "нет такого" << false;
+}
+
+void LogSearchTest::searchMatchesScan() {
+    QFETCH(QString, text);
+    QFETCH(bool, caseSensitive);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+
+    writeDictionary(LogJournalReader::categoriesPath(logFile), kCategories);
+
+    // Сжатый закрытый сегмент, несжатый закрытый и текущий; записей больше пачки сигнала
+    std::mt19937 rng(20241002);
+    qint64 timestampMs = kStartMs;
+    QVector<QVector<LogEntry>> segments(3);
+    for (QVector<LogEntry>& segment : segments) {
+        for (int i = 0; i < 700; ++i) {
+            timestampMs += 1000;
+            segment.append(randomEntry(rng, timestampMs));
+        }
+    }
+    writeFile(LogJournalReader::closedSegmentPath(logFile, segments[0].last().timestamp) + kLogCompressedSuffix,
+              qCompress(buildSegment(segments[0], kCategories)));
+    writeFile(LogJournalReader::closedSegmentPath(logFile, segments[1].last().timestamp),
+              buildSegment(segments[1], kCategories));
+    writeFile(LogJournalReader::journalPath(logFile), buildSegment(segments[2], kCategories));
+
+    const LogJournalReader reader(logFile);
+    QCOMPARE(reader.segmentFiles().size(), 3);
+
+    LogSearchOptions options;
+    options.text = text;
+    options.caseSensitive = caseSensitive;
+    for (const auto& interval : {qMakePair(std::numeric_limits<qint64>::min(), std::numeric_limits<qint64>::max()),
+                                 qMakePair(kStartMs + 900 * 1000, kStartMs + 1500 * 1000)}) {
+        options.fromMs = interval.first;
+        options.toMs = interval.second;
+
+        QVector<LogEntry> found;
+        int batches = 0;
+        const std::atomic<bool> cancelled{false};
+        const qint64 matches = LogSearch::search(reader, options, [&](const QVector<LogEntry>& batch) {
+            found += batch;
+            ++batches;
+            return true;
+        }, cancelled);
+
+        const QVector<LogEntry> expected = scan(reader, options);
+        QCOMPARE(matches, qint64(expected.size()));
+        QCOMPARE(found.size(), expected.size());
+        for (int i = 0; i < found.size(); ++i) {
+            QCOMPARE(found[i].timestamp, expected[i].timestamp);
+            QCOMPARE(found[i].message(), expected[i].message());
+        }
+        QVERIFY(batches <= (found.size() + 255) / 256 + 3);
+    }
+
+    // Прерванный получателем поиск возвращает только отданные записи
+    options.fromMs = std::numeric_limits<qint64>::min();
+    options.toMs = std::numeric_limits<qint64>::max();
+    const std::atomic<bool> cancelled{false};
+    qint64 delivered = 0;
+    const qint64 matches = LogSearch::search(reader, options, [&](const QVector<LogEntry>& batch) {
+        delivered += batch.size();
+        return false;
+    }, cancelled);
+    QCOMPARE(matches, delivered);
+}
+
+void LogSearchTest::searchSkipsSupersededRecords() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString logFile = QDir(directory.path()).filePath("LOG_test.txt");
+
+    LogEntry entry;
+    entry.timestamp = QDateTime::fromMSecsSinceEpoch(kStartMs);
+    entry.setCategory("Система");
+    entry.setText("Ёмкость пуста");
+
+    // Первое событие серии и заменяющая его запись серии из трех событий
+    QByteArray segment = logJournalHeader(kStartMs);
+    logJournalPutEvent(segment, entry, 2, 0);
+    LogEntry run = entry;
+    run.repeatCount = 3;
+    run.lastTimestamp = entry.timestamp.addSecs(2);
+    logJournalPutEvent(segment, run, 2, 0, true);
+    writeFile(LogJournalReader::journalPath(logFile), segment);
+
+    QVector<LogEntry> found;
+    const std::atomic<bool> cancelled{false};
+    LogSearchOptions options;
+    options.text = "ЁМКОСТЬ";
+    QCOMPARE(LogSearch::search(LogJournalReader(logFile), options, [&](const QVector<LogEntry>& batch) {
+        found += batch;
+        return true;
+    }, cancelled), qint64(1));
+    QCOMPARE(found.size(), 1);
+    QCOMPARE(found.first().repeatCount, 3);
+}
+
+QTEST_GUILESS_MAIN(LogSearchTest)
+
+#include "tst_logsearch.moc"
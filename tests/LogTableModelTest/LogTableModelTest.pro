@@ -0,0 +1,41 @@
+# Тест модели таблицы журнала: подгрузка истории с диска (fetchMore)
+# и перенос вытесненных из буфера записей в модель при подгруженной истории.
+#
+# Сборка и запуск (из корня репозитория):
+#   qmake tests/LogTableModelTest && make && make check
+
+QT += core gui concurrent testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = LogTableModelTest
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    tst_logtablemodel.cpp \
+    $$ROOT/src/core/LogBuffer.cpp \
+    $$ROOT/src/core/LogIndex.cpp \
+    $$ROOT/src/core/LogJournalCursor.cpp \
+    $$ROOT/src/core/LogJournalReader.cpp \
+    $$ROOT/src/core/LogManager.cpp \
+    $$ROOT/src/core/LogStringTable.cpp \
+    $$ROOT/src/ui/LogTableModel.cpp
+
+HEADERS += \
+    $$ROOT/src/core/BinaryFormat.h \
+    $$ROOT/src/core/LogBuffer.h \
+    $$ROOT/src/core/LogEntry.h \
+    $$ROOT/src/core/LogIndex.h \
+    $$ROOT/src/core/LogJournalCursor.h \
+    $$ROOT/src/core/LogJournalFormat.h \
+    $$ROOT/src/core/LogJournalReader.h \
+    $$ROOT/src/core/LogManager.h \
+    $$ROOT/src/core/LogStringTable.h \
+    $$ROOT/src/ui/LogTableModel.h
+
+INCLUDEPATH += $$ROOT/src/core $$ROOT/src/ui
@@ -0,0 +1,180 @@
+// tests/LogTableModelTest/tst_logtablemodel.cpp
+#include <QtTest>
+#include <QDir>
+#include <QTemporaryDir>
+#include <memory>
+
+#include "LogManager.h"
+#include "LogTableModel.h"
+
+using namespace ParamControl;
+
+namespace {
+
+/// Емкость буфера журнала в памяти.
+constexpr int kCapacity = 100;
+
+/**
+ * @brief Пишет записи "Событие first" ... "Событие end - 1"; четные - в категорию ТЕМП1.
+ */
+void logEvents(LogManager& manager, int first, int end) {
+    for (int i = first; i < end; ++i) {
+        manager.log(LogLevel::Info, i % 2 == 0 ? "ТЕМП1" : "Система", QString("Событие %1").arg(i),
+                    QString::number(i));
+    }
+    manager.flush();
+}
+
+/**
+ * @brief Подгружает всю историю с диска.
+ */
+void fetchAll(LogTableModel& model) {
+    for (int page = 0; page < 100 && model.canFetchMore(QModelIndex()); ++page) {
+        model.fetchMore(QModelIndex());
+    }
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+}
+
+/**
+ * @brief Строки модели - записи с номерами numbers[0], numbers[1], ... (от новых к старым).
+ */
+void compareRows(const LogTableModel& model, const QVector<int>& numbers) {
+    QCOMPARE(model.rowCount(), numbers.size());
+    for (int row = 0; row < numbers.size(); ++row) {
+        QCOMPARE(model.data(model.index(row, LogTableModel::MessageColumn)).toString(),
+                 QString("Событие %1").arg(numbers[row]));
+        QCOMPARE(model.data(model.index(row, LogTableModel::ValueColumn)).toString(),
+                 QString::number(numbers[row]));
+    }
+}
+
+/**
+ * @brief Номера записей от last до first с шагом step (от новых к старым).
+ */
+QVector<int> newestFirst(int last, int first, int step = 1) {
+    QVector<int> numbers;
+    for (int i = last; i >= first; i -= step) {
+        numbers.append(i);
+    }
+    return numbers;
+}
+
+} // namespace
+
+/**
+ * @brief Проверки LogTableModel: история с диска и вытеснение из буфера.
+ */
+class LogTableModelTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void fetchMoreLoadsOlderEntries();
+    void fetchMoreKeepsFilters();
+    void evictedRowsAreRetainedWithHistory();
+    void evictedRowsAreRemovedWithoutHistory();
+};
+
+void LogTableModelTest::fetchMoreLoadsOlderEntries() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    auto manager = std::make_shared<LogManager>();
+    QVERIFY(manager->initialize(QDir(directory.path()).filePath("LOG_test.txt"), kCapacity));
+    logEvents(*manager, 0, 1234);
+
+    // Сначала только записи буфера, история - по запросу представления
+    LogTableModel model(manager);
+    compareRows(model, newestFirst(1233, 1234 - kCapacity));
+    QVERIFY(model.canFetchMore(QModelIndex()));
+
+    // Первая страница идет сразу за записями буфера, без пропусков и повторов
+    model.fetchMore(QModelIndex());
+    QVERIFY(model.rowCount() > kCapacity);
+    QVERIFY(model.rowCount() < 1234);
+    compareRows(model, newestFirst(1233, 1234 - model.rowCount()));
+
+    fetchAll(model);
+    compareRows(model, newestFirst(1233, 0));
+}
+
+void LogTableModelTest::fetchMoreKeepsFilters() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    auto manager = std::make_shared<LogManager>();
+    QVERIFY(manager->initialize(QDir(directory.path()).filePath("LOG_test.txt"), kCapacity));
+    logEvents(*manager, 0, 700);
+
+    LogTableModel model(manager);
+    model.setCategoryFilter("ТЕМП1");
+    compareRows(model, newestFirst(698, 700 - kCapacity, 2));
+
+    // С диска подгружаются только записи, прошедшие фильтр
+    fetchAll(model);
+    compareRows(model, newestFirst(698, 0, 2));
+
+    // Смена фильтра сбрасывает историю
+    model.setCategoryFilter(QString());
+    compareRows(model, newestFirst(699, 700 - kCapacity));
+    QVERIFY(model.canFetchMore(QModelIndex()));
+}
+
+void LogTableModelTest::evictedRowsAreRetainedWithHistory() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    auto manager = std::make_shared<LogManager>();
+    QVERIFY(manager->initialize(QDir(directory.path()).filePath("LOG_test.txt"), kCapacity));
+    logEvents(*manager, 0, 300);
+
+    LogTableModel model(manager);
+    fetchAll(model);
+    compareRows(model, newestFirst(299, 0));
+
+    // Вытесненные из буфера записи остаются строками модели между памятью и историей
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+    logEvents(*manager, 300, 330);
+    model.onLogEntryAdded(LogEntry());
+    QCOMPARE(removed.count(), 0);
+    compareRows(model, newestFirst(329, 0));
+
+    logEvents(*manager, 330, 330 + kCapacity - 30);
+    model.onLogEntryAdded(LogEntry());
+    QCOMPARE(removed.count(), 0);
+    compareRows(model, newestFirst(329 + kCapacity - 30, 0));
+
+    // Копий больше емкости буфера не бывает: история сбрасывается и подгружается заново
+    logEvents(*manager, 400, 401);
+    model.onLogEntryAdded(LogEntry());
+    QCOMPARE(removed.count(), 1);
+    compareRows(model, newestFirst(400, 401 - kCapacity));
+    QVERIFY(model.canFetchMore(QModelIndex()));
+
+    fetchAll(model);
+    compareRows(model, newestFirst(400, 0));
+}
+
+void LogTableModelTest::evictedRowsAreRemovedWithoutHistory() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    auto manager = std::make_shared<LogManager>();
+    QVERIFY(manager->initialize(QDir(directory.path()).filePath("LOG_test.txt"), kCapacity));
+    logEvents(*manager, 0, 50);
+
+    LogTableModel model(manager);
+    compareRows(model, newestFirst(49, 0));
+
+    // Без подгруженной истории вытесненные записи просто удаляются снизу
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    logEvents(*manager, 50, 120);
+    model.onLogEntryAdded(LogEntry());
+    QCOMPARE(removed.count(), 1);
+    QCOMPARE(removed.first().at(1).toInt(), 30);
+    QCOMPARE(removed.first().at(2).toInt(), 49);
+    QCOMPARE(inserted.count(), 1);
+    QCOMPARE(inserted.first().at(1).toInt(), 0);
+    QCOMPARE(inserted.first().at(2).toInt(), 69);
+    compareRows(model, newestFirst(119, 120 - kCapacity));
+}
+
+QTEST_GUILESS_MAIN(LogTableModelTest)
+
+#include "tst_logtablemodel.moc"
@@ -0,0 +1,223 @@
+// tests/ParameterModelTest/tst_parametermodel.cpp
+#include <QtTest>
+#include <QVariantList>
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "ParameterModel.h"
+
+using namespace ParamControl;
+
+namespace {
+
+/// Ключ параметра: имя и тип.
+using Key = QPair<QString, ParameterType>;
+
+/**
+ * @brief Параметр с условием, подходящим для его типа.
+ */
+std::shared_ptr<Parameter> makeParameter(const Key& key) {
+    switch (key.second) {
+    case ParameterType::InLimits:
+        return Parameter::create(key.first, key.second, QVariantList{0.0, 10.0});
+    case ParameterType::OutOfLimits:
+        return Parameter::create(key.first, key.second, QVariantList{20.0, 30.0});
+    case ParameterType::Changed:
+        return Parameter::create(key.first, key.second, QVariant());
+    default:
+        return Parameter::create(key.first, key.second, 5.0);
+    }
+}
+
+/**
+ * @brief Сверка индексов модели и ее снимка с эталонным списком ключей.
+ */
+void compareWithModel(const ParameterModel& model, const QVector<Key>& keys) {
+    const auto snapshot = model.snapshot();
+    QCOMPARE(snapshot->rows.size(), keys.size());
+    QCOMPARE(model.getAllParameters().size(), keys.size());
+
+    QStringList names;
+    for (int row = 0; row < keys.size(); ++row) {
+        const Key& key = keys[row];
+        QCOMPARE(model.indexOf(key.first, key.second), row);
+        QCOMPARE(snapshot->indexOf(key.first, key.second), row);
+        QCOMPARE(snapshot->rows[row].name, key.first);
+        QCOMPARE(snapshot->rows[row].type, key.second);
+
+        const auto parameter = model.getParameter(key.first, key.second);
+        QVERIFY(parameter);
+        QCOMPARE(model.getParameterAt(row), parameter);
+        if (!names.contains(key.first)) {
+            names.append(key.first);
+        }
+    }
+    QVERIFY(!model.getParameterAt(keys.size()));
+    QVERIFY(!model.getParameterAt(-1));
+
+    // Параметры одного имени - в порядке строк
+    for (const QString& name : names) {
+        QVector<std::shared_ptr<Parameter>> expected;
+        for (int row = 0; row < keys.size(); ++row) {
+            if (keys[row].first == name) {
+                expected.append(model.getParameterAt(row));
+            }
+        }
+        QCOMPARE(model.getParametersByName(name), expected);
+    }
+    std::sort(names.begin(), names.end());
+    QCOMPARE(model.getAllParameterNames(), names.toVector());
+}
+
+} // namespace
+
+/**
+ * @brief Проверки индексов ParameterModel по имени и типу и неизменности снимков.
+ */
+class ParameterModelTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void duplicateIsRejected();
+    void removalShiftsRows();
+    void randomEditsMatchModel();
+    void snapshotsAreImmutable();
+};
+
+void ParameterModelTest::duplicateIsRejected() {
+    ParameterModel model;
+    QVERIFY(model.addParameter(makeParameter({"ТЕМП", ParameterType::InLimits})));
+    QVERIFY(model.addParameter(makeParameter({"ТЕМП", ParameterType::OutOfLimits})));
+
+    // Тот же ключ не добавляется и не подменяет уже добавленный параметр
+    const auto original = model.getParameter("ТЕМП", ParameterType::InLimits);
+    QVERIFY(!model.addParameter(makeParameter({"ТЕМП", ParameterType::InLimits})));
+    QVERIFY(!model.addParameter(nullptr));
+    QCOMPARE(model.getParameter("ТЕМП", ParameterType::InLimits), original);
+    compareWithModel(model, {{"ТЕМП", ParameterType::InLimits}, {"ТЕМП", ParameterType::OutOfLimits}});
+
+    // Удаление несуществующего ключа ничего не меняет
+    QVERIFY(!model.removeParameter("ТЕМП", ParameterType::Equals));
+    QVERIFY(!model.removeParameter("ТОК", ParameterType::InLimits));
+    compareWithModel(model, {{"ТЕМП", ParameterType::InLimits}, {"ТЕМП", ParameterType::OutOfLimits}});
+}
+
+void ParameterModelTest::removalShiftsRows() {
+    QVector<Key> keys = {
+        {"ТЕМП", ParameterType::InLimits},
+        {"ТОК", ParameterType::Equals},
+        {"ТЕМП", ParameterType::Changed},
+        {"НАПР", ParameterType::OutOfLimits},
+        {"ТОК", ParameterType::NotEquals},
+        {"ТЕМП", ParameterType::Equals},
+    };
+    ParameterModel model;
+    for (const Key& key : keys) {
+        QVERIFY(model.addParameter(makeParameter(key)));
+    }
+    compareWithModel(model, keys);
+
+    // Удаление из середины сдвигает строки после него, в том числе строки того же имени
+    QVERIFY(model.removeParameter("ТОК", ParameterType::Equals));
+    keys.removeAt(1);
+    compareWithModel(model, keys);
+    QCOMPARE(model.indexOf("ТОК", ParameterType::Equals), -1);
+
+    // Последний параметр имени убирает имя из индекса имен
+    QVERIFY(model.removeParameter("НАПР", ParameterType::OutOfLimits));
+    keys.removeAt(2);
+    compareWithModel(model, keys);
+    QVERIFY(model.getParametersByName("НАПР").isEmpty());
+
+    // Удаленный ключ можно добавить снова - в конец списка
+    QVERIFY(model.addParameter(makeParameter({"ТОК", ParameterType::Equals})));
+    keys.append({"ТОК", ParameterType::Equals});
+    compareWithModel(model, keys);
+}
+
+void ParameterModelTest::randomEditsMatchModel() {
+    const QStringList names = {"ТЕМП", "ТОК", "НАПР", "РЕЖИМ", "ДАВЛ"};
+    const QVector<ParameterType> types = {
+        ParameterType::Equals, ParameterType::NotEquals, ParameterType::InLimits,
+        ParameterType::OutOfLimits, ParameterType::Changed,
+    };
+
+    std::mt19937 rng(20241005);
+    ParameterModel model;
+    QVector<Key> keys;
+    for (int step = 0; step < 1000; ++step) {
+        const Key key(names[int(rng() % names.size())], types[int(rng() % types.size())]);
+        const bool exists = keys.contains(key);
+        if (rng() % 3 != 0) {
+            QCOMPARE(model.addParameter(makeParameter(key)), !exists);
+            if (!exists) {
+                keys.append(key);
+            }
+        } else {
+            QCOMPARE(model.removeParameter(key.first, key.second), exists);
+            keys.removeOne(key);
+        }
+
+        if (step % 50 == 0) {
+            compareWithModel(model, keys);
+        }
+    }
+    compareWithModel(model, keys);
+}
+
+void ParameterModelTest::snapshotsAreImmutable() {
+    ParameterModel model;
+    QVERIFY(model.addParameter(makeParameter({"ТЕМП", ParameterType::InLimits})));
+    QVERIFY(model.addParameter(makeParameter({"ТОК", ParameterType::Equals})));
+    const auto initial = model.snapshot();
+    QCOMPARE(initial->rows.size(), 2);
+    QCOMPARE(initial->rows[0].status, ParameterStatus::Unknown);
+    QVERIFY(!initial->rows[0].value.isValid());
+
+    // Такт публикует новый снимок; выданный ранее остается прежним
+    model.checkParameters({{"ТЕМП", 50.0}, {"ТОК", 5.0}});
+    const auto checked = model.snapshot();
+    QVERIFY(checked != initial);
+    QVERIFY(checked->version > initial->version);
+    QCOMPARE(checked->rows[0].status, ParameterStatus::Error);
+    QCOMPARE(checked->rows[0].value.toDouble(), 50.0);
+    QCOMPARE(checked->rows[1].status, ParameterStatus::Ok);
+    QCOMPARE(initial->rows[0].status, ParameterStatus::Unknown);
+    QVERIFY(!initial->rows[0].value.isValid());
+    QCOMPARE(initial->rows[1].status, ParameterStatus::Unknown);
+
+    // Правка условия меняет только новый снимок
+    QVERIFY(model.updateParameter("ТОК", ParameterType::Equals, 7.0, "Ток нагрузки"));
+    const auto updated = model.snapshot();
+    QVERIFY(updated->version > checked->version);
+    QCOMPARE(updated->rows[1].description, QString("Ток нагрузки"));
+    QVERIFY(checked->rows[1].description.isEmpty());
+    QVERIFY(checked->rows[1].condition != updated->rows[1].condition);
+
+    // Добавление и удаление не сдвигают строки и индекс выданных снимков
+    QVERIFY(model.addParameter(makeParameter({"НАПР", ParameterType::OutOfLimits})));
+    QVERIFY(model.removeParameter("ТЕМП", ParameterType::InLimits));
+    const auto edited = model.snapshot();
+    QCOMPARE(edited->rows.size(), 2);
+    QCOMPARE(edited->indexOf("ТОК", ParameterType::Equals), 0);
+    QCOMPARE(edited->indexOf("НАПР", ParameterType::OutOfLimits), 1);
+    QCOMPARE(edited->indexOf("ТЕМП", ParameterType::InLimits), -1);
+    QCOMPARE(edited->rows[0].value.toDouble(), 5.0);
+
+    for (const auto& snapshot : {initial, checked, updated}) {
+        QCOMPARE(snapshot->rows.size(), 2);
+        QCOMPARE(snapshot->indexOf("ТЕМП", ParameterType::InLimits), 0);
+        QCOMPARE(snapshot->indexOf("ТОК", ParameterType::Equals), 1);
+        QCOMPARE(snapshot->indexOf("НАПР", ParameterType::OutOfLimits), -1);
+        QCOMPARE(snapshot->rows[0].name, QString("ТЕМП"));
+    }
+    QCOMPARE(checked->rows[0].value.toDouble(), 50.0);
+
+    // Без изменений модель отдает тот же снимок
+    QCOMPARE(model.snapshot(), edited);
+}
+
+QTEST_GUILESS_MAIN(ParameterModelTest)
+
+#include "tst_parametermodel.moc"
@@ -0,0 +1,57 @@
+# Тест повторного прогона правил: переходы RuleReplay по тем же тактам
+# (напрямую и из файла записи JSONL) совпадают с живым прогоном ParameterModel.
+#
+# Сборка и запуск (из корня репозитория):
+#   qmake tests/RuleReplayTest && make && make check
+
+QT += core xml concurrent testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = RuleReplayTest
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    tst_rulereplay.cpp \
+    $$ROOT/src/core/Parameter.cpp \
+    $$ROOT/src/core/ParameterEquals.cpp \
+    $$ROOT/src/core/ParameterNotEquals.cpp \
+    $$ROOT/src/core/ParameterInLimits.cpp \
+    $$ROOT/src/core/ParameterOutOfLimits.cpp \
+    $$ROOT/src/core/ParameterChanged.cpp \
+    $$ROOT/src/core/ParameterExpression.cpp \
+    $$ROOT/src/core/ParameterRateOfChange.cpp \
+    $$ROOT/src/core/ParameterTrend.cpp \
+    $$ROOT/src/core/ParameterStatistic.cpp \
+    $$ROOT/src/core/ParameterModel.cpp \
+    $$ROOT/src/core/ConditionProgram.cpp \
+    $$ROOT/src/core/Expression.cpp \
+    $$ROOT/src/core/LimitKernel.cpp \
+    $$ROOT/src/core/WindowStore.cpp \
+    $$ROOT/src/core/HistoryStore.cpp \
+    $$ROOT/src/core/TelemetryArchive.cpp \
+    $$ROOT/src/core/TelemetryArchiveReader.cpp \
+    $$ROOT/src/core/RuleReplay.cpp
+
+HEADERS += \
+    $$ROOT/src/core/Parameter.h \
+    $$ROOT/src/core/ParameterModel.h \
+    $$ROOT/src/core/ParameterSnapshot.h \
+    $$ROOT/src/core/TickResult.h \
+    $$ROOT/src/core/ConditionProgram.h \
+    $$ROOT/src/core/LimitKernel.h \
+    $$ROOT/src/core/WindowStore.h \
+    $$ROOT/src/core/HistoryStore.h \
+    $$ROOT/src/core/TelemetryArchive.h \
+    $$ROOT/src/core/BinaryFormat.h \
+    $$ROOT/src/core/TelemetryArchiveFormat.h \
+    $$ROOT/src/core/TelemetryArchiveReader.h \
+    $$ROOT/src/core/RuleReplay.h
+
+INCLUDEPATH += $$ROOT/src/core
@@ -0,0 +1,182 @@
+// tests/RuleReplayTest/tst_rulereplay.cpp
+#include <QtTest>
+#include <QBuffer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QVariantList>
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "ParameterModel.h"
+#include "RuleReplay.h"
+
+using namespace ParamControl;
+
+namespace {
+
+const qint64 kStartMs = 1760745600000;
+
+/// Интервал опроса живого прогона, мс.
+constexpr int kIntervalMs = 500;
+
+/**
+ * @brief Правила, статус которых зависит только от значений и числа тактов.
+ *
+ * Подтверждение по секундам и правила скорости изменения в живом прогоне
+ * идут по часам, а при повторном - по времени тактов, поэтому здесь их нет.
+ * Каждый вызов создает новые объекты: статусы параметров меняются при прогоне.
+ */
+QVector<std::shared_ptr<Parameter>> makeParameters() {
+    ConditionFilter confirmed;
+    confirmed.hysteresis = 3.0;
+    confirmed.entrySamples = 2;
+    confirmed.exitSamples = 3;
+
+    QVector<std::shared_ptr<Parameter>> parameters = {
+        Parameter::create("ТЕМП", ParameterType::InLimits, QVariantList{-10.0, 50.0}),
+        Parameter::create("ТЕМП", ParameterType::OutOfLimits, QVariantList{0.0, 20.0}),
+        Parameter::create("ТОК", ParameterType::InLimits, QVariantList{0.5, 4.5}),
+        Parameter::create("ТОК", ParameterType::NotEquals, 3.0),
+        Parameter::create("РЕЖИМ", ParameterType::Equals, QString("ВКЛ")),
+        Parameter::create("РЕЖИМ", ParameterType::Changed, QVariant()),
+        Parameter::create("ПЕРЕГРЕВ", ParameterType::Expression, QString("ТЕМП > 40")),
+    };
+    parameters[0]->setFilter(confirmed);
+    return parameters;
+}
+
+/**
+ * @brief Случайные такты; часть параметров иногда пропускает такт.
+ */
+QVector<QVector<ParameterValue>> makeTicks(int count) {
+    std::mt19937 rng(20241004);
+    std::uniform_real_distribution<double> temperature(-20.0, 60.0);
+    std::uniform_int_distribution<int> current(0, 10);
+    QString mode = "ВКЛ";
+
+    QVector<QVector<ParameterValue>> ticks;
+    for (int tick = 0; tick < count; ++tick) {
+        QVector<ParameterValue> values;
+        if (rng() % 10 != 0) {
+            values.append({"ТЕМП", temperature(rng)});
+        }
+        values.append({"ТОК", current(rng) * 0.5});
+        if (rng() % 15 == 0) {
+            mode = mode == "ВКЛ" ? "ВЫКЛ" : "ВКЛ";
+        }
+        values.append({"РЕЖИМ", mode});
+        ticks.append(values);
+    }
+    return ticks;
+}
+
+/**
+ * @brief Переход в виде строки для сравнения списков.
+ */
+QString describe(int tick, const QString& name, ParameterType type, ParameterStatus previous,
+                 ParameterStatus current, const QVariant& value) {
+    return QString("%1 %2/%3 %4->%5 %6")
+        .arg(tick, 5, 10, QChar('0'))
+        .arg(name)
+        .arg(static_cast<int>(type))
+        .arg(static_cast<int>(previous))
+        .arg(static_cast<int>(current))
+        .arg(value.toString());
+}
+
+/**
+ * @brief Такты в формате файла записи JSONL.
+ */
+QByteArray toCapture(const QVector<QVector<ParameterValue>>& ticks) {
+    QByteArray capture;
+    for (int tick = 0; tick < ticks.size(); ++tick) {
+        QJsonObject values;
+        for (const ParameterValue& value : ticks[tick]) {
+            values.insert(value.name, QJsonValue::fromVariant(value.value));
+        }
+        QJsonObject line;
+        line.insert("timestampMs", double(kStartMs + qint64(tick) * kIntervalMs));
+        line.insert("values", values);
+        capture += QJsonDocument(line).toJson(QJsonDocument::Compact) + '\n';
+    }
+    return capture;
+}
+
+} // namespace
+
+/**
+ * @brief Проверки RuleReplay против живого прогона ParameterModel.
+ */
+class RuleReplayTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void replayMatchesLiveModel();
+};
+
+void RuleReplayTest::replayMatchesLiveModel() {
+    const QVector<QVector<ParameterValue>> ticks = makeTicks(400);
+
+    // Живой прогон: переходы из итогов тактов модели
+    ParameterModel model;
+    model.setSampleInterval(kIntervalMs);
+    for (const auto& parameter : makeParameters()) {
+        QVERIFY(model.addParameter(parameter));
+    }
+    QStringList live;
+    int liveTick = 0;
+    connect(&model, &ParameterModel::tickEvaluated, this, [&live, &liveTick](const TickResultPtr& result) {
+        for (const StatusTransition& transition : result->transitions) {
+            const ParameterRow& row = result->snapshot->rows[transition.row];
+            live << describe(liveTick, row.name, row.type, transition.previous, transition.current, row.value);
+        }
+    });
+    for (const auto& values : ticks) {
+        model.checkParameters(values);
+        ++liveTick;
+    }
+    std::sort(live.begin(), live.end());
+    QVERIFY(live.size() > 20);
+
+    // Повторный прогон по тем же тактам
+    RuleReplay replay(makeParameters());
+    replay.setSampleInterval(model.sampleInterval());
+    QStringList replayed;
+    int replayTick = 0;
+    const RuleReplay::Sink sink = [&replayed, &replayTick](const ReplayTransition& transition) {
+        replayed << describe(replayTick, transition.name, transition.type, transition.previous,
+                             transition.current, transition.value);
+    };
+    for (const auto& values : ticks) {
+        replay.processTick(values, kStartMs + qint64(replayTick) * kIntervalMs, sink);
+        ++replayTick;
+    }
+    QCOMPARE(replay.tickCount(), qint64(ticks.size()));
+    std::sort(replayed.begin(), replayed.end());
+    QCOMPARE(replayed, live);
+
+    // То же по файлу записи: номер такта - по его времени
+    QByteArray capture = toCapture(ticks);
+    QBuffer device(&capture);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QCOMPARE(RuleReplay::captureSampleInterval(device), kIntervalMs);
+    QVERIFY(device.seek(0));
+
+    RuleReplay fromCapture(makeParameters());
+    fromCapture.setSampleInterval(kIntervalMs);
+    QStringList captured;
+    QString error;
+    const qint64 processed = fromCapture.replayCapture(device, [&captured](const ReplayTransition& transition) {
+        captured << describe(int((transition.timestampMs - kStartMs) / kIntervalMs), transition.name,
+                             transition.type, transition.previous, transition.current, transition.value);
+    }, &error);
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    QCOMPARE(processed, qint64(ticks.size()));
+    std::sort(captured.begin(), captured.end());
+    QCOMPARE(captured, live);
+}
+
+QTEST_GUILESS_MAIN(RuleReplayTest)
+
+#include "tst_rulereplay.moc"
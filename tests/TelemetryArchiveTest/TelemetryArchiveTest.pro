@@ -0,0 +1,36 @@
+# Тест архива ТМИ: формат сегментов и индекса, восстановление после
+# недописанных записей, сводки и тренд по уровням сводок, запросы
+# с параллельной распаковкой блоков против последовательного подсчета.
+#
+# Сборка и запуск (из корня репозитория):
+#   qmake tests/TelemetryArchiveTest && make && make check
+
+QT += core concurrent testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = TelemetryArchiveTest
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    tst_telemetryarchive.cpp \
+    $$ROOT/src/core/HistoryStore.cpp \
+    $$ROOT/src/core/TelemetryArchive.cpp \
+    $$ROOT/src/core/TelemetryArchiveReader.cpp \
+    $$ROOT/src/core/TelemetryQuery.cpp
+
+HEADERS += \
+    $$ROOT/src/core/HistoryStore.h \
+    $$ROOT/src/core/TelemetryArchive.h \
+    $$ROOT/src/core/BinaryFormat.h \
+    $$ROOT/src/core/TelemetryArchiveFormat.h \
+    $$ROOT/src/core/TelemetryArchiveReader.h \
+    $$ROOT/src/core/TelemetryQuery.h
+
+INCLUDEPATH += $$ROOT/src/core
@@ -0,0 +1,480 @@
+// tests/TelemetryArchiveTest/tst_telemetryarchive.cpp
+#include <QtTest>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "TelemetryArchive.h"
+#include "TelemetryArchiveReader.h"
+#include "TelemetryQuery.h"
+
+#include <algorithm>
+
+using namespace ParamControl;
+
+namespace {
+
+/// Полночь UTC: сегмент не пересекает границу суток.
+constexpr qint64 kStartMs = 1699920000000LL;
+/// Шаг тактов, мс.
+constexpr qint64 kTickMs = 10000;
+/// Три часа тактов: больше одного блока (TelemetryArchive::kBlockTicks).
+constexpr int kTicks = 1080;
+
+qint64 tickTime(int tick) {
+    return kStartMs + tick * kTickMs;
+}
+
+/**
+ * @brief Значения такта: A - число каждый такт, B - сначала числа, затем строки,
+ * C - число в четных тактах.
+ */
+QVector<ParameterValue> tickValues(int tick) {
+    QVector<ParameterValue> values;
+    values.append(ParameterValue{"A", QVariant(double(tick % 100))});
+    values.append(ParameterValue{"B", tick < 5 ? QVariant(tick) : QVariant(QString(tick % 2 ? "on" : "off"))});
+    if (tick % 2 == 0) {
+        values.append(ParameterValue{"C", QVariant(tick * 0.5)});
+    }
+    return values;
+}
+
+void writeArchive(const QString& directory, int firstTick, int lastTick) {
+    TelemetryArchive archive;
+    QVERIFY(archive.open(directory, 1));
+    for (int tick = firstTick; tick < lastTick; ++tick) {
+        archive.appendTick(tickValues(tick), tickTime(tick));
+    }
+    archive.close();
+    QCOMPARE(archive.droppedTicks(), qint64(0));
+}
+
+QString segmentPath(const QString& directory, const char* suffix) {
+    const QDir dir(directory);
+    const QStringList files = dir.entryList(QStringList(QString("*") + suffix), QDir::Files, QDir::Name);
+    return files.isEmpty() ? QString() : dir.filePath(files.first());
+}
+
+void appendBytes(const QString& path, const QByteArray& bytes) {
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::Append));
+    QCOMPARE(file.write(bytes), qint64(bytes.size()));
+}
+
+} // namespace
+
+/**
+ * @brief Проверки записи и чтения архива ТМИ.
+ */
+class TelemetryArchiveTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void blockTicksRestoreTicks();
+    void readerSkipsTornRecords();
+    void writerDropsTornNameRecord();
+    void rollupsSummarizeClosedIntervals();
+    void rollupStateSurvivesReopen();
+    void trendLevelFollowsPointWidth();
+    void trendReturnsAtMostMaxPoints_data();
+    void trendReturnsAtMostMaxPoints();
+    void queryMatchesNames();
+    void queryMatchesSerialScan_data();
+    void queryMatchesSerialScan();
+    void queryMergesOverlappingSegments();
+};
+
+void TelemetryArchiveTest::roundTrip() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeArchive(directory.path(), 0, kTicks);
+
+    const TelemetryArchiveReader reader(directory.path());
+    QVERIFY(reader.isValid());
+    QCOMPARE(reader.names(), QStringList({"A", "B", "C"}));
+    QCOMPARE(reader.blockCount(), 2);
+    QCOMPARE(reader.firstTimestamp(), tickTime(0));
+    QCOMPARE(reader.lastTimestamp(), tickTime(kTicks - 1));
+
+    const QVector<HistorySample> a = reader.samples("A", tickTime(0), tickTime(kTicks));
+    QCOMPARE(a.size(), kTicks);
+    for (int tick = 0; tick < kTicks; ++tick) {
+        QCOMPARE(a[tick].timestampMs, tickTime(tick));
+        QCOMPARE(a[tick].value.toDouble(), double(tick % 100));
+    }
+
+    // Столбец, ставший строковым, хранит и прежние числа как строки
+    const QVector<HistorySample> b = reader.samples("B", tickTime(0), tickTime(9));
+    QCOMPARE(b.size(), 10);
+    QCOMPARE(b[4].value.toString(), QString("4"));
+    QCOMPARE(b[5].value.toString(), QString("on"));
+    QCOMPARE(b[6].value.toString(), QString("off"));
+
+    QCOMPARE(reader.samples("C", tickTime(0), tickTime(kTicks)).size(), kTicks / 2);
+
+    // Интервал внутри блока и интервал на стыке блоков
+    QCOMPARE(reader.samples("A", tickTime(10), tickTime(20)).size(), 11);
+    const QVector<HistorySample> joint = reader.samples("A", tickTime(1020), tickTime(1030));
+    QCOMPARE(joint.size(), 11);
+    QCOMPARE(joint.first().timestampMs, tickTime(1020));
+    QCOMPARE(joint.last().timestampMs, tickTime(1030));
+    QCOMPARE(reader.blocks(tickTime(1020), tickTime(1030)).size(), 2);
+
+    HistorySample sample;
+    QVERIFY(reader.valueAt("C", tickTime(1) + 5000, sample));
+    QCOMPARE(sample.timestampMs, tickTime(0));
+    QVERIFY(reader.valueAt("C", tickTime(1025), sample));
+    QCOMPARE(sample.timestampMs, tickTime(1024));
+    QCOMPARE(sample.value.toDouble(), 512.0);
+    QVERIFY(!reader.valueAt("C", tickTime(0) - 1, sample));
+    QVERIFY(!reader.valueAt("X", tickTime(10), sample));
+}
+
+void TelemetryArchiveTest::blockTicksRestoreTicks() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeArchive(directory.path(), 0, 100);
+
+    const TelemetryArchiveReader reader(directory.path());
+    const QVector<TelemetryArchiveReader::BlockRef> blocks = reader.blocks(tickTime(0), tickTime(100));
+    QCOMPARE(blocks.size(), 1);
+
+    const QVector<ArchiveTick> ticks = reader.blockTicks(blocks.first());
+    QCOMPARE(ticks.size(), 100);
+    QCOMPARE(ticks[0].timestampMs, tickTime(0));
+    QCOMPARE(ticks[0].values.size(), 3);
+    QCOMPARE(ticks[1].values.size(), 2);   // C пишется только в четных тактах
+
+    // Выбор столбцов: остальные значения не восстанавливаются, такты остаются
+    quint32 id = 0;
+    QVERIFY(reader.nameId("C", id));
+    const QVector<ArchiveTick> onlyC = reader.blockTicks(blocks.first(), {id});
+    QCOMPARE(onlyC.size(), 100);
+    QCOMPARE(onlyC[2].values.size(), 1);
+    QCOMPARE(onlyC[2].values.first().name, QString("C"));
+    QCOMPARE(onlyC[2].values.first().value.toDouble(), 1.0);
+    QVERIFY(onlyC[3].values.isEmpty());
+}
+
+void TelemetryArchiveTest::readerSkipsTornRecords() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeArchive(directory.path(), 0, kTicks);
+
+    // Недописанные записи индекса, справочника имен и сводок не видны читателю
+    const QString indexPath = segmentPath(directory.path(), kArchiveIndexSuffix);
+    QVERIFY(!indexPath.isEmpty());
+    appendBytes(indexPath, QByteArray(kArchiveIndexEntryBytes / 2, '\x7f'));
+    appendBytes(QDir(directory.path()).filePath(kArchiveNamesFile), QByteArray("\x28\x00xy", 4));
+    appendBytes(QDir(directory.path()).filePath(kArchiveRollupFiles[0]),
+                QByteArray(kArchiveRollupRecordBytes - 1, '\0'));
+
+    {
+        const TelemetryArchiveReader reader(directory.path());
+        QCOMPARE(reader.names(), QStringList({"A", "B", "C"}));
+        QCOMPARE(reader.blockCount(), 2);
+        QCOMPARE(reader.samples("A", tickTime(0), tickTime(kTicks)).size(), kTicks);
+    }
+
+    // Сегмент усечен посреди последнего блока: блок отбрасывается, предыдущие читаются
+    const QString segment = segmentPath(directory.path(), kArchiveSegmentSuffix);
+    QFile file(segment);
+    QVERIFY(file.resize(file.size() - 1));
+
+    const TelemetryArchiveReader reader(directory.path());
+    QCOMPARE(reader.blockCount(), 1);
+    QCOMPARE(reader.samples("A", tickTime(0), tickTime(kTicks)).size(), TelemetryArchive::kBlockTicks);
+}
+
+void TelemetryArchiveTest::writerDropsTornNameRecord() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeArchive(directory.path(), 0, 10);
+    appendBytes(QDir(directory.path()).filePath(kArchiveNamesFile), QByteArray("\x28\x00xy", 4));
+
+    // Новое имя получает номер сразу за целыми записями справочника
+    TelemetryArchive archive;
+    QVERIFY(archive.open(directory.path(), 1));
+    archive.appendTick({ParameterValue{"D", QVariant(7.0)}}, tickTime(10));
+    archive.close();
+
+    const TelemetryArchiveReader reader(directory.path());
+    QCOMPARE(reader.names(), QStringList({"A", "B", "C", "D"}));
+    quint32 id = 0;
+    QVERIFY(reader.nameId("D", id));
+    QCOMPARE(id, quint32(3));
+
+    const QVector<HistorySample> d = reader.samples("D", tickTime(0), tickTime(20));
+    QCOMPARE(d.size(), 1);
+    QCOMPARE(d.first().value.toDouble(), 7.0);
+    QCOMPARE(reader.samples("A", tickTime(0), tickTime(20)).size(), 10);
+}
+
+void TelemetryArchiveTest::rollupsSummarizeClosedIntervals() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeArchive(directory.path(), 0, kTicks);
+
+    const TelemetryArchiveReader reader(directory.path());
+    const qint64 endMs = tickTime(kTicks);
+
+    // Последняя минута и последний час не закрыты: их сводки еще в rollup.open
+    const QVector<TrendBucket> minutes = reader.rollups("A", kStartMs, endMs, 0);
+    QCOMPARE(minutes.size(), kTicks / 6 - 1);
+    for (int minute = 0; minute < minutes.size(); ++minute) {
+        const TrendBucket& bucket = minutes[minute];
+        QCOMPARE(bucket.startMs, kStartMs + minute * 60000LL);
+        QCOMPARE(bucket.durationMs, 60000LL);
+        QCOMPARE(bucket.count, 6);
+
+        double sum = 0.0;
+        double minimum = 1e9;
+        double maximum = -1e9;
+        for (int tick = minute * 6; tick < minute * 6 + 6; ++tick) {
+            sum += tick % 100;
+            minimum = qMin(minimum, double(tick % 100));
+            maximum = qMax(maximum, double(tick % 100));
+        }
+        QCOMPARE(bucket.minimum, minimum);
+        QCOMPARE(bucket.maximum, maximum);
+        QCOMPARE(bucket.mean, sum / 6);
+    }
+
+    const QVector<TrendBucket> hours = reader.rollups("A", kStartMs, endMs, 1);
+    QCOMPARE(hours.size(), 2);
+    QCOMPARE(hours[1].startMs, kStartMs + 3600000LL);
+    QCOMPARE(hours[1].count, 360);
+    QCOMPARE(hours[1].minimum, 0.0);
+    QCOMPARE(hours[1].maximum, 99.0);
+    QVERIFY(reader.rollups("A", kStartMs, endMs, 2).isEmpty());
+
+    // Строковые значения в сводки не попадают, числа строкового столбца - попадают
+    const QVector<TrendBucket> text = reader.rollups("B", kStartMs, endMs, 0);
+    QCOMPARE(text.size(), 1);
+    QCOMPARE(text.first().count, 5);
+    QCOMPARE(text.first().maximum, 4.0);
+
+    // Запрос с середины интервала включает сводку, которая его содержит
+    const QVector<TrendBucket> partial = reader.rollups("A", kStartMs + 90000, kStartMs + 150000, 0);
+    QCOMPARE(partial.size(), 2);
+    QCOMPARE(partial.first().startMs, kStartMs + 60000LL);
+}
+
+void TelemetryArchiveTest::rollupStateSurvivesReopen() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeArchive(directory.path(), 0, kTicks);
+    writeArchive(directory.path(), kTicks, kTicks + 60);
+
+    // Незакрытые интервалы первого сеанса закрыты во втором без потери значений
+    const TelemetryArchiveReader reader(directory.path());
+    const QVector<TrendBucket> minute = reader.rollups("A", tickTime(kTicks - 1), tickTime(kTicks - 1), 0);
+    QCOMPARE(minute.size(), 1);
+    QCOMPARE(minute.first().startMs, kStartMs + 179 * 60000LL);
+    QCOMPARE(minute.first().count, 6);
+
+    const QVector<TrendBucket> hour = reader.rollups("A", tickTime(kTicks - 1), tickTime(kTicks - 1), 1);
+    QCOMPARE(hour.size(), 1);
+    QCOMPARE(hour.first().startMs, kStartMs + 2 * 3600000LL);
+    QCOMPARE(hour.first().count, 360);
+}
+
+void TelemetryArchiveTest::trendLevelFollowsPointWidth() {
+    const qint64 hourMs = 3600000;
+    QCOMPARE(TelemetryArchiveReader::trendLevel(0, hourMs, 3600), -1);
+    QCOMPARE(TelemetryArchiveReader::trendLevel(0, hourMs, 60), 0);
+    QCOMPARE(TelemetryArchiveReader::trendLevel(0, 24 * hourMs, 24), 1);
+    QCOMPARE(TelemetryArchiveReader::trendLevel(0, 30 * 24 * hourMs, 30), 2);
+    QCOMPARE(TelemetryArchiveReader::trendLevel(0, hourMs, 0), -1);
+}
+
+void TelemetryArchiveTest::trendReturnsAtMostMaxPoints_data() {
+    QTest::addColumn<int>("maxPoints");
+
+    // Все уровни: сутки недоступны (сводки нет), час с достройкой, минута, отсчеты
+    QTest::newRow("1 point") << 1;
+    QTest::newRow("7 points") << 7;
+    QTest::newRow("10 points") << 10;
+    QTest::newRow("100 points") << 100;
+    QTest::newRow("1000 points") << 1000;
+    QTest::newRow("5000 points") << 5000;
+}
+
+void TelemetryArchiveTest::trendReturnsAtMostMaxPoints() {
+    QFETCH(int, maxPoints);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeArchive(directory.path(), 0, kTicks);
+
+    const TelemetryArchiveReader reader(directory.path());
+    const QVector<TrendBucket> trend = reader.trend("A", tickTime(0), tickTime(kTicks - 1), maxPoints);
+    QVERIFY(!trend.isEmpty());
+    QVERIFY2(trend.size() <= maxPoints, qPrintable(QString("%1 points").arg(trend.size())));
+
+    // Сводки разных уровней и отсчеты вместе покрывают каждое значение ровно один раз
+    int count = 0;
+    double sum = 0.0;
+    double minimum = trend.first().minimum;
+    double maximum = trend.first().maximum;
+    for (int i = 0; i < trend.size(); ++i) {
+        if (i > 0) {
+            QVERIFY(trend[i].startMs > trend[i - 1].startMs);
+        }
+        count += trend[i].count;
+        sum += trend[i].mean * trend[i].count;
+        minimum = qMin(minimum, trend[i].minimum);
+        maximum = qMax(maximum, trend[i].maximum);
+    }
+    QCOMPARE(count, kTicks);
+    QCOMPARE(minimum, 0.0);
+    QCOMPARE(maximum, 99.0);
+
+    double expected = 0.0;
+    for (int tick = 0; tick < kTicks; ++tick) {
+        expected += tick % 100;
+    }
+    QVERIFY(qAbs(sum - expected) < 1e-6);
+}
+
+void TelemetryArchiveTest::queryMatchesNames() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeArchive(directory.path(), 0, 10);
+
+    const TelemetryArchiveReader reader(directory.path());
+    const TelemetryQuery query(reader);
+    QCOMPARE(query.matchNames({}), QStringList({"A", "B", "C"}));
+    QCOMPARE(query.matchNames({"?"}), QStringList({"A", "B", "C"}));
+    QCOMPARE(query.matchNames({"C", "A"}), QStringList({"A", "C"}));
+    QVERIFY(query.matchNames({"X*"}).isEmpty());
+
+    // Только нечисловые значения не дают результата; числа строкового столбца учитываются
+    TelemetryQueryOptions options;
+    options.names = QStringList({"B"});
+    const QVector<TelemetryAggregate> text = query.run(options);
+    QCOMPARE(text.size(), 1);
+    QCOMPARE(text.first().count, qint64(5));
+    options.fromMs = tickTime(5);
+    QVERIFY(query.run(options).isEmpty());
+}
+
+void TelemetryArchiveTest::queryMatchesSerialScan_data() {
+    QTest::addColumn<int>("firstTick");
+    QTest::addColumn<int>("lastTick");
+
+    QTest::newRow("whole archive") << 0 << kTicks - 1;
+    QTest::newRow("across blocks") << 1000 << 1050;
+    QTest::newRow("inside block") << 10 << 20;
+}
+
+void TelemetryArchiveTest::queryMatchesSerialScan() {
+    QFETCH(int, firstTick);
+    QFETCH(int, lastTick);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    writeArchive(directory.path(), 0, kTicks);
+
+    const TelemetryArchiveReader reader(directory.path());
+    TelemetryQueryOptions options;
+    options.fromMs = tickTime(firstTick);
+    options.toMs = tickTime(lastTick);
+    options.names = QStringList({"A", "C"});
+    options.stepMs = 3600000;
+    options.percentiles = {0.0, 50.0, 95.0, 100.0};
+    options.hasThreshold = true;
+    options.threshold = 50.0;
+
+    const QVector<TelemetryAggregate> result = TelemetryQuery(reader).run(options);
+    QCOMPARE(result.size(), 2);
+
+    for (const TelemetryAggregate& aggregate : result) {
+        // Тот же подсчет последовательно по отсчетам
+        const QVector<HistorySample> samples = reader.samples(aggregate.name, options.fromMs, options.toMs);
+        QVERIFY(!samples.isEmpty());
+
+        QVector<double> values;
+        double sum = 0.0;
+        qint64 aboveMs = 0;
+        for (int i = 0; i < samples.size(); ++i) {
+            const double value = samples[i].value.toDouble();
+            values.append(value);
+            sum += value;
+            if (i > 0 && values[i - 1] > options.threshold) {
+                aboveMs += samples[i].timestampMs - samples[i - 1].timestampMs;
+            }
+        }
+        std::sort(values.begin(), values.end());
+
+        QCOMPARE(aggregate.count, qint64(samples.size()));
+        QCOMPARE(aggregate.firstMs, samples.first().timestampMs);
+        QCOMPARE(aggregate.lastMs, samples.last().timestampMs);
+        QCOMPARE(aggregate.minimum, values.first());
+        QCOMPARE(aggregate.maximum, values.last());
+        QCOMPARE(aggregate.mean, sum / samples.size());
+        QCOMPARE(aggregate.aboveMs, aboveMs);
+
+        QCOMPARE(aggregate.percentiles.size(), 4);
+        QCOMPARE(aggregate.percentiles[0], values.first());
+        QCOMPARE(aggregate.percentiles[3], values.last());
+        const double rank = 0.5 * (values.size() - 1);
+        const int lower = int(rank);
+        const double median = values[lower] + (values[qMin(lower + 1, values.size() - 1)] - values[lower]) * (rank - lower);
+        QCOMPARE(aggregate.percentiles[1], median);
+
+        qint64 seriesCount = 0;
+        for (const TrendBucket& bucket : aggregate.series) {
+            QCOMPARE(bucket.durationMs, options.stepMs);
+            QCOMPARE(bucket.startMs % options.stepMs, qint64(0));
+            seriesCount += bucket.count;
+        }
+        QCOMPARE(seriesCount, aggregate.count);
+    }
+}
+
+void TelemetryArchiveTest::queryMergesOverlappingSegments() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    // Второй сеанс начат после перевода часов назад: его сегмент перекрывает
+    // первый, и блок второго сегмента раньше второго блока первого
+    writeArchive(directory.path(), 0, 1100);
+    writeArchive(directory.path(), 200, 500);
+
+    const TelemetryArchiveReader reader(directory.path());
+    const QVector<TelemetryArchiveReader::BlockRef> blocks = reader.blocks(tickTime(0), tickTime(1100));
+    QVERIFY(!std::is_sorted(blocks.begin(), blocks.end(),
+                            [](const TelemetryArchiveReader::BlockRef& a, const TelemetryArchiveReader::BlockRef& b) {
+                                return a.firstMs < b.firstMs;
+                            }));
+
+    TelemetryQueryOptions options;
+    options.fromMs = tickTime(0);
+    options.toMs = tickTime(1100);
+    options.names = QStringList({"A"});
+    options.stepMs = 3600000;
+    const QVector<TelemetryAggregate> result = TelemetryQuery(reader).run(options);
+    QCOMPARE(result.size(), 1);
+
+    const TelemetryAggregate& aggregate = result.first();
+    QCOMPARE(aggregate.count, qint64(1100 + 300));
+    QCOMPARE(aggregate.firstMs, tickTime(0));
+    QCOMPARE(aggregate.lastMs, tickTime(1099));
+
+    // Интервалы ряда упорядочены и не повторяются; отсчеты второго сеанса попали в свои интервалы
+    QCOMPARE(aggregate.series.size(), 4);
+    qint64 seriesCount = 0;
+    for (int i = 0; i < aggregate.series.size(); ++i) {
+        QCOMPARE(aggregate.series[i].startMs, kStartMs + i * options.stepMs);
+        seriesCount += aggregate.series[i].count;
+    }
+    QCOMPARE(seriesCount, aggregate.count);
+    QCOMPARE(aggregate.series[0].count, 360 + 160);
+    QCOMPARE(aggregate.series[1].count, 360 + 140);
+}
+
+QTEST_GUILESS_MAIN(TelemetryArchiveTest)
+
+#include "tst_telemetryarchive.moc"
@@ -0,0 +1,52 @@
+// tests/common/LogJournalTestUtils.h
+#pragma once
+
+#include <QtTest>
+#include <QFile>
+#include <QStringList>
+#include <QVector>
+
+#include "LogJournalFormat.h"
+
+/**
+ * @brief Общие помощники тестов двоичного журнала событий: запись файлов,
+ * словарей строк и сегментов, собранных из записей.
+ */
+namespace LogJournalTestUtils {
+
+/**
+ * @brief Запись файла целиком; ошибка открытия или записи валит тест.
+ */
+inline void writeFile(const QString& path, const QByteArray& data) {
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(file.write(data), qint64(data.size()));
+}
+
+/**
+ * @brief Словарь строк журнала; номер строки - ее номер в strings.
+ */
+inline void writeDictionary(const QString& path, const QStringList& strings) {
+    QByteArray data;
+    for (const QString& text : strings) {
+        const QByteArray utf8 = text.toUtf8();
+        ParamControl::archivePut<quint16>(data, quint16(utf8.size()));
+        data += utf8;
+    }
+    writeFile(path, data);
+}
+
+/**
+ * @brief Сегмент с записями; время в заголовке - время первой записи,
+ * номер категории - ее номер в categories.
+ */
+inline QByteArray buildSegment(const QVector<ParamControl::LogEntry>& entries, const QStringList& categories) {
+    QByteArray segment = ParamControl::logJournalHeader(
+        entries.isEmpty() ? 0 : entries.first().timestamp.toMSecsSinceEpoch());
+    for (const ParamControl::LogEntry& entry : entries) {
+        ParamControl::logJournalPutEvent(segment, entry, quint32(categories.indexOf(entry.category())), 0);
+    }
+    return segment;
+}
+
+} // namespace LogJournalTestUtils
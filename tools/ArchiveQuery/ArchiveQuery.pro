@@ -0,0 +1,36 @@
+# Запросы к архиву ТМИ из командной строки: отсчеты, прореженные ряды,
+# минимум/максимум/среднее, процентили и время выше порога.
+#
+# Сборка (из корня репозитория):
+#   qmake tools/ArchiveQuery && make
+# Запуск:
+#   ./ArchiveQuery data/archive/ka1 --from 2025-10-01T00:00:00 --to 2025-10-08T00:00:00 \
+#       --name "T*" --step 3600 --percentile 95 --above 40
+
+QT += core concurrent
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = ArchiveQuery
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    main.cpp \
+    $$ROOT/src/core/HistoryStore.cpp \
+    $$ROOT/src/core/TelemetryArchiveReader.cpp \
+    $$ROOT/src/core/TelemetryQuery.cpp
+
+HEADERS += \
+    $$ROOT/src/core/HistoryStore.h \
+    $$ROOT/src/core/BinaryFormat.h \
+    $$ROOT/src/core/TelemetryArchiveFormat.h \
+    $$ROOT/src/core/TelemetryArchiveReader.h \
+    $$ROOT/src/core/TelemetryQuery.h
+
+INCLUDEPATH += $$ROOT/src/core
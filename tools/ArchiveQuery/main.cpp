@@ -0,0 +1,163 @@
+// tools/ArchiveQuery/main.cpp
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+#include "TelemetryArchiveReader.h"
+#include "TelemetryQuery.h"
+
+using namespace ParamControl;
+
+namespace {
+
+/**
+ * @brief Разбирает время: ISO 8601 (без зоны - UTC) или мс от эпохи.
+ */
+bool parseTime(const QString& text, qint64& ms) {
+    bool ok = false;
+    ms = text.toLongLong(&ok);
+    if (ok) {
+        return true;
+    }
+
+    QDateTime time = QDateTime::fromString(text, Qt::ISODateWithMs);
+    if (!time.isValid()) {
+        return false;
+    }
+    if (time.timeSpec() == Qt::LocalTime) {
+        time.setTimeSpec(Qt::UTC);
+    }
+    ms = time.toMSecsSinceEpoch();
+    return true;
+}
+
+QString formatTime(qint64 ms) {
+    return QDateTime::fromMSecsSinceEpoch(ms, Qt::UTC).toString("yyyy-MM-ddTHH:mm:ss.zzzZ");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Запросы к архиву ТМИ: отсчеты, прореженные ряды и сводки.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("archive", "Каталог архива КА (например, data/archive/ka1).");
+    const QCommandLineOption fromOption({"f", "from"}, "Начало интервала: ISO 8601 (UTC) или мс от эпохи.", "time");
+    const QCommandLineOption toOption({"t", "to"}, "Конец интервала (включительно).", "time");
+    const QCommandLineOption nameOption({"n", "name"}, "Имя или маска (*, ?); можно несколько раз.", "mask");
+    const QCommandLineOption stepOption({"s", "step"}, "Вывести ряд, прореженный с шагом в секундах.", "sec");
+    const QCommandLineOption percentileOption({"p", "percentile"}, "Процентиль 0..100; можно несколько раз.", "p");
+    const QCommandLineOption aboveOption("above", "Считать время выше порога.", "threshold");
+    const QCommandLineOption samplesOption("samples", "Вывести отсчеты вместо сводок.");
+    const QCommandLineOption listOption("list", "Вывести имена параметров архива.");
+    parser.addOptions({fromOption, toOption, nameOption, stepOption, percentileOption,
+                       aboveOption, samplesOption, listOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(1);
+    }
+
+    const TelemetryArchiveReader reader(parser.positionalArguments().first());
+    if (!reader.isValid()) {
+        err << "Archive not found: " << reader.directory() << "\n";
+        return 1;
+    }
+    const TelemetryQuery query(reader);
+
+    TelemetryQueryOptions options;
+    options.names = parser.values(nameOption);
+    if ((parser.isSet(fromOption) && !parseTime(parser.value(fromOption), options.fromMs)) ||
+        (parser.isSet(toOption) && !parseTime(parser.value(toOption), options.toMs))) {
+        err << "Invalid time, expected ISO 8601 or milliseconds since epoch\n";
+        return 1;
+    }
+    if (parser.isSet(stepOption)) {
+        options.stepMs = qint64(parser.value(stepOption).toDouble() * 1000);
+        if (options.stepMs <= 0) {
+            err << "Invalid step: " << parser.value(stepOption) << "\n";
+            return 1;
+        }
+    }
+    for (const QString& value : parser.values(percentileOption)) {
+        bool ok = false;
+        const double percentile = value.toDouble(&ok);
+        if (!ok || percentile < 0.0 || percentile > 100.0) {
+            err << "Invalid percentile: " << value << "\n";
+            return 1;
+        }
+        options.percentiles.append(percentile);
+    }
+    if (parser.isSet(aboveOption)) {
+        options.threshold = parser.value(aboveOption).toDouble(&options.hasThreshold);
+        if (!options.hasThreshold) {
+            err << "Invalid threshold: " << parser.value(aboveOption) << "\n";
+            return 1;
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (parser.isSet(listOption)) {
+        for (const QString& name : query.matchNames(options.names)) {
+            out << name << "\n";
+        }
+        return 0;
+    }
+
+    if (parser.isSet(samplesOption)) {
+        out << "name\ttime\tvalue\n";
+        for (const QString& name : query.matchNames(options.names)) {
+            for (const HistorySample& sample : reader.samples(name, options.fromMs, options.toMs)) {
+                out << name << '\t' << formatTime(sample.timestampMs) << '\t' << sample.value.toString() << "\n";
+            }
+        }
+        return 0;
+    }
+
+    const QVector<TelemetryAggregate> aggregates = query.run(options);
+
+    out << "name\tcount\tfirst\tlast\tmin\tmax\tmean";
+    for (double percentile : options.percentiles) {
+        out << "\tp" << percentile;
+    }
+    if (options.hasThreshold) {
+        out << "\tabove_s";
+    }
+    out << "\n";
+    for (const TelemetryAggregate& aggregate : aggregates) {
+        out << aggregate.name << '\t' << aggregate.count << '\t' << formatTime(aggregate.firstMs) << '\t'
+            << formatTime(aggregate.lastMs) << '\t' << aggregate.minimum << '\t' << aggregate.maximum << '\t'
+            << aggregate.mean;
+        for (double value : aggregate.percentiles) {
+            out << '\t' << value;
+        }
+        if (options.hasThreshold) {
+            out << '\t' << aggregate.aboveMs / 1000.0;
+        }
+        out << "\n";
+    }
+
+    if (options.stepMs > 0) {
+        out << "\nname\tstart\tcount\tmin\tmax\tmean\n";
+        for (const TelemetryAggregate& aggregate : aggregates) {
+            for (const TrendBucket& bucket : aggregate.series) {
+                out << aggregate.name << '\t' << formatTime(bucket.startMs) << '\t' << bucket.count << '\t'
+                    << bucket.minimum << '\t' << bucket.maximum << '\t' << bucket.mean << "\n";
+            }
+        }
+    }
+
+    out.flush();
+    err << "Blocks: " << reader.blocks(options.fromMs, options.toMs).size() << " of " << reader.blockCount()
+        << ", parameters: " << aggregates.size() << ", elapsed: " << timer.elapsed() << " ms\n";
+    return 0;
+}
@@ -0,0 +1,34 @@
+# Выгрузка двоичного журнала событий в текстовый формат
+# "Дата Время | Уровень | Категория | Сообщение | Значение | Статус".
+#
+# Сборка (из корня репозитория):
+#   qmake tools/LogExport && make
+# Запуск:
+#   ./LogExport data/LOG_main.txt --from 2025-10-01T00:00:00 --output LOG_october.txt
+
+QT += core
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = LogExport
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    main.cpp \
+    $$ROOT/src/core/LogJournalReader.cpp \
+    $$ROOT/src/core/LogStringTable.cpp
+
+HEADERS += \
+    $$ROOT/src/core/BinaryFormat.h \
+    $$ROOT/src/core/LogEntry.h \
+    $$ROOT/src/core/LogJournalFormat.h \
+    $$ROOT/src/core/LogJournalReader.h \
+    $$ROOT/src/core/LogStringTable.h
+
+INCLUDEPATH += $$ROOT/src/core
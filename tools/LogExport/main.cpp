@@ -0,0 +1,94 @@
+// tools/LogExport/main.cpp
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+
+#include <limits>
+
+#include "LogJournalReader.h"
+
+using namespace ParamControl;
+
+namespace {
+
+/**
+ * @brief Разбирает время: ISO 8601 (без зоны - UTC) или мс от эпохи.
+ */
+bool parseTime(const QString& text, qint64& ms) {
+    bool ok = false;
+    ms = text.toLongLong(&ok);
+    if (ok) {
+        return true;
+    }
+
+    QDateTime time = QDateTime::fromString(text, Qt::ISODateWithMs);
+    if (!time.isValid()) {
+        return false;
+    }
+    if (time.timeSpec() == Qt::LocalTime) {
+        time.setTimeSpec(Qt::UTC);
+    }
+    ms = time.toMSecsSinceEpoch();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Выгрузка журнала событий в текстовый формат.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("log", "Путь к журналу, как в настройках приложения (например, data/LOG_main.txt).");
+    const QCommandLineOption fromOption({"f", "from"}, "Начало интервала: ISO 8601 (UTC) или мс от эпохи.", "time");
+    const QCommandLineOption toOption({"t", "to"}, "Конец интервала (включительно).", "time");
+    const QCommandLineOption outputOption({"o", "output"}, "Текстовый файл (по умолчанию - стандартный вывод).", "file");
+    parser.addOptions({fromOption, toOption, outputOption});
+    parser.process(app);
+
+    QTextStream err(stderr);
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(1);
+    }
+
+    qint64 fromMs = std::numeric_limits<qint64>::min();
+    qint64 toMs = std::numeric_limits<qint64>::max();
+    if ((parser.isSet(fromOption) && !parseTime(parser.value(fromOption), fromMs)) ||
+        (parser.isSet(toOption) && !parseTime(parser.value(toOption), toMs))) {
+        err << "Invalid time, expected ISO 8601 or milliseconds since epoch\n";
+        return 1;
+    }
+
+    const LogJournalReader reader(parser.positionalArguments().first());
+    if (reader.segmentFiles().isEmpty()) {
+        err << "Log journal not found: " << LogJournalReader::journalPath(parser.positionalArguments().first()) << "\n";
+        return 1;
+    }
+
+    const QString outputPath = parser.value(outputOption);
+    QFile output;
+    bool opened = false;
+    if (outputPath.isEmpty()) {
+        opened = output.open(stdout, QIODevice::WriteOnly);
+    } else {
+        output.setFileName(outputPath);
+        opened = output.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+    if (!opened) {
+        err << "Cannot open output: " << outputPath << "\n";
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 exported = reader.exportText(output, fromMs, toMs);
+    output.close();
+
+    err << "Exported " << exported << " entries in " << timer.elapsed() << " ms\n";
+    return 0;
+}
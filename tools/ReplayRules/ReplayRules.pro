@@ -0,0 +1,60 @@
+# Прогон правил parameters_ka*.json по архиву ТМИ или файлу записи без GUI.
+# Переходы статусов совпадают с живым прогоном по тем же тактам и пишутся
+# в формате журнала или JSONL - для проверки новых пределов на прошлых данных.
+#
+# Сборка (из корня репозитория):
+#   qmake tools/ReplayRules && make
+# Запуск:
+#   ./ReplayRules --ka 1 --from 2025-09-01T00:00:00 --output transitions.jsonl
+#   ./ReplayRules --parameters new_limits.json --capture capture.jsonl --format log
+#   ./ReplayRules --ka 1 --interval 500   (интервал опроса; без него - по шагу тактов)
+
+QT += core xml concurrent
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = ReplayRules
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+ROOT = $$PWD/../..
+
+SOURCES += \
+    main.cpp \
+    $$ROOT/src/core/Parameter.cpp \
+    $$ROOT/src/core/ParameterEquals.cpp \
+    $$ROOT/src/core/ParameterNotEquals.cpp \
+    $$ROOT/src/core/ParameterInLimits.cpp \
+    $$ROOT/src/core/ParameterOutOfLimits.cpp \
+    $$ROOT/src/core/ParameterChanged.cpp \
+    $$ROOT/src/core/ParameterExpression.cpp \
+    $$ROOT/src/core/ParameterRateOfChange.cpp \
+    $$ROOT/src/core/ParameterTrend.cpp \
+    $$ROOT/src/core/ParameterStatistic.cpp \
+    $$ROOT/src/core/ParameterModel.cpp \
+    $$ROOT/src/core/ConditionProgram.cpp \
+    $$ROOT/src/core/Expression.cpp \
+    $$ROOT/src/core/LimitKernel.cpp \
+    $$ROOT/src/core/WindowStore.cpp \
+    $$ROOT/src/core/HistoryStore.cpp \
+    $$ROOT/src/core/TelemetryArchive.cpp \
+    $$ROOT/src/core/TelemetryArchiveReader.cpp \
+    $$ROOT/src/core/RuleReplay.cpp
+
+HEADERS += \
+    $$ROOT/src/core/Parameter.h \
+    $$ROOT/src/core/ParameterModel.h \
+    $$ROOT/src/core/ConditionProgram.h \
+    $$ROOT/src/core/LimitKernel.h \
+    $$ROOT/src/core/WindowStore.h \
+    $$ROOT/src/core/HistoryStore.h \
+    $$ROOT/src/core/TelemetryArchive.h \
+    $$ROOT/src/core/BinaryFormat.h \
+    $$ROOT/src/core/TelemetryArchiveFormat.h \
+    $$ROOT/src/core/TelemetryArchiveReader.h \
+    $$ROOT/src/core/RuleReplay.h
+
+INCLUDEPATH += $$ROOT/src/core
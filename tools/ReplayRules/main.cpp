@@ -0,0 +1,260 @@
+// tools/ReplayRules/main.cpp
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include <limits>
+
+#include "ParameterModel.h"
+#include "RuleReplay.h"
+#include "TelemetryArchiveReader.h"
+
+using namespace ParamControl;
+
+namespace {
+
+/**
+ * @brief Разбирает время: ISO 8601 (без зоны - UTC) или мс от эпохи.
+ */
+bool parseTime(const QString& text, qint64& ms) {
+    bool ok = false;
+    ms = text.toLongLong(&ok);
+    if (ok) {
+        return true;
+    }
+
+    QDateTime time = QDateTime::fromString(text, Qt::ISODateWithMs);
+    if (!time.isValid()) {
+        return false;
+    }
+    if (time.timeSpec() == Qt::LocalTime) {
+        time.setTimeSpec(Qt::UTC);
+    }
+    ms = time.toMSecsSinceEpoch();
+    return true;
+}
+
+QString typeName(ParameterType type) {
+    switch (type) {
+        case ParameterType::Equals: return "Equals";
+        case ParameterType::NotEquals: return "NotEquals";
+        case ParameterType::InLimits: return "InLimits";
+        case ParameterType::OutOfLimits: return "OutOfLimits";
+        case ParameterType::Changed: return "Changed";
+        case ParameterType::Expression: return "Expression";
+        case ParameterType::RateOfChange: return "RateOfChange";
+        case ParameterType::Trend: return "Trend";
+        case ParameterType::Statistic: return "Statistic";
+    }
+    return "Unknown";
+}
+
+QString statusName(ParameterStatus status) {
+    switch (status) {
+        case ParameterStatus::Ok: return "Ok";
+        case ParameterStatus::Error: return "Error";
+        case ParameterStatus::Unknown: return "Unknown";
+    }
+    return "Unknown";
+}
+
+/**
+ * @brief Строка в формате файла журнала LogManager.
+ */
+QString formatLogLine(const ReplayTransition& transition) {
+    QString message;
+    switch (transition.current) {
+        case ParameterStatus::Error:
+            message = QString("Условие нарушено (%1)").arg(transition.condition);
+            break;
+        case ParameterStatus::Ok:
+            message = transition.previous == ParameterStatus::Error
+                ? QString("Значение вернулось в норму")
+                : QString("Значение в норме (%1)").arg(transition.condition);
+            break;
+        case ParameterStatus::Unknown:
+            message = "Статус не определен";
+            break;
+    }
+
+    const bool error = transition.current == ParameterStatus::Error;
+    return QString("%1 | %2 | %3 | %4 | %5 | %6")
+        .arg(QDateTime::fromMSecsSinceEpoch(transition.timestampMs).toString("yyyy-MM-dd hh:mm:ss"))
+        .arg(error ? "ERROR" : "INFO")
+        .arg(transition.name)
+        .arg(message)
+        .arg(transition.value.toString())
+        .arg(error ? "Error" : "Normal");
+}
+
+QByteArray formatJsonLine(const ReplayTransition& transition) {
+    QJsonObject object;
+    object["time"] = QDateTime::fromMSecsSinceEpoch(transition.timestampMs, Qt::UTC).toString(Qt::ISODateWithMs);
+    object["timestampMs"] = double(transition.timestampMs);
+    object["name"] = transition.name;
+    object["type"] = typeName(transition.type);
+    object["previous"] = statusName(transition.previous);
+    object["current"] = statusName(transition.current);
+    object["value"] = QJsonValue::fromVariant(transition.value);
+    object["condition"] = transition.condition;
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Прогон правил контроля по архиву ТМИ или файлу записи без GUI.");
+    parser.addHelpOption();
+    const QCommandLineOption kaOption({"k", "ka"}, "Номер КА: parameters_ka<N>.json и data/archive/ka<N> по умолчанию.", "number");
+    const QCommandLineOption parametersOption({"p", "parameters"}, "Файл параметров (parameters_ka*.json).", "file");
+    const QCommandLineOption archiveOption({"a", "archive"}, "Каталог архива ТМИ.", "dir");
+    const QCommandLineOption captureOption({"c", "capture"}, "Файл записи JSONL вместо архива.", "file");
+    const QCommandLineOption fromOption({"f", "from"}, "Начало интервала архива: ISO 8601 (UTC) или мс от эпохи.", "time");
+    const QCommandLineOption toOption({"t", "to"}, "Конец интервала архива (включительно).", "time");
+    const QCommandLineOption outputOption({"o", "output"}, "Файл переходов (по умолчанию - стандартный вывод).", "file");
+    const QCommandLineOption formatOption("format", "Формат: log или jsonl (по умолчанию - по расширению файла, иначе log).", "format");
+    const QCommandLineOption intervalOption({"i", "interval"}, "Интервал опроса живого прогона, мс (по умолчанию - по шагу тактов записи).", "ms");
+    parser.addOptions({kaOption, parametersOption, archiveOption, captureOption, fromOption, toOption,
+                       outputOption, formatOption, intervalOption});
+    parser.process(app);
+
+    QTextStream err(stderr);
+
+    const QString ka = parser.value(kaOption);
+    const QString parametersPath = parser.isSet(parametersOption)
+        ? parser.value(parametersOption)
+        : (ka.isEmpty() ? QString() : QString("parameters_ka%1.json").arg(ka));
+    const QString archivePath = parser.isSet(archiveOption)
+        ? parser.value(archiveOption)
+        : (ka.isEmpty() ? QString() : QString("data/archive/ka%1").arg(ka));
+    if (parametersPath.isEmpty() || (archivePath.isEmpty() && !parser.isSet(captureOption))) {
+        parser.showHelp(1);
+    }
+
+    qint64 fromMs = std::numeric_limits<qint64>::min();
+    qint64 toMs = std::numeric_limits<qint64>::max();
+    if ((parser.isSet(fromOption) && !parseTime(parser.value(fromOption), fromMs)) ||
+        (parser.isSet(toOption) && !parseTime(parser.value(toOption), toMs))) {
+        err << "Invalid time, expected ISO 8601 or milliseconds since epoch\n";
+        return 1;
+    }
+
+    const QString outputPath = parser.value(outputOption);
+    const QString format = parser.isSet(formatOption)
+        ? parser.value(formatOption)
+        : (outputPath.endsWith(".jsonl") ? QString("jsonl") : QString("log"));
+    if (format != "log" && format != "jsonl") {
+        err << "Unknown format: " << format << "\n";
+        return 1;
+    }
+
+    int intervalMs = 0;
+    if (parser.isSet(intervalOption)) {
+        bool ok = false;
+        intervalMs = parser.value(intervalOption).toInt(&ok);
+        if (!ok || intervalMs <= 0) {
+            err << "Invalid interval: " << parser.value(intervalOption) << "\n";
+            return 1;
+        }
+    }
+
+    // Параметры загружаются тем же кодом, что и в приложении. Ошибки в
+    // отдельных записях приложение тоже пропускает: прогон идет по остальным
+    ParameterModel model;
+    const bool loaded = model.loadParameters(parametersPath);
+    if (model.getAllParameters().isEmpty()) {
+        err << "Cannot load parameters: " << parametersPath << "\n";
+        return 1;
+    }
+    if (!loaded) {
+        err << "Some parameters were skipped, see warnings above: " << parametersPath << "\n";
+    }
+    RuleReplay replay(model.getAllParameters());
+
+    // Окна правил должны иметь ту же емкость, что и в живом прогоне
+    if (intervalMs == 0) {
+        if (parser.isSet(captureOption)) {
+            QFile capture(parser.value(captureOption));
+            if (capture.open(QIODevice::ReadOnly)) {
+                intervalMs = RuleReplay::captureSampleInterval(capture);
+            }
+        } else {
+            intervalMs = replay.archiveSampleInterval(TelemetryArchiveReader(archivePath), fromMs, toMs);
+        }
+    }
+    if (intervalMs > 0) {
+        replay.setSampleInterval(intervalMs);
+    } else {
+        intervalMs = replay.sampleInterval();
+    }
+
+    QFile output;
+    bool opened = false;
+    if (outputPath.isEmpty()) {
+        opened = output.open(stdout, QIODevice::WriteOnly);
+    } else {
+        output.setFileName(outputPath);
+        opened = output.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+    if (!opened) {
+        err << "Cannot open output: " << outputPath << "\n";
+        return 1;
+    }
+    QTextStream out(&output);
+    out.setCodec("UTF-8");
+    if (format == "log") {
+        out << "# Прогон правил " << parametersPath << " по "
+            << (parser.isSet(captureOption) ? parser.value(captureOption) : archivePath) << "\n";
+        out << "# Формат: Дата Время | Уровень | Категория | Сообщение | Значение | Статус\n\n";
+    }
+
+    qint64 transitions = 0;
+    const RuleReplay::Sink sink = [&](const ReplayTransition& transition) {
+        ++transitions;
+        if (format == "jsonl") {
+            out << formatJsonLine(transition) << "\n";
+        } else {
+            out << formatLogLine(transition) << "\n";
+        }
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (parser.isSet(captureOption)) {
+        QFile capture(parser.value(captureOption));
+        if (!capture.open(QIODevice::ReadOnly)) {
+            err << "Cannot open capture: " << capture.fileName() << "\n";
+            return 1;
+        }
+        QString error;
+        replay.replayCapture(capture, sink, &error);
+        if (!error.isEmpty()) {
+            err << "Skipped malformed lines, first: " << error << "\n";
+        }
+    } else {
+        const TelemetryArchiveReader reader(archivePath);
+        if (!reader.isValid()) {
+            err << "Archive not found: " << archivePath << "\n";
+            return 1;
+        }
+        replay.replayArchive(reader, fromMs, toMs, sink);
+    }
+
+    out.flush();
+    const qint64 elapsedMs = qMax<qint64>(1, timer.elapsed());
+    err << "Rules: " << model.getAllParameters().size() << ", interval: " << intervalMs
+        << " ms, ticks: " << replay.tickCount()
+        << ", transitions: " << transitions << ", elapsed: " << elapsedMs << " ms ("
+        << replay.tickCount() * 1000 / elapsedMs << " ticks/s)\n";
+    return 0;
+}